@@ -119,6 +119,54 @@ def test_history_export_strips_internal_analysis_fields_from_json() -> None:
     assert "_internal" not in metadata.get("analysis", {})
 
 
+def test_history_export_csv_format_streams_the_zip_csv_without_content_length() -> None:
+    app, _ = make_app_and_state(language="en", sample_count=30)
+    with TestClient(app) as client:
+        bundle = client.get("/api/history/run-1/export")
+        response = client.get("/api/history/run-1/export", params={"format": "csv"})
+
+    assert response.status_code == 200
+    assert response.headers["content-type"].startswith("text/csv")
+    assert response.headers["content-disposition"] == 'attachment; filename="run-1_raw.csv"'
+    assert "content-length" not in response.headers
+    with zipfile.ZipFile(io.BytesIO(bundle.content), "r") as archive:
+        assert response.content == archive.read("run-1_raw.csv")
+
+
+def test_history_export_columnar_format_round_trips_samples() -> None:
+    from vibesensor.use_cases.history.columnar_export import read_columnar_export
+
+    app, state = make_app_and_state(language="en", sample_count=40)
+    with TestClient(app) as client:
+        response = client.get("/api/history/run-1/export", params={"format": "columnar"})
+
+    assert response.status_code == 200
+    assert response.headers["content-type"] == "application/zip"
+    assert response.headers["content-disposition"] == ('attachment; filename="run-1_columnar.zip"')
+    assert "content-length" not in response.headers
+    with zipfile.ZipFile(io.BytesIO(response.content), "r") as archive:
+        assert archive.namelist()[0] == "schema.json"
+        assert archive.testzip() is None
+        metadata = json.loads(archive.read("run-1.json").decode("utf-8"))
+        columns = read_columnar_export(archive)
+    assert metadata["sample_count"] == 40
+    assert columns["t_s"] == [float(row["t_s"]) for row in state.history_db.samples]
+    assert columns["speed_kmh"] == [row["speed_kmh"] for row in state.history_db.samples]
+    assert set(columns["client_id"]) == {"aabbccddeeff"}
+
+
+@pytest.mark.parametrize("export_format", ["csv", "columnar"])
+def test_history_streamed_exports_return_404_before_streaming(export_format: str) -> None:
+    app, _ = make_app_and_state(language="en")
+    with TestClient(app) as client:
+        response = client.get(
+            "/api/history/missing-run/export",
+            params={"format": export_format},
+        )
+
+    assert response.status_code == 404
+
+
 @pytest.mark.parametrize(
     ("path", "lang"),
     [
@@ -0,0 +1,106 @@
+"""Guard round-trips, LRU eviction, restart rescans, and corrupt-entry recovery."""
+
+from __future__ import annotations
+
+import os
+from pathlib import Path
+
+import numpy as np
+
+from vibesensor.adapters.persistence.whole_run_spectral_cache import (
+    FileWholeRunSpectralChunkCache,
+)
+from vibesensor.use_cases.diagnostics.whole_run_spectral_cache import WholeRunSpectralChunk
+from vibesensor.use_cases.diagnostics.whole_run_spectral_projection import (
+    WholeRunWindowSpectralSummary,
+)
+
+
+def _chunk(*, rows: int = 4, bins: int = 64, fill: float = 1.0) -> WholeRunSpectralChunk:
+    return WholeRunSpectralChunk(
+        freq_hz=np.linspace(1.0, 64.0, bins, dtype=np.float64),
+        spectrum_rows=np.full((rows, bins), fill, dtype=np.float32),
+        summaries=tuple(
+            WholeRunWindowSpectralSummary(
+                window_index=index,
+                coverage_state="full",
+                returned_sample_start=index * 8,
+                returned_sample_count=8,
+                window_start_t_s=float(index),
+                window_end_t_s=float(index) + 1.0,
+                dominant_freq_hz=12.5,
+            )
+            for index in range(rows)
+        ),
+    )
+
+
+def _entry_bytes(tmp_path: Path) -> int:
+    probe = FileWholeRunSpectralChunkCache(root_dir=tmp_path / "probe")
+    probe.store("probe", _chunk())
+    return probe.stats().total_bytes
+
+
+def test_spectral_cache_round_trips_chunks_as_memory_maps(tmp_path: Path) -> None:
+    cache = FileWholeRunSpectralChunkCache(root_dir=tmp_path / "cache")
+    chunk = _chunk(fill=0.25)
+
+    assert cache.load("a" * 64) is None
+    cache.store("a" * 64, chunk)
+    loaded = cache.load("a" * 64)
+
+    assert loaded is not None
+    assert isinstance(loaded.spectrum_rows, np.memmap)
+    np.testing.assert_array_equal(loaded.spectrum_rows, chunk.spectrum_rows)
+    np.testing.assert_array_equal(loaded.freq_hz, chunk.freq_hz)
+    assert loaded.summaries == chunk.summaries
+    stats = cache.stats()
+    assert (stats.entry_count, stats.hits, stats.misses) == (1, 1, 1)
+
+
+def test_spectral_cache_evicts_least_recently_used_entries_over_budget(tmp_path: Path) -> None:
+    entry_bytes = _entry_bytes(tmp_path)
+    cache = FileWholeRunSpectralChunkCache(
+        root_dir=tmp_path / "cache",
+        max_bytes=(entry_bytes * 2) + (entry_bytes // 2),
+    )
+    cache.store("first", _chunk())
+    cache.store("second", _chunk())
+    assert cache.load("first") is not None
+
+    cache.store("third", _chunk())
+
+    assert cache.load("second") is None
+    assert not (tmp_path / "cache" / "second").exists()
+    assert cache.load("first") is not None
+    assert cache.load("third") is not None
+    assert cache.stats().total_bytes <= cache.stats().max_bytes
+
+
+def test_spectral_cache_rescan_keeps_mtime_order_and_budget(tmp_path: Path) -> None:
+    entry_bytes = _entry_bytes(tmp_path)
+    root_dir = tmp_path / "cache"
+    cache = FileWholeRunSpectralChunkCache(root_dir=root_dir)
+    for age_s, key in ((300, "old"), (200, "middle"), (100, "new")):
+        cache.store(key, _chunk())
+        stamp = (root_dir / key).stat().st_mtime - age_s
+        os.utime(root_dir / key, (stamp, stamp))
+    (root_dir / ".tmp-interrupted").mkdir()
+
+    reopened = FileWholeRunSpectralChunkCache(root_dir=root_dir, max_bytes=entry_bytes * 2)
+
+    assert reopened.stats().entry_count == 2
+    assert reopened.load("old") is None
+    assert reopened.load("middle") is not None
+    assert not (root_dir / ".tmp-interrupted").exists()
+
+
+def test_spectral_cache_drops_unreadable_entries(tmp_path: Path) -> None:
+    root_dir = tmp_path / "cache"
+    cache = FileWholeRunSpectralChunkCache(root_dir=root_dir)
+    cache.store("broken", _chunk())
+    (root_dir / "broken" / "combined_spectrum.f32.npy").write_bytes(b"not an npy file")
+
+    assert cache.load("broken") is None
+    assert cache.stats().entry_count == 0
+    assert not (root_dir / "broken").exists()
@@ -0,0 +1,210 @@
+"""Backlog replay throughput and live-frame latency: UDP stop-and-wait vs. TCP stream.
+
+Opt-in benchmark (``benchmark_*.py`` is not collected by default)::
+
+    pytest apps/server/tests/adapters/udp/benchmark_backlog_stream.py \
+        --benchmark-only --benchmark-json=backlog-stream.json
+
+A node emulator in a child process replays a queued backlog the way the
+firmware does: either one UDP datagram per DATA_ACK (the pre-stream path) or
+length-prefixed records over the TCP backlog stream with a bounded window of
+unacknowledged records.  A second node sends live frames over UDP at 100 Hz
+throughout and times each DATA_ACK round trip.  The server side is the real
+data receiver and registry.  ``extra_info`` records replay frames/s and live
+round-trip percentiles while idle and during each kind of replay.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import multiprocessing
+import queue
+import socket
+import threading
+import time
+from pathlib import Path
+from typing import Literal
+
+import numpy as np
+import pytest
+
+from vibesensor.adapters.persistence.history_db import create_history_persistence_adapters
+from vibesensor.adapters.udp.backlog_stream_rx import start_backlog_stream_server
+from vibesensor.adapters.udp.protocol import (
+    DATA_ACK_BYTES,
+    pack_data,
+    pack_stream_record,
+    parse_data_ack,
+)
+from vibesensor.adapters.udp.udp_data_rx import start_udp_data_receiver
+from vibesensor.infra.runtime.registry import ClientRegistry
+
+type _ReplayMode = Literal["idle", "udp", "stream"]
+
+_BACKLOG_CLIENT = bytes.fromhex("aabbccddee01")
+_LIVE_CLIENT = bytes.fromhex("aabbccddee02")
+_BACKLOG_FRAMES = 4_000
+_SAMPLES_PER_FRAME = 200
+_STREAM_WINDOW = 16
+_LIVE_INTERVAL_S = 0.01
+_IDLE_LIVE_FRAMES = 200
+_ACK_TIMEOUT_S = 0.12
+
+
+class _NullProcessor:
+    def ingest(self, client_id, samples, *, sample_rate_hz, t0_us) -> None:
+        return None
+
+    def flush_client_buffer(self, client_id: str) -> None:
+        return None
+
+
+def _packet(client_id: bytes, seq: int, samples: np.ndarray) -> bytes:
+    return pack_data(client_id, seq=seq, t0_us=seq * 250_000, samples=samples)
+
+
+def _replay_udp(data_port: int, samples: np.ndarray) -> None:
+    with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as sock:
+        sock.settimeout(_ACK_TIMEOUT_S)
+        for seq in range(_BACKLOG_FRAMES):
+            packet = _packet(_BACKLOG_CLIENT, seq, samples)
+            while True:
+                sock.sendto(packet, ("127.0.0.1", data_port))
+                try:
+                    ack = parse_data_ack(sock.recv(64))
+                except TimeoutError:
+                    continue
+                if ack.last_seq_received == seq:
+                    break
+
+
+def _replay_stream(stream_port: int, samples: np.ndarray) -> None:
+    with socket.create_connection(("127.0.0.1", stream_port)) as sock:
+        sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        pending = b""
+        next_seq = 0
+        acked = -1
+        while acked < _BACKLOG_FRAMES - 1:
+            burst = []
+            while next_seq < _BACKLOG_FRAMES and next_seq - acked <= _STREAM_WINDOW:
+                burst.append(pack_stream_record(_packet(_BACKLOG_CLIENT, next_seq, samples)))
+                next_seq += 1
+            if burst:
+                sock.sendall(b"".join(burst))
+            pending += sock.recv(4096)
+            while len(pending) >= DATA_ACK_BYTES:
+                acked = parse_data_ack(pending[:DATA_ACK_BYTES]).last_seq_received
+                pending = pending[DATA_ACK_BYTES:]
+
+
+def _run_live(data_port: int, samples: np.ndarray, stop: threading.Event) -> list[int]:
+    rtts_us: list[int] = []
+    with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as sock:
+        sock.settimeout(_ACK_TIMEOUT_S)
+        seq = 0
+        while not stop.is_set():
+            started = time.perf_counter_ns()
+            sock.sendto(_packet(_LIVE_CLIENT, seq, samples), ("127.0.0.1", data_port))
+            try:
+                sock.recv(64)
+                rtts_us.append((time.perf_counter_ns() - started) // 1_000)
+            except TimeoutError:
+                rtts_us.append(int(_ACK_TIMEOUT_S * 1_000_000))
+            seq += 1
+            time.sleep(_LIVE_INTERVAL_S)
+    return rtts_us
+
+
+def _run_node(
+    mode: _ReplayMode,
+    data_port: int,
+    stream_port: int,
+    results: multiprocessing.Queue,
+) -> None:
+    samples = np.zeros((_SAMPLES_PER_FRAME, 3), dtype=np.int16)
+    stop = threading.Event()
+    live_rtts: list[int] = []
+    live = threading.Thread(
+        target=lambda: live_rtts.extend(_run_live(data_port, samples, stop)),
+        daemon=True,
+    )
+    live.start()
+    started = time.perf_counter()
+    if mode == "udp":
+        _replay_udp(data_port, samples)
+    elif mode == "stream":
+        _replay_stream(stream_port, samples)
+    else:
+        time.sleep(_IDLE_LIVE_FRAMES * _LIVE_INTERVAL_S)
+    replay_s = time.perf_counter() - started
+    stop.set()
+    live.join()
+    results.put((replay_s, live_rtts))
+
+
+async def _serve_node(tmp_path: Path, mode: _ReplayMode) -> tuple[float, list[int]]:
+    adapters = create_history_persistence_adapters(tmp_path / f"history-{mode}.db")
+    registry = ClientRegistry(db=adapters.client_name_repository)
+    transport, protocol = await start_udp_data_receiver(
+        "127.0.0.1",
+        0,
+        registry,
+        _NullProcessor(),
+    )
+    stream_server = await start_backlog_stream_server("127.0.0.1", 0, protocol)
+    consumer = asyncio.create_task(protocol.process_queue())
+    ctx = multiprocessing.get_context("fork")
+    results = ctx.Queue()
+    node = ctx.Process(
+        target=_run_node,
+        args=(
+            mode,
+            transport.get_extra_info("sockname")[1],
+            stream_server.sockets[0].getsockname()[1],
+            results,
+        ),
+        daemon=True,
+    )
+    node.start()
+    try:
+        while True:
+            try:
+                return results.get_nowait()
+            except queue.Empty:
+                await asyncio.sleep(0.01)
+    finally:
+        node.join(timeout=5)
+        consumer.cancel()
+        await asyncio.gather(consumer, return_exceptions=True)
+        stream_server.close()
+        await stream_server.wait_closed()
+        transport.close()
+
+
+def _percentile(values: list[int], fraction: float) -> int:
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+
+@pytest.mark.benchmark(group="backlog-stream")
+def test_backlog_replay_throughput_and_live_latency(benchmark, tmp_path: Path) -> None:
+    def run() -> dict[str, tuple[float, list[int]]]:
+        return {
+            mode: asyncio.run(_serve_node(tmp_path, mode)) for mode in ("idle", "udp", "stream")
+        }
+
+    measured = benchmark.pedantic(run, rounds=1, iterations=1)
+
+    for mode, (replay_s, live_rtts) in measured.items():
+        info: dict[str, object] = {
+            "live_frames": len(live_rtts),
+            "live_rtt_p50_us": _percentile(live_rtts, 0.50),
+            "live_rtt_p95_us": _percentile(live_rtts, 0.95),
+        }
+        if mode != "idle":
+            info["replay_frames_per_s"] = round(_BACKLOG_FRAMES / replay_s)
+        benchmark.extra_info[mode] = info
+
+    udp_s, _ = measured["udp"]
+    stream_s, _ = measured["stream"]
+    assert stream_s < udp_s
@@ -0,0 +1,166 @@
+"""Sync-clock offset error: user-space ACK stamps vs. kernel stamps + min-RTT.
+
+Opt-in benchmark (``benchmark_*.py`` is not collected by default)::
+
+    pytest apps/server/tests/adapters/udp/benchmark_sync_clock_error.py \
+        --benchmark-only --benchmark-json=sync.json
+
+A POSIX node emulator runs in a child process (so it does not share the GIL
+with the server loop) and answers ``CMD_SYNC_CLOCK`` like the firmware does,
+on a device clock that is the host monotonic clock minus a known offset.  It
+stamps its own receive with the kernel timestamp, so the measured error is
+the server's.  Meanwhile the server event loop is kept busy with short
+blocking chunks, standing in for processing ticks, so ACKs wait in the socket
+before ``datagram_received`` runs.
+
+The baseline path stamps ACKs in user space and trusts the latest exchange;
+the current path reads the kernel receive stamp and filters by minimum
+round trip.  Absolute offset errors (µs) for both paths land in the
+benchmark's ``extra_info``.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import multiprocessing
+import random
+import socket
+import struct
+import time
+from pathlib import Path
+
+import pytest
+
+from vibesensor.adapters.persistence.history_db import create_history_persistence_adapters
+from vibesensor.adapters.udp.protocol import (
+    CMD_SYNC_CLOCK,
+    HelloMessage,
+    pack_ack_sync_clock,
+    parse_cmd,
+)
+from vibesensor.adapters.udp.udp_control_tx import UDPControlPlane
+from vibesensor.infra.runtime.registry import ClientRegistry
+
+_CLIENT_HEX = "aabbccddeeff"
+_TRUE_OFFSET_US = 1_234_567
+_ROUNDS = 200
+_ROUND_INTERVAL_S = 0.02
+_LOOP_STALL_MAX_S = 0.002
+_SO_TIMESTAMPNS = 35
+
+
+def _run_node(port_queue: multiprocessing.Queue, stop: multiprocessing.Event) -> None:
+    with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as sock:
+        sock.bind(("127.0.0.1", 0))
+        sock.setsockopt(socket.SOL_SOCKET, _SO_TIMESTAMPNS, 1)
+        sock.settimeout(0.1)
+        port_queue.put(sock.getsockname()[1])
+        while not stop.is_set():
+            try:
+                data, ancdata, _flags, addr = sock.recvmsg(256, 64)
+            except TimeoutError:
+                continue
+            receive_ns = time.monotonic_ns()
+            for level, kind, payload in ancdata:
+                if level == socket.SOL_SOCKET and kind == _SO_TIMESTAMPNS:
+                    sec, nsec = struct.unpack("@ll", payload[: struct.calcsize("@ll")])
+                    receive_ns = (sec * 1_000_000_000) + nsec - time.time_ns() + receive_ns
+            cmd = parse_cmd(data)
+            if cmd.cmd_id != CMD_SYNC_CLOCK:
+                continue
+            sock.sendto(
+                pack_ack_sync_clock(
+                    cmd.client_id,
+                    cmd.cmd_seq,
+                    device_receive_us=(receive_ns // 1_000) - _TRUE_OFFSET_US,
+                    device_send_us=(time.monotonic_ns() // 1_000) - _TRUE_OFFSET_US,
+                ),
+                addr,
+            )
+
+
+async def _stall_loop(stop: asyncio.Event) -> None:
+    rng = random.Random(0x5EED)
+    while not stop.is_set():
+        deadline = time.perf_counter() + rng.uniform(0.0, _LOOP_STALL_MAX_S)
+        while time.perf_counter() < deadline:
+            pass
+        await asyncio.sleep(0)
+
+
+async def _measure(tmp_path: Path, node_port: int, *, kernel_path: bool) -> list[int]:
+    adapters = create_history_persistence_adapters(tmp_path / f"history-{kernel_path}.db")
+    registry = ClientRegistry(
+        db=adapters.client_name_repository,
+        sync_filter_window=8 if kernel_path else 1,
+    )
+    plane = UDPControlPlane(
+        registry=registry,
+        bind_host="127.0.0.1",
+        bind_port=0,
+        kernel_rx_timestamps=kernel_path,
+    )
+    await plane.start()
+    registry.update_from_hello(
+        HelloMessage(
+            client_id=bytes.fromhex(_CLIENT_HEX),
+            control_port=node_port,
+            sample_rate_hz=800,
+            name="node",
+            firmware_version="fw",
+        ),
+        ("127.0.0.1", node_port),
+    )
+    stop = asyncio.Event()
+    staller = asyncio.create_task(_stall_loop(stop))
+    errors: list[int] = []
+    try:
+        for _ in range(_ROUNDS):
+            plane.broadcast_sync_clock()
+            await asyncio.sleep(_ROUND_INTERVAL_S)
+            record = registry.get(_CLIENT_HEX)
+            if record is not None and record.sync_offset_us is not None:
+                errors.append(abs(record.sync_offset_us - _TRUE_OFFSET_US))
+    finally:
+        stop.set()
+        await staller
+        plane.close()
+    return errors
+
+
+def _percentile(values: list[int], fraction: float) -> int:
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+
+@pytest.mark.benchmark(group="sync-clock-error")
+def test_sync_clock_error_kernel_stamps_vs_user_space(benchmark, tmp_path: Path) -> None:
+    ctx = multiprocessing.get_context("fork")
+    port_queue = ctx.Queue()
+    stop = ctx.Event()
+    node = ctx.Process(target=_run_node, args=(port_queue, stop), daemon=True)
+    node.start()
+    try:
+        node_port = port_queue.get(timeout=10)
+
+        def run() -> tuple[list[int], list[int]]:
+            baseline = asyncio.run(_measure(tmp_path, node_port, kernel_path=False))
+            current = asyncio.run(_measure(tmp_path, node_port, kernel_path=True))
+            return baseline, current
+
+        baseline, current = benchmark.pedantic(run, rounds=1, iterations=1)
+    finally:
+        stop.set()
+        node.join(timeout=5)
+
+    for label, errors in (("user_space_latest", baseline), ("kernel_min_rtt", current)):
+        benchmark.extra_info[label] = {
+            "samples": len(errors),
+            "p50_us": _percentile(errors, 0.50),
+            "p95_us": _percentile(errors, 0.95),
+            "max_us": max(errors),
+        }
+
+    assert len(baseline) >= _ROUNDS // 2
+    assert len(current) >= _ROUNDS // 2
+    assert _percentile(current, 0.95) <= _percentile(baseline, 0.95)
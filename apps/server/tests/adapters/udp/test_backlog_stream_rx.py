@@ -0,0 +1,145 @@
+"""TCP backlog stream: record framing, in-stream DATA_ACKs, and backfill dispatch."""
+
+from __future__ import annotations
+
+import asyncio
+from types import SimpleNamespace
+
+import numpy as np
+import pytest
+
+from vibesensor.adapters.udp.backlog_stream_rx import start_backlog_stream_server
+from vibesensor.adapters.udp.protocol import (
+    DATA_ACK_BYTES,
+    pack_data,
+    pack_stream_record,
+    parse_data_ack,
+)
+from vibesensor.adapters.udp.udp_data_rx import DataDatagramProtocol
+from vibesensor.infra.runtime.registry import DataUpdateResult
+
+_CLIENT_ID = bytes.fromhex("010203040506")
+
+
+class _ReplayRegistry:
+    def __init__(self) -> None:
+        self.replayed: list[tuple[int, bool]] = []
+        self.parse_errors: list[str | None] = []
+
+    def update_from_data(self, msg, addr, now_ts, *, replayed=False) -> DataUpdateResult:
+        self.replayed.append((msg.seq, replayed))
+        return DataUpdateResult()
+
+    def get(self, _client_id: str):
+        return SimpleNamespace(sample_rate_hz=800)
+
+    def note_parse_error(self, client_id: str | None) -> None:
+        self.parse_errors.append(client_id)
+
+
+class _Processor:
+    def __init__(self) -> None:
+        self.t0_us: list[int] = []
+
+    def ingest(self, client_id, samples, *, sample_rate_hz, t0_us) -> None:
+        self.t0_us.append(t0_us)
+
+
+def _packet(seq: int) -> bytes:
+    return pack_data(
+        _CLIENT_ID,
+        seq=seq,
+        t0_us=1_000 * seq,
+        samples=np.zeros((4, 3), dtype=np.int16),
+    )
+
+
+def test_pack_stream_record_prefixes_little_endian_length() -> None:
+    packet = _packet(7)
+
+    record = pack_stream_record(packet)
+
+    assert record[:2] == len(packet).to_bytes(2, "little")
+    assert record[2:] == packet
+    with pytest.raises(ValueError):
+        pack_stream_record(bytes(0x10000))
+
+
+@pytest.mark.asyncio
+async def test_stream_records_are_dispatched_as_replayed_and_acked_in_stream(
+    fake_transport,
+) -> None:
+    registry = _ReplayRegistry()
+    processor = _Processor()
+    proto = DataDatagramProtocol(registry=registry, processor=processor)
+    proto.connection_made(fake_transport)
+    server = await start_backlog_stream_server("127.0.0.1", 0, proto)
+    port = server.sockets[0].getsockname()[1]
+    try:
+        reader, writer = await asyncio.open_connection("127.0.0.1", port)
+        writer.write(b"".join(pack_stream_record(_packet(seq)) for seq in (3, 4, 5)))
+        await writer.drain()
+        acks = [
+            parse_data_ack(await asyncio.wait_for(reader.readexactly(DATA_ACK_BYTES), 2.0))
+            for _ in range(3)
+        ]
+        writer.close()
+        await writer.wait_closed()
+    finally:
+        server.close()
+        await server.wait_closed()
+
+    assert [ack.last_seq_received for ack in acks] == [3, 4, 5]
+    assert {ack.client_id for ack in acks} == {_CLIENT_ID}
+    assert registry.replayed == [(3, True), (4, True), (5, True)]
+    assert processor.t0_us == [3_000, 4_000, 5_000]
+    # The stream carries its own ACKs; nothing goes back over UDP.
+    assert fake_transport.sent == []
+
+
+@pytest.mark.asyncio
+async def test_stream_closes_on_unparsable_record(fake_transport) -> None:
+    registry = _ReplayRegistry()
+    proto = DataDatagramProtocol(registry=registry, processor=_Processor())
+    proto.connection_made(fake_transport)
+    server = await start_backlog_stream_server("127.0.0.1", 0, proto)
+    port = server.sockets[0].getsockname()[1]
+    try:
+        reader, writer = await asyncio.open_connection("127.0.0.1", port)
+        writer.write(pack_stream_record(b"\x00" * 8) + pack_stream_record(_packet(1)))
+        await writer.drain()
+        tail = await asyncio.wait_for(reader.read(), 2.0)
+        writer.close()
+        await writer.wait_closed()
+    finally:
+        server.close()
+        await server.wait_closed()
+
+    assert tail == b""
+    assert registry.replayed == []
+    assert len(registry.parse_errors) == 1
+
+
+@pytest.mark.asyncio
+async def test_stream_closes_when_the_node_goes_silent(fake_transport) -> None:
+    registry = _ReplayRegistry()
+    proto = DataDatagramProtocol(registry=registry, processor=_Processor())
+    proto.connection_made(fake_transport)
+    server = await start_backlog_stream_server("127.0.0.1", 0, proto, idle_timeout_s=0.05)
+    port = server.sockets[0].getsockname()[1]
+    try:
+        reader, writer = await asyncio.open_connection("127.0.0.1", port)
+        # One whole record, then half of the next prefix and nothing more.
+        writer.write(pack_stream_record(_packet(1)) + b"\x10")
+        await writer.drain()
+        ack = await asyncio.wait_for(reader.readexactly(DATA_ACK_BYTES), 2.0)
+        tail = await asyncio.wait_for(reader.read(), 2.0)
+        writer.close()
+        await writer.wait_closed()
+    finally:
+        server.close()
+        await server.wait_closed()
+
+    assert parse_data_ack(ack).last_seq_received == 1
+    assert tail == b""
+    assert registry.replayed == [(1, True)]
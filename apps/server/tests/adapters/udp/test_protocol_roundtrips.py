@@ -10,7 +10,15 @@ import pytest
 from vibesensor.adapters.udp.protocol import (
     CMD_IDENTIFY,
     CMD_SYNC_CLOCK,
+    DATA_HEADER_BYTES,
+    DATA_PULSE_CHANNEL_BYTES,
+    DATA_RANGE_TAG_CLIPPED,
+    DATA_RANGE_TAG_FULL_RES,
+    HELLO_ACK_BYTES,
+    HELLO_ACK_RECEIPTS_BYTES,
     HELLO_CAP_EXPLICIT_ACK,
+    HELLO_CAP_RANGE_TAG,
+    HELLO_CAP_RESUME_RECEIPTS,
     MSG_DATA,
     MSG_DATA_ACK,
     MSG_HELLO,
@@ -73,6 +81,76 @@ def test_data_roundtrip() -> None:
     np.testing.assert_array_equal(decoded.samples, samples)
 
 
+def test_untagged_data_has_no_range() -> None:
+    samples = np.zeros((2, 3), dtype=np.int16)
+    decoded = parse_data(pack_data(bytes(6), seq=1, t0_us=0, samples=samples))
+
+    assert decoded.range_g is None
+    assert decoded.clipped is False
+
+
+def test_full_res_range_tag_keeps_counts() -> None:
+    samples = np.array([[511, -512, 256], [4, 5, 6]], dtype=np.int16)
+    pkt = pack_data(
+        bytes(6),
+        seq=3,
+        t0_us=10,
+        samples=samples,
+        range_tag=DATA_RANGE_TAG_FULL_RES | DATA_RANGE_TAG_CLIPPED,
+    )
+
+    decoded = parse_data(pkt)
+
+    assert decoded.range_g == 2
+    assert decoded.clipped is True
+    np.testing.assert_array_equal(decoded.samples, samples)
+
+
+@pytest.mark.parametrize(("range_code", "range_g"), [(0, 2), (1, 4), (2, 8), (3, 16)])
+def test_fixed_res_range_tag_rescales_to_full_res_counts(range_code: int, range_g: int) -> None:
+    # +/-1 g in 10-bit fixed resolution is 512 / range_g counts.
+    one_g = 512 // range_g
+    samples = np.array([[one_g, -one_g, 0]], dtype=np.int16)
+    pkt = pack_data(bytes(6), seq=1, t0_us=0, samples=samples, range_tag=range_code)
+
+    decoded = parse_data(pkt)
+
+    assert decoded.range_g == range_g
+    assert decoded.clipped is False
+    np.testing.assert_array_equal(decoded.samples, [[256, -256, 0]])
+    assert decoded.samples.flags.writeable is False
+
+
+@pytest.mark.parametrize("last_edge_offset_us", [-48_000, 1_250, None])
+def test_pulse_channel_roundtrip(last_edge_offset_us: int | None) -> None:
+    samples = np.array([[1, 2, 3], [4, 5, 6]], dtype=np.int16)
+    pkt = pack_data(
+        bytes(6),
+        seq=9,
+        t0_us=5_000_000,
+        samples=samples,
+        range_tag=DATA_RANGE_TAG_FULL_RES | DATA_RANGE_TAG_CLIPPED,
+        pulse=(70_000, last_edge_offset_us),
+    )
+
+    decoded = parse_data(pkt)
+
+    assert len(pkt) == DATA_HEADER_BYTES + samples.nbytes + 1 + DATA_PULSE_CHANNEL_BYTES
+    assert decoded.range_g == 2
+    assert decoded.clipped is True
+    assert decoded.pulse_edge_count == 70_000 & 0xFFFF
+    assert decoded.pulse_last_edge_offset_us == last_edge_offset_us
+    np.testing.assert_array_equal(decoded.samples, samples)
+
+
+def test_data_without_pulse_channel_has_no_pulse_reading() -> None:
+    samples = np.zeros((2, 3), dtype=np.int16)
+    decoded = parse_data(pack_data(bytes(6), seq=1, t0_us=0, samples=samples, range_tag=0))
+
+    assert decoded.pulse_edge_count is None
+    assert decoded.pulse_last_edge_offset_us is None
+
+
 def test_parse_data_returns_read_only_view_over_datagram_payload() -> None:
     client_id = bytes.fromhex("010203040506")
     samples = np.array([[1, 2, 3], [4, 5, 6], [-2, -1, 0]], dtype=np.int16)
@@ -190,11 +268,48 @@ def test_sync_clock_ack_roundtrip() -> None:
 
 def test_hello_ack_roundtrip() -> None:
     client_id = bytes.fromhex("aabbccddeeff")
-    pkt = pack_hello_ack(client_id)
+    pkt = pack_hello_ack(client_id, HELLO_CAP_EXPLICIT_ACK | HELLO_CAP_RANGE_TAG)
 
     assert pkt[0] == MSG_HELLO_ACK
+    assert len(pkt) == HELLO_ACK_BYTES
+    decoded = parse_hello_ack(pkt)
+    assert decoded.client_id == client_id
+    assert decoded.capabilities == HELLO_CAP_EXPLICIT_ACK | HELLO_CAP_RANGE_TAG
+    assert decoded.contiguous_seq is None
+
+
+def test_hello_ack_with_receipts_roundtrip() -> None:
+    client_id = bytes.fromhex("aabbccddeeff")
+    pkt = pack_hello_ack(client_id, HELLO_CAP_EXPLICIT_ACK, (0xFFFFFFFE, 0b101))
+
+    assert len(pkt) == HELLO_ACK_RECEIPTS_BYTES
     decoded = parse_hello_ack(pkt)
     assert decoded.client_id == client_id
+    assert decoded.capabilities == HELLO_CAP_EXPLICIT_ACK | HELLO_CAP_RESUME_RECEIPTS
+    assert decoded.contiguous_seq == 0xFFFFFFFE
+    assert decoded.receipt_bitmap == 0b101
+    # Firmware without resume support only reads the leading HELLO_ACK fields.
+    assert pkt[:HELLO_ACK_BYTES] == pack_hello_ack(
+        client_id, HELLO_CAP_EXPLICIT_ACK | HELLO_CAP_RESUME_RECEIPTS
+    )
+
+
+def test_hello_with_oldest_pending_seq_roundtrip() -> None:
+    client_id = bytes.fromhex("aabbccddeeff")
+    pkt = pack_hello(
+        client_id=client_id,
+        control_port=9010,
+        sample_rate_hz=800,
+        name="node",
+        firmware_version="fw",
+        oldest_pending_seq=4242,
+        boot_id=0xB0075EED,
+    )
+
+    decoded = parse_hello(pkt)
+    assert decoded.capabilities & HELLO_CAP_RESUME_RECEIPTS
+    assert decoded.oldest_pending_seq == 4242
+    assert decoded.boot_id == 0xB0075EED
 
 
 def test_data_ack_roundtrip() -> None:
@@ -51,6 +51,20 @@ def test_parse_hello_rejects_missing_capabilities() -> None:
         parse_hello(legacy_packet)
 
 
+def test_parse_hello_rejects_resume_capability_without_oldest_pending_seq() -> None:
+    packet = pack_hello(
+        client_id=bytes.fromhex("a1b2c3d4e5f6"),
+        control_port=9123,
+        sample_rate_hz=800,
+        name="front-left",
+        firmware_version="fw-test",
+        oldest_pending_seq=12,
+    )[:-1]
+
+    with pytest.raises(ProtocolError, match="HELLO missing oldest_pending_seq"):
+        parse_hello(packet)
+
+
 @pytest.mark.parametrize(
     ("parse_fn", "short_data", "match"),
     [
@@ -95,7 +109,7 @@ def test_parse_too_short(parse_fn, short_data: bytes, match: str) -> None:
         ),
         (
             parse_hello_ack,
-            HELLO_ACK_STRUCT.pack(0xFF, 0x01, b"\x00" * 6),
+            HELLO_ACK_STRUCT.pack(0xFF, 0x01, b"\x00" * 6, 0),
             "Invalid HELLO_ACK header",
         ),
     ],
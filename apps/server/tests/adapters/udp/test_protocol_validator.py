@@ -112,6 +112,15 @@ class TestValidateDataFrame:
                 bytes_per_sample=6,
             )
 
+    def test_optional_trailer(self) -> None:
+        frame = {"sample_count": 10, "header_bytes": 20, "bytes_per_sample": 6}
+        assert validate_data_frame(data_length=80, trailer_bytes=1, **frame) is False
+        assert validate_data_frame(data_length=81, trailer_bytes=1, **frame) is True
+        with pytest.raises(ProtocolError, match="payload size mismatch"):
+            validate_data_frame(data_length=81, **frame)
+        with pytest.raises(ProtocolError, match="payload size mismatch"):
+            validate_data_frame(data_length=82, trailer_bytes=1, **frame)
+
 
 class TestValidateHelloSampleRate:
     def test_zero_rate(self) -> None:
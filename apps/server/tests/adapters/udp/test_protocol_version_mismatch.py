@@ -9,6 +9,7 @@ import numpy as np
 import pytest
 
 from vibesensor.adapters.udp.protocol import (
+    HELLO_CAP_EXPLICIT_ACK,
     pack_ack,
     pack_cmd_identify,
     pack_data,
@@ -61,7 +62,7 @@ from vibesensor.adapters.udp.udp_data_rx import DataDatagramProtocol
             "DATA_ACK version mismatch: expected 1, got 2",
         ),
         (
-            pack_hello_ack(bytes.fromhex("aabbccddeeff")),
+            pack_hello_ack(bytes.fromhex("aabbccddeeff"), HELLO_CAP_EXPLICIT_ACK),
             parse_hello_ack,
             "HELLO_ACK version mismatch: expected 1, got 2",
         ),
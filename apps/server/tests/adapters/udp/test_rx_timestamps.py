@@ -0,0 +1,90 @@
+"""Kernel receive stamps for control-plane datagrams on the monotonic clock."""
+
+from __future__ import annotations
+
+import asyncio
+import socket
+import sys
+import time
+
+import pytest
+
+from vibesensor.adapters.udp.rx_timestamps import KernelRxTimestamps
+
+
+def test_rx_timestamps_without_a_socket_fall_back_to_user_space() -> None:
+    stamps = KernelRxTimestamps(None)
+
+    assert stamps.enabled is False
+    assert stamps.last_rx_monotonic_us() is None
+
+
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="SIOCGSTAMPNS is Linux-only")
+def test_rx_timestamp_brackets_the_datagram_on_the_monotonic_clock() -> None:
+    with (
+        socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as rx,
+        socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as tx,
+    ):
+        rx.bind(("127.0.0.1", 0))
+        stamps = KernelRxTimestamps(rx)
+        assert stamps.enabled is True
+
+        before_us = time.monotonic_ns() // 1_000
+        tx.sendto(b"ack", rx.getsockname())
+        time.sleep(0.02)
+        rx.recvfrom(16)
+        after_us = time.monotonic_ns() // 1_000
+        stamp_us = stamps.last_rx_monotonic_us()
+
+    assert stamp_us is not None
+    # The kernel stamp predates the 20 ms the datagram sat in the socket.
+    assert before_us - 1_000 <= stamp_us <= after_us - 15_000
+
+
+class _StampingProtocol(asyncio.DatagramProtocol):
+    def __init__(self, received: asyncio.Future[tuple[int | None, int]]) -> None:
+        self.received = received
+        self.stamps = KernelRxTimestamps(None)
+
+    def connection_made(self, transport: asyncio.BaseTransport) -> None:
+        self.stamps = KernelRxTimestamps(transport.get_extra_info("socket"))
+
+    def datagram_received(self, data: bytes, addr: tuple[str, int]) -> None:
+        if not self.received.done():
+            callback_us = time.monotonic_ns() // 1_000
+            self.received.set_result((self.stamps.last_rx_monotonic_us(), callback_us))
+
+
+async def _stamp_one_datagram() -> tuple[int, int | None, int]:
+    loop = asyncio.get_running_loop()
+    received: asyncio.Future[tuple[int | None, int]] = loop.create_future()
+    transport, _protocol = await loop.create_datagram_endpoint(
+        lambda: _StampingProtocol(received), local_addr=("127.0.0.1", 0)
+    )
+    try:
+        with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as tx:
+            before_us = time.monotonic_ns() // 1_000
+            tx.sendto(b"ack", transport.get_extra_info("sockname"))
+            # Hold the loop so the datagram waits in the socket before it is read.
+            time.sleep(0.02)
+            stamp_us, callback_us = await asyncio.wait_for(received, timeout=2.0)
+    finally:
+        transport.close()
+    return before_us, stamp_us, callback_us
+
+
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="SIOCGSTAMPNS is Linux-only")
+@pytest.mark.parametrize("loop_name", ["asyncio", "uvloop"])
+def test_rx_timestamp_holds_under_the_event_loop_reading_the_socket(loop_name: str) -> None:
+    if loop_name == "uvloop":
+        uvloop = pytest.importorskip("uvloop")
+        runner = asyncio.Runner(loop_factory=uvloop.new_event_loop)
+    else:
+        runner = asyncio.Runner()
+    with runner:
+        before_us, stamp_us, callback_us = runner.run(_stamp_one_datagram())
+
+    assert stamp_us is not None
+    # The loop reads the socket itself; the stamp still predates the 20 ms the
+    # datagram waited before the callback ran.
+    assert before_us - 1_000 <= stamp_us <= callback_us - 15_000
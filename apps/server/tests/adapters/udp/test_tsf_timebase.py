@@ -0,0 +1,153 @@
+"""TSF timebase calibration and DATA t0 remapping for TSF-stamped sensors."""
+
+from __future__ import annotations
+
+from types import SimpleNamespace
+
+import numpy as np
+
+from vibesensor.adapters.udp.protocol import HELLO_CAP_EXPLICIT_ACK, HELLO_CAP_TSF_TIMEBASE
+from vibesensor.adapters.udp.protocol_messages import DataMessage
+from vibesensor.adapters.udp.tsf_timebase import TsfTimebase
+from vibesensor.adapters.udp.udp_data_rx import DataDatagramProtocol
+from vibesensor.infra.runtime.registry import DataUpdateResult
+
+_CLIENT_ID = bytes.fromhex("aabbccddeeff")
+
+
+class _Registry:
+    def __init__(self, capabilities: int) -> None:
+        self._capabilities = capabilities
+
+    def update_from_data(self, msg, addr, now_ts, *, replayed=False) -> DataUpdateResult:
+        return DataUpdateResult()
+
+    def get(self, _client_id: str):
+        return SimpleNamespace(sample_rate_hz=800, hello_capabilities=self._capabilities)
+
+
+class _Processor:
+    def __init__(self) -> None:
+        self.t0_values: list[int | None] = []
+
+    def ingest(self, client_id, samples, *, sample_rate_hz, t0_us) -> None:
+        self.t0_values.append(t0_us)
+
+    def flush_client_buffer(self, client_id: str) -> None:
+        pass
+
+
+def _data_message(t0_us: int) -> DataMessage:
+    return DataMessage(
+        client_id=_CLIENT_ID,
+        seq=1,
+        t0_us=t0_us,
+        sample_count=1,
+        samples=np.zeros((1, 3), dtype=np.int16),
+    )
+
+
+def test_calibrate_uses_tightest_bracketed_read() -> None:
+    # Five (before, after) brackets with spans 900, 40, 300, 500, 100 µs.
+    brackets = [
+        (1_000_000, 1_000_900),
+        (1_001_000, 1_001_040),
+        (1_002_000, 1_002_300),
+        (1_003_000, 1_003_500),
+        (1_004_000, 1_004_100),
+    ]
+    clock = iter([stamp for bracket in brackets for stamp in bracket])
+    tsf_reads = iter([5_000_000, 5_000_400, 5_001_000, 5_002_000, 5_003_000])
+    timebase = TsfTimebase(read_tsf_us=lambda: next(tsf_reads), monotonic_us=lambda: next(clock))
+
+    assert timebase.calibrate()
+    assert timebase.offset_us == 1_001_020 - 5_000_400
+
+
+def test_unavailable_tsf_leaves_timebase_unmapped() -> None:
+    timebase = TsfTimebase(read_tsf_us=lambda: None, monotonic_us=lambda: 10)
+
+    assert not timebase.calibrate()
+    assert timebase.to_monotonic_us(123) is None
+
+
+def test_recalibration_is_paced_by_the_injected_clock() -> None:
+    now_us = [100_000_000]
+    tsf_reads: list[int | None] = [None]
+    timebase = TsfTimebase(read_tsf_us=lambda: tsf_reads[-1], monotonic_us=lambda: now_us[0])
+
+    assert timebase.to_monotonic_us(123) is None
+    tsf_reads.append(40_000_000)
+    now_us[0] += 29_000_000
+    assert timebase.to_monotonic_us(123) is None
+
+    now_us[0] += 1_000_000
+    assert timebase.to_monotonic_us(123) == 123 + now_us[0] - 40_000_000
+
+    # Once calibrated, the offset is only re-taken every 60 s.
+    calibrated_at_us = now_us[0]
+    tsf_reads.append(50_000_000)
+    now_us[0] += 59_000_000
+    assert timebase.to_monotonic_us(123) == 123 + calibrated_at_us - 40_000_000
+    now_us[0] += 1_000_000
+    assert timebase.to_monotonic_us(123) == 123 + now_us[0] - 50_000_000
+
+
+def test_data_rx_remaps_t0_only_for_tsf_clients() -> None:
+    timebase = TsfTimebase(read_tsf_us=lambda: 2_000_000, monotonic_us=lambda: 9_000_000)
+
+    tsf_processor = _Processor()
+    DataDatagramProtocol(
+        registry=_Registry(HELLO_CAP_EXPLICIT_ACK | HELLO_CAP_TSF_TIMEBASE),
+        processor=tsf_processor,
+        tsf_timebase=timebase,
+    )._dispatch_data_message(_data_message(2_500_000), ("10.4.0.2", 9000))
+
+    legacy_processor = _Processor()
+    DataDatagramProtocol(
+        registry=_Registry(HELLO_CAP_EXPLICIT_ACK),
+        processor=legacy_processor,
+        tsf_timebase=timebase,
+    )._dispatch_data_message(_data_message(2_500_000), ("10.4.0.2", 9000))
+
+    assert tsf_processor.t0_values == [9_500_000]
+    assert legacy_processor.t0_values == [2_500_000]
+
+
+class _RawCapture:
+    def __init__(self) -> None:
+        self.t0_values: list[int] = []
+
+    def capture_raw_samples(self, *, client_id, sample_rate_hz, t0_us, samples) -> None:
+        self.t0_values.append(t0_us)
+
+    def note_late_packet_loss(self, *, client_id: str) -> None:
+        pass
+
+
+def test_data_rx_times_tsf_frames_by_arrival_when_timebase_unavailable() -> None:
+    processor = _Processor()
+    raw_capture = _RawCapture()
+    DataDatagramProtocol(
+        registry=_Registry(HELLO_CAP_TSF_TIMEBASE),
+        processor=processor,
+        raw_capture_sink=raw_capture,
+        tsf_timebase=TsfTimebase(read_tsf_us=lambda: None),
+    )._dispatch_data_message(_data_message(2_500_000), ("10.4.0.2", 9000), received_mono_s=5.0)
+
+    # One sample at 800 Hz arrived at 5 s on the server clock; raw capture
+    # must use the same fallback as ingest, not the unmapped TSF value.
+    assert processor.t0_values == [5_000_000 - 1_250]
+    assert raw_capture.t0_values == processor.t0_values
+
+
+def test_data_rx_raw_capture_uses_mapped_tsf_t0() -> None:
+    raw_capture = _RawCapture()
+    DataDatagramProtocol(
+        registry=_Registry(HELLO_CAP_TSF_TIMEBASE),
+        processor=_Processor(),
+        raw_capture_sink=raw_capture,
+        tsf_timebase=TsfTimebase(read_tsf_us=lambda: 2_000_000, monotonic_us=lambda: 9_000_000),
+    )._dispatch_data_message(_data_message(2_500_000), ("10.4.0.2", 9000))
+
+    assert raw_capture.t0_values == [9_500_000]
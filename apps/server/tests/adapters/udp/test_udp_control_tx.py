@@ -6,19 +6,29 @@ import logging
 import struct
 from pathlib import Path
 
+import numpy as np
 import pytest
 
 from vibesensor.adapters.persistence.history_db import create_history_persistence_adapters
 from vibesensor.adapters.udp.protocol import (
+    CMD_TX_SLOT,
     HELLO_CAP_EXPLICIT_ACK,
+    HELLO_CAP_RANGE_TAG,
+    HELLO_CAP_TX_SLOTS,
     MSG_HELLO_ACK,
+    DataMessage,
     HelloMessage,
     pack_ack,
     pack_ack_sync_clock,
     pack_hello,
     parse_cmd,
+    parse_hello_ack,
+)
+from vibesensor.adapters.udp.udp_control_tx import (
+    TX_SLOT_MIN_WIDTH_US,
+    ControlDatagramProtocol,
+    UDPControlPlane,
 )
-from vibesensor.adapters.udp.udp_control_tx import ControlDatagramProtocol, UDPControlPlane
 from vibesensor.infra.runtime.registry import ClientRegistry
 
 
@@ -146,6 +156,114 @@ def test_control_datagram_sends_hello_ack_for_capable_firmware(
     payload, addr = fake_transport.sent[0]
     assert payload[0] == MSG_HELLO_ACK
     assert addr == ("127.0.0.1", 9010)
+    assert parse_hello_ack(payload).capabilities == HELLO_CAP_EXPLICIT_ACK
+
+
+def test_control_datagram_hello_ack_echoes_only_capabilities_the_server_has(
+    tmp_path: Path,
+    fake_transport,
+) -> None:
+    registry = _make_registry(tmp_path)
+    protocol = ControlDatagramProtocol(registry)
+    protocol.transport = fake_transport
+    unknown_capability = 1 << 7
+    packet = pack_hello(
+        client_id=bytes.fromhex("aabbccddeeff"),
+        control_port=9010,
+        sample_rate_hz=800,
+        name="node",
+        frame_samples=200,
+        firmware_version="fw",
+        capabilities=HELLO_CAP_EXPLICIT_ACK | HELLO_CAP_RANGE_TAG | unknown_capability,
+    )
+
+    protocol.datagram_received(packet, ("127.0.0.1", 54000))
+
+    payload, _addr = fake_transport.sent[0]
+    assert parse_hello_ack(payload).capabilities == HELLO_CAP_EXPLICIT_ACK | HELLO_CAP_RANGE_TAG
+
+
+def test_control_datagram_reports_data_receipts_to_resume_capable_firmware(
+    tmp_path: Path,
+    fake_transport,
+) -> None:
+    registry = _make_registry(tmp_path)
+    protocol = ControlDatagramProtocol(registry)
+    protocol.transport = fake_transport
+    client_id = bytes.fromhex("aabbccddeeff")
+    for seq in (10, 11, 13):
+        registry.update_from_data(
+            DataMessage(
+                client_id=client_id,
+                seq=seq,
+                t0_us=seq * 250_000,
+                sample_count=200,
+                samples=np.zeros((200, 3), dtype=np.int16),
+            ),
+            ("127.0.0.1", 54001),
+        )
+    packet = pack_hello(
+        client_id=client_id,
+        control_port=9010,
+        sample_rate_hz=800,
+        name="node",
+        frame_samples=200,
+        firmware_version="fw",
+        oldest_pending_seq=10,
+    )
+
+    protocol.datagram_received(packet, ("127.0.0.1", 54000))
+
+    payload, _addr = fake_transport.sent[0]
+    ack = parse_hello_ack(payload)
+    assert ack.contiguous_seq == 11
+    assert ack.receipt_bitmap == 0b1
+
+
+def test_control_datagram_drops_receipts_from_before_a_sensor_reboot(
+    tmp_path: Path,
+    fake_transport,
+) -> None:
+    registry = _make_registry(tmp_path)
+    protocol = ControlDatagramProtocol(registry)
+    protocol.transport = fake_transport
+    client_id = bytes.fromhex("aabbccddeeff")
+
+    def hello(oldest_pending_seq: int, boot_id: int) -> bytes:
+        return pack_hello(
+            client_id=client_id,
+            control_port=9010,
+            sample_rate_hz=800,
+            name="node",
+            frame_samples=200,
+            firmware_version="fw",
+            oldest_pending_seq=oldest_pending_seq,
+            boot_id=boot_id,
+        )
+
+    protocol.datagram_received(hello(10, 0x1111), ("127.0.0.1", 54000))
+    for seq in (10, 11, 13):
+        registry.update_from_data(
+            DataMessage(
+                client_id=client_id,
+                seq=seq,
+                t0_us=seq * 250_000,
+                sample_count=200,
+                samples=np.zeros((200, 3), dtype=np.int16),
+            ),
+            ("127.0.0.1", 54001),
+        )
+
+    # After a reboot seqs restart at 0, so 10, 11 and 13 of the new boot have
+    # not been sent yet even though the window still holds the old ones.
+    protocol.datagram_received(hello(0, 0x2222), ("127.0.0.1", 54000))
+    ack = parse_hello_ack(fake_transport.sent[-1][0])
+    assert ack.contiguous_seq is None
+
+    protocol.datagram_received(hello(0, 0x2222), ("127.0.0.1", 54000))
+    ack = parse_hello_ack(fake_transport.sent[-1][0])
+    assert ack.contiguous_seq == 0xFFFFFFFF
+    assert ack.receipt_bitmap == 0
 
 
 def test_close_closes_transport_once_and_clears_reference(tmp_path: Path, fake_transport) -> None:
@@ -227,3 +345,173 @@ def test_broadcast_sync_clock_rolls_ack_timestamps_into_next_sync_payload(
 
     assert fake_transport.closed is True
     assert plane.transport is None
+
+
+def test_broadcast_sync_clock_assigns_tx_slots_to_capable_sensors(
+    tmp_path: Path,
+    fake_transport,
+) -> None:
+    registry = _make_registry(tmp_path)
+    sensors = (
+        ("aabbccddee02", 9012, HELLO_CAP_EXPLICIT_ACK | HELLO_CAP_TX_SLOTS),
+        ("aabbccddee01", 9011, HELLO_CAP_EXPLICIT_ACK | HELLO_CAP_TX_SLOTS),
+        ("aabbccddee03", 9013, HELLO_CAP_EXPLICIT_ACK),
+    )
+    for client_hex, control_port, capabilities in sensors:
+        registry.update_from_hello(
+            HelloMessage(
+                client_id=bytes.fromhex(client_hex),
+                control_port=control_port,
+                sample_rate_hz=800,
+                name="node",
+                firmware_version="fw",
+                capabilities=capabilities,
+            ),
+            ("127.0.0.1", 54000),
+        )
+    plane = UDPControlPlane(
+        registry=registry,
+        bind_host="127.0.0.1",
+        bind_port=9001,
+        tx_slot_period_us=20_000,
+    )
+    plane.transport = fake_transport
+
+    assert plane.broadcast_sync_clock() == 3
+
+    slots = {}
+    for payload, addr in fake_transport.sent:
+        cmd = parse_cmd(payload)
+        if cmd.cmd_id == CMD_TX_SLOT:
+            slots[cmd.client_id.hex()] = (addr, struct.unpack("<III", cmd.params))
+    assert slots == {
+        "aabbccddee01": (("127.0.0.1", 9011), (0, 20_000, 10_000)),
+        "aabbccddee02": (("127.0.0.1", 9012), (10_000, 20_000, 10_000)),
+    }
+
+
+def _tx_slot_commands(fake_transport) -> dict[str, tuple[int, int, int]]:
+    slots = {}
+    for payload, _ in fake_transport.sent:
+        cmd = parse_cmd(payload)
+        if cmd.cmd_id == CMD_TX_SLOT:
+            slots[cmd.client_id.hex()] = struct.unpack("<III", cmd.params)
+    return slots
+
+
+def test_assign_tx_slots_withdraws_slots_without_a_period(tmp_path: Path, fake_transport) -> None:
+    registry = _make_registry(tmp_path)
+    registry.update_from_hello(
+        HelloMessage(
+            client_id=bytes.fromhex("aabbccddeeff"),
+            control_port=9010,
+            sample_rate_hz=800,
+            name="node",
+            firmware_version="fw",
+            capabilities=HELLO_CAP_TX_SLOTS,
+        ),
+        ("127.0.0.1", 54000),
+    )
+    plane = UDPControlPlane(registry=registry, bind_host="127.0.0.1", bind_port=9001)
+    plane.transport = fake_transport
+
+    assert plane.broadcast_sync_clock() == 1
+    assert _tx_slot_commands(fake_transport) == {"aabbccddeeff": (0, 0, 0)}
+
+
+def test_assign_tx_slots_falls_back_to_contention_when_slots_are_too_narrow(
+    tmp_path: Path,
+    fake_transport,
+    caplog: pytest.LogCaptureFixture,
+) -> None:
+    registry = _make_registry(tmp_path)
+    for client_hex in ("aabbccddee01", "aabbccddee02"):
+        registry.update_from_hello(
+            HelloMessage(
+                client_id=bytes.fromhex(client_hex),
+                control_port=9010,
+                sample_rate_hz=800,
+                name="node",
+                firmware_version="fw",
+                capabilities=HELLO_CAP_TX_SLOTS,
+            ),
+            ("127.0.0.1", 54000),
+        )
+    plane = UDPControlPlane(
+        registry=registry,
+        bind_host="127.0.0.1",
+        bind_port=9001,
+        tx_slot_period_us=TX_SLOT_MIN_WIDTH_US * 2 - 2,
+    )
+    plane.transport = fake_transport
+
+    with caplog.at_level(logging.WARNING, logger="vibesensor.adapters.udp.udp_control_tx"):
+        assert plane.assign_tx_slots() == 2
+        assert plane.assign_tx_slots() == 2
+
+    assert _tx_slot_commands(fake_transport) == {
+        "aabbccddee01": (0, 0, 0),
+        "aabbccddee02": (0, 0, 0),
+    }
+    assert sum("falling back to contention" in r.message for r in caplog.records) == 1
+
+    fake_transport.sent.clear()
+    plane.tx_slot_period_us = TX_SLOT_MIN_WIDTH_US * 2
+    assert plane.assign_tx_slots() == 2
+    assert _tx_slot_commands(fake_transport) == {
+        "aabbccddee01": (0, TX_SLOT_MIN_WIDTH_US * 2, TX_SLOT_MIN_WIDTH_US),
+        "aabbccddee02": (TX_SLOT_MIN_WIDTH_US, TX_SLOT_MIN_WIDTH_US * 2, TX_SLOT_MIN_WIDTH_US),
+    }
+
+
+def test_sync_clock_keeps_the_minimum_round_trip_offset(
+    tmp_path: Path,
+    fake_transport,
+    monkeypatch: pytest.MonkeyPatch,
+) -> None:
+    client_hex = "aabbccddeeff"
+    registry = _make_registry(tmp_path)
+    registry.update_from_hello(
+        HelloMessage(
+            client_id=bytes.fromhex(client_hex),
+            control_port=9010,
+            sample_rate_hz=800,
+            name="node",
+            firmware_version="fw",
+        ),
+        ("127.0.0.1", 54000),
+        now=1.0,
+    )
+    plane = UDPControlPlane(registry=registry, bind_host="127.0.0.1", bind_port=9001)
+    plane.transport = fake_transport
+    current_mono = [1.0]
+    monkeypatch.setattr(
+        "vibesensor.adapters.udp.udp_control_tx.time.monotonic",
+        lambda: current_mono[0],
+    )
+
+    def exchange(send_s: float, receive_s: float, device_receive_us: int) -> None:
+        current_mono[0] = send_s
+        plane.broadcast_sync_clock()
+        cmd = parse_cmd(fake_transport.sent[-1][0])
+        current_mono[0] = receive_s
+        plane.protocol.datagram_received(
+            pack_ack_sync_clock(
+                bytes.fromhex(client_hex),
+                cmd_seq=cmd.cmd_seq,
+                device_receive_us=device_receive_us,
+                device_send_us=device_receive_us + 100,
+            ),
+            ("127.0.0.1", 9010),
+        )
+
+    # Clean exchange: 1 ms round trip, offset 5 ms.
+    exchange(1.0, 1.0011, 995_500)
+    # Event-loop stall delays the ACK by 6 ms; the raw estimate would be 8 ms.
+    exchange(6.0, 6.0071, 5_995_500)
+
+    record = registry.get(client_hex)
+    assert record is not None
+    assert record.sync_offset_us == 5_000
+    assert record.sync_rtt_us == 1_000
+    assert record.last_sync_monotonic_us == 6_007_100
@@ -30,11 +30,20 @@ class RecordingRegistry:
         self._sample_rate_hz = sample_rate_hz
         self._update_error = update_error
         self.update_calls: list[tuple[object, tuple[str, int], float]] = []
+        self.replayed_flags: list[bool] = []
         self.queue_drops: list[str | None] = []
         self.parse_errors: list[str | None] = []
 
-    def update_from_data(self, msg, addr: tuple[str, int], now_ts: float) -> DataUpdateResult:
+    def update_from_data(
+        self,
+        msg,
+        addr: tuple[str, int],
+        now_ts: float,
+        *,
+        replayed: bool = False,
+    ) -> DataUpdateResult:
         self.update_calls.append((msg, addr, now_ts))
+        self.replayed_flags.append(replayed)
         if self._update_error is not None:
             raise self._update_error
         if self._results:
@@ -403,6 +412,33 @@ async def test_reset_detected_flushes_buffer_before_ingest(
     assert len(fake_transport.sent) == 1
 
 
+def test_replayed_backfill_is_captured_without_late_loss_or_udp_ack(fake_transport) -> None:
+    registry = RecordingRegistry(results=[DataUpdateResult(is_late=True, is_backfill=True)])
+    processor = RecordingProcessor()
+    raw_capture_sink = RecordingRawCaptureSink()
+    proto = DataDatagramProtocol(
+        registry=registry,
+        processor=processor,
+        raw_capture_sink=raw_capture_sink,
+    )
+    proto.connection_made(fake_transport)
+    pkt = pack_data(
+        bytes.fromhex("010203040506"),
+        seq=4,
+        t0_us=500,
+        samples=np.zeros((2, 3), dtype=np.int16),
+    )
+
+    msg = proto.process_replayed_packet(pkt, ("127.0.0.1", 40000))
+
+    assert msg is not None and msg.seq == 4
+    assert registry.replayed_flags == [True]
+    assert processor.ingested == []
+    assert [entry[2] for entry in raw_capture_sink.captured] == [500]
+    assert raw_capture_sink.late_losses == []
+    assert fake_transport.sent == []
+
+
 @pytest.mark.asyncio
 async def test_process_queue_exports_trace_span(
     fake_transport,
@@ -174,6 +174,26 @@ class TestUDPConfigValidation:
                 data_queue_maxsize=bad_value,
             )
 
+    def test_backlog_stream_port_allows_zero_to_disable(self) -> None:
+        cfg = UDPConfig(
+            data_host="0.0.0.0",
+            data_port=9000,
+            control_host="0.0.0.0",
+            control_port=9001,
+            data_queue_maxsize=1024,
+            backlog_stream_port=0,
+        )
+        assert cfg.backlog_stream_port == 0
+        with pytest.raises(ValueError, match="backlog_stream_port"):
+            UDPConfig(
+                data_host="0.0.0.0",
+                data_port=9000,
+                control_host="0.0.0.0",
+                control_port=9001,
+                data_queue_maxsize=1024,
+                backlog_stream_port=65536,
+            )
+
 
 # ---------------------------------------------------------------------------
 # LoggingConfig.__post_init__ validation
@@ -18,7 +18,9 @@ def _config() -> SimpleNamespace:
             data_host="0.0.0.0",
             data_port=9000,
             data_queue_maxsize=321,
+            backlog_stream_port=9002,
         ),
+        ap=SimpleNamespace(ifname="wlan1"),
         gps=SimpleNamespace(
             gpsd_host="gpsd.local",
             gpsd_port=2947,
@@ -72,6 +74,8 @@ def test_runtime_state_projects_lifecycle_runtime() -> None:
     assert lifecycle_runtime.udp_data_host == "0.0.0.0"
     assert lifecycle_runtime.udp_data_port == 9000
     assert lifecycle_runtime.udp_data_queue_maxsize == 321
+    assert lifecycle_runtime.udp_backlog_stream_port == 9002
+    assert lifecycle_runtime.ap_ifname == "wlan1"
     assert lifecycle_runtime.gpsd_host == "gpsd.local"
     assert lifecycle_runtime.gpsd_port == 2947
     assert lifecycle_runtime.shutdown_analysis_timeout_s == 12.5
@@ -57,3 +57,24 @@ def test_dedup_window_clear_resets_running_max_state() -> None:
 
     assert window.contains(100) is False
     assert window.contains(1) is True
+
+
+def test_dedup_window_receipts_report_contiguous_run_and_later_arrivals() -> None:
+    window = DedupWindow()
+    for seq in (40, 41, 42, 44, 46):
+        window.record(seq)
+
+    assert window.receipts_from(40) == (42, 0b101)
+    # A gap at the oldest pending seq leaves the run empty; later arrivals
+    # still show up in the bitmap: seqs 40-42, 44 and 46 are bits 4-6, 8, 10.
+    assert window.receipts_from(35) == (34, 0b101_0111_0000)
+    assert window.receipts_from(44) == (44, 0b1)
+
+
+def test_dedup_window_receipts_wrap_with_the_wire_sequence() -> None:
+    window = DedupWindow()
+    for seq in (0xFFFFFFFF, 0, 2):
+        window.record(seq)
+
+    assert window.receipts_from(0xFFFFFFFF) == (0, 0b1)
+    assert DedupWindow().receipts_from(0) == (0xFFFFFFFF, 0)
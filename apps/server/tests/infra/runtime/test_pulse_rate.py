@@ -0,0 +1,124 @@
+"""Guard edge-interval rate, slow-wheel spans, stall decay, and reset in the pulse tracker."""
+
+from __future__ import annotations
+
+from pathlib import Path
+
+import pytest
+from test_support.runtime_lifecycle import FakeDataMessage, build_registry_with_hello
+
+from vibesensor.infra.runtime.pulse_rate import PULSE_STALL_US, PulseRateTracker
+from vibesensor.infra.runtime.registry import ClientRegistry
+
+# 200-sample frames at 800 Hz.
+_FRAME_US = 250_000
+
+
+def _update(
+    tracker: PulseRateTracker,
+    *,
+    frame: int,
+    edge_count: int,
+    last_edge_offset_us: int | None,
+) -> None:
+    t0_us = frame * _FRAME_US
+    tracker.update(
+        edge_count=edge_count,
+        last_edge_offset_us=last_edge_offset_us,
+        t0_us=t0_us,
+        frame_end_us=t0_us + _FRAME_US,
+    )
+
+
+def test_pulse_rate_uses_time_between_last_edges() -> None:
+    tracker = PulseRateTracker()
+    _update(tracker, frame=0, edge_count=10, last_edge_offset_us=240_000)
+    assert tracker.rate_hz is None
+
+    # 12 more edges, the last one 300 ms after the previous frame's.
+    _update(tracker, frame=1, edge_count=22, last_edge_offset_us=290_000)
+
+    assert tracker.rate_hz == pytest.approx(40.0)
+    assert tracker.last_edge_us == 540_000
+
+
+def test_pulse_rate_spans_frames_without_edges() -> None:
+    tracker = PulseRateTracker()
+    _update(tracker, frame=0, edge_count=1, last_edge_offset_us=100_000)
+    _update(tracker, frame=1, edge_count=2, last_edge_offset_us=-50_000)
+    _update(tracker, frame=2, edge_count=2, last_edge_offset_us=-300_000)
+    _update(tracker, frame=3, edge_count=3, last_edge_offset_us=0)
+
+    # One edge per 550 ms, measured across the edgeless frame.
+    assert tracker.rate_hz == pytest.approx(1_000_000 / 550_000)
+
+
+def test_pulse_rate_decays_to_zero_once_the_wheel_stops() -> None:
+    tracker = PulseRateTracker()
+    _update(tracker, frame=0, edge_count=0, last_edge_offset_us=200_000)
+    _update(tracker, frame=1, edge_count=20, last_edge_offset_us=200_000)
+    assert tracker.rate_hz == pytest.approx(80.0)
+
+    _update(tracker, frame=2, edge_count=20, last_edge_offset_us=-50_000)
+    # 550 ms without an edge caps the rate below one edge per 550 ms.
+    _update(tracker, frame=3, edge_count=20, last_edge_offset_us=-300_000)
+    assert tracker.rate_hz == pytest.approx(1_000_000 / 550_000)
+
+    frames_to_stall = PULSE_STALL_US // _FRAME_US
+    for frame in range(4, 4 + frames_to_stall):
+        _update(tracker, frame=frame, edge_count=20, last_edge_offset_us=None)
+    assert tracker.rate_hz == 0.0
+
+
+def test_pulse_rate_handles_edge_count_wrap() -> None:
+    tracker = PulseRateTracker()
+    _update(tracker, frame=0, edge_count=0xFFFE, last_edge_offset_us=0)
+    _update(tracker, frame=1, edge_count=3, last_edge_offset_us=0)
+
+    assert tracker.rate_hz == pytest.approx(5 * 1_000_000 / _FRAME_US)
+
+
+def test_registry_tracks_pulse_rate_and_clears_it_on_reset(tmp_path: Path) -> None:
+    registry, client_id = build_registry_with_hello(tmp_path)
+    addr = ("10.4.0.2", 50000)
+
+    def data(seq: int, t0_us: int, edge_count: int, offset_us: int) -> FakeDataMessage:
+        return FakeDataMessage(
+            client_id=client_id,
+            seq=seq,
+            t0_us=t0_us,
+            sample_count=200,
+            pulse_edge_count=edge_count,
+            pulse_last_edge_offset_us=offset_us,
+        )
+
+    registry.update_from_data(data(5000, 10_000_000, 100, 200_000), addr, now=2.0)
+    registry.update_from_data(data(5001, 10_250_000, 125, 200_000), addr, now=2.25)
+    registry.update_from_data(data(5001, 10_250_000, 125, 200_000), addr, now=2.3)
+
+    record = registry.get(client_id.hex())
+    assert record is not None
+    assert record.pulse_rate_hz == pytest.approx(100.0)
+    assert record.pulse_last_edge_us == 10_450_000
+
+    result = registry.update_from_data(data(3, 1_000, 4, 500), addr, now=3.0)
+    assert result.reset_detected is True
+
+    record = registry.get(client_id.hex())
+    assert record is not None
+    assert record.pulse_rate_hz is None
+
+
+def test_registry_ignores_frames_without_a_pulse_channel() -> None:
+    registry = ClientRegistry()
+    client_id = bytes.fromhex("aabbccddeeff")
+    registry.update_from_data(
+        FakeDataMessage(client_id=client_id, seq=0, t0_us=0, sample_count=200),
+        ("10.4.0.2", 50000),
+        now=2.0,
+    )
+
+    record = registry.get(client_id.hex())
+    assert record is not None
+    assert record.pulse_rate_hz is None
+    assert record.pulse_last_edge_us is None
@@ -29,6 +29,7 @@ from test_support.runtime_lifecycle import (
 from vibesensor.adapters.persistence.history_db import create_history_persistence_adapters
 from vibesensor.adapters.udp.protocol import HelloMessage
 from vibesensor.infra.runtime.registry import ClientRegistry
+from vibesensor.infra.runtime.sync_filter import SyncSample
 from vibesensor.shared.boundaries.clients import snapshot_for_api
 
 
@@ -99,6 +100,39 @@ def test_registry_rename_normalizes_client_id(tmp_path: Path) -> None:
     assert rows[0]["name"] == "rear-updated"
 
 
+def test_registry_firmware_change_forgets_sync_samples() -> None:
+    registry = ClientRegistry()
+    client_id = bytes.fromhex("aabbccddeeff")
+    hello = _FakeHelloMessage(
+        client_id=client_id,
+        control_port=9010,
+        sample_rate_hz=800,
+        name="node-1",
+        firmware_version="fw",
+    )
+    registry.update_from_hello(hello, ("10.4.0.2", 9010), now=1.0)
+    record = registry.get("aabbccddeeff")
+    assert record is not None
+    record.sync_samples.add(SyncSample(offset_us=5_000, rtt_us=800, receive_us=1_000_000))
+
+    # Same firmware: the sensor's clock is unchanged, so the samples stay.
+    registry.update_from_hello(hello, ("10.4.0.2", 9010), now=2.0)
+    assert len(record.sync_samples) == 1
+
+    registry.update_from_hello(
+        _FakeHelloMessage(
+            client_id=client_id,
+            control_port=9010,
+            sample_rate_hz=800,
+            name="node-1",
+            firmware_version="fw2",
+        ),
+        ("10.4.0.2", 9010),
+        now=3.0,
+    )
+    assert len(record.sync_samples) == 0
+
+
 def test_registry_persist_keeps_offline_names(tmp_path: Path) -> None:
     db = create_history_persistence_adapters(tmp_path / "history.db")
     registry = ClientRegistry(db=db.client_name_repository)
@@ -172,6 +172,29 @@ def test_out_of_order_packet_is_marked_late_without_rewinding_live_state(
     assert registry.get(client_id.hex()).last_t0_us == 20_000
 
 
+def test_replayed_backlog_frames_fill_gaps_behind_live_frames(tmp_path: Path) -> None:
+    """Stream-replayed frames that land behind live UDP frames are backfill, not loss."""
+    registry, client_id = _make_registry_with_hello(tmp_path)
+
+    for seq in (0, 3):
+        msg = _data_msg(client_id, seq, seq * 10000)
+        registry.update_from_data(msg, ("10.4.0.2", 50000), now=2.0)
+    for seq in (1, 2):
+        r = registry.update_from_data(
+            _data_msg(client_id, seq, seq * 10000),
+            ("10.4.0.2", 50000),
+            now=3.0,
+            replayed=True,
+        )
+        assert r.is_late is True
+        assert r.is_backfill is True
+
+    row = snapshot_for_api(registry, now=3.0)[0]
+    assert row["frames_total"] == 4
+    assert row["dropped_frames"] == 0
+    assert registry.get(client_id.hex()).last_seq == 3
+
+
 def test_reset_clears_seen_seqs(tmp_path: Path) -> None:
     """After a sensor reset, the same low seq numbers should be accepted again."""
     registry, client_id = _make_registry_with_hello(tmp_path)
@@ -0,0 +1,55 @@
+"""Guard min-RTT selection, sample ageing, and clock-step reset in the sync filter."""
+
+from __future__ import annotations
+
+import pytest
+
+from vibesensor.infra.runtime.sync_filter import SyncSample, SyncSampleWindow
+
+
+def test_sync_window_keeps_the_smallest_round_trip_sample() -> None:
+    window = SyncSampleWindow()
+
+    window.add(SyncSample(offset_us=5_000, rtt_us=800, receive_us=1_000_000))
+    best = window.add(SyncSample(offset_us=5_900, rtt_us=4_000, receive_us=2_000_000))
+
+    assert best.offset_us == 5_000
+    assert best.rtt_us == 800
+
+
+def test_sync_window_prefers_a_fresh_sample_once_the_old_one_has_aged() -> None:
+    window = SyncSampleWindow(window_size=4)
+    window.add(SyncSample(offset_us=5_000, rtt_us=800, receive_us=0))
+
+    # 100 s later the clean sample's drift allowance (5 ms) exceeds the
+    # noisy one's half round trip.
+    best = window.add(SyncSample(offset_us=5_300, rtt_us=2_000, receive_us=100_000_000))
+
+    assert best.offset_us == 5_300
+    assert len(window) == 2
+
+
+def test_sync_window_is_bounded() -> None:
+    window = SyncSampleWindow(window_size=2)
+    window.add(SyncSample(offset_us=5_000, rtt_us=100, receive_us=0))
+    window.add(SyncSample(offset_us=5_100, rtt_us=900, receive_us=1_000))
+    best = window.add(SyncSample(offset_us=5_200, rtt_us=700, receive_us=2_000))
+
+    assert len(window) == 2
+    assert best.rtt_us == 700
+
+
+def test_sync_window_restarts_after_a_clock_step() -> None:
+    window = SyncSampleWindow()
+    window.add(SyncSample(offset_us=5_000, rtt_us=200, receive_us=1_000_000))
+
+    # A rebooted sensor restarts its timer, moving the offset by seconds.
+    best = window.add(SyncSample(offset_us=900_000_000, rtt_us=3_000, receive_us=2_000_000))
+
+    assert best.offset_us == 900_000_000
+    assert len(window) == 1
+
+
+def test_sync_window_best_requires_a_sample() -> None:
+    with pytest.raises(LookupError):
+        SyncSampleWindow().best(0)
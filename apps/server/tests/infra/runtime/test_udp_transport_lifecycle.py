@@ -33,9 +33,11 @@ async def test_startup_tracks_transport_and_starts_consumer_task() -> None:
         registry=MagicMock(),
         processor=MagicMock(),
         queue_maxsize=64,
+        tsf_ifname="wlan1",
     )
 
     assert lifecycle.transport is transport
+    assert start_udp_receiver.call_args.kwargs["tsf_ifname"] == "wlan1"
     start_background_task.assert_called_once()
     task_factory = start_background_task.call_args.args[0]
     assert getattr(task_factory, "__self__", None) is consumer
@@ -34,6 +34,7 @@ class FakeHelloMessage:
     firmware_version: str
     frame_samples: int = 0
     queue_overflow_drops: int = 0
+    capabilities: int = 0
 
 
 @dataclass(slots=True)
@@ -42,6 +43,8 @@ class FakeDataMessage:
     seq: int
     t0_us: int
     sample_count: int
+    pulse_edge_count: int | None = None
+    pulse_last_edge_offset_us: int | None = None
 
 
 @dataclass(slots=True)
@@ -88,6 +91,7 @@ class StubUDPConfig:
     data_queue_maxsize: int = 100
     control_host: str = "0.0.0.0"
     control_port: int = 5006
+    backlog_stream_port: int = 0
 
 
 @dataclass(slots=True)
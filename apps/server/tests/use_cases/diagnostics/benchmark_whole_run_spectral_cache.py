@@ -0,0 +1,142 @@
+"""Second whole-run spectral pass after a car-profile change, cold vs. cached.
+
+Opt-in benchmark (``benchmark_*.py`` is not collected by default)::
+
+    pytest apps/server/tests/use_cases/diagnostics/benchmark_whole_run_spectral_cache.py \
+        --benchmark-only -o addopts='' --benchmark-json=spectral-cache.json
+
+Editing the car profile changes order references and context labels, not the
+raw capture or DSP parameters, so a re-analysis can reuse every spectral chunk
+from the first pass.  The dataset matches ``benchmark_whole_run_spectra.py``
+(four sensors, 800 Hz, five minutes, ``FFT_N=2048``).  ``extra_info`` records
+the cold pass, cache footprint and hit counts next to the timed warm pass.
+
+Only the whole-run spectral stage is timed.  A full re-analysis also reloads
+the run and reruns the context, order and spatial stages, which the cache does
+not touch, so the end-to-end saving is smaller than the ratio measured here.
+"""
+
+from __future__ import annotations
+
+import time
+from dataclasses import replace
+from math import pi
+from pathlib import Path
+
+import numpy as np
+import pytest
+from test_support.history_db_lifecycle import (
+    build_history_db,
+    create_recording_run,
+    make_run_metadata,
+)
+
+from vibesensor.adapters.persistence.whole_run_spectral_cache import (
+    FileWholeRunSpectralChunkCache,
+)
+from vibesensor.shared.constants.dsp import FFT_N
+from vibesensor.shared.types.raw_capture import RawCaptureChunk, RawRunCapture
+from vibesensor.shared.types.run_schema import RunMetadata
+from vibesensor.use_cases.diagnostics.whole_run_spectra import (
+    WholeRunSpectralBuildResult,
+    build_whole_run_spectral_artifact_bundle,
+)
+from vibesensor.use_cases.diagnostics.whole_run_spectral_cache import WholeRunSpectralChunkCache
+
+_SAMPLE_RATE_HZ = 800
+_DURATION_S = 300
+_TOTAL_SAMPLES = _SAMPLE_RATE_HZ * _DURATION_S
+_RAW_CHUNK_SAMPLES = 1024
+_CLIENT_IDS = tuple(f"sensor-{idx:02d}" for idx in range(4))
+_BASE_FREQS_HZ = (23.0, 37.0, 51.0, 67.0)
+_RUN_ID = "run-spectral-cache"
+
+
+def _sensor_samples(freq_hz: float) -> np.ndarray:
+    t = np.arange(_TOTAL_SAMPLES, dtype=np.float64) / _SAMPLE_RATE_HZ
+    x = (0.16 * np.sin(2.0 * pi * freq_hz * t) * 256.0).astype(np.int16)
+    y = (0.10 * np.sin(2.0 * pi * (freq_hz + 11.0) * t) * 256.0).astype(np.int16)
+    z = (0.06 * np.sin(2.0 * pi * (freq_hz * 0.5) * t) * 256.0).astype(np.int16)
+    return np.stack([x, y, z], axis=1)
+
+
+@pytest.fixture(scope="module")
+def recorded_run(tmp_path_factory: pytest.TempPathFactory) -> tuple[RunMetadata, RawRunCapture]:
+    db = build_history_db(Path(tmp_path_factory.mktemp("spectral-cache-bench")))
+    metadata = make_run_metadata(
+        _RUN_ID,
+        fft_window_size_samples=FFT_N,
+        accel_scale_g_per_lsb=1.0 / 256.0,
+    )
+    create_recording_run(db, _RUN_ID, metadata=metadata)
+    for client_id, freq_hz in zip(_CLIENT_IDS, _BASE_FREQS_HZ, strict=True):
+        samples = _sensor_samples(freq_hz)
+        for sample_start in range(0, _TOTAL_SAMPLES, _RAW_CHUNK_SAMPLES):
+            chunk = samples[sample_start : sample_start + _RAW_CHUNK_SAMPLES]
+            db.run_repository._run_sync(
+                db.run_repository.aappend_raw_capture_chunk(
+                    _RUN_ID,
+                    RawCaptureChunk(
+                        client_id=client_id,
+                        sample_rate_hz=_SAMPLE_RATE_HZ,
+                        t0_us=int(sample_start * (1_000_000 / _SAMPLE_RATE_HZ)),
+                        sample_count=int(chunk.shape[0]),
+                        samples_i16le=np.ascontiguousarray(chunk).tobytes(order="C"),
+                    ),
+                )
+            )
+    assert db.run_repository._run_sync(db.run_repository.afinalize_raw_capture(_RUN_ID))
+    raw_capture = db.run_repository._run_sync(db.run_repository.aload_raw_capture(_RUN_ID))
+    assert raw_capture is not None
+    return metadata, raw_capture
+
+
+def _build(
+    metadata: RunMetadata,
+    raw_capture: RawRunCapture,
+    spectral_cache: WholeRunSpectralChunkCache | None,
+) -> WholeRunSpectralBuildResult:
+    return build_whole_run_spectral_artifact_bundle(
+        run_id=_RUN_ID,
+        metadata=metadata,
+        raw_capture=raw_capture,
+        created_at="2026-01-01T00:00:00Z",
+        spectral_cache=spectral_cache,
+    )
+
+
+@pytest.mark.benchmark(group="whole-run-spectral-cache")
+def test_second_pass_after_car_profile_change_reuses_spectra(
+    benchmark,
+    recorded_run: tuple[RunMetadata, RawRunCapture],
+    tmp_path: Path,
+) -> None:
+    metadata, raw_capture = recorded_run
+    cache = FileWholeRunSpectralChunkCache(root_dir=tmp_path / "spectral-cache")
+
+    started = time.perf_counter()
+    first = _build(metadata, raw_capture, cache)
+    cold_s = time.perf_counter() - started
+    cold_stats = cache.stats()
+
+    edited = replace(metadata, wheel_circumference_m=2.05)
+    second = benchmark.pedantic(
+        _build,
+        args=(edited, raw_capture, cache),
+        rounds=3,
+        iterations=1,
+    )
+    warm_stats = cache.stats()
+
+    benchmark.extra_info["window_count"] = first.window_plan.total_window_count
+    benchmark.extra_info["cold_pass_s"] = round(cold_s, 3)
+    benchmark.extra_info["cache_entries"] = warm_stats.entry_count
+    benchmark.extra_info["cache_bytes"] = warm_stats.total_bytes
+    benchmark.extra_info["warm_hits"] = warm_stats.hits - cold_stats.hits
+    benchmark.extra_info["warm_misses"] = warm_stats.misses - cold_stats.misses
+
+    assert first.bundle is not None
+    assert second.bundle is not None
+    assert second.bundle.artifact_contents == first.bundle.artifact_contents
+    assert warm_stats.misses == cold_stats.misses
+    assert benchmark.stats.stats.mean < cold_s
@@ -134,8 +134,12 @@ def test_esp_protocol_constants_match_python() -> None:
         CMD_IDENTIFY,
         CMD_IDENTIFY_BYTES,
         CMD_SYNC_CLOCK_BYTES,
+        CMD_TX_SLOT,
+        CMD_TX_SLOT_BYTES,
         DATA_ACK_BYTES,
         DATA_HEADER_BYTES,
+        DATA_PULSE_CHANNEL_BYTES,
+        DATA_RANGE_TAG_BYTES,
         HELLO_FIXED_BYTES,
         MSG_ACK,
         MSG_CMD,
@@ -162,28 +166,35 @@ def test_esp_protocol_constants_match_python() -> None:
     assert _cpp_const("kMsgAck") == MSG_ACK
     assert _cpp_const("kMsgDataAck") == MSG_DATA_ACK
     assert _cpp_const("kCmdIdentify") == CMD_IDENTIFY
+    assert _cpp_const("kCmdTxSlot") == CMD_TX_SLOT
 
     # Byte-size constants are computed as expressions in C++; verify by evaluating
     # with kClientIdBytes = 6
     py_sizes = {
         "HELLO_FIXED_BYTES": HELLO_FIXED_BYTES,
         "DATA_HEADER_BYTES": DATA_HEADER_BYTES,
+        "DATA_RANGE_TAG_BYTES": DATA_RANGE_TAG_BYTES,
+        "DATA_PULSE_CHANNEL_BYTES": DATA_PULSE_CHANNEL_BYTES,
         "ACK_BYTES": ACK_BYTES,
         "ACK_SYNC_CLOCK_BYTES": ACK_SYNC_CLOCK_BYTES,
         "DATA_ACK_BYTES": DATA_ACK_BYTES,
         "CMD_HEADER_BYTES": CMD_HEADER_BYTES,
         "CMD_IDENTIFY_BYTES": CMD_IDENTIFY_BYTES,
         "CMD_SYNC_CLOCK_BYTES": CMD_SYNC_CLOCK_BYTES,
+        "CMD_TX_SLOT_BYTES": CMD_TX_SLOT_BYTES,
     }
     cpp_names = {
         "HELLO_FIXED_BYTES": "kHelloFixedBytes",
         "DATA_HEADER_BYTES": "kDataHeaderBytes",
+        "DATA_RANGE_TAG_BYTES": "kDataRangeTagBytes",
+        "DATA_PULSE_CHANNEL_BYTES": "kDataPulseChannelBytes",
         "ACK_BYTES": "kAckBytes",
         "ACK_SYNC_CLOCK_BYTES": "kAckSyncClockBytes",
         "DATA_ACK_BYTES": "kDataAckBytes",
         "CMD_HEADER_BYTES": "kCmdHeaderBytes",
         "CMD_IDENTIFY_BYTES": "kCmdIdentifyBytes",
         "CMD_SYNC_CLOCK_BYTES": "kCmdSyncClockBytes",
+        "CMD_TX_SLOT_BYTES": "kCmdTxSlotBytes",
     }
     # Evaluate C++ expressions by substituting kClientIdBytes and kCmdHeaderBytes
     for py_name, expected in py_sizes.items():
@@ -25,6 +25,10 @@ from vibesensor.use_cases.diagnostics.whole_run_spectra import (
     build_whole_run_spectral_artifact_bundle,
     build_whole_run_spectral_artifact_bundle_from_ranges,
 )
+from vibesensor.use_cases.diagnostics.whole_run_spectral_cache import (
+    WholeRunSpectralCacheStats,
+    WholeRunSpectralChunk,
+)
 
 _RUN_START_US = 1_000_000
 
@@ -477,7 +481,7 @@ def test_whole_run_spectra_allow_mixed_observed_sample_rates() -> None:
         _make_sensor(
             client_id="sensor-a",
             sample_rate_hz=8,
-            chunks=[(_RUN_START_US, _sine_samples(total_samples=24))],
+            chunks=[(_RUN_START_US, _sine_samples(total_samples=16))],
             clock_sync=_verified_sync(),
         ),
         _make_sensor(
@@ -532,3 +536,81 @@ def test_whole_run_spectra_warn_when_sample_rate_is_unverified() -> None:
     assert result.coverage_summary.sample_rate_mismatch_sensor_count == 0
     assert result.coverage_summary.sample_rate_unverified_sensor_count == 1
     assert result.coverage_summary.coverage_confidence == "partial"
+
+
+class _DictSpectralCache:
+    def __init__(self) -> None:
+        self.entries: dict[str, WholeRunSpectralChunk] = {}
+
+    def load(self, key: str) -> WholeRunSpectralChunk | None:
+        return self.entries.get(key)
+
+    def store(self, key: str, chunk: WholeRunSpectralChunk) -> None:
+        self.entries[key] = chunk
+
+    def stats(self) -> WholeRunSpectralCacheStats:
+        return WholeRunSpectralCacheStats(
+            entry_count=len(self.entries), total_bytes=0, max_bytes=0, hits=0, misses=0
+        )
+
+
+def test_whole_run_spectra_reuse_cached_chunks_after_a_car_profile_change() -> None:
+    raw_capture = _raw_capture(
+        _make_sensor(
+            client_id="sensor-a",
+            sample_rate_hz=8,
+            chunks=[(_RUN_START_US, _sine_samples(total_samples=24))],
+            clock_sync=_verified_sync(),
+        )
+    )
+    cache = _DictSpectralCache()
+    first_reads: list[int] = []
+    second_reads: list[int] = []
+
+    def build(metadata: RunMetadata, read_sizes: list[int]):
+        return build_whole_run_spectral_artifact_bundle_from_ranges(
+            run_id="run-spectra",
+            metadata=metadata,
+            raw_capture_manifest=raw_capture.manifest,
+            raw_range_reader=_range_reader(raw_capture, read_sizes),
+            chunk_window_count=2,
+            created_at="2025-01-01T00:00:00Z",
+            spectral_cache=cache,
+        )
+
+    first = build(_metadata(), first_reads)
+    second = build(replace(_metadata(), wheel_circumference_m=2.05), second_reads)
+
+    assert first.bundle is not None
+    assert second.bundle is not None
+    assert first_reads == [8, 8, 8]
+    assert second_reads == []
+    assert len(cache.entries) == 2
+    assert second.bundle.artifact_contents == first.bundle.artifact_contents
+    assert second.coverage_summary == first.coverage_summary
+
+
+def test_whole_run_spectra_cache_misses_when_dsp_parameters_change() -> None:
+    raw_capture = _raw_capture(
+        _make_sensor(
+            client_id="sensor-a",
+            sample_rate_hz=8,
+            chunks=[(_RUN_START_US, _sine_samples(total_samples=16))],
+            clock_sync=_verified_sync(),
+        )
+    )
+    cache = _DictSpectralCache()
+    read_sizes: list[int] = []
+
+    for accel_scale in (0.001, 0.002):
+        build_whole_run_spectral_artifact_bundle_from_ranges(
+            run_id="run-spectra",
+            metadata=replace(_metadata(), accel_scale_g_per_lsb=accel_scale),
+            raw_capture_manifest=raw_capture.manifest,
+            raw_range_reader=_range_reader(raw_capture, read_sizes),
+            created_at="2025-01-01T00:00:00Z",
+            spectral_cache=cache,
+        )
+
+    assert len(cache.entries) == 2
+    assert len(read_sizes) == 6
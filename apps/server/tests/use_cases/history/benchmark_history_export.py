@@ -0,0 +1,156 @@
+"""History export throughput and peak memory: spooled ZIP vs. streamed CSV/columnar.
+
+Opt-in benchmark (``benchmark_*.py`` is not collected by default)::
+
+    pytest apps/server/tests/use_cases/history/benchmark_history_export.py \
+        --benchmark-only -o addopts='' --benchmark-json=history-export.json
+
+The run holds 120k sample rows (four sensors) plus one minute of 800 Hz raw
+capture per sensor.  Each format is drained end to end through the same
+service the HTTP route uses.  ``extra_info`` records rows/s for the timed
+passes, bytes delivered, and the traced peak allocation of one extra pass,
+which stays flat for the streamed formats as the run grows.
+"""
+
+from __future__ import annotations
+
+import time
+import tracemalloc
+from pathlib import Path
+from typing import Literal
+
+import numpy as np
+import pytest
+from test_support.history_db_lifecycle import (
+    build_history_db,
+    create_recording_run,
+    make_run_metadata,
+)
+
+from vibesensor.adapters.history import ProjectedHistoryExportService
+from vibesensor.adapters.persistence.history_db import HistoryPersistenceAdapters
+from vibesensor.shared.boundaries.sensor_frames import sensor_frame_from_mapping
+from vibesensor.shared.types.raw_capture import RawCaptureChunk
+from vibesensor.use_cases.history.exports import HistoryExportService
+
+_RUN_ID = "run-export-bench"
+_CLIENT_IDS = tuple(f"sensor-{idx:02d}" for idx in range(4))
+_ROWS_PER_SENSOR = 30_000
+_TOTAL_ROWS = _ROWS_PER_SENSOR * len(_CLIENT_IDS)
+_INSERT_BATCH = 2_000
+_RAW_SAMPLE_RATE_HZ = 800
+_RAW_SAMPLES_PER_SENSOR = _RAW_SAMPLE_RATE_HZ * 60
+_RAW_CHUNK_SAMPLES = 1024
+
+type _BenchFormat = Literal["zip", "csv", "columnar"]
+
+
+def _sample_row(client_id: str, index: int) -> dict[str, object]:
+    t_s = index * 0.05
+    return {
+        "run_id": _RUN_ID,
+        "timestamp_utc": f"2026-01-01T00:{int(t_s) // 60:02d}:{t_s % 60:06.3f}Z",
+        "t_s": t_s,
+        "analysis_window_start_us": index * 50_000,
+        "analysis_window_end_us": index * 50_000 + 250_000,
+        "analysis_window_synced": True,
+        "client_id": client_id,
+        "client_name": client_id,
+        "location": "front-left",
+        "sample_rate_hz": _RAW_SAMPLE_RATE_HZ,
+        "speed_kmh": 80.0 + np.sin(t_s / 30.0) * 20.0,
+        "speed_source": "gps",
+        "accel_x_g": 0.02 + np.sin(t_s) * 0.01,
+        "accel_y_g": 0.01,
+        "accel_z_g": 1.0,
+        "dominant_freq_hz": 15.0 + (index % 7),
+        "dominant_axis": "x",
+        "top_peaks": [{"hz": 15.0 + (index % 7), "amp": 0.1}],
+        "vibration_strength_db": 12.0 + (index % 5),
+        "strength_bucket": "l2",
+        "frames_dropped_total": index // 10_000,
+        "queue_overflow_drops": 0,
+    }
+
+
+@pytest.fixture(scope="module")
+def history_db(tmp_path_factory: pytest.TempPathFactory) -> HistoryPersistenceAdapters:
+    db = build_history_db(Path(tmp_path_factory.mktemp("history-export-bench")))
+    repository = db.run_repository
+    metadata = create_recording_run(db, _RUN_ID, metadata=make_run_metadata(_RUN_ID))
+    for start in range(0, _ROWS_PER_SENSOR, _INSERT_BATCH // len(_CLIENT_IDS)):
+        batch = [
+            sensor_frame_from_mapping(_sample_row(client_id, index))
+            for index in range(start, start + (_INSERT_BATCH // len(_CLIENT_IDS)))
+            for client_id in _CLIENT_IDS
+        ]
+        assert repository._run_sync(repository.aappend_samples(_RUN_ID, batch)) == len(batch)
+    t = np.arange(_RAW_SAMPLES_PER_SENSOR, dtype=np.float64) / _RAW_SAMPLE_RATE_HZ
+    for sensor_index, client_id in enumerate(_CLIENT_IDS):
+        wave = (np.sin(2.0 * np.pi * (20.0 + sensor_index * 7.0) * t) * 120.0).astype(np.int16)
+        samples = np.stack([wave, wave // 2, wave // 3 + 256], axis=1)
+        for sample_start in range(0, _RAW_SAMPLES_PER_SENSOR, _RAW_CHUNK_SAMPLES):
+            chunk = samples[sample_start : sample_start + _RAW_CHUNK_SAMPLES]
+            repository._run_sync(
+                repository.aappend_raw_capture_chunk(
+                    _RUN_ID,
+                    RawCaptureChunk(
+                        client_id=client_id,
+                        sample_rate_hz=_RAW_SAMPLE_RATE_HZ,
+                        t0_us=int(sample_start * (1_000_000 / _RAW_SAMPLE_RATE_HZ)),
+                        sample_count=int(chunk.shape[0]),
+                        samples_i16le=np.ascontiguousarray(chunk).tobytes(order="C"),
+                    ),
+                )
+            )
+    assert repository._run_sync(repository.afinalize_raw_capture(_RUN_ID))
+    repository.finalize_run(_RUN_ID, "2026-01-01T00:30:00Z", metadata=metadata)
+    return db
+
+
+async def _drain(service: ProjectedHistoryExportService, export_format: _BenchFormat) -> int:
+    delivered = 0
+    if export_format == "zip":
+        download = await service.build_export(_RUN_ID)
+        for chunk in download.iter_bytes():
+            delivered += len(chunk)
+        return delivered
+    stream = await service.stream_export(_RUN_ID, export_format)
+    async for chunk in stream.chunks:
+        delivered += len(chunk)
+    return delivered
+
+
+@pytest.mark.benchmark(group="history-export")
+@pytest.mark.parametrize("export_format", ["zip", "csv", "columnar"])
+def test_history_export_rows_per_second_and_peak_memory(
+    benchmark,
+    history_db: HistoryPersistenceAdapters,
+    export_format: _BenchFormat,
+) -> None:
+    repository = history_db.run_repository
+    service = ProjectedHistoryExportService(HistoryExportService(repository))
+
+    tracemalloc.start()
+    try:
+        started = time.perf_counter()
+        delivered = repository._run_sync(_drain(service, export_format))
+        traced_s = time.perf_counter() - started
+        _current, peak = tracemalloc.get_traced_memory()
+    finally:
+        tracemalloc.stop()
+
+    timed_delivered = benchmark.pedantic(
+        lambda: repository._run_sync(_drain(service, export_format)),
+        rounds=3,
+        iterations=1,
+    )
+
+    benchmark.extra_info["rows"] = _TOTAL_ROWS
+    benchmark.extra_info["rows_per_s"] = round(_TOTAL_ROWS / benchmark.stats.stats.mean)
+    benchmark.extra_info["bytes_delivered"] = delivered
+    benchmark.extra_info["peak_memory_bytes"] = peak
+    benchmark.extra_info["traced_pass_s"] = round(traced_s, 3)
+
+    assert timed_delivered == delivered
+    assert delivered > 0
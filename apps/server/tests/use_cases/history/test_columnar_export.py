@@ -0,0 +1,119 @@
+"""Round-trip guards for the per-column encodings of streamed columnar exports."""
+
+from __future__ import annotations
+
+import io
+import json
+import zipfile
+
+import numpy as np
+
+from vibesensor.shared.boundaries.codecs import strength_peak_payloads
+from vibesensor.shared.boundaries.sensor_frames import sensor_frame_from_mapping
+from vibesensor.shared.types.sensor_frame import SensorFrame
+from vibesensor.use_cases.history.columnar_export import (
+    COLUMNAR_EXPORT_COLUMNS,
+    COLUMNAR_SCHEMA_MEMBER,
+    columnar_export_schema_json,
+    encode_columnar_block,
+    encode_raw_capture_segment,
+    read_columnar_export,
+    read_columnar_raw_capture,
+)
+from vibesensor.use_cases.history.exports import EXPORT_CSV_COLUMNS
+
+
+def _frame(i: int) -> SensorFrame:
+    return sensor_frame_from_mapping(
+        {
+            "run_id": "run-1",
+            "timestamp_utc": f"2026-01-01T00:00:{i:02d}Z",
+            "t_s": i * 0.5,
+            "analysis_window_start_us": None if i % 3 == 0 else 1_000_000 * i,
+            "analysis_window_end_us": 1_000_000 * i + 500_000,
+            "analysis_window_synced": None if i % 4 == 0 else i % 2 == 0,
+            "client_id": f"sensor-{i % 2}",
+            "client_name": "front-left wheel",
+            "sample_rate_hz": 800,
+            "speed_kmh": None if i == 2 else 60.0 + (i * 0.1),
+            "accel_x_g": 0.02 * i,
+            "accel_y_g": -0.01 * i,
+            "accel_z_g": 1.0,
+            "dominant_freq_hz": 15.0,
+            "dominant_axis": "x" if i % 2 else "z",
+            "top_peaks": [{"hz": 15.0 + i, "amp": 0.1}],
+            "vibration_strength_db": 12.0,
+            "strength_bucket": None if i == 5 else "l2",
+            "frames_dropped_total": i // 3,
+            "queue_overflow_drops": 0,
+        }
+    )
+
+
+def _archive(members: list[tuple[str, bytes]], raw_sensors: tuple = ()) -> zipfile.ZipFile:
+    buffer = io.BytesIO()
+    with zipfile.ZipFile(buffer, mode="w", compression=zipfile.ZIP_DEFLATED) as archive:
+        archive.writestr(COLUMNAR_SCHEMA_MEMBER, columnar_export_schema_json(raw_sensors))
+        for name, payload in members:
+            archive.writestr(name, payload)
+    buffer.seek(0)
+    return zipfile.ZipFile(buffer)
+
+
+def test_columnar_columns_match_csv_columns() -> None:
+    assert tuple(column.name for column in COLUMNAR_EXPORT_COLUMNS) == EXPORT_CSV_COLUMNS
+
+
+def test_columnar_blocks_round_trip_values_and_nulls() -> None:
+    frames = [_frame(i) for i in range(12)]
+    members = encode_columnar_block(frames[:7], block_index=0)
+    members += encode_columnar_block(frames[7:], block_index=1)
+
+    decoded = read_columnar_export(_archive(members))
+
+    assert decoded["t_s"] == [frame.t_s for frame in frames]
+    assert decoded["speed_kmh"] == [frame.speed_kmh for frame in frames]
+    assert decoded["accel_y_g"] == [frame.accel_y_g for frame in frames]
+    assert decoded["analysis_window_start_us"] == [
+        frame.analysis_window_start_us for frame in frames
+    ]
+    assert decoded["frames_dropped_total"] == [frame.frames_dropped_total for frame in frames]
+    assert decoded["client_id"] == [frame.client_id for frame in frames]
+    assert decoded["strength_bucket"] == [frame.strength_bucket for frame in frames]
+    assert decoded["analysis_window_synced"] == [
+        None if frame.analysis_window_synced is None else str(frame.analysis_window_synced).lower()
+        for frame in frames
+    ]
+    assert [json.loads(value) for value in decoded["top_peaks"]] == [
+        json.loads(json.dumps(strength_peak_payloads(frame.top_peaks))) for frame in frames
+    ]
+
+
+def test_columnar_float_columns_are_mostly_zero_bits_for_smooth_signals() -> None:
+    frames = [_frame(i) for i in range(64)]
+    members = dict(encode_columnar_block(frames, block_index=0))
+
+    xored = np.load(io.BytesIO(members["blocks/000000/accel_z_g.npy"]))
+
+    assert xored.dtype == np.uint64
+    assert np.count_nonzero(xored[1:]) == 0
+
+
+def test_raw_capture_segments_round_trip_across_int16_wraparound() -> None:
+    rng = np.random.default_rng(7)
+    samples = rng.integers(-32768, 32767, size=(300, 3), dtype=np.int16)
+    samples[10] = (32767, -32768, 0)
+    samples[11] = (-32768, 32767, 0)
+    members = [
+        encode_raw_capture_segment(samples[:128], sensor_index=0, segment_index=0),
+        encode_raw_capture_segment(samples[128:], sensor_index=0, segment_index=1),
+    ]
+    raw_sensor = type(
+        "Sensor",
+        (),
+        {"client_id": "sensor-0", "sample_rate_hz": 800, "sample_count": 300},
+    )()
+
+    decoded = read_columnar_raw_capture(_archive(members, (raw_sensor,)))
+
+    np.testing.assert_array_equal(decoded["sensor-0"], samples)
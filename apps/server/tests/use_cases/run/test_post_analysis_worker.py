@@ -17,6 +17,10 @@ from tests.test_support.persisted_analysis import make_persisted_analysis
 from vibesensor.shared.boundaries.runs.metadata import run_metadata_from_mapping
 from vibesensor.shared.boundaries.sensor_frames import sensor_frames_from_mappings
 from vibesensor.shared.types.run_schema import RunMetadata
+from vibesensor.use_cases.diagnostics.whole_run_spectral_cache import (
+    WholeRunSpectralCacheStats,
+    WholeRunSpectralChunk,
+)
 from vibesensor.use_cases.run.post_analysis import PostAnalysisWorker
 
 # ---------------------------------------------------------------------------
@@ -166,6 +170,32 @@ class TestPostAnalysisWorkerSnapshot:
         release.set()
         assert worker.wait(timeout_s=2.0)
 
+    def test_logs_spectral_cache_stats_after_each_run(
+        self, make_worker, caplog: pytest.LogCaptureFixture
+    ) -> None:
+        class _Cache:
+            def load(self, key: str) -> WholeRunSpectralChunk | None:
+                return None
+
+            def store(self, key: str, chunk: WholeRunSpectralChunk) -> None:
+                return None
+
+            def stats(self) -> WholeRunSpectralCacheStats:
+                return WholeRunSpectralCacheStats(
+                    entry_count=3, total_bytes=4096, max_bytes=8192, hits=5, misses=2
+                )
+
+        worker = make_worker(run_fn=lambda _rid: None, whole_run_spectral_cache=_Cache())
+
+        with caplog.at_level("INFO", logger="vibesensor.use_cases.run.post_analysis"):
+            worker.schedule("run-1")
+            assert worker.wait(timeout_s=2.0)
+
+        assert (
+            "Whole-run spectral cache after run run-1: 3 entries, 4096 of 8192 bytes, "
+            "5 hits, 2 misses"
+        ) in caplog.messages
+
 
 class TestPostAnalysisWorkerWait:
     def test_wait_no_work_returns_immediately(self) -> None:
@@ -50,6 +50,7 @@ def test_build_isolated_server_config_rewrites_runtime_paths_and_copies_seed_dat
         "data_port": 19080,
         "control_host": "127.0.0.1",
         "control_port": 19180,
+        "backlog_stream_port": 0,
     }
     assert data["gps"]["gps_enabled"] is False
     assert data["ap"]["self_heal"]["enabled"] is False
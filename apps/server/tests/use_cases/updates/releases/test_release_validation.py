@@ -76,6 +76,7 @@ def test_build_release_smoke_config_rewrites_runtime_paths(tmp_path: Path) -> No
         "data_port": 19080,
         "control_host": "127.0.0.1",
         "control_port": 19081,
+        "backlog_stream_port": 0,
     }
     assert data["gps"]["gps_enabled"] is False
     assert data["ap"]["self_heal"]["enabled"] is False
@@ -6,8 +6,10 @@ import asyncio
 import shutil
 import tempfile
 import zipfile
-from typing import cast
+from collections.abc import AsyncIterator
+from typing import Literal, cast
 
+import numpy as np
 from pydantic import TypeAdapter
 
 from vibesensor.adapters.http.models import (
@@ -18,13 +20,24 @@ from vibesensor.adapters.http.models import (
 )
 from vibesensor.shared.boundaries.runs.metadata import run_metadata_from_mapping
 from vibesensor.shared.boundaries.summary_fields.warnings import localize_warning_list
+from vibesensor.shared.filenames import safe_filename
 from vibesensor.shared.ports import ActiveCarReader
+from vibesensor.shared.types.history_records import StoredHistoryRun
 from vibesensor.shared.types.json_types import JsonValue, is_json_array, is_json_object
+from vibesensor.shared.types.sensor_frame import SensorFrame
+from vibesensor.use_cases.history.columnar_export import (
+    COLUMNAR_SCHEMA_MEMBER,
+    columnar_export_schema_json,
+    encode_columnar_block,
+    encode_raw_capture_segment,
+)
 from vibesensor.use_cases.history.exports import (
+    EXPORT_RAW_SEGMENT_SAMPLES,
     EXPORT_SPOOL_THRESHOLD,
     HistoryExportContext,
     HistoryExportDownload,
     HistoryExportService,
+    HistoryExportStream,
 )
 from vibesensor.use_cases.history.runs import HistoryRunService
 from vibesensor.use_cases.run.run_context import add_current_context_warnings
@@ -39,6 +52,8 @@ _HISTORY_INSIGHTS_ADAPTER = TypeAdapter(HistoryInsightsResponse)
 
 __all__ = ["ProjectedHistoryExportService", "ProjectedHistoryRunService"]
 
+type StreamedExportFormat = Literal["csv", "columnar"]
+
 
 class ProjectedHistoryRunService:
     """Adapter that projects persisted history analysis before HTTP delivery."""
@@ -109,6 +124,68 @@ class ProjectedHistoryExportService:
     def __init__(self, service: HistoryExportService) -> None:
         self._service = service
 
+    async def stream_export(
+        self,
+        run_id: str,
+        export_format: StreamedExportFormat,
+    ) -> HistoryExportStream:
+        """Open a constant-memory export that streams without a spool or size header."""
+        run = await self._service.load_export_run(run_id)
+        name = safe_filename(run_id)
+        if export_format == "csv":
+            return HistoryExportStream(
+                filename=f"{name}_raw.csv",
+                media_type="text/csv",
+                chunks=self._service.aiter_csv_chunks(run_id),
+            )
+        return HistoryExportStream(
+            filename=f"{name}_columnar.zip",
+            media_type="application/zip",
+            chunks=self._aiter_columnar_zip(run, name),
+        )
+
+    async def _aiter_columnar_zip(self, run: StoredHistoryRun, name: str) -> AsyncIterator[bytes]:
+        sink = _ZipStreamSink()
+        archive = zipfile.ZipFile(sink, mode="w", compression=zipfile.ZIP_DEFLATED)
+        try:
+            raw_manifest = run.raw_capture_manifest
+            archive.writestr(
+                COLUMNAR_SCHEMA_MEMBER,
+                columnar_export_schema_json(raw_manifest.sensors if raw_manifest else ()),
+            )
+            sample_count = 0
+            block_index = 0
+            async for batch in self._service.aiter_sample_batches(run.run_id):
+                sample_count += len(batch)
+                await asyncio.to_thread(_write_sample_block, archive, batch, block_index)
+                block_index += 1
+                yield sink.drain()
+            if raw_manifest is not None:
+                async for sensor_index, raw_range in self._service.aiter_raw_capture_segments(
+                    run.run_id,
+                    raw_manifest,
+                ):
+                    await asyncio.to_thread(
+                        _write_raw_segment,
+                        archive,
+                        raw_range.samples_i16,
+                        sensor_index,
+                        raw_range.requested_sample_start // EXPORT_RAW_SEGMENT_SAMPLES,
+                    )
+                    yield sink.drain()
+            archive.writestr(
+                f"{name}.json",
+                build_projected_run_details_json(
+                    run,
+                    sample_count=sample_count,
+                    run_id=run.run_id,
+                ),
+            )
+            archive.close()
+            yield sink.drain()
+        finally:
+            archive.close()
+
     async def build_export(self, run_id: str) -> HistoryExportDownload:
         context = await self._service.build_export_context(run_id)
         return await asyncio.to_thread(self._build_export_download, context)
@@ -143,3 +220,51 @@ class ProjectedHistoryExportService:
             if not download_built:
                 spool.close()
             context.raw_csv_spool.close()
+
+
+class _ZipStreamSink:
+    """Write-only file object that lets :class:`zipfile.ZipFile` emit a streamable archive.
+
+    Without ``seek``/``tell`` the archive falls back to data descriptors, so each
+    member can be handed to the response as soon as it is compressed.
+    """
+
+    __slots__ = ("_buffer",)
+
+    def __init__(self) -> None:
+        self._buffer = bytearray()
+
+    def write(self, data: bytes) -> int:
+        self._buffer += data
+        return len(data)
+
+    def flush(self) -> None:
+        return None
+
+    def drain(self) -> bytes:
+        data = bytes(self._buffer)
+        self._buffer.clear()
+        return data
+
+
+def _write_sample_block(
+    archive: zipfile.ZipFile,
+    batch: list[SensorFrame],
+    block_index: int,
+) -> None:
+    for member_name, payload in encode_columnar_block(batch, block_index=block_index):
+        archive.writestr(member_name, payload)
+
+
+def _write_raw_segment(
+    archive: zipfile.ZipFile,
+    samples_i16: np.ndarray,
+    sensor_index: int,
+    segment_index: int,
+) -> None:
+    member_name, payload = encode_raw_capture_segment(
+        samples_i16,
+        sensor_index=sensor_index,
+        segment_index=segment_index,
+    )
+    archive.writestr(member_name, payload)
@@ -3,7 +3,7 @@
 from __future__ import annotations
 
 from dataclasses import dataclass
-from typing import TYPE_CHECKING, Protocol
+from typing import TYPE_CHECKING, Literal, Protocol
 
 from vibesensor.adapters.http.models import (
     DeleteHistoryRunResponse,
@@ -25,7 +25,7 @@ from vibesensor.shared.ports import (
     UiPreferencesStore,
 )
 from vibesensor.shared.types.payload_types import ClientMetrics
-from vibesensor.use_cases.history.exports import HistoryExportDownload
+from vibesensor.use_cases.history.exports import HistoryExportDownload, HistoryExportStream
 from vibesensor.use_cases.history.reports import HistoryReportPdf
 from vibesensor.use_cases.run import RunRecorder
 from vibesensor.use_cases.updates.firmware.esp_flash_manager import EspFlashManager
@@ -62,6 +62,12 @@ class HistoryReportServiceProtocol(Protocol):
 class HistoryExportServiceProtocol(Protocol):
     async def build_export(self, run_id: str) -> HistoryExportDownload: ...
 
+    async def stream_export(
+        self,
+        run_id: str,
+        export_format: Literal["csv", "columnar"],
+    ) -> HistoryExportStream: ...
+
 
 class SettingsSpeedServiceProtocol(Protocol):
     def status_snapshot(self) -> SpeedSourceStatusSnapshot: ...
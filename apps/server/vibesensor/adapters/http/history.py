@@ -2,7 +2,7 @@
 
 from __future__ import annotations
 
-from typing import TYPE_CHECKING
+from typing import TYPE_CHECKING, Literal
 
 from fastapi import APIRouter, Query
 from fastapi.responses import JSONResponse, Response, StreamingResponse
@@ -167,16 +167,40 @@ def create_history_routes(
             headers=pdf_headers,
         )
 
-    # -- CSV/ZIP export --------------------------------------------------------
+    # -- CSV/ZIP/columnar export -----------------------------------------------
 
     @router.get(
         "/api/history/{run_id}/export",
         response_class=StreamingResponse,
         responses={**_INVALID_RUN_ID_RESPONSE, **_EXPORT_RESPONSES},
     )
-    async def export_history_run(run_id: str) -> StreamingResponse:
-        """Build and stream the ZIP export bundle for a persisted run."""
+    async def export_history_run(
+        run_id: str,
+        export_format: Literal["zip", "csv", "columnar"] = Query(
+            default="zip",
+            alias="format",
+            description=(
+                "'zip' bundles the run JSON with the raw-sample CSV.  'csv' streams the "
+                "raw-sample CSV alone and 'columnar' streams a ZIP of per-column encoded "
+                "sample blocks plus raw capture; both start immediately and omit "
+                "Content-Length."
+            ),
+        ),
+    ) -> StreamingResponse:
+        """Build and stream the export bundle for a persisted run."""
         run_id = normalize_run_id_or_400(run_id)
+        if export_format != "zip":
+            with route_errors_to_http():
+                stream = await export_service.stream_export(run_id, export_format)
+            return StreamingResponse(
+                content=stream.chunks,
+                media_type=stream.media_type,
+                headers={
+                    "Content-Disposition": (
+                        f'attachment; filename="{safe_filename(stream.filename)}"'
+                    ),
+                },
+            )
         with route_errors_to_http():
             export = await export_service.build_export(run_id)
         return StreamingResponse(
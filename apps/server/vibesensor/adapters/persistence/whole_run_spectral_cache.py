@@ -0,0 +1,188 @@
+"""Disk-backed content-addressed cache for whole-run spectral chunks.
+
+Each entry is a directory named by the chunk key holding the frequency grid
+and spectrum rows as ``.npy`` files (loaded memory-mapped, so a warm
+re-analysis pages in only what the merge touches) plus the window summaries
+as JSONL.  Entries are written to a temporary directory and renamed into
+place, so a crash never leaves a half-written entry under a valid key.
+Least-recently-used entries are evicted once the cache exceeds its disk
+budget; directory mtimes carry the LRU order across restarts.
+"""
+
+from __future__ import annotations
+
+import logging
+import os
+import shutil
+import uuid
+from collections import OrderedDict
+from pathlib import Path
+from threading import RLock
+
+import numpy as np
+
+from vibesensor.use_cases.diagnostics.whole_run_spectral_cache import (
+    WholeRunSpectralCacheStats,
+    WholeRunSpectralChunk,
+)
+from vibesensor.use_cases.diagnostics.whole_run_spectral_projection import (
+    whole_run_window_spectral_summaries_from_jsonl_bytes,
+    whole_run_window_spectral_summaries_to_jsonl_bytes,
+)
+
+LOGGER = logging.getLogger(__name__)
+
+WHOLE_RUN_SPECTRAL_CACHE_DIR_NAME = "whole-run-spectral-cache"
+WHOLE_RUN_SPECTRAL_CACHE_MAX_BYTES = 256 * 1024 * 1024
+
+_FREQ_FILE_NAME = "freq.f64.npy"
+_ROWS_FILE_NAME = "combined_spectrum.f32.npy"
+_SUMMARIES_FILE_NAME = "windows.jsonl"
+_TMP_PREFIX = ".tmp-"
+
+
+class FileWholeRunSpectralChunkCache:
+    """LRU spectral chunk cache stored under one directory with a byte budget."""
+
+    __slots__ = (
+        "_entries",
+        "_hits",
+        "_lock",
+        "_max_bytes",
+        "_misses",
+        "_root_dir",
+        "_total_bytes",
+    )
+
+    def __init__(
+        self,
+        *,
+        root_dir: Path,
+        max_bytes: int = WHOLE_RUN_SPECTRAL_CACHE_MAX_BYTES,
+    ) -> None:
+        self._root_dir = root_dir
+        self._max_bytes = max(0, int(max_bytes))
+        self._lock = RLock()
+        self._entries: OrderedDict[str, int] = OrderedDict()
+        self._total_bytes = 0
+        self._hits = 0
+        self._misses = 0
+        self._scan()
+
+    def stats(self) -> WholeRunSpectralCacheStats:
+        """Return cache size statistics for telemetry and diagnostics."""
+        with self._lock:
+            return WholeRunSpectralCacheStats(
+                entry_count=len(self._entries),
+                total_bytes=self._total_bytes,
+                max_bytes=self._max_bytes,
+                hits=self._hits,
+                misses=self._misses,
+            )
+
+    def load(self, key: str) -> WholeRunSpectralChunk | None:
+        """Return a cached chunk with memory-mapped arrays and refresh its LRU position."""
+        with self._lock:
+            if key not in self._entries:
+                self._misses += 1
+                return None
+            self._entries.move_to_end(key)
+        entry_dir = self._root_dir / key
+        try:
+            chunk = WholeRunSpectralChunk(
+                freq_hz=np.load(entry_dir / _FREQ_FILE_NAME, mmap_mode="r", allow_pickle=False),
+                spectrum_rows=np.load(
+                    entry_dir / _ROWS_FILE_NAME,
+                    mmap_mode="r",
+                    allow_pickle=False,
+                ),
+                summaries=whole_run_window_spectral_summaries_from_jsonl_bytes(
+                    (entry_dir / _SUMMARIES_FILE_NAME).read_bytes()
+                ),
+            )
+            os.utime(entry_dir)
+        except (OSError, ValueError):
+            LOGGER.warning("Dropping unreadable whole-run spectral cache entry %s", key)
+            with self._lock:
+                self._forget(key)
+                self._misses += 1
+            shutil.rmtree(entry_dir, ignore_errors=True)
+            return None
+        with self._lock:
+            self._hits += 1
+        return chunk
+
+    def store(self, key: str, chunk: WholeRunSpectralChunk) -> None:
+        """Persist *chunk* under *key* and evict least-recently-used entries over budget."""
+        entry_dir = self._root_dir / key
+        tmp_dir = self._root_dir / f"{_TMP_PREFIX}{uuid.uuid4().hex}"
+        try:
+            tmp_dir.mkdir(parents=True)
+            np.save(tmp_dir / _FREQ_FILE_NAME, np.asarray(chunk.freq_hz), allow_pickle=False)
+            np.save(
+                tmp_dir / _ROWS_FILE_NAME,
+                np.ascontiguousarray(chunk.spectrum_rows),
+                allow_pickle=False,
+            )
+            (tmp_dir / _SUMMARIES_FILE_NAME).write_bytes(
+                whole_run_window_spectral_summaries_to_jsonl_bytes(chunk.summaries)
+            )
+            size_bytes = _dir_size_bytes(tmp_dir)
+            if size_bytes > self._max_bytes:
+                shutil.rmtree(tmp_dir, ignore_errors=True)
+                return
+            with self._lock:
+                if key in self._entries:
+                    shutil.rmtree(tmp_dir, ignore_errors=True)
+                    self._entries.move_to_end(key)
+                    return
+                os.replace(tmp_dir, entry_dir)
+                self._entries[key] = size_bytes
+                self._total_bytes += size_bytes
+                evicted = self._evict_over_budget()
+        except OSError:
+            LOGGER.warning("Failed to store whole-run spectral cache entry %s", key, exc_info=True)
+            shutil.rmtree(tmp_dir, ignore_errors=True)
+            return
+        for evicted_key in evicted:
+            shutil.rmtree(self._root_dir / evicted_key, ignore_errors=True)
+
+    def _evict_over_budget(self) -> list[str]:
+        evicted: list[str] = []
+        while self._entries and self._total_bytes > self._max_bytes:
+            evicted_key, evicted_size = self._entries.popitem(last=False)
+            self._total_bytes -= evicted_size
+            evicted.append(evicted_key)
+        return evicted
+
+    def _forget(self, key: str) -> None:
+        size_bytes = self._entries.pop(key, None)
+        if size_bytes is not None:
+            self._total_bytes -= size_bytes
+
+    def _scan(self) -> None:
+        """Rebuild the LRU index from disk, oldest mtime first."""
+        if not self._root_dir.is_dir():
+            return
+        found: list[tuple[float, str, int]] = []
+        for entry_dir in self._root_dir.iterdir():
+            if not entry_dir.is_dir():
+                continue
+            if entry_dir.name.startswith(_TMP_PREFIX):
+                shutil.rmtree(entry_dir, ignore_errors=True)
+                continue
+            try:
+                found.append(
+                    (entry_dir.stat().st_mtime, entry_dir.name, _dir_size_bytes(entry_dir))
+                )
+            except OSError:
+                continue
+        for _mtime, key, size_bytes in sorted(found):
+            self._entries[key] = size_bytes
+            self._total_bytes += size_bytes
+        for evicted_key in self._evict_over_budget():
+            shutil.rmtree(self._root_dir / evicted_key, ignore_errors=True)
+
+
+def _dir_size_bytes(path: Path) -> int:
+    return sum(child.stat().st_size for child in path.iterdir() if child.is_file())
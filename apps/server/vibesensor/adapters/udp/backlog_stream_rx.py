@@ -0,0 +1,126 @@
+"""TCP backlog stream receiver — bulk replay of queued sensor frames.
+
+A node whose frame queue grows past its replay threshold opens one TCP
+connection to ``udp.backlog_stream_port`` and streams its oldest frames
+there, while live frames keep arriving over UDP.  Each record is a
+little-endian ``u16`` length followed by one DATA packet, and each record
+is answered with a DATA_ACK on the same connection.  The node bounds how
+many records it keeps unacknowledged, which is the stream's flow control.
+
+Records are dispatched exactly like UDP datagrams, so the client's dedup
+window and sequence bookkeeping merge both paths by seq.
+
+A node that vanishes without closing the connection (power loss, Wi-Fi drop)
+leaves no FIN behind, so a stream that stays silent for
+``BACKLOG_STREAM_IDLE_TIMEOUT_S`` is closed rather than held open forever.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import contextlib
+import logging
+from typing import Protocol
+
+from vibesensor.adapters.udp.protocol import (
+    STREAM_RECORD_PREFIX,
+    STREAM_RECORD_PREFIX_BYTES,
+    DataMessage,
+    pack_data_ack,
+)
+
+__all__ = [
+    "BACKLOG_STREAM_IDLE_TIMEOUT_S",
+    "BacklogStreamConnection",
+    "ReplayDispatcher",
+    "start_backlog_stream_server",
+]
+
+LOGGER = logging.getLogger(__name__)
+
+# The node keeps records in flight until the backlog is acknowledged, so a
+# healthy stream is never quiet for long; this only reaps dead peers.
+BACKLOG_STREAM_IDLE_TIMEOUT_S = 10.0
+
+
+class ReplayDispatcher(Protocol):
+    def process_replayed_packet(
+        self,
+        data: bytes,
+        addr: tuple[str, int],
+    ) -> DataMessage | None: ...
+
+
+class BacklogStreamConnection:
+    """Read length-prefixed DATA records from one node and ACK each in-stream."""
+
+    __slots__ = ("_addr", "_dispatcher", "_idle_timeout_s", "_reader", "_writer", "records")
+
+    def __init__(
+        self,
+        dispatcher: ReplayDispatcher,
+        reader: asyncio.StreamReader,
+        writer: asyncio.StreamWriter,
+        *,
+        idle_timeout_s: float = BACKLOG_STREAM_IDLE_TIMEOUT_S,
+    ) -> None:
+        self._dispatcher = dispatcher
+        self._reader = reader
+        self._writer = writer
+        self._idle_timeout_s = idle_timeout_s
+        peer = writer.get_extra_info("peername")
+        self._addr: tuple[str, int] = (
+            (str(peer[0]), int(peer[1])) if isinstance(peer, tuple) else ("", 0)
+        )
+        self.records = 0
+
+    async def _read(self, n: int) -> bytes:
+        return await asyncio.wait_for(self._reader.readexactly(n), self._idle_timeout_s)
+
+    async def run(self) -> None:
+        """Dispatch records until the node closes the stream, breaks framing or goes idle."""
+        try:
+            while True:
+                try:
+                    prefix = await self._read(STREAM_RECORD_PREFIX_BYTES)
+                    (length,) = STREAM_RECORD_PREFIX.unpack(prefix)
+                    packet = await self._read(length)
+                except asyncio.IncompleteReadError:
+                    return
+                except TimeoutError:
+                    LOGGER.info("Closing idle backlog stream from %s", self._addr)
+                    return
+                msg = self._dispatcher.process_replayed_packet(packet, self._addr)
+                if msg is None:
+                    # Unlike a lost datagram, an unparsable record means the two
+                    # ends disagree on framing; the node falls back to UDP.
+                    LOGGER.warning("Closing backlog stream from %s: bad record", self._addr)
+                    return
+                self.records += 1
+                self._writer.write(pack_data_ack(msg.client_id, msg.seq))
+                await self._writer.drain()
+                # Replay is bulk work: let queued live datagrams go first.
+                await asyncio.sleep(0)
+        except ConnectionError:
+            LOGGER.debug("Backlog stream from %s reset", self._addr, exc_info=True)
+        finally:
+            self._writer.close()
+            with contextlib.suppress(ConnectionError):
+                await self._writer.wait_closed()
+
+
+async def start_backlog_stream_server(
+    host: str,
+    port: int,
+    dispatcher: ReplayDispatcher,
+    *,
+    idle_timeout_s: float = BACKLOG_STREAM_IDLE_TIMEOUT_S,
+) -> asyncio.Server:
+    """Listen for backlog streams and dispatch their records through *dispatcher*."""
+
+    async def _handle(reader: asyncio.StreamReader, writer: asyncio.StreamWriter) -> None:
+        await BacklogStreamConnection(
+            dispatcher, reader, writer, idle_timeout_s=idle_timeout_s
+        ).run()
+
+    return await asyncio.start_server(_handle, host=host, port=port)
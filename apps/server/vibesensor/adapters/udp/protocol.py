@@ -20,10 +20,12 @@ from vibesensor.adapters.udp.protocol_packing import (
     pack_ack_sync_clock,
     pack_cmd_identify,
     pack_cmd_sync_clock,
+    pack_cmd_tx_slot,
     pack_data,
     pack_data_ack,
     pack_hello,
     pack_hello_ack,
+    pack_stream_record,
 )
 from vibesensor.adapters.udp.protocol_parsing import (
     parse_ack,
@@ -37,7 +39,14 @@ from vibesensor.adapters.udp.protocol_wire import (
     ACK_SYNC_CLOCK_BYTES,
     ACK_SYNC_CLOCK_STRUCT,
     HELLO_ACK_BYTES,
+    HELLO_ACK_RECEIPTS_BYTES,
     HELLO_CAP_EXPLICIT_ACK,
+    HELLO_CAP_PULSE_CHANNEL,
+    HELLO_CAP_RANGE_TAG,
+    HELLO_CAP_RESUME_RECEIPTS,
+    HELLO_CAP_TSF_TIMEBASE,
+    HELLO_CAP_TX_SLOTS,
+    SERVER_HELLO_CAPABILITIES,
 )
 
 ACK_BYTES = _wire.ACK_BYTES
@@ -52,19 +61,34 @@ CMD_IDENTIFY_STRUCT = _wire.CMD_IDENTIFY_STRUCT
 CMD_SYNC_CLOCK = _wire.CMD_SYNC_CLOCK
 CMD_SYNC_CLOCK_BYTES = _wire.CMD_SYNC_CLOCK_BYTES
 CMD_SYNC_CLOCK_STRUCT = _wire.CMD_SYNC_CLOCK_STRUCT
+CMD_TX_SLOT = _wire.CMD_TX_SLOT
+CMD_TX_SLOT_BYTES = _wire.CMD_TX_SLOT_BYTES
+CMD_TX_SLOT_STRUCT = _wire.CMD_TX_SLOT_STRUCT
 DATA_ACK_BYTES = _wire.DATA_ACK_BYTES
 DATA_ACK_STRUCT = _wire.DATA_ACK_STRUCT
+DATA_CHANNEL_WHEEL_PULSE = _wire.DATA_CHANNEL_WHEEL_PULSE
 DATA_HEADER = _wire.DATA_HEADER
 DATA_HEADER_BYTES = _wire.DATA_HEADER_BYTES
+DATA_PULSE_CHANNEL = _wire.DATA_PULSE_CHANNEL
+DATA_PULSE_CHANNEL_BYTES = _wire.DATA_PULSE_CHANNEL_BYTES
+DATA_PULSE_NO_EDGE = _wire.DATA_PULSE_NO_EDGE
+DATA_RANGE_TAG_BYTES = _wire.DATA_RANGE_TAG_BYTES
+DATA_RANGE_TAG_CLIPPED = _wire.DATA_RANGE_TAG_CLIPPED
+DATA_RANGE_TAG_FULL_RES = _wire.DATA_RANGE_TAG_FULL_RES
+DATA_RANGE_TAG_RANGE_MASK = _wire.DATA_RANGE_TAG_RANGE_MASK
+HELLO_ACK_RECEIPTS_STRUCT = _wire.HELLO_ACK_RECEIPTS_STRUCT
 HELLO_ACK_STRUCT = _wire.HELLO_ACK_STRUCT
 HELLO_BASE = _wire.HELLO_BASE
 HELLO_FIXED_BYTES = _wire.HELLO_FIXED_BYTES
+HELLO_RESUME_BYTES = _wire.HELLO_RESUME_BYTES
 MSG_ACK = _wire.MSG_ACK
 MSG_CMD = _wire.MSG_CMD
 MSG_DATA = _wire.MSG_DATA
 MSG_DATA_ACK = _wire.MSG_DATA_ACK
 MSG_HELLO = _wire.MSG_HELLO
 MSG_HELLO_ACK = _wire.MSG_HELLO_ACK
+STREAM_RECORD_PREFIX = _wire.STREAM_RECORD_PREFIX
+STREAM_RECORD_PREFIX_BYTES = _wire.STREAM_RECORD_PREFIX_BYTES
 VERSION = _wire.VERSION
 
 __all__ = [
@@ -75,9 +99,16 @@ __all__ = [
     "DataAckMessage",
     "DataMessage",
     "HELLO_ACK_BYTES",
+    "HELLO_ACK_RECEIPTS_BYTES",
     "HELLO_CAP_EXPLICIT_ACK",
+    "HELLO_CAP_PULSE_CHANNEL",
+    "HELLO_CAP_RANGE_TAG",
+    "HELLO_CAP_RESUME_RECEIPTS",
+    "HELLO_CAP_TSF_TIMEBASE",
+    "HELLO_CAP_TX_SLOTS",
     "HelloMessage",
     "HelloAckMessage",
+    "SERVER_HELLO_CAPABILITIES",
     "client_id_hex",
     "client_id_mac",
     "extract_client_id_hex",
@@ -85,10 +116,12 @@ __all__ = [
     "pack_ack_sync_clock",
     "pack_cmd_identify",
     "pack_cmd_sync_clock",
+    "pack_cmd_tx_slot",
     "pack_data",
     "pack_data_ack",
     "pack_hello",
     "pack_hello_ack",
+    "pack_stream_record",
     "parse_ack",
     "parse_client_id",
     "parse_cmd",
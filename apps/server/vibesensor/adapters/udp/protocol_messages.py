@@ -22,17 +22,31 @@ class HelloMessage:
     frame_samples: int = 0
     queue_overflow_drops: int = 0
     capabilities: int = 0
+    oldest_pending_seq: int | None = None
+    boot_id: int | None = None
 
 
 @dataclass(slots=True)
 class DataMessage:
-    """Decoded DATA message containing one frame of accelerometer samples."""
+    """Decoded DATA message containing one frame of accelerometer samples.
+
+    ``samples`` are always ADXL345 full-resolution counts. ``range_g`` and
+    ``clipped`` come from the optional range tag and stay ``None``/``False``
+    for untagged frames.  ``pulse_edge_count`` (wrapping at 16 bits) and
+    ``pulse_last_edge_offset_us`` (latest edge relative to ``t0_us``) come from
+    the optional wheel pulse channel; the offset is also ``None`` while the
+    node has no edge to report.
+    """
 
     client_id: bytes
     seq: int
     t0_us: int
     sample_count: int
     samples: np.ndarray
+    range_g: int | None = None
+    clipped: bool = False
+    pulse_edge_count: int | None = None
+    pulse_last_edge_offset_us: int | None = None
 
 
 @dataclass(slots=True)
@@ -66,9 +80,17 @@ class DataAckMessage:
 
 @dataclass(slots=True)
 class HelloAckMessage:
-    """Decoded HELLO_ACK message: server acknowledgment of HELLO receipt."""
+    """Decoded HELLO_ACK message: server acknowledgment of HELLO receipt.
+
+    ``capabilities`` echoes the HELLO capabilities the server accepted.
+    ``contiguous_seq`` and ``receipt_bitmap`` are only present in the extended
+    form answering a HELLO that reported its oldest pending seq.
+    """
 
     client_id: bytes
+    capabilities: int = 0
+    contiguous_seq: int | None = None
+    receipt_bitmap: int = 0
 
 
 def client_id_hex(client_id: bytes) -> str:
@@ -20,11 +20,18 @@ from vibesensor.adapters.udp.protocol_wire import (
     CMD_IDENTIFY_STRUCT,
     CMD_SYNC_CLOCK,
     CMD_SYNC_CLOCK_STRUCT,
+    CMD_TX_SLOT,
+    CMD_TX_SLOT_STRUCT,
     DATA_ACK_STRUCT,
+    DATA_CHANNEL_WHEEL_PULSE,
     DATA_HEADER,
+    DATA_PULSE_CHANNEL,
+    DATA_PULSE_NO_EDGE,
+    HELLO_ACK_RECEIPTS_STRUCT,
     HELLO_ACK_STRUCT,
     HELLO_BASE,
     HELLO_CAP_EXPLICIT_ACK,
+    HELLO_CAP_RESUME_RECEIPTS,
     MSG_ACK,
     MSG_CMD,
     MSG_DATA,
@@ -32,6 +39,7 @@ from vibesensor.adapters.udp.protocol_wire import (
     MSG_HELLO,
     MSG_HELLO_ACK,
     SAMPLE_DTYPE,
+    STREAM_RECORD_PREFIX,
 )
 
 
@@ -44,9 +52,18 @@ def pack_hello(
     firmware_version: str = "",
     queue_overflow_drops: int = 0,
     capabilities: int = HELLO_CAP_EXPLICIT_ACK,
+    oldest_pending_seq: int | None = None,
+    boot_id: int = 0,
 ) -> bytes:
-    """Encode a HELLO message as bytes."""
+    """Encode a HELLO message as bytes.
+
+    Passing *oldest_pending_seq* sets ``HELLO_CAP_RESUME_RECEIPTS`` and appends
+    the seq and *boot_id*, asking for a HELLO_ACK that carries the server's
+    receipt state for that boot.
+    """
     validate_client_id(client_id)
+    if oldest_pending_seq is not None:
+        capabilities |= HELLO_CAP_RESUME_RECEIPTS
     name_bytes = name.encode("utf-8")[:HELLO_MAX_NAME_BYTES]
     fw_bytes = firmware_version.encode("utf-8")[:HELLO_MAX_NAME_BYTES]
     header = HELLO_BASE.pack(
@@ -58,7 +75,7 @@ def pack_hello(
         frame_samples,
         len(name_bytes),
     )
-    return (
+    packet = (
         header
         + name_bytes
         + bytes([len(fw_bytes)])
@@ -66,14 +83,42 @@ def pack_hello(
         + struct.pack("<I", int(max(0, queue_overflow_drops)))
         + bytes([capabilities & 0xFF])
     )
+    if oldest_pending_seq is not None:
+        packet += struct.pack(
+            "<II", int(oldest_pending_seq) & 0xFFFFFFFF, int(boot_id) & 0xFFFFFFFF
+        )
+    return packet
 
 
-def pack_data(client_id: bytes, seq: int, t0_us: int, samples: np.ndarray) -> bytes:
-    """Encode a DATA message as bytes from an (N, 3) int16 samples array."""
+def pack_data(
+    client_id: bytes,
+    seq: int,
+    t0_us: int,
+    samples: np.ndarray,
+    *,
+    range_tag: int | None = None,
+    pulse: tuple[int, int | None] | None = None,
+) -> bytes:
+    """Encode a DATA message as bytes from an (N, 3) int16 samples array.
+
+    *range_tag* appends the optional one-byte range tag trailer.  *pulse*
+    appends the wheel pulse channel after it as ``(edge_count,
+    last_edge_offset_us)``, with ``None`` for "no edge to report".
+    """
     samples_int16 = np.asarray(samples, dtype=SAMPLE_DTYPE)
     sample_count = validate_samples_array(samples_int16)
     header = DATA_HEADER.pack(MSG_DATA, VERSION, client_id, seq, t0_us, sample_count)
-    return bytes(header + samples_int16.tobytes(order="C"))
+    trailer = b"" if range_tag is None else bytes((range_tag & 0xFF,))
+    if pulse is not None:
+        if range_tag is None:
+            raise ValueError("pack_data: the pulse channel follows the range tag")
+        edge_count, last_edge_offset_us = pulse
+        trailer += DATA_PULSE_CHANNEL.pack(
+            DATA_CHANNEL_WHEEL_PULSE,
+            edge_count & 0xFFFF,
+            DATA_PULSE_NO_EDGE if last_edge_offset_us is None else last_edge_offset_us,
+        )
+    return bytes(header + samples_int16.tobytes(order="C") + trailer)
 
 
 def pack_cmd_identify(client_id: bytes, cmd_seq: int, duration_ms: int) -> bytes:
@@ -112,10 +157,57 @@ def pack_cmd_sync_clock(
     )
 
 
-def pack_hello_ack(client_id: bytes) -> bytes:
-    """Encode a HELLO_ACK message as bytes."""
+def pack_cmd_tx_slot(
+    client_id: bytes,
+    cmd_seq: int,
+    *,
+    slot_offset_us: int,
+    slot_period_us: int,
+    slot_width_us: int,
+) -> bytes:
+    """Encode a CMD_TX_SLOT command as bytes.
+
+    A zero ``slot_period_us`` withdraws the assignment (contention access).
+    """
+    validate_cmd_seq(cmd_seq)
+    u32_max = (1 << 32) - 1
+    return CMD_TX_SLOT_STRUCT.pack(
+        MSG_CMD,
+        VERSION,
+        client_id,
+        CMD_TX_SLOT,
+        cmd_seq,
+        max(0, min(u32_max, int(slot_offset_us))),
+        max(0, min(u32_max, int(slot_period_us))),
+        max(0, min(u32_max, int(slot_width_us))),
+    )
+
+
+def pack_hello_ack(
+    client_id: bytes,
+    capabilities: int,
+    receipts: tuple[int, int] | None = None,
+) -> bytes:
+    """Encode a HELLO_ACK message as bytes.
+
+    *capabilities* echoes the HELLO capabilities the server accepted.
+    *receipts* is ``(contiguous_seq, receipt_bitmap)``; when given,
+    ``HELLO_CAP_RESUME_RECEIPTS`` is set and the extended form is sent so the
+    sensor can release frames the server already has.  Firmware that predates
+    either reads only the leading fields.
+    """
     validate_client_id(client_id)
-    return HELLO_ACK_STRUCT.pack(MSG_HELLO_ACK, VERSION, client_id)
+    if receipts is None:
+        return HELLO_ACK_STRUCT.pack(MSG_HELLO_ACK, VERSION, client_id, capabilities & 0xFF)
+    contiguous_seq, receipt_bitmap = receipts
+    return HELLO_ACK_RECEIPTS_STRUCT.pack(
+        MSG_HELLO_ACK,
+        VERSION,
+        client_id,
+        (capabilities | HELLO_CAP_RESUME_RECEIPTS) & 0xFF,
+        int(contiguous_seq) & 0xFFFFFFFF,
+        int(receipt_bitmap) & 0xFFFFFFFF,
+    )
 
 
 def pack_ack(client_id: bytes, cmd_seq: int, status: int = 0) -> bytes:
@@ -148,3 +240,10 @@ def pack_ack_sync_clock(
 def pack_data_ack(client_id: bytes, last_seq_received: int) -> bytes:
     """Encode a DATA_ACK message as bytes."""
     return DATA_ACK_STRUCT.pack(MSG_DATA_ACK, VERSION, client_id, last_seq_received & 0xFFFFFFFF)
+
+
+def pack_stream_record(packet: bytes) -> bytes:
+    """Frame one DATA packet as a backlog-stream record (length prefix + packet)."""
+    if len(packet) > 0xFFFF:
+        raise ValueError(f"stream record too long: {len(packet)} bytes")
+    return STREAM_RECORD_PREFIX.pack(len(packet)) + packet
@@ -34,13 +34,25 @@ from vibesensor.adapters.udp.protocol_wire import (
     CMD_HEADER_BYTES,
     CMD_IDENTIFY,
     CMD_SYNC_CLOCK,
+    CMD_TX_SLOT,
     DATA_ACK_BYTES,
     DATA_ACK_STRUCT,
+    DATA_CHANNEL_WHEEL_PULSE,
     DATA_HEADER,
     DATA_HEADER_BYTES,
+    DATA_PULSE_CHANNEL,
+    DATA_PULSE_CHANNEL_BYTES,
+    DATA_PULSE_NO_EDGE,
+    DATA_RANGE_TAG_BYTES,
+    DATA_RANGE_TAG_CLIPPED,
+    DATA_RANGE_TAG_FULL_RES,
+    DATA_RANGE_TAG_RANGE_MASK,
     HELLO_ACK_BYTES,
+    HELLO_ACK_RECEIPTS_BYTES,
     HELLO_ACK_STRUCT,
     HELLO_BASE,
+    HELLO_CAP_RESUME_RECEIPTS,
+    HELLO_RESUME_BYTES,
     MSG_ACK,
     MSG_CMD,
     MSG_DATA,
@@ -129,6 +141,13 @@ def parse_hello(data: bytes) -> HelloMessage:
     if len(data) < offset + 1:
         raise _ProtocolError("HELLO missing capabilities")
     capabilities = data[offset]
+    offset += 1
+    oldest_pending_seq: int | None = None
+    boot_id: int | None = None
+    if capabilities & HELLO_CAP_RESUME_RECEIPTS:
+        if len(data) < offset + HELLO_RESUME_BYTES:
+            raise _ProtocolError("HELLO missing oldest_pending_seq/boot_id")
+        oldest_pending_seq, boot_id = struct.unpack_from("<II", data, offset)
 
     return HelloMessage(
         client_id=client_id,
@@ -139,6 +158,8 @@ def parse_hello(data: bytes) -> HelloMessage:
         firmware_version=firmware_version,
         queue_overflow_drops=queue_overflow_drops,
         capabilities=capabilities,
+        oldest_pending_seq=oldest_pending_seq,
+        boot_id=boot_id,
     )
 
 
@@ -152,11 +173,22 @@ def parse_data(data: bytes) -> DataMessage:
         expected_msg_type=MSG_DATA,
     )
     _msg_type, _version, client_id, seq, t0_us, sample_count = header
-    validate_data_frame(
+    # A channel record only ever follows the range tag.
+    frame_length = len(data)
+    has_pulse_channel = frame_length == (
+        DATA_HEADER_BYTES
+        + sample_count * BYTES_PER_SAMPLE
+        + DATA_RANGE_TAG_BYTES
+        + DATA_PULSE_CHANNEL_BYTES
+    )
+    if has_pulse_channel:
+        frame_length -= DATA_PULSE_CHANNEL_BYTES
+    has_range_tag = validate_data_frame(
         sample_count=sample_count,
-        data_length=len(data),
+        data_length=frame_length,
         header_bytes=DATA_HEADER_BYTES,
         bytes_per_sample=BYTES_PER_SAMPLE,
+        trailer_bytes=DATA_RANGE_TAG_BYTES,
     )
 
     samples = np.frombuffer(
@@ -165,6 +197,24 @@ def parse_data(data: bytes) -> DataMessage:
         count=sample_count * ACCEL_AXES,
         offset=DATA_HEADER_BYTES,
     ).reshape(sample_count, ACCEL_AXES)
+    range_g: int | None = None
+    clipped = False
+    if has_range_tag:
+        range_tag = data[frame_length - 1]
+        range_g = 2 << (range_tag & DATA_RANGE_TAG_RANGE_MASK)
+        clipped = bool(range_tag & DATA_RANGE_TAG_CLIPPED)
+        if not range_tag & DATA_RANGE_TAG_FULL_RES:
+            samples = _fixed_res_to_full_res_counts(samples, range_g)
+    pulse_edge_count: int | None = None
+    pulse_last_edge_offset_us: int | None = None
+    if has_pulse_channel:
+        channel_type, pulse_edge_count, last_edge_offset_us = DATA_PULSE_CHANNEL.unpack_from(
+            data, frame_length
+        )
+        if channel_type != DATA_CHANNEL_WHEEL_PULSE:
+            raise _ProtocolError(f"DATA has unsupported channel type={channel_type}")
+        if last_edge_offset_us != DATA_PULSE_NO_EDGE:
+            pulse_last_edge_offset_us = last_edge_offset_us
     samples.setflags(write=False)
     return DataMessage(
         client_id=client_id,
@@ -172,9 +222,25 @@ def parse_data(data: bytes) -> DataMessage:
         t0_us=t0_us,
         sample_count=sample_count,
         samples=samples,
+        range_g=range_g,
+        clipped=clipped,
+        pulse_edge_count=pulse_edge_count,
+        pulse_last_edge_offset_us=pulse_last_edge_offset_us,
     )
 
 
+def _fixed_res_to_full_res_counts(samples: np.ndarray, range_g: int) -> np.ndarray:
+    """Rescale 10-bit fixed-resolution counts to full-resolution counts.
+
+    Fixed resolution reads ``range_g * 2 / 1024`` g/LSB against the ~3.9 mg/LSB
+    (1/256 g) of full resolution, an exact integer ratio of ``range_g / 2``.
+    """
+    ratio = range_g // 2
+    if ratio == 1:
+        return samples
+    return samples * np.int16(ratio)
+
+
 def parse_cmd(data: bytes) -> CmdMessage:
     """Decode a raw CMD message into a :class:`CmdMessage`."""
     validate_minimum_size(label="CMD", data_length=len(data), minimum=CMD_HEADER_BYTES)
@@ -185,7 +251,7 @@ def parse_cmd(data: bytes) -> CmdMessage:
         expected_msg_type=MSG_CMD,
     )
     _msg_type, _version, client_id, cmd_id, cmd_seq = header
-    if cmd_id not in (CMD_IDENTIFY, CMD_SYNC_CLOCK):
+    if cmd_id not in (CMD_IDENTIFY, CMD_SYNC_CLOCK, CMD_TX_SLOT):
         raise _ProtocolError(f"CMD has unsupported cmd_id={cmd_id}")
     params = data[CMD_HEADER_BYTES:]
     return CmdMessage(client_id=client_id, cmd_id=cmd_id, cmd_seq=cmd_seq, params=params)
@@ -193,17 +259,27 @@ def parse_cmd(data: bytes) -> CmdMessage:
 
 def parse_hello_ack(data: bytes) -> HelloAckMessage:
     """Decode a raw HELLO_ACK message into a :class:`HelloAckMessage`."""
-    validate_fixed_message_size(
-        label="HELLO_ACK", data_length=len(data), expected_size=HELLO_ACK_BYTES
-    )
+    if len(data) not in (HELLO_ACK_BYTES, HELLO_ACK_RECEIPTS_BYTES):
+        raise _ProtocolError(
+            "HELLO_ACK has unexpected size "
+            f"{len(data)} bytes (expected {HELLO_ACK_BYTES} or {HELLO_ACK_RECEIPTS_BYTES})"
+        )
     header = HELLO_ACK_STRUCT.unpack_from(data, 0)
     _validate_unpacked_header(
         label="HELLO_ACK",
         header_fields=header,
         expected_msg_type=MSG_HELLO_ACK,
     )
-    _msg_type, _version, client_id = header
-    return HelloAckMessage(client_id=client_id)
+    _msg_type, _version, client_id, capabilities = header
+    if len(data) == HELLO_ACK_RECEIPTS_BYTES and capabilities & HELLO_CAP_RESUME_RECEIPTS:
+        contiguous_seq, receipt_bitmap = struct.unpack_from("<II", data, HELLO_ACK_BYTES)
+        return HelloAckMessage(
+            client_id=client_id,
+            capabilities=capabilities,
+            contiguous_seq=contiguous_seq,
+            receipt_bitmap=receipt_bitmap,
+        )
+    return HelloAckMessage(client_id=client_id, capabilities=capabilities)
 
 
 def parse_ack(data: bytes) -> AckMessage:
@@ -54,17 +54,22 @@ def validate_data_frame(
     data_length: int,
     header_bytes: int,
     bytes_per_sample: int,
-) -> None:
-    """Validate DATA message sample count and payload size."""
+    trailer_bytes: int = 0,
+) -> bool:
+    """Validate DATA message sample count and payload size.
+
+    Returns whether the optional *trailer_bytes* trailer is present.
+    """
     if sample_count > MAX_SAMPLE_COUNT:
         raise ProtocolError(f"DATA sample_count {sample_count} exceeds maximum {MAX_SAMPLE_COUNT}")
     if sample_count == 0:
         raise ProtocolError("DATA sample_count must not be zero")
     expected_len = header_bytes + sample_count * bytes_per_sample
-    if data_length != expected_len:
-        raise ProtocolError(
-            f"DATA payload size mismatch: expected {expected_len}, got {data_length}"
-        )
+    if data_length == expected_len:
+        return False
+    if trailer_bytes > 0 and data_length == expected_len + trailer_bytes:
+        return True
+    raise ProtocolError(f"DATA payload size mismatch: expected {expected_len}, got {data_length}")
 
 
 def validate_hello_sample_rate(sample_rate_hz: int) -> None:
@@ -18,9 +18,41 @@ MSG_DATA_ACK = 5
 MSG_HELLO_ACK = 6
 
 HELLO_CAP_EXPLICIT_ACK = 1 << 0
+HELLO_CAP_TSF_TIMEBASE = 1 << 1
+HELLO_CAP_TX_SLOTS = 1 << 2
+HELLO_CAP_RANGE_TAG = 1 << 3
+HELLO_CAP_RESUME_RECEIPTS = 1 << 4
+HELLO_CAP_PULSE_CHANNEL = 1 << 5
+# Capabilities this server implements; HELLO_ACK echoes the HELLO's
+# capabilities masked by these, and firmware only sends an optional DATA
+# trailer once the echo carries its bit.
+SERVER_HELLO_CAPABILITIES = (
+    HELLO_CAP_EXPLICIT_ACK
+    | HELLO_CAP_TSF_TIMEBASE
+    | HELLO_CAP_TX_SLOTS
+    | HELLO_CAP_RANGE_TAG
+    | HELLO_CAP_RESUME_RECEIPTS
+    | HELLO_CAP_PULSE_CHANNEL
+)
+
+# Optional one-byte DATA trailer: ADXL345 range code (+/-2 g << code) in
+# bits 0-1, FULL_RES in bit 2, "a sample sat on the range rail" in bit 7.
+DATA_RANGE_TAG_BYTES = 1
+DATA_RANGE_TAG_RANGE_MASK = 0x03
+DATA_RANGE_TAG_FULL_RES = 1 << 2
+DATA_RANGE_TAG_CLIPPED = 1 << 7
+
+# Optional DATA channel record after the range tag: a channel type byte and
+# that channel's fixed-size reading.  The wheel pulse channel carries the
+# running input edge count (u16, wrapping) and the latest edge's offset from
+# t0_us (i32 us, DATA_PULSE_NO_EDGE when there is none to report).
+DATA_CHANNEL_WHEEL_PULSE = 1
+DATA_PULSE_CHANNEL = struct.Struct("<BHi")
+DATA_PULSE_NO_EDGE = -(1 << 31)
 
 CMD_IDENTIFY = 1
 CMD_SYNC_CLOCK = 2
+CMD_TX_SLOT = 3
 
 CLIENT_ID_OFFSET = 2
 
@@ -29,20 +61,36 @@ DATA_HEADER = struct.Struct("<BB6sIQH")
 ACK_STRUCT = struct.Struct("<BB6sIB")
 ACK_SYNC_CLOCK_STRUCT = struct.Struct("<BB6sIBQQ")
 DATA_ACK_STRUCT = struct.Struct("<BB6sI")
-HELLO_ACK_STRUCT = struct.Struct("<BB6s")
+# HELLO_ACK ends with the accepted-capabilities echo; servers that predate it
+# sent only the header, which firmware reads as accepting nothing.
+HELLO_ACK_STRUCT = struct.Struct("<BB6sB")
+# HELLO_ACK extended with the server's receipt state for the sender's backlog:
+# highest contiguous seq, then bit i set when seq contiguous + 2 + i arrived.
+HELLO_ACK_RECEIPTS_STRUCT = struct.Struct("<BB6sBII")
 CMD_HEADER = struct.Struct("<BB6sBI")
 CMD_IDENTIFY_STRUCT = struct.Struct("<BB6sBIH")
 CMD_SYNC_CLOCK_STRUCT = struct.Struct("<BB6sBIQqI")
+CMD_TX_SLOT_STRUCT = struct.Struct("<BB6sBIIII")
+# Backlog stream (TCP): every record is this little-endian length followed by
+# one DATA packet; the server answers each record with a DATA_ACK in-stream.
+STREAM_RECORD_PREFIX = struct.Struct("<H")
 
 HELLO_FIXED_BYTES = HELLO_BASE.size + 1 + 4 + 1
+# Trailing oldest-pending seq and boot id, present when
+# HELLO_CAP_RESUME_RECEIPTS is set.
+HELLO_RESUME_BYTES = 4 + 4
 DATA_HEADER_BYTES: int = DATA_HEADER.size
 ACK_BYTES: int = ACK_STRUCT.size
 ACK_SYNC_CLOCK_BYTES: int = ACK_SYNC_CLOCK_STRUCT.size
 DATA_ACK_BYTES: int = DATA_ACK_STRUCT.size
 HELLO_ACK_BYTES: int = HELLO_ACK_STRUCT.size
+HELLO_ACK_RECEIPTS_BYTES: int = HELLO_ACK_RECEIPTS_STRUCT.size
 CMD_HEADER_BYTES: int = CMD_HEADER.size
 CMD_IDENTIFY_BYTES: int = CMD_IDENTIFY_STRUCT.size
 CMD_SYNC_CLOCK_BYTES: int = CMD_SYNC_CLOCK_STRUCT.size
+CMD_TX_SLOT_BYTES: int = CMD_TX_SLOT_STRUCT.size
+STREAM_RECORD_PREFIX_BYTES: int = STREAM_RECORD_PREFIX.size
+DATA_PULSE_CHANNEL_BYTES: int = DATA_PULSE_CHANNEL.size
 
 SAMPLE_DTYPE = np.dtype("<i2")
 BYTES_PER_SAMPLE: int = _protocol_validator.ACCEL_AXES * SAMPLE_DTYPE.itemsize
@@ -0,0 +1,84 @@
+"""Kernel receive timestamps for datagrams on an asyncio UDP socket.
+
+``CMD_SYNC_CLOCK`` offsets are only as good as the server's receive stamp on
+the ACK.  Stamping in ``datagram_received`` adds however long the event loop
+took to get to the socket, and that delay lands in the offset estimate.  The
+kernel already stamps every packet when it is queued; on Linux the stamp of
+the most recently read datagram is available through ``SIOCGSTAMPNS`` without
+changing how asyncio reads the socket, because the protocol callback runs
+straight after the ``recvfrom`` that dequeued it.
+
+That ordering is a property of the event loop, not of asyncio.  The selector
+loop and uvloop (the production loop, see ``app/bootstrap.py``) both hand each
+datagram to the protocol before reading the next; ``test_rx_timestamps`` runs
+under both.  A loop that batched reads (``recvmmsg``) would give every
+datagram of a batch the stamp of the last one.
+
+The kernel stamp is on ``CLOCK_REALTIME``; it is moved onto
+``time.monotonic()`` with a back-to-back read of both clocks, which costs well
+under a microsecond of error (NTP slewing between the two reads aside).  On
+other platforms, or when the ioctl fails, callers get ``None`` and fall back
+to stamping in user space.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import fcntl
+import logging
+import socket
+import struct
+import sys
+import time
+
+LOGGER = logging.getLogger(__name__)
+
+__all__ = ["KernelRxTimestamps"]
+
+# <linux/sockios.h>; Python's socket module does not export it.  Setting
+# SO_TIMESTAMPNS instead would move the stamp into ancillary data, which
+# asyncio's recvfrom discards, and leave the ioctl with nothing to report.
+_SIOCGSTAMPNS = 0x8907
+# struct timespec with native ``long`` fields, as the legacy ioctl returns it.
+_TIMESPEC = struct.Struct("@ll")
+_NS_PER_US = 1_000
+
+
+class KernelRxTimestamps:
+    """Reads kernel receive stamps for one socket on the monotonic clock."""
+
+    __slots__ = ("_fileno",)
+
+    def __init__(self, sock: socket.socket | asyncio.trsock.TransportSocket | None) -> None:
+        self._fileno: int | None = None
+        if sock is None or not sys.platform.startswith("linux"):
+            return
+        fileno = sock.fileno()
+        try:
+            # The first SIOCGSTAMPNS switches kernel stamping on for the
+            # socket and reports ENOENT because nothing was stamped yet.
+            fcntl.ioctl(fileno, _SIOCGSTAMPNS, bytes(_TIMESPEC.size))
+        except FileNotFoundError:
+            pass
+        except OSError:
+            LOGGER.info("Kernel RX timestamps unavailable; stamping sync ACKs in user space")
+            return
+        self._fileno = fileno
+
+    @property
+    def enabled(self) -> bool:
+        return self._fileno is not None
+
+    def last_rx_monotonic_us(self) -> int | None:
+        """Return the monotonic µs stamp of the last datagram read, or ``None``."""
+
+        if self._fileno is None:
+            return None
+        try:
+            raw = fcntl.ioctl(self._fileno, _SIOCGSTAMPNS, bytes(_TIMESPEC.size))
+        except OSError:
+            return None
+        sec, nsec = _TIMESPEC.unpack(raw)
+        realtime_ns = time.time_ns()
+        monotonic_ns = time.monotonic_ns()
+        return ((sec * 1_000_000_000) + nsec - realtime_ns + monotonic_ns) // _NS_PER_US
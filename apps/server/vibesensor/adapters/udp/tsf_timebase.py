@@ -0,0 +1,117 @@
+"""Wi-Fi TSF → server-monotonic timebase for sensors stamping DATA in AP TSF.
+
+Sensors that advertise ``HELLO_CAP_TSF_TIMEBASE`` map their local sample
+clock onto the access point's 802.11 TSF counter before sending ``t0_us``.
+The Pi hosts that AP, so one bracketed read of its own TSF against
+``time.monotonic()`` is enough to move every such timestamp into the same
+server-monotonic domain that ``CMD_SYNC_CLOCK`` sensors already use.
+
+mac80211 drivers expose the BSS TSF through debugfs as a hex counter.  FullMAC
+drivers that do not publish it leave the timebase unavailable; callers then
+time TSF sensors' frames by arrival rather than guessing an offset.
+"""
+
+from __future__ import annotations
+
+import glob
+import logging
+import time
+from collections.abc import Callable
+from pathlib import Path
+
+LOGGER = logging.getLogger(__name__)
+
+__all__ = ["TsfTimebase", "read_debugfs_tsf_us"]
+
+_US_PER_SEC: int = 1_000_000
+_DEFAULT_IFNAME = "wlan0"
+_DEBUGFS_TSF_GLOB = "/sys/kernel/debug/ieee80211/phy*/netdev:{ifname}/tsf"
+_MAX_READ_SPAN_US: int = 2_000
+_CALIBRATION_ATTEMPTS: int = 5
+_RETRY_INTERVAL_S: float = 30.0
+_RECALIBRATE_INTERVAL_S: float = 60.0
+
+
+def read_debugfs_tsf_us(ifname: str = _DEFAULT_IFNAME) -> int | None:
+    """Return the current BSS TSF of *ifname* in microseconds, or ``None``."""
+    for path in glob.glob(_DEBUGFS_TSF_GLOB.format(ifname=ifname)):
+        try:
+            raw = Path(path).read_text(encoding="ascii").strip()
+        except OSError:
+            continue
+        try:
+            return int(raw, 16)
+        except ValueError:
+            continue
+    return None
+
+
+class TsfTimebase:
+    """Lazily calibrated TSF → monotonic offset for the local AP."""
+
+    __slots__ = ("_monotonic_us", "_next_attempt_mono_s", "_offset_us", "_read_tsf_us")
+
+    def __init__(
+        self,
+        *,
+        ifname: str = _DEFAULT_IFNAME,
+        read_tsf_us: Callable[[], int | None] | None = None,
+        monotonic_us: Callable[[], int] | None = None,
+    ) -> None:
+        self._read_tsf_us = read_tsf_us or (lambda: read_debugfs_tsf_us(ifname))
+        self._monotonic_us = monotonic_us or (lambda: int(round(time.monotonic() * _US_PER_SEC)))
+        self._offset_us: int | None = None
+        self._next_attempt_mono_s = 0.0
+
+    @property
+    def offset_us(self) -> int | None:
+        """Calibrated ``monotonic_us − tsf_us`` offset, if one has been taken."""
+        return self._offset_us
+
+    def calibrate(self) -> bool:
+        """Take the tightest of a few bracketed TSF reads as the offset."""
+        best_span_us: int | None = None
+        best_offset_us: int | None = None
+        for _ in range(_CALIBRATION_ATTEMPTS):
+            before_us = self._monotonic_us()
+            tsf_us = self._read_tsf_us()
+            after_us = self._monotonic_us()
+            if tsf_us is None or tsf_us <= 0:
+                return False
+            span_us = after_us - before_us
+            if span_us > _MAX_READ_SPAN_US:
+                continue
+            if best_span_us is None or span_us < best_span_us:
+                best_span_us = span_us
+                best_offset_us = (before_us + span_us // 2) - tsf_us
+        if best_offset_us is None:
+            return False
+        if self._offset_us is None:
+            LOGGER.info(
+                "TSF timebase calibrated: offset_us=%d read_span_us=%d",
+                best_offset_us,
+                best_span_us,
+            )
+        self._offset_us = best_offset_us
+        return True
+
+    def to_monotonic_us(self, tsf_us: int) -> int | None:
+        """Map an AP-TSF timestamp onto server monotonic µs, or ``None``."""
+        now_s = self._monotonic_us() / _US_PER_SEC
+        if now_s >= self._next_attempt_mono_s:
+            # Re-take the offset periodically so the AP crystal's drift against
+            # the Pi's monotonic clock stays bounded; every sensor sees the same
+            # step, so cross-sensor alignment is unaffected.
+            had_offset = self._offset_us is not None
+            calibrated = self.calibrate()
+            has_offset = self._offset_us is not None
+            interval_s = _RECALIBRATE_INTERVAL_S if has_offset else _RETRY_INTERVAL_S
+            self._next_attempt_mono_s = now_s + interval_s
+            if not calibrated and not had_offset:
+                LOGGER.warning(
+                    "TSF timebase unavailable; TSF-stamped sensors fall back to arrival time",
+                )
+        offset_us = self._offset_us
+        if offset_us is None:
+            return None
+        return tsf_us + offset_us
@@ -15,18 +15,22 @@ import time
 from typing import cast
 
 from vibesensor.adapters.udp.protocol import (
+    HELLO_CAP_TX_SLOTS,
     MSG_ACK,
     MSG_DATA_ACK,
     MSG_HELLO,
+    SERVER_HELLO_CAPABILITIES,
     extract_client_id_hex,
     pack_cmd_identify,
     pack_cmd_sync_clock,
+    pack_cmd_tx_slot,
     pack_hello_ack,
     parse_ack,
     parse_client_id,
     parse_hello,
 )
 from vibesensor.adapters.udp.protocol_validator import ProtocolVersionMismatch
+from vibesensor.adapters.udp.rx_timestamps import KernelRxTimestamps
 from vibesensor.infra.runtime.registry import ClientRegistry
 from vibesensor.shared.exceptions import ProtocolError
 
@@ -36,14 +40,30 @@ __all__ = ["UDPControlPlane"]
 
 _US_PER_SEC: int = 1_000_000
 
+# Narrowest TDMA slot worth assigning: one 400 us frame at the firmware's
+# airtime budget (VIBESENSOR_TDMA_FRAME_AIRTIME_US) plus the 100 us guard
+# floor at both slot edges. Firmware refuses anything narrower.
+TX_SLOT_MIN_WIDTH_US: int = 400 + 2 * 100
+
 
 class ControlDatagramProtocol(asyncio.DatagramProtocol):
-    def __init__(self, registry: ClientRegistry):
+    def __init__(self, registry: ClientRegistry, *, kernel_rx_timestamps: bool = True):
         self.registry = registry
         self.transport: asyncio.DatagramTransport | None = None
+        self.kernel_rx_timestamps = kernel_rx_timestamps
+        self._rx_timestamps = KernelRxTimestamps(None)
 
     def connection_made(self, transport: asyncio.BaseTransport) -> None:
         self.transport = cast("asyncio.DatagramTransport", transport)
+        if self.kernel_rx_timestamps:
+            self._rx_timestamps = KernelRxTimestamps(transport.get_extra_info("socket"))
+
+    def _receive_monotonic(self) -> float:
+        """Return when the current datagram arrived, on ``time.monotonic()``."""
+        rx_us = self._rx_timestamps.last_rx_monotonic_us()
+        if rx_us is None:
+            return time.monotonic()
+        return rx_us / _US_PER_SEC
 
     def datagram_received(self, data: bytes, addr: tuple[str, int]) -> None:
         if not data:
@@ -57,14 +77,25 @@ class ControlDatagramProtocol(asyncio.DatagramProtocol):
                 hello = parse_hello(data)
                 registry.update_from_hello(hello, addr, now_ts)
                 if self.transport is not None:
+                    receipts = (
+                        None
+                        if hello.oldest_pending_seq is None or hello.boot_id is None
+                        else registry.hello_ack_receipts(
+                            hello.client_id, hello.oldest_pending_seq, hello.boot_id
+                        )
+                    )
                     self.transport.sendto(
-                        pack_hello_ack(hello.client_id),
+                        pack_hello_ack(
+                            hello.client_id,
+                            hello.capabilities & SERVER_HELLO_CAPABILITIES,
+                            receipts,
+                        ),
                         (addr[0], hello.control_port),
                     )
             elif msg_type == MSG_ACK:
                 ack = parse_ack(data)
                 LOGGER.info("ACK from %s: cmd_seq=%s status=%s", addr, ack.cmd_seq, ack.status)
-                registry.update_from_ack(ack, now_ts, now_mono=time.monotonic())
+                registry.update_from_ack(ack, now_ts, now_mono=self._receive_monotonic())
             elif msg_type == MSG_DATA_ACK:
                 return
         except ProtocolVersionMismatch as exc:
@@ -95,14 +126,24 @@ class ControlDatagramProtocol(asyncio.DatagramProtocol):
 class UDPControlPlane:
     """Manages the control UDP socket: receives ACKs, sends commands to sensors."""
 
-    def __init__(self, registry: ClientRegistry, bind_host: str, bind_port: int):
+    def __init__(
+        self,
+        registry: ClientRegistry,
+        bind_host: str,
+        bind_port: int,
+        *,
+        tx_slot_period_us: int = 0,
+        kernel_rx_timestamps: bool = True,
+    ):
         self.registry = registry
         self.bind_host = bind_host
         self.bind_port = bind_port
-        self.protocol = ControlDatagramProtocol(registry)
+        self.tx_slot_period_us = max(0, int(tx_slot_period_us))
+        self.protocol = ControlDatagramProtocol(registry, kernel_rx_timestamps=kernel_rx_timestamps)
         self.transport: asyncio.DatagramTransport | None = None
         self._cmd_seq = random.randint(1, 1_000_000)
         self._cmd_seq_lock = threading.Lock()
+        self._tx_slot_narrow_count = 0
 
     def _next_cmd_seq(self) -> int:
         """Atomically increment and return the next command sequence number."""
@@ -146,23 +187,28 @@ class UDPControlPlane:
     def broadcast_sync_clock(self) -> int:
         """Send a clock-sync command to every active sensor.
 
+        Each command is stamped just before its own ``sendto`` so the time
+        spent packing earlier sensors' commands does not count as network
+        delay for later ones.
+
         Returns the number of sensors that received the message.
         """
         transport = self.transport
         if transport is None:
             return 0
-        server_time_us = int(time.monotonic() * _US_PER_SEC)
         registry = self.registry
         _fromhex = bytes.fromhex
         _next_seq = self._next_cmd_seq
         _pack = pack_cmd_sync_clock
         _sendto = transport.sendto
+        _monotonic = time.monotonic
         sent = 0
         for client_id in registry.active_client_ids():
             record = registry.get(client_id)
             if record is None or record.control_addr is None:
                 continue
             seq = _next_seq()
+            server_time_us = int(_monotonic() * _US_PER_SEC)
             payload = _pack(
                 _fromhex(record.client_id),
                 seq,
@@ -173,4 +219,62 @@ class UDPControlPlane:
             _sendto(payload, record.control_addr)
             registry.mark_cmd_sent(client_id, seq, sync_send_us=server_time_us)
             sent += 1
+        self.assign_tx_slots()
         return sent
+
+    def assign_tx_slots(self) -> int:
+        """Send every slot-capable active sensor its TDMA transmit slot.
+
+        The configured period is split evenly across capable sensors in
+        client-id order, so a node keeps its slot while membership is stable.
+        Assignments ride the sync-clock cadence: slots are placed on the server
+        clock, and a node only honours them once it holds a sync offset.
+
+        With TDMA disabled, or when the even split would leave slots narrower
+        than ``TX_SLOT_MIN_WIDTH_US``, every capable sensor is sent a zero
+        period instead so it falls back to contention access.
+
+        Returns the number of sensors that received a CMD_TX_SLOT.
+        """
+        transport = self.transport
+        if transport is None:
+            return 0
+        registry = self.registry
+        slotted = []
+        for client_id in sorted(registry.active_client_ids()):
+            record = registry.get(client_id)
+            if record is None or record.control_addr is None:
+                continue
+            if not record.hello_capabilities & HELLO_CAP_TX_SLOTS:
+                continue
+            slotted.append(record)
+        if not slotted:
+            return 0
+        period_us = self.tx_slot_period_us
+        width_us = period_us // len(slotted)
+        if 0 < width_us < TX_SLOT_MIN_WIDTH_US:
+            if self._tx_slot_narrow_count != len(slotted):
+                LOGGER.warning(
+                    "TDMA period %d us leaves %d us per sensor for %d sensors "
+                    "(minimum %d us); falling back to contention access",
+                    period_us,
+                    width_us,
+                    len(slotted),
+                    TX_SLOT_MIN_WIDTH_US,
+                )
+            self._tx_slot_narrow_count = len(slotted)
+            period_us = width_us = 0
+        else:
+            self._tx_slot_narrow_count = 0
+        for index, record in enumerate(slotted):
+            seq = self._next_cmd_seq()
+            payload = pack_cmd_tx_slot(
+                bytes.fromhex(record.client_id),
+                seq,
+                slot_offset_us=index * width_us,
+                slot_period_us=period_us,
+                slot_width_us=width_us,
+            )
+            transport.sendto(payload, record.control_addr)
+            registry.mark_cmd_sent(record.client_id, seq)
+        return len(slotted)
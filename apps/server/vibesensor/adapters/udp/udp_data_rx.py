@@ -3,6 +3,7 @@
 ``UDPDataRxProtocol`` is an asyncio ``DatagramProtocol`` that decodes
 incoming ``DataMessage`` frames, deduplicates them via the client registry,
 runs the processing pipeline, and hands results to the metrics logger.
+Frames replayed over the TCP backlog stream go through the same dispatch.
 """
 
 from __future__ import annotations
@@ -15,7 +16,9 @@ from typing import Protocol, cast
 import numpy as np
 from opentelemetry.trace import SpanKind
 
+from vibesensor.adapters.udp.backlog_stream_rx import start_backlog_stream_server
 from vibesensor.adapters.udp.protocol import (
+    HELLO_CAP_TSF_TIMEBASE,
     MSG_DATA,
     DataMessage,
     extract_client_id_hex,
@@ -23,6 +26,7 @@ from vibesensor.adapters.udp.protocol import (
     parse_data,
 )
 from vibesensor.adapters.udp.protocol_validator import ProtocolVersionMismatch
+from vibesensor.adapters.udp.tsf_timebase import TsfTimebase
 from vibesensor.infra.processing import SignalProcessor
 from vibesensor.infra.runtime.registry import ClientRegistry, DataUpdateResult
 from vibesensor.shared.exceptions import ProtocolError
@@ -34,6 +38,19 @@ LOGGER = logging.getLogger(__name__)
 _QUEUE_DROP_LOG_INTERVAL_S: float = 2.0
 
 
+def _arrival_t0_us(
+    arrival_mono_s: float,
+    *,
+    sample_count: int,
+    sample_rate_hz: int | None,
+) -> int:
+    """Estimate a frame's first-sample time on the server clock from its arrival."""
+    arrival_us = int(round(arrival_mono_s * 1_000_000))
+    if not sample_rate_hz or sample_rate_hz <= 0:
+        return arrival_us
+    return arrival_us - (sample_count * 1_000_000) // sample_rate_hz
+
+
 class RawCaptureSink(Protocol):
     def capture_raw_samples(
         self,
@@ -75,12 +92,15 @@ class DataDatagramProtocol(asyncio.DatagramProtocol):
         ingest_diagnostics: IngestDiagnosticsCollector | None = None,
         queue_maxsize: int = 1024,
         queue_drop_log_interval_s: float = _QUEUE_DROP_LOG_INTERVAL_S,
+        tsf_timebase: TsfTimebase | None = None,
     ):
         self.registry = registry
         self.processor = processor
         self._raw_capture_sink = raw_capture_sink
+        self._tsf_timebase = tsf_timebase
         self._ingest_diagnostics = ingest_diagnostics
         self.transport: asyncio.DatagramTransport | None = None
+        self.backlog_stream_server: asyncio.Server | None = None
         self._queue: asyncio.Queue[tuple[bytes, tuple[str, int], float]] = asyncio.Queue(
             maxsize=max(1, queue_maxsize),
         )
@@ -92,6 +112,12 @@ class DataDatagramProtocol(asyncio.DatagramProtocol):
         """Store the transport reference when the datagram endpoint is established."""
         self.transport = cast("asyncio.DatagramTransport", transport)
 
+    def connection_lost(self, exc: Exception | None) -> None:
+        """Stop accepting backlog streams once the data socket is closed."""
+        if self.backlog_stream_server is not None:
+            self.backlog_stream_server.close()
+            self.backlog_stream_server = None
+
     def datagram_received(self, data: bytes, addr: tuple[str, int]) -> None:
         """Enqueue an incoming datagram for background processing."""
         if not data:
@@ -150,13 +176,23 @@ class DataDatagramProtocol(asyncio.DatagramProtocol):
             finally:
                 self._queue.task_done()
 
+    def process_replayed_packet(self, data: bytes, addr: tuple[str, int]) -> DataMessage | None:
+        """Dispatch one backlog-stream DATA packet; the stream acknowledges it."""
+        return self._process_datagram(
+            data,
+            addr,
+            received_mono_s=time.monotonic(),
+            replayed=True,
+        )
+
     def _process_datagram(
         self,
         data: bytes,
         addr: tuple[str, int],
         *,
         received_mono_s: float | None = None,
-    ) -> None:
+        replayed: bool = False,
+    ) -> DataMessage | None:
         with start_span(
             __name__,
             "udp.data.dispatch",
@@ -169,8 +205,9 @@ class DataDatagramProtocol(asyncio.DatagramProtocol):
             msg = self._parse_data_message(data, addr)
             if msg is None:
                 span.set_attribute("vibesensor.datagram.accepted", False)
-                return
+                return None
             span.set_attribute("vibesensor.datagram.accepted", True)
+            span.set_attribute("vibesensor.replayed", replayed)
             span.set_attribute("vibesensor.client_id", msg.client_id.hex())
             span.set_attribute("vibesensor.sample_count", len(msg.samples))
             try:
@@ -178,6 +215,7 @@ class DataDatagramProtocol(asyncio.DatagramProtocol):
                     msg,
                     addr,
                     received_mono_s=received_mono_s,
+                    replayed=replayed,
                 )
             except Exception as exc:
                 mark_span_error(span, exc)
@@ -185,6 +223,7 @@ class DataDatagramProtocol(asyncio.DatagramProtocol):
             span.set_attribute("vibesensor.is_duplicate", result.is_duplicate)
             span.set_attribute("vibesensor.is_late", result.is_late)
             span.set_attribute("vibesensor.reset_detected", result.reset_detected)
+        return msg
 
     def _parse_data_message(self, data: bytes, addr: tuple[str, int]) -> DataMessage | None:
         try:
@@ -206,6 +245,7 @@ class DataDatagramProtocol(asyncio.DatagramProtocol):
         addr: tuple[str, int],
         *,
         received_mono_s: float | None = None,
+        replayed: bool = False,
     ) -> DataUpdateResult:
         client_id = msg.client_id.hex()
         registry = self.registry
@@ -217,7 +257,8 @@ class DataDatagramProtocol(asyncio.DatagramProtocol):
             else 0.0
         )
         now_ts = time.time()
-        result = registry.update_from_data(msg, addr, now_ts)
+        result = registry.update_from_data(msg, addr, now_ts, replayed=replayed)
+        late_loss = result.is_late and not result.is_backfill
         if not result.is_duplicate:
             if result.reset_detected:
                 LOGGER.warning(
@@ -227,25 +268,44 @@ class DataDatagramProtocol(asyncio.DatagramProtocol):
                 processor.flush_client_buffer(client_id)
             record = registry.get(client_id)
             sample_rate_hz = record.sample_rate_hz if record is not None else None
+            t0_us: int | None = msg.t0_us
+            if (
+                self._tsf_timebase is not None
+                and record is not None
+                and record.hello_capabilities & HELLO_CAP_TSF_TIMEBASE
+            ):
+                t0_us = self._tsf_timebase.to_monotonic_us(msg.t0_us)
+                if t0_us is None and not replayed:
+                    # Unmapped TSF is not on the server clock; ingest and raw
+                    # capture both fall back to the arrival time instead. A
+                    # replayed frame's arrival says nothing about when it was
+                    # sampled, so it stays out of the raw capture.
+                    t0_us = _arrival_t0_us(
+                        received_mono_s or dispatch_started_mono_s,
+                        sample_count=len(msg.samples),
+                        sample_rate_hz=sample_rate_hz,
+                    )
             if not result.is_late:
                 processor.ingest(
                     client_id,
                     msg.samples,
                     sample_rate_hz=sample_rate_hz,
-                    t0_us=msg.t0_us,
+                    t0_us=t0_us,
                 )
             if self._raw_capture_sink is not None:
-                if result.is_late:
+                if late_loss:
                     self._raw_capture_sink.note_late_packet_loss(client_id=client_id)
-                self._raw_capture_sink.capture_raw_samples(
-                    client_id=client_id,
-                    sample_rate_hz=sample_rate_hz,
-                    t0_us=msg.t0_us,
-                    samples=msg.samples,
-                )
-        if result.is_late and self._ingest_diagnostics is not None:
+                if t0_us is not None:
+                    self._raw_capture_sink.capture_raw_samples(
+                        client_id=client_id,
+                        sample_rate_hz=sample_rate_hz,
+                        t0_us=t0_us,
+                        samples=msg.samples,
+                    )
+        if late_loss and self._ingest_diagnostics is not None:
             self._ingest_diagnostics.note_late_packet(client_id=client_id)
-        self._send_data_ack(msg, addr, client_id=client_id)
+        if not replayed:
+            self._send_data_ack(msg, addr, client_id=client_id)
         if self._ingest_diagnostics is not None:
             ack_completed_mono_s = time.monotonic()
             self._ingest_diagnostics.note_udp_processed(
@@ -290,18 +350,39 @@ async def start_udp_data_receiver(
     raw_capture_sink: RawCaptureSink | None = None,
     ingest_diagnostics: IngestDiagnosticsCollector | None = None,
     queue_maxsize: int = 1024,
+    tsf_timebase: TsfTimebase | None = None,
+    backlog_stream_port: int = 0,
+    tsf_ifname: str = "",
 ) -> tuple[asyncio.DatagramTransport, DataDatagramProtocol]:
-    """Bind the UDP data socket and start the background consumer task."""
+    """Bind the UDP data socket and start the background consumer task.
+
+    A non-zero *backlog_stream_port* also listens for TCP backlog streams on
+    the same host; they close with the data socket.  *tsf_ifname* is the
+    hotspot interface whose TSF the default timebase reads.
+    """
     loop = asyncio.get_running_loop()
+    if tsf_timebase is None:
+        tsf_timebase = TsfTimebase(ifname=tsf_ifname) if tsf_ifname else TsfTimebase()
     protocol = DataDatagramProtocol(
         registry=registry,
         processor=processor,
         raw_capture_sink=raw_capture_sink,
         ingest_diagnostics=ingest_diagnostics,
         queue_maxsize=queue_maxsize,
+        tsf_timebase=tsf_timebase,
     )
     transport, _ = await loop.create_datagram_endpoint(
         lambda: protocol,
         local_addr=(host, port),
     )
+    if backlog_stream_port > 0:
+        try:
+            protocol.backlog_stream_server = await start_backlog_stream_server(
+                host,
+                backlog_stream_port,
+                protocol,
+            )
+        except OSError:
+            transport.close()
+            raise
     return transport, protocol
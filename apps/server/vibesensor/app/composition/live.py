@@ -5,6 +5,10 @@ from dataclasses import dataclass
 
 from vibesensor.adapters.http.dependencies import HealthDeps, LiveDeps
 from vibesensor.adapters.persistence.history_db import HistoryPersistenceAdapters
+from vibesensor.adapters.persistence.whole_run_spectral_cache import (
+    WHOLE_RUN_SPECTRAL_CACHE_DIR_NAME,
+    FileWholeRunSpectralChunkCache,
+)
 from vibesensor.adapters.udp.udp_control_tx import UDPControlPlane
 from vibesensor.adapters.websocket.hub import WebSocketHub
 from vibesensor.app.composition.settings import RuntimeSettingsDeps
@@ -108,6 +112,7 @@ def build_live_runtime(
         registry=registry,
         bind_host=config.udp.control_host,
         bind_port=config.udp.control_port,
+        tx_slot_period_us=config.udp.tx_slot_period_ms * 1000,
     )
     processing_loop_state = ProcessingLoopState()
     processing_loop = ProcessingLoop(
@@ -153,6 +158,9 @@ def build_live_runtime(
         sensor_metadata_reader=runtime_settings.sensor_metadata_reader,
         language_reader=runtime_settings.language_reader,
         ingest_diagnostics=ingest_diagnostics,
+        whole_run_spectral_cache=FileWholeRunSpectralChunkCache(
+            root_dir=config.logging.history_db_path.parent / WHOLE_RUN_SPECTRAL_CACHE_DIR_NAME,
+        ),
     )
 
     stale_analyzing = history.run_repository.stale_analyzing_run_ids()
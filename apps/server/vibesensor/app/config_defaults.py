@@ -28,6 +28,8 @@ DEFAULT_CONFIG: JsonObject = {
         "control_host": "0.0.0.0",
         "control_port": 9001,
         "data_queue_maxsize": 1024,
+        "tx_slot_period_ms": 0,
+        "backlog_stream_port": 9002,
     },
     "processing": {
         "sample_rate_hz": 800,
@@ -166,6 +166,14 @@ def load_config(config_path: Path | None = None) -> AppConfig:
                 1,
                 _coerce_int(udp_cfg["data_queue_maxsize"], "udp.data_queue_maxsize"),
             ),
+            tx_slot_period_ms=max(
+                0,
+                _coerce_int(udp_cfg["tx_slot_period_ms"], "udp.tx_slot_period_ms"),
+            ),
+            backlog_stream_port=_coerce_int(
+                udp_cfg["backlog_stream_port"],
+                "udp.backlog_stream_port",
+            ),
         ),
         processing=ProcessingConfig(
             sample_rate_hz=_coerce_int(
@@ -96,6 +96,8 @@ class UDPConfig:
     control_host: str
     control_port: int
     data_queue_maxsize: int
+    tx_slot_period_ms: int = 0
+    backlog_stream_port: int = 0
 
     def __post_init__(self) -> None:
         for name in ("data_port", "control_port"):
@@ -106,6 +108,13 @@ class UDPConfig:
             raise ValueError(
                 f"UDPConfig.data_queue_maxsize must be ≥1, got {self.data_queue_maxsize!r}",
             )
+        if not isinstance(self.tx_slot_period_ms, int) or self.tx_slot_period_ms < 0:
+            raise ValueError(
+                f"UDPConfig.tx_slot_period_ms must be ≥0, got {self.tx_slot_period_ms!r}",
+            )
+        port = self.backlog_stream_port
+        if not isinstance(port, int) or not (0 <= port <= 65535):
+            raise ValueError(f"UDPConfig.backlog_stream_port must be 0–65535, got {port!r}")
 
 
 @dataclass(slots=True)
@@ -68,6 +68,8 @@ class RuntimeState:
             udp_data_host=self.config.udp.data_host,
             udp_data_port=self.config.udp.data_port,
             udp_data_queue_maxsize=self.config.udp.data_queue_maxsize,
+            udp_backlog_stream_port=self.config.udp.backlog_stream_port,
+            ap_ifname=self.config.ap.ifname,
             gpsd_host=self.config.gps.gpsd_host,
             gpsd_port=self.config.gps.gpsd_port,
             shutdown_analysis_timeout_s=self.config.logging.shutdown_analysis_timeout_s,
@@ -15,17 +15,29 @@ from vibesensor.adapters.udp.protocol import (
     CMD_IDENTIFY,
     CMD_IDENTIFY_BYTES,
     CMD_SYNC_CLOCK_BYTES,
+    CMD_TX_SLOT,
+    CMD_TX_SLOT_BYTES,
     DATA_ACK_BYTES,
     DATA_HEADER_BYTES,
+    DATA_PULSE_CHANNEL_BYTES,
+    DATA_RANGE_TAG_BYTES,
     HELLO_ACK_BYTES,
+    HELLO_ACK_RECEIPTS_BYTES,
     HELLO_CAP_EXPLICIT_ACK,
+    HELLO_CAP_PULSE_CHANNEL,
+    HELLO_CAP_RANGE_TAG,
+    HELLO_CAP_RESUME_RECEIPTS,
+    HELLO_CAP_TSF_TIMEBASE,
+    HELLO_CAP_TX_SLOTS,
     HELLO_FIXED_BYTES,
+    HELLO_RESUME_BYTES,
     MSG_ACK,
     MSG_CMD,
     MSG_DATA,
     MSG_DATA_ACK,
     MSG_HELLO,
     MSG_HELLO_ACK,
+    STREAM_RECORD_PREFIX_BYTES,
     VERSION,
 )
 from vibesensor.app.config_defaults import DEFAULT_CONFIG
@@ -42,6 +54,7 @@ def render_contract_reference_markdown() -> str:
     srv: JsonObject = srv_raw
     data_port = int(str(udp["data_port"]))
     control_port = int(str(udp["control_port"]))
+    backlog_stream_port = int(str(udp["backlog_stream_port"]))
     server_http_port = int(str(srv["port"]))
 
     # Canonical metric/report field names
@@ -75,6 +88,7 @@ This document is generated from code and shared contract files.
 - HTTP API/UI server port: `{server_http_port}`
 - UDP data ingest port: `{data_port}`
 - UDP control/identify port: `{control_port}`
+- TCP backlog stream port: `{backlog_stream_port}`
 
 ## Wire protocol version and message types
 
@@ -86,19 +100,31 @@ This document is generated from code and shared contract files.
 - DATA_ACK: `{MSG_DATA_ACK}`
 - HELLO_ACK: `{MSG_HELLO_ACK}`
 - CMD identify id: `{CMD_IDENTIFY}`
+- CMD tx slot id: `{CMD_TX_SLOT}`
 - HELLO explicit-ack capability bit: `0x{HELLO_CAP_EXPLICIT_ACK:02x}`
+- HELLO TSF-timebase capability bit: `0x{HELLO_CAP_TSF_TIMEBASE:02x}`
+- HELLO tx-slots capability bit: `0x{HELLO_CAP_TX_SLOTS:02x}`
+- HELLO range-tag capability bit: `0x{HELLO_CAP_RANGE_TAG:02x}`
+- HELLO resume-receipts capability bit: `0x{HELLO_CAP_RESUME_RECEIPTS:02x}`
+- HELLO pulse-channel capability bit: `0x{HELLO_CAP_PULSE_CHANNEL:02x}`
 
 ## Wire packet byte sizes
 
 - HELLO fixed bytes (without variable name/fw bytes): `{HELLO_FIXED_BYTES}`
+- HELLO oldest-pending seq + boot id trailer bytes (resume-receipts only): `{HELLO_RESUME_BYTES}`
 - DATA header bytes (without sample payload): `{DATA_HEADER_BYTES}`
+- DATA range tag trailer bytes (optional): `{DATA_RANGE_TAG_BYTES}`
+- DATA wheel pulse channel bytes (pulse-channel only): `{DATA_PULSE_CHANNEL_BYTES}`
 - CMD header bytes: `{CMD_HEADER_BYTES}`
 - CMD identify bytes: `{CMD_IDENTIFY_BYTES}`
 - CMD sync clock bytes: `{CMD_SYNC_CLOCK_BYTES}`
+- CMD tx slot bytes: `{CMD_TX_SLOT_BYTES}`
 - ACK bytes: `{ACK_BYTES}`
 - ACK sync clock bytes: `{ACK_SYNC_CLOCK_BYTES}`
 - DATA_ACK bytes: `{DATA_ACK_BYTES}`
 - HELLO_ACK bytes: `{HELLO_ACK_BYTES}`
+- HELLO_ACK with receipts bytes: `{HELLO_ACK_RECEIPTS_BYTES}`
+- Backlog stream record length prefix bytes: `{STREAM_RECORD_PREFIX_BYTES}`
 
 ## Hello handshake
 
@@ -106,6 +132,42 @@ This document is generated from code and shared contract files.
 - Server replies to HELLO packets with `HELLO_ACK` on the sensor control port.
 - Firmware waits for `HELLO_ACK` before sending DATA frames, so the control path
   is validated before streaming starts.
+- `HELLO_ACK` ends with a byte echoing the HELLO capabilities the server
+  accepted. Firmware appends the DATA range tag only once that echo carries the
+  range-tag bit, since older servers reject DATA of any other length; a
+  `HELLO_ACK` without the byte accepts nothing.
+- Firmware with the resume-receipts capability appends the seq of its oldest
+  queued DATA frame and a boot id drawn at startup. The server then answers with
+  the longer `HELLO_ACK`: the highest seq received contiguously from there, and a
+  32-bit bitmap whose bit `i` marks seq `contiguous + 2 + i` as received.
+  Firmware drops those frames instead of resending them after a reconnect.
+- Seqs restart at 0 on every boot, so when the boot id differs from the one the
+  server last saw it forgets that client's received seqs and answers without
+  receipts.
+
+## Wheel pulse channel
+
+- Firmware with the pulse-channel capability appends one channel record after the
+  range tag of every DATA frame: a type byte (`1`, wheel pulse), the cumulative
+  count of accepted pulse edges as a little-endian `u16`, and the time of the
+  latest edge as a little-endian `i32` in microseconds relative to the frame
+  `t0_us`. `INT32_MIN` means there is no edge to report yet.
+- The record is only sent once the server's `HELLO_ACK` echo carries both the
+  range-tag and pulse-channel bits.
+- Edges are timestamped on the clock the samples run on, so the server derives
+  the pulse rate from new edges over the time between consecutive last edges
+  without any per-frame quantisation.
+
+## Backlog stream
+
+- Firmware whose queue holds more frames than its replay threshold opens one TCP
+  connection to the backlog stream port and sends its oldest queued frames there.
+  Frames queued after the connection opened keep going over UDP.
+- Each stream record is a little-endian `u16` length followed by one DATA packet.
+  The server answers every record with a `DATA_ACK` on the same connection; the
+  firmware bounds how many records it leaves unacknowledged.
+- Both paths feed the same per-client seq bookkeeping, so frames are merged by seq.
+  Firmware falls back to UDP replay when the stream cannot be opened.
 
 ## Shared metric payload fields
 
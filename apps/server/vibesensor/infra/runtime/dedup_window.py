@@ -4,9 +4,11 @@ from __future__ import annotations
 
 from dataclasses import dataclass, field
 
-__all__ = ["DedupWindow"]
+__all__ = ["RECEIPT_BITMAP_BITS", "DedupWindow"]
 
 _DEFAULT_WINDOW_SIZE = 128
+_SEQ_MASK = 0xFFFFFFFF
+RECEIPT_BITMAP_BITS = 32
 
 
 @dataclass(slots=True)
@@ -48,3 +50,24 @@ class DedupWindow:
         self.record(seq)
         self.prune(window_size)
         return False
+
+    def receipts_from(self, floor_seq: int) -> tuple[int, int]:
+        """Return ``(contiguous_seq, receipt_bitmap)`` for a sender's backlog.
+
+        *floor_seq* is the oldest sequence the sender still holds, so anything
+        older counts as settled.  ``contiguous_seq`` is the highest sequence
+        with every sequence from *floor_seq* up to it received; bit ``i`` of
+        the bitmap is set when ``contiguous_seq + 2 + i`` was received.  All
+        arithmetic wraps at 32 bits like the wire sequence.
+        """
+
+        seen = self._seen_seqs
+        contiguous = (floor_seq - 1) & _SEQ_MASK
+        # Bounded by the window: at most one step per remembered sequence.
+        while (next_seq := (contiguous + 1) & _SEQ_MASK) in seen:
+            contiguous = next_seq
+        bitmap = 0
+        for bit in range(RECEIPT_BITMAP_BITS):
+            if ((contiguous + 2 + bit) & _SEQ_MASK) in seen:
+                bitmap |= 1 << bit
+        return contiguous, bitmap
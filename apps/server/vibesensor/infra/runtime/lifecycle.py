@@ -132,6 +132,8 @@ class LifecycleRuntime:
     esp_flash_manager: LifecycleManagedJobs
     worker_pool: LifecycleWorkerPool
     history_db: LifecycleHistoryDb
+    udp_backlog_stream_port: int = 0
+    ap_ifname: str = ""
 
 
 LOGGER = logging.getLogger(__name__)
@@ -0,0 +1,78 @@
+"""Wheel pulse rate from the DATA pulse channel of one client.
+
+Each frame carries the sensor's cumulative edge count and the time of the
+latest accepted edge relative to the frame ``t0_us``.  Both come from the
+clock the samples run on, so the rate between two readings is simply the new
+edges over the time between their last edges: no per-frame quantisation, and
+a slow wheel that only produces an edge every few frames still measures the
+full interval.
+
+When no edge arrives the true rate can only be below one edge per time since
+the last edge, so the rate is capped by that bound each frame and drops to
+zero once the wheel has been quiet for ``PULSE_STALL_US``.
+"""
+
+from __future__ import annotations
+
+from dataclasses import dataclass
+
+__all__ = ["PULSE_STALL_US", "PulseRateTracker"]
+
+# Quiet time after which the wheel counts as stopped; below ~0.5 Hz a
+# typical multi-tooth wheel sensor is already at walking pace.
+PULSE_STALL_US = 2_000_000
+# The firmware sends the cumulative edge count truncated to 16 bits.
+_EDGE_COUNT_MASK = 0xFFFF
+
+
+@dataclass(slots=True)
+class PulseRateTracker:
+    """Running edge rate derived from consecutive DATA pulse readings."""
+
+    rate_hz: float | None = None
+    last_edge_us: int | None = None
+    _edge_count: int | None = None
+
+    def clear(self) -> None:
+        """Forget the previous reading (e.g. after a sensor reset)."""
+
+        self.rate_hz = None
+        self.last_edge_us = None
+        self._edge_count = None
+
+    def update(
+        self,
+        *,
+        edge_count: int,
+        last_edge_offset_us: int | None,
+        t0_us: int,
+        frame_end_us: int,
+    ) -> None:
+        """Fold in the pulse reading of an in-order frame spanning up to *frame_end_us*."""
+
+        last_edge_us = None if last_edge_offset_us is None else t0_us + last_edge_offset_us
+        previous_count = self._edge_count
+        self._edge_count = edge_count
+        if previous_count is None:
+            self.last_edge_us = last_edge_us
+            return
+
+        new_edges = (edge_count - previous_count) & _EDGE_COUNT_MASK
+        if new_edges > 0:
+            previous_edge_us = self.last_edge_us
+            self.last_edge_us = last_edge_us
+            if (
+                previous_edge_us is not None
+                and last_edge_us is not None
+                and last_edge_us > previous_edge_us
+            ):
+                self.rate_hz = new_edges * 1_000_000.0 / float(last_edge_us - previous_edge_us)
+            return
+
+        if self.rate_hz is None or self.last_edge_us is None:
+            return
+        quiet_us = frame_end_us - self.last_edge_us
+        if quiet_us >= PULSE_STALL_US:
+            self.rate_hz = 0.0
+        elif quiet_us > 0:
+            self.rate_hz = min(self.rate_hz, 1_000_000.0 / float(quiet_us))
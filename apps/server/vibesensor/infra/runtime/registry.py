@@ -21,11 +21,17 @@ from vibesensor.infra.runtime.client_metadata import ClientMetadataManager
 from vibesensor.infra.runtime.client_snapshot import ClientSnapshot
 from vibesensor.infra.runtime.client_snapshot_assembler import ClientSnapshotAssembler
 from vibesensor.infra.runtime.dedup_window import DedupWindow
+from vibesensor.infra.runtime.pulse_rate import PulseRateTracker
 from vibesensor.infra.runtime.registry_diagnostics import RegistryDiagnostics
 from vibesensor.infra.runtime.registry_updates import (
     DataUpdateResult,
     apply_data_message_update,
 )
+from vibesensor.infra.runtime.sync_filter import (
+    SYNC_FILTER_WINDOW,
+    SyncSample,
+    SyncSampleWindow,
+)
 from vibesensor.shared.ports import (
     ClientNamePersistence,
     RegistryAckMessage,
@@ -77,6 +83,8 @@ class ClientRecord:
     queue_overflow_drops: int = 0
     server_queue_drops: int = 0
     parse_errors: int = 0
+    hello_capabilities: int = 0
+    boot_id: int | None = None
     last_seq: int | None = None
     last_ack_cmd_seq: int | None = None
     last_ack_status: int | None = None
@@ -92,6 +100,8 @@ class ClientRecord:
     timing_drift_us_total: float = 0.0
     duplicates_received: int = 0
     dedup_window: DedupWindow = field(default_factory=DedupWindow)
+    sync_samples: SyncSampleWindow = field(default_factory=SyncSampleWindow)
+    pulse_rate: PulseRateTracker = field(default_factory=PulseRateTracker)
 
 
 @dataclass(frozen=True, slots=True)
@@ -113,6 +123,7 @@ class ClientRecordSnapshot:
     queue_overflow_drops: int = 0
     server_queue_drops: int = 0
     parse_errors: int = 0
+    hello_capabilities: int = 0
     last_seq: int | None = None
     last_ack_cmd_seq: int | None = None
     last_ack_status: int | None = None
@@ -125,6 +136,8 @@ class ClientRecordSnapshot:
     timing_jitter_us_ema: float = 0.0
     timing_drift_us_total: float = 0.0
     duplicates_received: int = 0
+    pulse_rate_hz: float | None = None
+    pulse_last_edge_us: int | None = None
 
 
 def _snapshot_record(record: ClientRecord) -> ClientRecordSnapshot:
@@ -144,6 +157,7 @@ def _snapshot_record(record: ClientRecord) -> ClientRecordSnapshot:
         queue_overflow_drops=record.queue_overflow_drops,
         server_queue_drops=record.server_queue_drops,
         parse_errors=record.parse_errors,
+        hello_capabilities=record.hello_capabilities,
         last_seq=record.last_seq,
         last_ack_cmd_seq=record.last_ack_cmd_seq,
         last_ack_status=record.last_ack_status,
@@ -156,6 +170,8 @@ def _snapshot_record(record: ClientRecord) -> ClientRecordSnapshot:
         timing_jitter_us_ema=record.timing_jitter_us_ema,
         timing_drift_us_total=record.timing_drift_us_total,
         duplicates_received=record.duplicates_received,
+        pulse_rate_hz=record.pulse_rate.rate_hz,
+        pulse_last_edge_us=record.pulse_rate.last_edge_us,
     )
 
 
@@ -167,8 +183,10 @@ class ClientRegistry:
         db: ClientNamePersistence | None = None,
         live_ttl_seconds: float = 10.0,
         retention_ttl_seconds: float = 120.0,
+        sync_filter_window: int = SYNC_FILTER_WINDOW,
     ):
         self._lock = RLock()
+        self._sync_filter_window = max(1, int(sync_filter_window))
         self._liveness_policy = ClientLivenessPolicy(
             live_ttl_seconds=live_ttl_seconds,
             retention_ttl_seconds=retention_ttl_seconds,
@@ -214,7 +232,11 @@ class ClientRegistry:
         record = self._clients.get(normalized)
         if record is None:
             default_name = self._metadata.default_name_for(normalized)
-            record = ClientRecord(client_id=normalized, name=default_name)
+            record = ClientRecord(
+                client_id=normalized,
+                name=default_name,
+                sync_samples=SyncSampleWindow(window_size=self._sync_filter_window),
+            )
             self._clients[normalized] = record
         return record
 
@@ -241,10 +263,35 @@ class ClientRegistry:
                 record.reset_count += 1
                 record.last_reset_time = now_ts
                 record.dedup_window.clear()
+                record.sync_samples.clear()
             record.firmware_version = hello.firmware_version
             record.queue_overflow_drops = hello.queue_overflow_drops
+            record.hello_capabilities = hello.capabilities
             self._metadata.apply_advertised_name(record, hello.name)
 
+    def hello_ack_receipts(
+        self,
+        client_id: bytes,
+        oldest_pending_seq: int,
+        boot_id: int,
+    ) -> tuple[int, int] | None:
+        """Return ``(contiguous_seq, receipt_bitmap)`` for a resume-capable HELLO_ACK.
+
+        Built from the DATA dedup window, so it covers the sequences the server
+        still remembers; see :meth:`DedupWindow.receipts_from`.  Seqs restart
+        at 0 when the sensor reboots, so a *boot_id* other than the one last
+        seen clears the window and returns ``None``: the remembered seqs belong
+        to the previous boot.
+        """
+        with self._lock:
+            record = self._get_or_create(self._normalize_wire_client_id(client_id))
+            previous_boot_id = record.boot_id
+            record.boot_id = boot_id
+            if previous_boot_id is not None and previous_boot_id != boot_id:
+                record.dedup_window.clear()
+                return None
+            return record.dedup_window.receipts_from(oldest_pending_seq)
+
     def update_from_data(
         self,
         data_msg: RegistryDataMessage,
@@ -252,12 +299,14 @@ class ClientRegistry:
         now: float | None = None,
         *,
         now_mono: float | None = None,
+        replayed: bool = False,
     ) -> DataUpdateResult:
         """Update bookkeeping from a DATA message.
 
         Returns a :class:`DataUpdateResult` indicating whether a sensor reset
         was detected and whether this message is a duplicate retransmit.
         Duplicates are tracked but do not inflate counters or timing metrics.
+        *replayed* is set for frames that arrived over the backlog stream.
         """
         with self._lock:
             now_ts = _resolve_now_wall(now)
@@ -272,6 +321,9 @@ class ClientRegistry:
                 addr=addr,
                 now_ts=now_ts,
                 mono=mono,
+                replayed=replayed,
+                pulse_edge_count=data_msg.pulse_edge_count,
+                pulse_last_edge_offset_us=data_msg.pulse_last_edge_offset_us,
             )
 
     def update_from_ack(
@@ -302,11 +354,19 @@ class ClientRegistry:
                         0,
                         server_receive_us - record.pending_sync_send_us - processing_us,
                     )
-                    record.sync_offset_us = (
+                    offset_us = (
                         (record.pending_sync_send_us - ack.device_receive_us)
                         + (server_receive_us - ack.device_send_us)
                     ) // 2
-                    record.sync_rtt_us = round_trip_us
+                    best = record.sync_samples.add(
+                        SyncSample(
+                            offset_us=offset_us,
+                            rtt_us=round_trip_us,
+                            receive_us=server_receive_us,
+                        )
+                    )
+                    record.sync_offset_us = best.offset_us
+                    record.sync_rtt_us = best.rtt_us
                     record.last_sync_monotonic_us = server_receive_us
                 record.pending_sync_cmd_seq = None
                 record.pending_sync_send_us = None
@@ -23,6 +23,7 @@ class DataUpdateResult:
     reset_detected: bool = False
     is_duplicate: bool = False
     is_late: bool = False
+    is_backfill: bool = False
 
 
 def _is_short_session_restart(
@@ -71,8 +72,18 @@ def apply_data_message_update(
     addr: tuple[str, int],
     now_ts: float,
     mono: float,
+    replayed: bool = False,
+    pulse_edge_count: int | None = None,
+    pulse_last_edge_offset_us: int | None = None,
 ) -> DataUpdateResult:
-    """Apply one DATA message to an existing client record."""
+    """Apply one DATA message to an existing client record.
+
+    *replayed* marks frames from the backlog stream.  One that lands behind
+    the live sequence fills a gap the live path already counted as dropped,
+    so it is reported as a backfill rather than a late loss.  The wheel pulse
+    reading, when the frame carries one, only advances the pulse rate for
+    in-order frames.
+    """
 
     record.last_seen = now_ts
     record.last_seen_mono = mono
@@ -86,11 +97,16 @@ def apply_data_message_update(
         record.last_t0_us = None
         record.timing_jitter_us_ema = 0.0
         record.timing_drift_us_total = 0.0
+        record.pulse_rate.clear()
 
     if record.dedup_window.track(seq):
         record.duplicates_received += 1
         return DataUpdateResult(is_duplicate=True)
     if _is_late_packet(record, seq=seq, t0_us=t0_us):
+        if replayed:
+            record.frames_total += 1
+            record.frames_dropped = max(0, record.frames_dropped - 1)
+            return DataUpdateResult(is_late=True, is_backfill=True)
         return DataUpdateResult(is_late=True)
 
     record.frames_total += 1
@@ -118,6 +134,7 @@ def apply_data_message_update(
             record.timing_drift_us_total = 0.0
             record.dedup_window.clear()
             record.dedup_window.track(seq)
+            record.pulse_rate.clear()
             reset_detected = True
         else:
             expected = (record.last_seq + 1) & _SEQ_MASK
@@ -129,4 +146,14 @@ def apply_data_message_update(
     if record.last_seq is None or ((seq - record.last_seq) & _SEQ_MASK) < _SEQ_HALF:
         record.last_seq = seq
     record.last_t0_us = t0_us
+    if pulse_edge_count is not None:
+        frame_end_us = t0_us
+        if record.sample_rate_hz > 0:
+            frame_end_us += int(sample_count * 1_000_000 / record.sample_rate_hz)
+        record.pulse_rate.update(
+            edge_count=pulse_edge_count,
+            last_edge_offset_us=pulse_last_edge_offset_us,
+            t0_us=t0_us,
+            frame_end_us=frame_end_us,
+        )
     return DataUpdateResult(reset_detected=reset_detected)
@@ -151,6 +151,8 @@ class StartupRunner:
             raw_capture_sink=self._runtime.run_recorder,
             queue_maxsize=self._runtime.udp_data_queue_maxsize,
             ingest_diagnostics=self._runtime.ingest_diagnostics,
+            backlog_stream_port=self._runtime.udp_backlog_stream_port,
+            tsf_ifname=self._runtime.ap_ifname,
         )
 
     async def _start_background(
@@ -0,0 +1,79 @@
+"""Min-RTT filter over recent ``CMD_SYNC_CLOCK`` exchanges for one client.
+
+A single exchange's offset error is bounded by half its round trip: all the
+queueing (Wi-Fi retries, event-loop scheduling) lands on one leg or the
+other and the midpoint estimate absorbs it.  Keeping the last few exchanges
+and trusting the one with the smallest round trip therefore filters out the
+noisy ones.  Older exchanges also age: the sensor crystal drifts against the
+server clock, so each sample's error bound grows by the drift bound times
+its age, and a fresh noisy sample eventually beats a stale clean one.
+
+Two samples whose offsets differ by more than the sum of their error bounds
+cannot both be right; that only happens when the sensor clock stepped (a
+reboot), so the window restarts from the new sample.
+"""
+
+from __future__ import annotations
+
+from collections import deque
+from dataclasses import dataclass, field
+
+__all__ = ["SYNC_FILTER_WINDOW", "SyncSample", "SyncSampleWindow"]
+
+# Exchanges kept per client; at the ~5 s sync cadence this spans ~40 s.
+SYNC_FILTER_WINDOW = 8
+# Generous bound on ESP32 crystal vs. Pi clock drift (±20 ppm parts each side
+# plus temperature); only used to age samples, not to correct for drift.
+_DRIFT_BOUND_PPM = 50
+
+
+@dataclass(frozen=True, slots=True)
+class SyncSample:
+    """One completed sync exchange on the server monotonic clock."""
+
+    offset_us: int
+    rtt_us: int
+    receive_us: int
+
+    def error_bound_us(self, now_us: int) -> int:
+        """Return the worst-case offset error of this sample at *now_us*."""
+
+        age_us = max(0, now_us - self.receive_us)
+        return (self.rtt_us // 2) + (age_us * _DRIFT_BOUND_PPM) // 1_000_000
+
+
+@dataclass(slots=True)
+class SyncSampleWindow:
+    """Bounded history of sync samples; ``best`` picks the tightest one."""
+
+    window_size: int = SYNC_FILTER_WINDOW
+    _samples: deque[SyncSample] = field(default_factory=deque)
+
+    def clear(self) -> None:
+        """Forget every sample (e.g. after a sensor reset)."""
+
+        self._samples.clear()
+
+    def __len__(self) -> int:
+        return len(self._samples)
+
+    def add(self, sample: SyncSample) -> SyncSample:
+        """Record *sample* and return the best sample as of its receive time."""
+
+        now_us = sample.receive_us
+        if self._samples:
+            best = self.best(now_us)
+            tolerance_us = best.error_bound_us(now_us) + sample.error_bound_us(now_us)
+            if abs(sample.offset_us - best.offset_us) > tolerance_us:
+                self._samples.clear()
+        self._samples.append(sample)
+        while len(self._samples) > max(1, self.window_size):
+            self._samples.popleft()
+        return self.best(now_us)
+
+    def best(self, now_us: int) -> SyncSample:
+        """Return the sample with the smallest error bound at *now_us*."""
+
+        if not self._samples:
+            raise LookupError("no sync samples recorded")
+        return min(self._samples, key=lambda sample: sample.error_bound_us(now_us))
@@ -57,6 +57,8 @@ class UdpTransportLifecycle:
         raw_capture_sink: object | None = None,
         queue_maxsize: int,
         ingest_diagnostics: object | None = None,
+        backlog_stream_port: int = 0,
+        tsf_ifname: str = "",
     ) -> None:
         self._data_transport, consumer = await self._start_udp_receiver(
             host=host,
@@ -66,6 +68,8 @@ class UdpTransportLifecycle:
             raw_capture_sink=raw_capture_sink,
             queue_maxsize=queue_maxsize,
             ingest_diagnostics=ingest_diagnostics,
+            backlog_stream_port=backlog_stream_port,
+            tsf_ifname=tsf_ifname,
         )
         if consumer is not None:
             self._start_background_task(consumer.process_queue)
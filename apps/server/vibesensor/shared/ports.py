@@ -362,6 +362,7 @@ class RegistryHelloMessage(Protocol):
     firmware_version: str
     frame_samples: int
     queue_overflow_drops: int
+    capabilities: int
 
 
 class RegistryDataMessage(Protocol):
@@ -371,6 +372,8 @@ class RegistryDataMessage(Protocol):
     seq: int
     t0_us: int
     sample_count: int
+    pulse_edge_count: int | None
+    pulse_last_edge_offset_us: int | None
 
 
 class RegistryAckMessage(Protocol):
@@ -42,6 +42,12 @@ from vibesensor.shared.types.whole_run_analysis import (
     WholeRunWindowPolicy,
 )
 from vibesensor.shared.window_quality import score_window_quality
+from vibesensor.use_cases.diagnostics.whole_run_spectral_cache import (
+    WholeRunSpectralChunk,
+    WholeRunSpectralChunkCache,
+    raw_capture_source_digest,
+    spectral_chunk_cache_key,
+)
 from vibesensor.use_cases.diagnostics.whole_run_spectral_projection import (
     WholeRunSpectralCoverageSummary,
     WholeRunWindowSpectralSummary,
@@ -115,6 +121,7 @@ class _SpectralChunk:
     raw_range_reader: RawCaptureRangeReader
     chunk_index: int
     windows: tuple[WholeRunWindowDescriptor, ...]
+    cache_key: str | None = None
 
 
 @dataclass(frozen=True, slots=True)
@@ -134,6 +141,7 @@ def build_whole_run_spectral_artifact_bundle(
     max_workers: int = DEFAULT_WHOLE_RUN_MAX_WORKERS,
     chunk_window_count: int = _DEFAULT_CHUNK_WINDOW_COUNT,
     created_at: str | None = None,
+    spectral_cache: WholeRunSpectralChunkCache | None = None,
 ) -> WholeRunSpectralBuildResult:
     """Compute deterministic time-aligned whole-run spectral artifacts from raw capture."""
 
@@ -161,6 +169,7 @@ def build_whole_run_spectral_artifact_bundle(
         max_workers=max_workers,
         chunk_window_count=chunk_window_count,
         created_at=created_at,
+        spectral_cache=spectral_cache,
     )
 
 
@@ -173,6 +182,7 @@ def build_whole_run_spectral_artifact_bundle_from_ranges(
     max_workers: int = DEFAULT_WHOLE_RUN_MAX_WORKERS,
     chunk_window_count: int = _DEFAULT_CHUNK_WINDOW_COUNT,
     created_at: str | None = None,
+    spectral_cache: WholeRunSpectralChunkCache | None = None,
 ) -> WholeRunSpectralBuildResult:
     """Compute whole-run spectral artifacts from manifest metadata and bounded raw reads."""
 
@@ -196,6 +206,7 @@ def build_whole_run_spectral_artifact_bundle_from_ranges(
         max_workers=max_workers,
         chunk_window_count=chunk_window_count,
         created_at=created_at,
+        spectral_cache=spectral_cache,
     )
 
 
@@ -209,6 +220,7 @@ def _build_whole_run_spectral_artifact_bundle_with_ranges(
     max_workers: int,
     chunk_window_count: int,
     created_at: str | None,
+    spectral_cache: WholeRunSpectralChunkCache | None,
 ) -> WholeRunSpectralBuildResult:
     sensors = tuple(sensors)
     if not sensors:
@@ -234,11 +246,16 @@ def _build_whole_run_spectral_artifact_bundle_with_ranges(
         raw_range_reader=raw_range_reader,
         plan=plan,
         chunk_window_count=chunk_window_count,
+        source_digest=(
+            raw_capture_source_digest(raw_capture_manifest) if spectral_cache is not None else None
+        ),
+        metadata=metadata,
     )
     chunk_results = _execute_chunks(
         chunks=chunks,
         metadata=metadata,
         max_workers=max_workers,
+        spectral_cache=spectral_cache,
     )
     summaries_by_sensor = {
         sensor_id: tuple(summary for result in sensor_results for summary in result.summaries)
@@ -533,6 +550,8 @@ def _build_chunks(
     raw_range_reader: RawCaptureRangeReader,
     plan: WholeRunWindowPlan,
     chunk_window_count: int,
+    source_digest: str | None,
+    metadata: RunMetadata,
 ) -> tuple[_SpectralChunk, ...]:
     normalized_chunk_size = max(1, int(chunk_window_count))
     chunks: list[_SpectralChunk] = []
@@ -548,6 +567,16 @@ def _build_chunks(
                     raw_range_reader=raw_range_reader,
                     chunk_index=chunk_index,
                     windows=chunk_windows,
+                    cache_key=(
+                        spectral_chunk_cache_key(
+                            source_digest=source_digest,
+                            sensor_id=sensor_data.manifest.client_id,
+                            windows=chunk_windows,
+                            metadata=metadata,
+                        )
+                        if source_digest is not None
+                        else None
+                    ),
                 )
             )
     return tuple(chunks)
@@ -558,6 +587,7 @@ def _execute_chunks(
     chunks: Sequence[_SpectralChunk],
     metadata: RunMetadata,
     max_workers: int,
+    spectral_cache: WholeRunSpectralChunkCache | None = None,
 ) -> tuple[_SpectralChunkResult, ...]:
     if not chunks:
         return ()
@@ -566,6 +596,7 @@ def _execute_chunks(
             _process_chunk(
                 chunk=chunk,
                 metadata=metadata,
+                spectral_cache=spectral_cache,
             )
             for chunk in chunks
         )
@@ -599,6 +630,7 @@ def _execute_chunks(
                         _process_chunk,
                         chunk=chunks[next_chunk_position],
                         metadata=metadata,
+                        spectral_cache=spectral_cache,
                     )
                 ] = next_chunk_position
                 next_chunk_position += 1
@@ -664,6 +696,35 @@ def _process_chunk(
     *,
     chunk: _SpectralChunk,
     metadata: RunMetadata,
+    spectral_cache: WholeRunSpectralChunkCache | None = None,
+) -> _SpectralChunkResult:
+    if spectral_cache is None or chunk.cache_key is None:
+        return _compute_chunk(chunk=chunk, metadata=metadata)
+    cached = spectral_cache.load(chunk.cache_key)
+    if cached is not None and len(cached.summaries) == len(chunk.windows):
+        return _SpectralChunkResult(
+            sensor_id=chunk.sensor.manifest.client_id,
+            chunk_index=chunk.chunk_index,
+            freq_hz=tuple(float(value) for value in cached.freq_hz),
+            spectrum_rows=cached.spectrum_rows,
+            summaries=cached.summaries,
+        )
+    result = _compute_chunk(chunk=chunk, metadata=metadata)
+    spectral_cache.store(
+        chunk.cache_key,
+        WholeRunSpectralChunk(
+            freq_hz=np.asarray(result.freq_hz, dtype=np.float64),
+            spectrum_rows=result.spectrum_rows,
+            summaries=result.summaries,
+        ),
+    )
+    return result
+
+
+def _compute_chunk(
+    *,
+    chunk: _SpectralChunk,
+    metadata: RunMetadata,
 ) -> _SpectralChunkResult:
     sensor_manifest = chunk.sensor.manifest
     sample_rate_hz = int(sensor_manifest.sample_rate_hz or 0)
@@ -0,0 +1,107 @@
+"""Cache port and content keys for reusing whole-run spectral chunks."""
+
+from __future__ import annotations
+
+import hashlib
+import json
+from collections.abc import Sequence
+from dataclasses import dataclass
+from typing import Protocol
+
+import numpy as np
+
+from vibesensor.shared.constants.dsp import SPECTRUM_MAX_HZ, SPECTRUM_MIN_HZ
+from vibesensor.shared.types.raw_capture import RawCaptureManifest
+from vibesensor.shared.types.run_schema import RunMetadata
+from vibesensor.shared.types.whole_run_analysis import (
+    WHOLE_RUN_ALGORITHM_VERSIONS,
+    WholeRunWindowDescriptor,
+)
+from vibesensor.use_cases.diagnostics.whole_run_spectral_projection import (
+    WholeRunWindowSpectralSummary,
+)
+
+__all__ = [
+    "WholeRunSpectralCacheStats",
+    "WholeRunSpectralChunk",
+    "WholeRunSpectralChunkCache",
+    "raw_capture_source_digest",
+    "spectral_chunk_cache_key",
+]
+
+
+@dataclass(frozen=True, slots=True)
+class WholeRunSpectralChunk:
+    """Spectral rows and window summaries for one sensor's run of adjacent windows."""
+
+    freq_hz: np.ndarray
+    spectrum_rows: np.ndarray
+    summaries: tuple[WholeRunWindowSpectralSummary, ...]
+
+
+@dataclass(frozen=True, slots=True)
+class WholeRunSpectralCacheStats:
+    """Current spectral cache disk-budget state and hit counters."""
+
+    entry_count: int
+    total_bytes: int
+    max_bytes: int
+    hits: int
+    misses: int
+
+
+class WholeRunSpectralChunkCache(Protocol):
+    """Content-addressed store for spectral chunks reused across re-analyses.
+
+    Keys come from :func:`spectral_chunk_cache_key`, so an entry stays valid
+    for exactly as long as the raw capture and DSP inputs behind it do.
+    """
+
+    def load(self, key: str) -> WholeRunSpectralChunk | None: ...
+
+    def store(self, key: str, chunk: WholeRunSpectralChunk) -> None: ...
+
+    def stats(self) -> WholeRunSpectralCacheStats: ...
+
+
+def raw_capture_source_digest(raw_capture_manifest: RawCaptureManifest) -> str:
+    """Digest the finalized raw-capture manifest that a run's spectra derive from."""
+    # The finalized manifest pins every chunk count, byte count, timeline anchor
+    # and loss counter, so it stands in for the raw bytes it describes.
+    return _canonical_digest(raw_capture_manifest.to_json_object())
+
+
+def spectral_chunk_cache_key(
+    *,
+    source_digest: str,
+    sensor_id: str,
+    windows: Sequence[WholeRunWindowDescriptor],
+    metadata: RunMetadata,
+) -> str:
+    """Key one sensor's window range by everything its spectra depend on.
+
+    Car profile, order references and context settings are deliberately left
+    out: they only affect the stages downstream of the spectra.
+    """
+    first_window = windows[0]
+    last_window = windows[-1]
+    return _canonical_digest(
+        {
+            "source_digest": source_digest,
+            "sensor_id": sensor_id,
+            "window_count": len(windows),
+            "window_index_range": [first_window.window_index, last_window.window_index],
+            "window_end_t_s_range": [first_window.end_t_s, last_window.end_t_s],
+            "window_sample_count": first_window.sample_count,
+            "fft_window_size_samples": int(metadata.fft_window_size_samples or 0),
+            "accel_scale_g_per_lsb": metadata.accel_scale_g_per_lsb,
+            "spectrum_min_hz": SPECTRUM_MIN_HZ,
+            "spectrum_max_hz": SPECTRUM_MAX_HZ,
+            "algorithm_version": WHOLE_RUN_ALGORITHM_VERSIONS["whole_run_spectra"],
+        }
+    )
+
+
+def _canonical_digest(payload: object) -> str:
+    encoded = json.dumps(payload, sort_keys=True, separators=(",", ":"))
+    return hashlib.sha256(encoded.encode("utf-8")).hexdigest()
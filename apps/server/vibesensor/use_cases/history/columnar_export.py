@@ -0,0 +1,283 @@
+"""Per-column block encoding for streamed columnar history exports.
+
+A columnar export is a ZIP archive written front to back, so it can stream
+without a seekable spool:
+
+- ``schema.json`` lists every column with its encoding.
+- ``blocks/<n>/`` holds one member per column for each sample batch, plus
+  ``block.json`` with the row count and the block's string dictionaries.
+- ``raw/<sensor>/<n>.npy`` holds consecutive raw-capture segments per sensor,
+  in the order ``schema.json`` lists the sensors.
+
+Column encodings, chosen so the archive's deflate pass has little left to do:
+
+``f8-xor``
+    float64 bit patterns XORed with the previous row (``uint64`` ``.npy``).
+    Slowly varying signals share sign, exponent and high mantissa bits, so
+    most of each word becomes zero.  ``None`` is stored as NaN.
+``i8-delta``
+    int64 first differences (``.npy``).  ``None`` is stored as ``INT64_MIN``
+    before differencing; wrap-around keeps the cumulative sum exact.
+``dict``
+    int16 codes (``.npy``) into the block's dictionary, ``-1`` for ``None``.
+``json``
+    JSON array of strings, for high-cardinality text such as ``top_peaks``.
+``i2-delta``
+    Raw int16 ``(n, 3)`` samples as per-axis first differences, wrapping in
+    int16 so the cumulative sum restores the counts exactly.
+
+Every member is a plain ``.npy`` or ``.json`` file, so a laptop with numpy can
+read the archive without VibeSensor installed.
+"""
+
+from __future__ import annotations
+
+import json
+import zipfile
+from collections.abc import Callable, Sequence
+from dataclasses import dataclass
+from io import BytesIO
+from typing import Literal
+
+import numpy as np
+
+from vibesensor.shared.boundaries.codecs import strength_peak_payloads
+from vibesensor.shared.json_utils import json_text_dumps
+from vibesensor.shared.types.json_types import JsonObject
+from vibesensor.shared.types.raw_capture import RawCaptureSensorManifest
+from vibesensor.shared.types.sensor_frame import SensorFrame
+
+COLUMNAR_EXPORT_FORMAT = "vibesensor-columnar"
+COLUMNAR_EXPORT_VERSION = 1
+COLUMNAR_SCHEMA_MEMBER = "schema.json"
+
+RAW_CAPTURE_ENCODING = "i2-delta"
+
+type ColumnEncoding = Literal["f8-xor", "i8-delta", "dict", "json"]
+
+_INT_NULL = np.iinfo(np.int64).min
+_DICT_NULL = -1
+
+
+@dataclass(frozen=True, slots=True)
+class ColumnarExportColumn:
+    """One exported column and how its values are pulled from a frame."""
+
+    name: str
+    encoding: ColumnEncoding
+    value: Callable[[SensorFrame], object]
+
+    @property
+    def member_suffix(self) -> str:
+        return ".json" if self.encoding == "json" else ".npy"
+
+
+def _attr(name: str) -> Callable[[SensorFrame], object]:
+    return lambda frame: getattr(frame, name)
+
+
+def _synced_label(frame: SensorFrame) -> str | None:
+    if frame.analysis_window_synced is None:
+        return None
+    return "true" if frame.analysis_window_synced else "false"
+
+
+def _top_peaks_json(frame: SensorFrame) -> str:
+    return json_text_dumps(strength_peak_payloads(frame.top_peaks))
+
+
+def _column(name: str, encoding: ColumnEncoding) -> ColumnarExportColumn:
+    return ColumnarExportColumn(name=name, encoding=encoding, value=_attr(name))
+
+
+# Same column order as ``EXPORT_CSV_COLUMNS``.
+COLUMNAR_EXPORT_COLUMNS: tuple[ColumnarExportColumn, ...] = (
+    _column("run_id", "dict"),
+    _column("timestamp_utc", "json"),
+    _column("t_s", "f8-xor"),
+    _column("analysis_window_start_us", "i8-delta"),
+    _column("analysis_window_end_us", "i8-delta"),
+    ColumnarExportColumn("analysis_window_synced", "dict", _synced_label),
+    _column("client_id", "dict"),
+    _column("client_name", "dict"),
+    _column("location", "dict"),
+    _column("sample_rate_hz", "i8-delta"),
+    _column("speed_kmh", "f8-xor"),
+    _column("gps_speed_kmh", "f8-xor"),
+    _column("speed_source", "dict"),
+    _column("engine_rpm", "f8-xor"),
+    _column("engine_rpm_source", "dict"),
+    _column("gear", "f8-xor"),
+    _column("final_drive_ratio", "f8-xor"),
+    _column("accel_x_g", "f8-xor"),
+    _column("accel_y_g", "f8-xor"),
+    _column("accel_z_g", "f8-xor"),
+    _column("dominant_freq_hz", "f8-xor"),
+    _column("dominant_axis", "dict"),
+    ColumnarExportColumn("top_peaks", "json", _top_peaks_json),
+    _column("vibration_strength_db", "f8-xor"),
+    _column("strength_bucket", "dict"),
+    _column("strength_peak_amp_g", "f8-xor"),
+    _column("strength_floor_amp_g", "f8-xor"),
+    _column("frames_dropped_total", "i8-delta"),
+    _column("queue_overflow_drops", "i8-delta"),
+)
+
+
+def columnar_export_schema_json(
+    raw_sensors: Sequence[RawCaptureSensorManifest] = (),
+) -> str:
+    """Return the ``schema.json`` member written at the head of every archive."""
+    return json_text_dumps(
+        {
+            "format": COLUMNAR_EXPORT_FORMAT,
+            "version": COLUMNAR_EXPORT_VERSION,
+            "columns": [
+                {"name": column.name, "encoding": column.encoding}
+                for column in COLUMNAR_EXPORT_COLUMNS
+            ],
+            "raw_capture": {
+                "encoding": RAW_CAPTURE_ENCODING,
+                "sensors": [
+                    {
+                        "client_id": sensor.client_id,
+                        "sample_rate_hz": sensor.sample_rate_hz,
+                        "sample_count": sensor.sample_count,
+                    }
+                    for sensor in raw_sensors
+                ],
+            },
+        },
+        indent=2,
+    )
+
+
+def encode_columnar_block(
+    frames: Sequence[SensorFrame],
+    *,
+    block_index: int,
+) -> list[tuple[str, bytes]]:
+    """Encode one sample batch into ``(member_name, payload)`` archive members."""
+    prefix = f"blocks/{block_index:06d}/"
+    dictionaries: JsonObject = {}
+    members: list[tuple[str, bytes]] = []
+    for column in COLUMNAR_EXPORT_COLUMNS:
+        values = [column.value(frame) for frame in frames]
+        if column.encoding == "f8-xor":
+            payload = _npy_bytes(_encode_f8_xor(values))
+        elif column.encoding == "i8-delta":
+            payload = _npy_bytes(_encode_i8_delta(values))
+        elif column.encoding == "dict":
+            codes, dictionary = _encode_dict(values)
+            dictionaries[column.name] = list(dictionary)
+            payload = _npy_bytes(codes)
+        else:
+            payload = json_text_dumps(values).encode("utf-8")
+        members.append((f"{prefix}{column.name}{column.member_suffix}", payload))
+    members.append(
+        (
+            f"{prefix}block.json",
+            json_text_dumps({"row_count": len(frames), "dictionaries": dictionaries}).encode(
+                "utf-8"
+            ),
+        )
+    )
+    return members
+
+
+def encode_raw_capture_segment(
+    samples_i16: np.ndarray,
+    *,
+    sensor_index: int,
+    segment_index: int,
+) -> tuple[str, bytes]:
+    """Encode one raw-capture segment into its ``(member_name, payload)`` pair."""
+    deltas = np.array(samples_i16, dtype=np.int16, copy=True)
+    # Each segment restarts the delta chain so segments decode independently.
+    deltas[1:] -= samples_i16[:-1]
+    return f"raw/{sensor_index:02d}/{segment_index:06d}.npy", _npy_bytes(deltas)
+
+
+def read_columnar_export(archive: zipfile.ZipFile) -> dict[str, list[object]]:
+    """Decode a columnar export archive back into per-column Python lists."""
+    schema = json.loads(archive.read(COLUMNAR_SCHEMA_MEMBER))
+    if not isinstance(schema, dict) or schema.get("format") != COLUMNAR_EXPORT_FORMAT:
+        raise ValueError("not a columnar history export")
+    columns = [(str(entry["name"]), str(entry["encoding"])) for entry in schema["columns"]]
+    decoded: dict[str, list[object]] = {name: [] for name, _encoding in columns}
+    block_prefixes = sorted(
+        {name.rsplit("/", 1)[0] for name in archive.namelist() if name.startswith("blocks/")}
+    )
+    for prefix in block_prefixes:
+        block = json.loads(archive.read(f"{prefix}/block.json"))
+        dictionaries = block["dictionaries"]
+        for name, encoding in columns:
+            if encoding == "json":
+                decoded[name].extend(json.loads(archive.read(f"{prefix}/{name}.json")))
+                continue
+            array = np.load(BytesIO(archive.read(f"{prefix}/{name}.npy")), allow_pickle=False)
+            if encoding == "f8-xor":
+                floats = np.bitwise_xor.accumulate(array).view(np.float64)
+                decoded[name].extend(None if np.isnan(v) else float(v) for v in floats)
+            elif encoding == "i8-delta":
+                ints = np.cumsum(array, dtype=np.int64)
+                decoded[name].extend(None if v == _INT_NULL else int(v) for v in ints)
+            else:
+                dictionary = dictionaries[name]
+                decoded[name].extend(None if c == _DICT_NULL else dictionary[c] for c in array)
+    return decoded
+
+
+def read_columnar_raw_capture(archive: zipfile.ZipFile) -> dict[str, np.ndarray]:
+    """Decode the raw-capture segments of a columnar export, keyed by client id."""
+    schema = json.loads(archive.read(COLUMNAR_SCHEMA_MEMBER))
+    sensors = schema["raw_capture"]["sensors"]
+    names = archive.namelist()
+    decoded: dict[str, np.ndarray] = {}
+    for sensor_index, sensor in enumerate(sensors):
+        prefix = f"raw/{sensor_index:02d}/"
+        segments = [
+            np.cumsum(
+                np.load(BytesIO(archive.read(name)), allow_pickle=False),
+                axis=0,
+                dtype=np.int16,
+            )
+            for name in sorted(name for name in names if name.startswith(prefix))
+        ]
+        decoded[str(sensor["client_id"])] = (
+            np.concatenate(segments) if segments else np.empty((0, 3), dtype=np.int16)
+        )
+    return decoded
+
+
+def _encode_f8_xor(values: list[object]) -> np.ndarray:
+    floats = np.array([np.nan if v is None else v for v in values], dtype=np.float64)
+    bits = floats.view(np.uint64)
+    xored = bits.copy()
+    xored[1:] ^= bits[:-1]
+    return xored
+
+
+def _encode_i8_delta(values: list[object]) -> np.ndarray:
+    ints = np.array([_INT_NULL if v is None else v for v in values], dtype=np.int64)
+    deltas = ints.copy()
+    with np.errstate(over="ignore"):
+        deltas[1:] -= ints[:-1]
+    return deltas
+
+
+def _encode_dict(values: list[object]) -> tuple[np.ndarray, tuple[str, ...]]:
+    index: dict[str, int] = {}
+    codes = np.empty(len(values), dtype=np.int16)
+    for row, value in enumerate(values):
+        if value is None:
+            codes[row] = _DICT_NULL
+            continue
+        codes[row] = index.setdefault(str(value), len(index))
+    return codes, tuple(index)
+
+
+def _npy_bytes(array: np.ndarray) -> bytes:
+    buffer = BytesIO()
+    np.save(buffer, array, allow_pickle=False)
+    return buffer.getvalue()
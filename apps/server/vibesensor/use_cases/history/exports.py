@@ -1,4 +1,4 @@
-"""CSV/ZIP export shaping and streaming for history runs."""
+"""CSV/ZIP/columnar export shaping and streaming for history runs."""
 
 from __future__ import annotations
 
@@ -6,7 +6,7 @@ import csv
 import io
 import logging
 import tempfile
-from collections.abc import Iterator
+from collections.abc import AsyncIterator, Iterator
 from dataclasses import dataclass
 
 from vibesensor.shared.boundaries.sensor_frames import sensor_frame_to_json_object
@@ -15,6 +15,8 @@ from vibesensor.shared.json_utils import json_text_dumps, sanitize_for_json
 from vibesensor.shared.ports import RunPersistence
 from vibesensor.shared.types.history_records import StoredHistoryRun
 from vibesensor.shared.types.json_types import JsonObject
+from vibesensor.shared.types.raw_capture import RawCaptureManifest, RawCaptureSensorRange
+from vibesensor.shared.types.sensor_frame import SensorFrame
 from vibesensor.use_cases.history.helpers import async_require_run
 
 LOGGER = logging.getLogger(__name__)
@@ -22,6 +24,7 @@ LOGGER = logging.getLogger(__name__)
 EXPORT_BATCH_SIZE = 2048
 EXPORT_SPOOL_THRESHOLD = 4 * 1024 * 1024
 EXPORT_STREAM_CHUNK = 1024 * 1024
+EXPORT_RAW_SEGMENT_SAMPLES = 64 * 1024
 
 EXPORT_CSV_COLUMNS: tuple[str, ...] = (
     "run_id",
@@ -89,6 +92,15 @@ class HistoryExportDownload:
             self.spool.close()
 
 
+@dataclass
+class HistoryExportStream:
+    """Unsized export streamed batch by batch straight to the response."""
+
+    filename: str
+    media_type: str
+    chunks: AsyncIterator[bytes]
+
+
 @dataclass
 class HistoryExportContext:
     """Raw export artifacts ready for adapter-level packaging."""
@@ -119,6 +131,44 @@ class HistoryExportService:
             raw_csv_spool=raw_csv_spool,
         )
 
+    async def load_export_run(self, run_id: str) -> StoredHistoryRun:
+        """Resolve the run up front so a streamed export can 404 before it starts."""
+        return await async_require_run(self._history_db, run_id)
+
+    def aiter_sample_batches(self, run_id: str) -> AsyncIterator[list[SensorFrame]]:
+        return self._history_db.aiter_run_samples(run_id, batch_size=EXPORT_BATCH_SIZE)
+
+    async def aiter_csv_chunks(self, run_id: str) -> AsyncIterator[bytes]:
+        """Yield the raw-sample CSV one encoded batch at a time."""
+        buffer = io.StringIO(newline="")
+        writer = csv.DictWriter(buffer, fieldnames=EXPORT_CSV_COLUMNS, extrasaction="ignore")
+        writer.writeheader()
+        async for batch in self.aiter_sample_batches(run_id):
+            writer.writerows(flatten_for_csv(sensor_frame_to_json_object(row)) for row in batch)
+            yield buffer.getvalue().encode("utf-8")
+            buffer.seek(0)
+            buffer.truncate()
+        if buffer.tell():
+            yield buffer.getvalue().encode("utf-8")
+
+    async def aiter_raw_capture_segments(
+        self,
+        run_id: str,
+        manifest: RawCaptureManifest,
+    ) -> AsyncIterator[tuple[int, RawCaptureSensorRange]]:
+        """Yield ``(sensor_index, range)`` reads walking each sensor's capture in order."""
+        for sensor_index, sensor in enumerate(manifest.sensors):
+            for sample_start in range(0, sensor.sample_count, EXPORT_RAW_SEGMENT_SAMPLES):
+                raw_range = await self._history_db.aload_raw_capture_sensor_range(
+                    run_id,
+                    sensor.client_id,
+                    sample_start=sample_start,
+                    sample_count=EXPORT_RAW_SEGMENT_SAMPLES,
+                )
+                if raw_range is None or raw_range.samples_i16.shape[0] == 0:
+                    break
+                yield sensor_index, raw_range
+
     async def _build_raw_csv_spool(
         self,
         run_id: str,
@@ -108,6 +108,8 @@ def build_isolated_server_config(
     udp["data_port"] = udp_data_port
     udp["control_host"] = host
     udp["control_port"] = udp_control_port
+    # Parallel isolated servers share the host; keep the fixed TCP replay port unbound.
+    udp["backlog_stream_port"] = 0
 
     gps = _mapping_section(data, "gps")
     gps["gps_enabled"] = False
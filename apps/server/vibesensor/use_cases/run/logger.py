@@ -28,6 +28,7 @@ from vibesensor.shared.types.raw_capture import (
     RawCaptureSensorClockSync,
 )
 from vibesensor.shared.types.run_schema import RunRawCaptureFinalize
+from vibesensor.use_cases.diagnostics.whole_run_spectral_cache import WholeRunSpectralChunkCache
 from vibesensor.use_cases.run.capture_readiness import CaptureReadinessTracker
 from vibesensor.use_cases.run.capture_readiness_observation import observe_capture_readiness
 from vibesensor.use_cases.run.finalize_stages import (
@@ -95,6 +96,7 @@ class RunRecorder:
         sensor_metadata_reader: SensorMetadataReader | None = None,
         language_reader: LanguageReader | None = None,
         ingest_diagnostics: IngestDiagnosticsCollector | None = None,
+        whole_run_spectral_cache: WholeRunSpectralChunkCache | None = None,
     ):
         self.metrics_log_hz = max(1, config.metrics_log_hz)
         self.registry = registry
@@ -139,6 +141,7 @@ class RunRecorder:
             error_callback=self._persistence.set_last_write_error,
             clear_error_callback=self._persistence.clear_last_write_error,
             analysis_runner=build_post_analysis_summary,
+            whole_run_spectral_cache=whole_run_spectral_cache,
         )
         self._raw_capture = RunRawCaptureWriter(
             history_db=history_db if config.persist_history_db else None,
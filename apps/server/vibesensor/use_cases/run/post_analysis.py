@@ -14,13 +14,16 @@ from __future__ import annotations
 import logging
 import time
 from collections.abc import Callable
+from functools import partial
 from threading import Event, RLock, Thread
 
 from vibesensor.shared.ports import RunPersistence
+from vibesensor.use_cases.diagnostics.whole_run_spectral_cache import WholeRunSpectralChunkCache
 from vibesensor.use_cases.run.post_analysis_executor import (
     PostAnalysisAttemptResult,
     PostAnalysisExecutionConfig,
     PostAnalysisRunner,
+    PostAnalysisWholeRunBuilderConfig,
     execute_post_analysis,
 )
 from vibesensor.use_cases.run.post_analysis_failures import (
@@ -37,6 +40,7 @@ from vibesensor.use_cases.run.post_analysis_state import (
     PostAnalysisState,
 )
 from vibesensor.use_cases.run.post_analysis_summary import build_post_analysis_summary
+from vibesensor.use_cases.run.post_analysis_whole_run_builders import build_whole_run_artifacts
 
 LOGGER = logging.getLogger(__name__)
 
@@ -61,6 +65,11 @@ class PostAnalysisWorker:
         Callable that builds the persisted analysis summary once metadata and
         samples have been loaded. `RunRecorder` injects the concrete
         diagnostics implementation.
+    whole_run_spectral_cache:
+        Optional content-addressed spectral chunk store.  When set, re-analysing
+        a run whose raw capture and DSP parameters are unchanged (for example
+        after a car-profile edit) reuses its spectra and reruns only the
+        downstream context/order stages.
 
     Notes
     -----
@@ -75,11 +84,23 @@ class PostAnalysisWorker:
         error_callback: Callable[[str], None] | None = None,
         clear_error_callback: Callable[[], None] | None = None,
         analysis_runner: PostAnalysisRunner = build_post_analysis_summary,
+        whole_run_spectral_cache: WholeRunSpectralChunkCache | None = None,
     ) -> None:
         self._history_db = history_db
         self._error_cb = error_callback or (lambda _msg: None)
         self._clear_error_cb = clear_error_callback or (lambda: None)
         self._analysis_runner = analysis_runner
+        self._spectral_cache = whole_run_spectral_cache
+        self._whole_run_builders = (
+            PostAnalysisWholeRunBuilderConfig(
+                artifact_builder=partial(
+                    build_whole_run_artifacts,
+                    spectral_cache=whole_run_spectral_cache,
+                ),
+            )
+            if whole_run_spectral_cache is not None
+            else PostAnalysisWholeRunBuilderConfig()
+        )
         self._unexpected_bug_recorder = UnexpectedPostAnalysisBugRecorder(
             history_db=history_db,
             error_callback=self._error_cb,
@@ -213,6 +234,21 @@ class PostAnalysisWorker:
                 return
             with self._lock:
                 self._state.finish_active(run_id)
+            self._log_spectral_cache_stats(run_id)
+
+    def _log_spectral_cache_stats(self, run_id: str) -> None:
+        if self._spectral_cache is None:
+            return
+        stats = self._spectral_cache.stats()
+        LOGGER.info(
+            "Whole-run spectral cache after run %s: %d entries, %d of %d bytes, %d hits, %d misses",
+            run_id,
+            stats.entry_count,
+            stats.total_bytes,
+            stats.max_bytes,
+            stats.hits,
+            stats.misses,
+        )
 
     def _handle_unexpected_run_bug(self, run_id: str, exc: Exception) -> None:
         with self._lock:
@@ -244,6 +280,7 @@ class PostAnalysisWorker:
                 db=db,
                 config=PostAnalysisExecutionConfig(
                     analysis_runner=self._analysis_runner,
+                    whole_run_builders=self._whole_run_builders,
                     defer_retryable_error_storage=defer_retryable_error_storage,
                 ),
             )
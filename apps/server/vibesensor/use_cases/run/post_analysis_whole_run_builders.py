@@ -33,6 +33,7 @@ from vibesensor.use_cases.diagnostics.whole_run_spectra import (
     WholeRunSpectralBuildResult,
     build_whole_run_spectral_artifact_bundle_from_ranges,
 )
+from vibesensor.use_cases.diagnostics.whole_run_spectral_cache import WholeRunSpectralChunkCache
 from vibesensor.use_cases.diagnostics.whole_run_windows import WholeRunWindowPlan
 from vibesensor.use_cases.run.post_analysis_input import PostAnalysisRunInput
 
@@ -51,12 +52,14 @@ def build_whole_run_artifacts(
     metadata: RunMetadata,
     raw_capture_manifest: RawCaptureManifest,
     raw_range_reader: RawCaptureRangeReader,
+    spectral_cache: WholeRunSpectralChunkCache | None = None,
 ) -> WholeRunSpectralBuildResult:
     return build_whole_run_spectral_artifact_bundle_from_ranges(
         run_id=run_id,
         metadata=metadata,
         raw_capture_manifest=raw_capture_manifest,
         raw_range_reader=raw_range_reader,
+        spectral_cache=spectral_cache,
     )
 
 
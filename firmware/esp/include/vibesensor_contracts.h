@@ -10,4 +10,5 @@
 
 #define VS_SERVER_UDP_DATA_PORT 9000
 #define VS_SERVER_UDP_CONTROL_PORT 9001
+#define VS_SERVER_BACKLOG_STREAM_PORT 9002
 #define VS_FIRMWARE_CONTROL_PORT_BASE 9010
@@ -14,7 +14,9 @@ constexpr uint8_t VALUE_DEVID = 0xE5;
 constexpr uint8_t VALUE_POWER_CTL_STANDBY = 0x00;
 constexpr uint8_t VALUE_POWER_CTL_MEASURE = 0x08;
 constexpr uint8_t VALUE_INT_ENABLE_WATERMARK = 0x02;
+constexpr uint8_t VALUE_DATA_FORMAT_FULL_RES = 0x08;
 constexpr uint8_t VALUE_DATA_FORMAT_FULL_RES_16G = 0x0B;
+constexpr uint8_t MASK_DATA_FORMAT_RANGE = 0x03;
 constexpr uint8_t VALUE_BW_RATE_800HZ = 0x0D;
 constexpr uint8_t VALUE_FIFO_STREAM_MODE = 0x80;
 constexpr uint8_t MASK_FIFO_WATERMARK = 0x1F;
@@ -127,6 +129,20 @@ bool ADXL345::available() const {
   return available_;
 }
 
+bool ADXL345::set_range(uint8_t range_code, FailureKind* failure_kind) {
+  set_failure(failure_kind, FailureKind::kNone);
+  if (!available_) {
+    return false;
+  }
+  if (!write_reg(REG_DATA_FORMAT,
+                 static_cast<uint8_t>(VALUE_DATA_FORMAT_FULL_RES |
+                                      (range_code & MASK_DATA_FORMAT_RANGE)))) {
+    set_failure(failure_kind, FailureKind::kConfigWrite);
+    return false;
+  }
+  return true;
+}
+
 size_t ADXL345::read_samples(int16_t* xyz_interleaved,
                              size_t max_samples,
                              FailureKind* failure_kind,
@@ -163,19 +179,21 @@ size_t ADXL345::read_samples(int16_t* xyz_interleaved,
   // The datasheet requires >= 5 µs between the end of one data-register
   // read (transition past 0x37) and the start of the next FIFO read or
   // FIFO_STATUS read, so the FIFO entry is fully popped.
-  uint8_t raw[6];
+  //
+  // DATAX0..DATAZ1 are little-endian X, Y, Z, which is exactly the layout of
+  // one interleaved int16 triple on the ESP32, so each entry is read straight
+  // into the caller's buffer (usually frame memory) with no staging copy.
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                "FIFO entries are decoded in place as little-endian int16");
   for (size_t i = 0; i < count; ++i) {
     if (i > 0) {
       delayMicroseconds(kFifoPopDelayUs);
     }
-    if (!read_multi(REG_DATAX0, raw, 6)) {
+    uint8_t* entry = reinterpret_cast<uint8_t*>(xyz_interleaved + (i * 3));
+    if (!read_multi(REG_DATAX0, entry, 6)) {
       set_failure(failure_kind, FailureKind::kFifoDataRead);
       return i;
     }
-    const size_t out = i * 3;
-    xyz_interleaved[out + 0] = static_cast<int16_t>(raw[0] | (raw[1] << 8));
-    xyz_interleaved[out + 1] = static_cast<int16_t>(raw[2] | (raw[3] << 8));
-    xyz_interleaved[out + 2] = static_cast<int16_t>(raw[4] | (raw[5] << 8));
   }
   return count;
 }
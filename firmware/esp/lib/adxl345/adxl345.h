@@ -23,9 +23,13 @@ class ADXL345 {
   bool begin(FailureKind* failure_kind = nullptr);
   bool recover_bus(FailureKind* failure_kind = nullptr);
   bool available() const;
+  // Switches the +/-g range (0 = 2 g ... 3 = 16 g) while staying in FULL_RES.
+  // begin() always starts at +/-16 g.
+  bool set_range(uint8_t range_code, FailureKind* failure_kind = nullptr);
 
-  // Reads up to max_samples from FIFO and writes XYZ triples into xyz_interleaved.
-  // Returns number of samples written.
+  // Reads up to max_samples from FIFO and writes XYZ triples into xyz_interleaved,
+  // decoding each entry in place, so the buffer can be the destination frame.
+  // Returns number of samples written; entries past that count are unspecified.
   size_t read_samples(int16_t* xyz_interleaved,
                       size_t max_samples,
                       FailureKind* failure_kind = nullptr,
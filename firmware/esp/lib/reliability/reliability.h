@@ -259,4 +259,120 @@ inline bool sensor_should_reinit(uint8_t consecutive_errors,
          static_cast<int32_t>(now_ms - last_reinit_ms) >= static_cast<int32_t>(cooldown_ms);
 }
 
+// Server-assigned TDMA transmit slot on the synced clock: the node may start
+// DATA transmissions while (now - offset) mod period lies inside width.
+struct TxSlotSchedule {
+  uint32_t offset_us = 0;
+  uint32_t period_us = 0;
+  uint32_t width_us = 0;
+};
+
+inline bool tx_slot_schedule_valid(const TxSlotSchedule& schedule) {
+  return schedule.period_us > 0U && schedule.width_us > 0U &&
+         schedule.width_us <= schedule.period_us && schedule.offset_us < schedule.period_us;
+}
+
+// Guard kept at both slot edges: a fixed floor, half the last sync round trip
+// (the offset's error bound) and worst-case crystal drift accumulated since
+// that sync. Capped so at least a quarter of the slot stays usable.
+inline uint32_t tx_slot_guard_us(uint32_t min_guard_us,
+                                 uint32_t sync_round_trip_us,
+                                 uint32_t since_sync_ms,
+                                 uint32_t drift_ppm,
+                                 uint32_t width_us) {
+  const uint64_t drift_us =
+      (static_cast<uint64_t>(since_sync_ms) * static_cast<uint64_t>(drift_ppm)) / 1000U;
+  const uint64_t guard_us =
+      static_cast<uint64_t>(min_guard_us) + (sync_round_trip_us / 2U) + drift_us;
+  const uint64_t cap_us = (static_cast<uint64_t>(width_us) * 3U) / 8U;
+  return static_cast<uint32_t>(guard_us > cap_us ? cap_us : guard_us);
+}
+
+// Microseconds of transmit window left in the current slot after the trailing
+// guard, or 0 when synced_now_us is outside the guarded slot.
+inline uint32_t tx_slot_remaining_us(const TxSlotSchedule& schedule,
+                                     int64_t synced_now_us,
+                                     uint32_t guard_us) {
+  if (!tx_slot_schedule_valid(schedule)) {
+    return 0;
+  }
+  const int64_t period = static_cast<int64_t>(schedule.period_us);
+  int64_t phase = (synced_now_us - static_cast<int64_t>(schedule.offset_us)) % period;
+  if (phase < 0) {
+    phase += period;
+  }
+  const uint64_t phase_us = static_cast<uint64_t>(phase);
+  const uint64_t usable_end_us =
+      schedule.width_us > guard_us ? static_cast<uint64_t>(schedule.width_us - guard_us) : 0U;
+  if (phase_us < guard_us || phase_us >= usable_end_us) {
+    return 0;
+  }
+  return static_cast<uint32_t>(usable_end_us - phase_us);
+}
+
+// ADXL345 +/-g range codes (DATA_FORMAT bits 0-1). In FULL_RES mode every
+// range reads about 3.9 mg/LSB; the range only sets the clip rail and how many
+// bits a sample occupies: 10 at +/-2 g up to 13 at +/-16 g.
+constexpr uint8_t kAccelRange2g = 0;
+constexpr uint8_t kAccelRange16g = 3;
+
+inline uint8_t accel_range_g(uint8_t range_code) {
+  return static_cast<uint8_t>(2U << range_code);
+}
+
+inline uint8_t accel_range_sample_bits(uint8_t range_code) {
+  return static_cast<uint8_t>(10U + range_code);
+}
+
+inline int32_t accel_range_rail_counts(uint8_t range_code) {
+  return (static_cast<int32_t>(1) << (9U + range_code)) - 1;
+}
+
+// True when a FULL_RES reading sits on the rail of range_code (the sensor
+// saturates there rather than wrapping).
+inline bool accel_sample_clipped(int16_t value, uint8_t range_code) {
+  const int32_t rail = accel_range_rail_counts(range_code);
+  return value >= rail || value <= -(rail + 1);
+}
+
+// Auto-range controller, evaluated once per frame. A clipped frame jumps
+// straight to +/-16 g, a peak above 3/4 of the rail steps up one range, and
+// the range only steps down after quiet_frames_to_step_down consecutive
+// frames whose peak would sit under 3/8 of the lower range's rail. The gap
+// between the two thresholds is the hysteresis.
+struct AutoRangeState {
+  uint8_t range_code = kAccelRange16g;
+  uint8_t quiet_frames = 0;
+};
+
+inline uint8_t auto_range_next(AutoRangeState& state,
+                               int32_t frame_peak_counts,
+                               bool frame_clipped,
+                               uint8_t quiet_frames_to_step_down) {
+  if (frame_clipped) {
+    state.range_code = kAccelRange16g;
+    state.quiet_frames = 0;
+    return state.range_code;
+  }
+  const int32_t rail = accel_range_rail_counts(state.range_code);
+  if (frame_peak_counts > (rail * 3) / 4) {
+    if (state.range_code < kAccelRange16g) {
+      state.range_code++;
+    }
+    state.quiet_frames = 0;
+    return state.range_code;
+  }
+  if (state.range_code == kAccelRange2g ||
+      frame_peak_counts >= (accel_range_rail_counts(state.range_code - 1U) * 3) / 8) {
+    state.quiet_frames = 0;
+    return state.range_code;
+  }
+  state.quiet_frames = saturating_inc_u8(state.quiet_frames);
+  if (state.quiet_frames >= quiet_frames_to_step_down) {
+    state.range_code--;
+    state.quiet_frames = 0;
+  }
+  return state.range_code;
+}
+
 }  // namespace vibesensor::reliability
@@ -94,10 +94,14 @@ size_t pack_hello(uint8_t* out,
                   const char* name,
                    const char* firmware_version,
                    uint32_t queue_overflow_drops,
-                   uint8_t capabilities) {
+                   uint8_t capabilities,
+                   uint32_t oldest_pending_seq,
+                   uint32_t boot_id) {
   const size_t name_len = strnlen(name, kHelloNameMaxBytes);
   const size_t fw_len = strnlen(firmware_version, kFirmwareVersionMaxBytes);
-  const size_t need = kHelloFixedBytes + name_len + fw_len;
+  const bool resume = (capabilities & kHelloCapResumeReceipts) != 0;
+  const size_t resume_bytes = resume ? kHelloResumeBytes : 0;
+  const size_t need = kHelloFixedBytes + name_len + fw_len + resume_bytes;
   if (out_len < need) {
     return 0;
   }
@@ -121,6 +125,12 @@ size_t pack_hello(uint8_t* out,
   write_u32_le(out + o, queue_overflow_drops);
   o += 4;
   out[o++] = capabilities;
+  if (resume) {
+    write_u32_le(out + o, oldest_pending_seq);
+    o += 4;
+    write_u32_le(out + o, boot_id);
+    o += 4;
+  }
   return o;
 }
 
@@ -128,9 +138,9 @@ size_t pack_data(uint8_t* out,
                  size_t out_len,
                  const uint8_t client_id[6],
                  uint32_t seq,
-                  uint64_t t0_us,
-                  const int16_t* xyz_interleaved,
-                  uint16_t sample_count) {
+                 uint64_t t0_us,
+                 const int16_t* xyz_interleaved,
+                 uint16_t sample_count) {
   const size_t payload_len = static_cast<size_t>(sample_count) * kXyzSampleBytes;
   const size_t need = kDataHeaderBytes + payload_len;
   if (out_len < need) {
@@ -153,6 +163,45 @@ size_t pack_data(uint8_t* out,
   return o;
 }
 
+size_t pack_data(uint8_t* out,
+                 size_t out_len,
+                 const uint8_t client_id[6],
+                 uint32_t seq,
+                 uint64_t t0_us,
+                 const int16_t* xyz_interleaved,
+                 uint16_t sample_count,
+                 uint8_t range_tag) {
+  const size_t o =
+      pack_data(out, out_len, client_id, seq, t0_us, xyz_interleaved, sample_count);
+  if (o == 0 || out_len < o + kDataRangeTagBytes) {
+    return 0;
+  }
+  out[o] = range_tag;
+  return o + kDataRangeTagBytes;
+}
+
+size_t pack_data(uint8_t* out,
+                 size_t out_len,
+                 const uint8_t client_id[6],
+                 uint32_t seq,
+                 uint64_t t0_us,
+                 const int16_t* xyz_interleaved,
+                 uint16_t sample_count,
+                 uint8_t range_tag,
+                 const DataPulseChannel& pulse) {
+  size_t o = pack_data(
+      out, out_len, client_id, seq, t0_us, xyz_interleaved, sample_count, range_tag);
+  if (o == 0 || out_len < o + kDataPulseChannelBytes) {
+    return 0;
+  }
+  out[o++] = kDataChannelWheelPulse;
+  write_u16_le(out + o, pulse.edge_count);
+  o += 2;
+  write_u32_le(out + o, static_cast<uint32_t>(pulse.last_edge_offset_us));
+  o += 4;
+  return o;
+}
+
 bool parse_cmd(const uint8_t* data,
                size_t len,
                const uint8_t expected_client_id[6],
@@ -161,7 +210,10 @@ bool parse_cmd(const uint8_t* data,
                uint16_t* out_identify_duration_ms,
                uint64_t* out_server_time_us,
                int64_t* out_applied_offset_us,
-               uint32_t* out_round_trip_us) {
+               uint32_t* out_round_trip_us,
+               uint32_t* out_slot_offset_us,
+               uint32_t* out_slot_period_us,
+               uint32_t* out_slot_width_us) {
   const size_t base = kCmdHeaderBytes;
   if (len < base) {
     return false;
@@ -206,6 +258,21 @@ bool parse_cmd(const uint8_t* data,
     }
   }
 
+  if (cmd_id == kCmdTxSlot) {
+    if (len < kCmdTxSlotBytes) {
+      return false;
+    }
+    if (out_slot_offset_us != nullptr) {
+      *out_slot_offset_us = read_u32_le(data + base);
+    }
+    if (out_slot_period_us != nullptr) {
+      *out_slot_period_us = read_u32_le(data + base + 4);
+    }
+    if (out_slot_width_us != nullptr) {
+      *out_slot_width_us = read_u32_le(data + base + 8);
+    }
+  }
+
   return true;
 }
 
@@ -291,7 +358,18 @@ bool parse_data_ack(const uint8_t* data,
   return true;
 }
 
-size_t pack_hello_ack(uint8_t* out, size_t out_len, const uint8_t client_id[6]) {
+size_t pack_stream_record_prefix(uint8_t* out, size_t out_len, size_t packet_len) {
+  if (out_len < kStreamRecordPrefixBytes || packet_len > 0xFFFFU) {
+    return 0;
+  }
+  write_u16_le(out, static_cast<uint16_t>(packet_len));
+  return kStreamRecordPrefixBytes;
+}
+
+size_t pack_hello_ack(uint8_t* out,
+                      size_t out_len,
+                      const uint8_t client_id[6],
+                      uint8_t capabilities) {
   if (out_len < kHelloAckBytes) {
     return 0;
   }
@@ -300,19 +378,62 @@ size_t pack_hello_ack(uint8_t* out, size_t out_len, const uint8_t client_id[6])
   out[o++] = kProtoVersion;
   copy_client_id(out + o, client_id);
   o += kClientIdBytes;
+  out[o++] = capabilities;
+  return o;
+}
+
+size_t pack_hello_ack(uint8_t* out,
+                      size_t out_len,
+                      const uint8_t client_id[6],
+                      uint8_t capabilities,
+                      uint32_t contiguous_seq,
+                      uint32_t receipt_bitmap) {
+  if (out_len < kHelloAckReceiptsBytes) {
+    return 0;
+  }
+  size_t o = pack_hello_ack(
+      out, out_len, client_id, static_cast<uint8_t>(capabilities | kHelloCapResumeReceipts));
+  write_u32_le(out + o, contiguous_seq);
+  o += 4;
+  write_u32_le(out + o, receipt_bitmap);
+  o += 4;
   return o;
 }
 
 bool parse_hello_ack(const uint8_t* data,
                      size_t len,
-                     const uint8_t expected_client_id[6]) {
-  if (len < kHelloAckBytes) {
+                     const uint8_t expected_client_id[6],
+                     uint8_t* out_capabilities,
+                     bool* out_has_receipts,
+                     uint32_t* out_contiguous_seq,
+                     uint32_t* out_receipt_bitmap) {
+  if (len < kHelloAckHeaderBytes) {
     return false;
   }
   if (data[0] != kMsgHelloAck || data[1] != kProtoVersion) {
     return false;
   }
-  return packet_client_id_matches(data, expected_client_id);
+  if (!packet_client_id_matches(data, expected_client_id)) {
+    return false;
+  }
+  // Servers that predate the echo send the bare header and accept nothing
+  // beyond it.
+  const uint8_t capabilities = len >= kHelloAckBytes ? data[kHelloAckHeaderBytes] : 0U;
+  if (out_capabilities != nullptr) {
+    *out_capabilities = capabilities;
+  }
+  const bool has_receipts =
+      (capabilities & kHelloCapResumeReceipts) != 0 && len >= kHelloAckReceiptsBytes;
+  if (out_has_receipts != nullptr) {
+    *out_has_receipts = has_receipts;
+  }
+  if (has_receipts && out_contiguous_seq != nullptr) {
+    *out_contiguous_seq = read_u32_le(data + kHelloAckBytes);
+  }
+  if (has_receipts && out_receipt_bitmap != nullptr) {
+    *out_receipt_bitmap = read_u32_le(data + kHelloAckBytes + 4);
+  }
+  return true;
 }
 
 }  // namespace vibesensor
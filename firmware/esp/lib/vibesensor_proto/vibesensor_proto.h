@@ -7,14 +7,24 @@ namespace vibesensor {
 constexpr uint8_t kProtoVersion = 1;
 constexpr size_t kClientIdBytes = 6;
 constexpr size_t kHelloFixedBytes = 1 + 1 + kClientIdBytes + 2 + 2 + 2 + 1 + 1 + 4 + 1;
+// Resume-receipts HELLO trailer: oldest pending seq, then the boot id.
+constexpr size_t kHelloResumeBytes = 4 + 4;
 constexpr size_t kDataHeaderBytes = 1 + 1 + kClientIdBytes + 4 + 8 + 2;
+constexpr size_t kDataRangeTagBytes = 1;
+constexpr size_t kDataPulseChannelBytes = 1 + 2 + 4;
 constexpr size_t kAckBytes = 1 + 1 + kClientIdBytes + 4 + 1;
 constexpr size_t kAckSyncClockBytes = kAckBytes + 8 + 8;
 constexpr size_t kDataAckBytes = 1 + 1 + kClientIdBytes + 4;
-constexpr size_t kHelloAckBytes = 1 + 1 + kClientIdBytes;
+// Servers that predate the capability echo answer with just the header.
+constexpr size_t kHelloAckHeaderBytes = 1 + 1 + kClientIdBytes;
+constexpr size_t kHelloAckBytes = kHelloAckHeaderBytes + 1;
+constexpr size_t kHelloAckReceiptsBytes = kHelloAckBytes + 4 + 4;
+constexpr uint32_t kHelloAckReceiptBits = 32;
+constexpr size_t kStreamRecordPrefixBytes = 2;
 constexpr size_t kCmdHeaderBytes = 1 + 1 + kClientIdBytes + 1 + 4;
 constexpr size_t kCmdIdentifyBytes = kCmdHeaderBytes + 2;
 constexpr size_t kCmdSyncClockBytes = kCmdHeaderBytes + 8 + 8 + 4;
+constexpr size_t kCmdTxSlotBytes = kCmdHeaderBytes + 4 + 4 + 4;
 
 enum MessageType : uint8_t {
   kMsgHello = 1,
@@ -28,10 +38,43 @@ enum MessageType : uint8_t {
 enum CommandId : uint8_t {
   kCmdIdentify = 1,
   kCmdSyncClock = 2,
+  kCmdTxSlot = 3,
 };
 
 enum HelloCapabilityFlags : uint8_t {
   kHelloCapExplicitAck = 1 << 0,
+  kHelloCapTsfTimebase = 1 << 1,
+  kHelloCapTxSlots = 1 << 2,
+  kHelloCapRangeTag = 1 << 3,
+  kHelloCapResumeReceipts = 1 << 4,
+  kHelloCapPulseChannel = 1 << 5,
+};
+
+// Optional one-byte DATA trailer describing how the frame's counts were
+// sampled: bits 0-1 hold the ADXL345 range code (+/-2 g << code), bit 2 is
+// set for FULL_RES (~3.9 mg/LSB at every range, otherwise range*2/1024 g/LSB)
+// and bit 7 flags a frame with at least one sample on the range's rail.
+enum DataRangeTagBits : uint8_t {
+  kDataRangeTagRangeMask = 0x03,
+  kDataRangeTagFullRes = 1 << 2,
+  kDataRangeTagClipped = 1 << 7,
+};
+
+// Optional DATA channel record after the range tag: a channel type byte
+// followed by that channel's fixed-size reading.
+enum DataChannelType : uint8_t {
+  kDataChannelWheelPulse = 1,
+};
+
+constexpr int32_t kDataPulseNoEdge = INT32_MIN;
+
+// Wheel/shaft pulse reading taken when the frame was committed: the running
+// count of input edges (wrapping at 16 bits) and when the latest of them
+// happened relative to the frame's t0_us. kDataPulseNoEdge stands in before
+// the first edge and once the latest one is too old to express.
+struct DataPulseChannel {
+  uint16_t edge_count = 0;
+  int32_t last_edge_offset_us = kDataPulseNoEdge;
 };
 
 bool parse_mac(const String& mac, uint8_t out_client_id[6]);
@@ -46,7 +89,9 @@ size_t pack_hello(uint8_t* out,
                   const char* name,
                   const char* firmware_version,
                   uint32_t queue_overflow_drops = 0,
-                  uint8_t capabilities = kHelloCapExplicitAck);
+                  uint8_t capabilities = kHelloCapExplicitAck,
+                  uint32_t oldest_pending_seq = 0,
+                  uint32_t boot_id = 0);
 
 size_t pack_data(uint8_t* out,
                  size_t out_len,
@@ -56,6 +101,27 @@ size_t pack_data(uint8_t* out,
                  const int16_t* xyz_interleaved,
                  uint16_t sample_count);
 
+// Same as above with the DATA range tag trailer appended.
+size_t pack_data(uint8_t* out,
+                 size_t out_len,
+                 const uint8_t client_id[6],
+                 uint32_t seq,
+                 uint64_t t0_us,
+                 const int16_t* xyz_interleaved,
+                 uint16_t sample_count,
+                 uint8_t range_tag);
+
+// Same as above with the wheel pulse channel record after the range tag.
+size_t pack_data(uint8_t* out,
+                 size_t out_len,
+                 const uint8_t client_id[6],
+                 uint32_t seq,
+                 uint64_t t0_us,
+                 const int16_t* xyz_interleaved,
+                 uint16_t sample_count,
+                 uint8_t range_tag,
+                 const DataPulseChannel& pulse);
+
 bool parse_cmd(const uint8_t* data,
                size_t len,
                const uint8_t expected_client_id[6],
@@ -64,7 +130,10 @@ bool parse_cmd(const uint8_t* data,
                uint16_t* out_identify_duration_ms,
                uint64_t* out_server_time_us = nullptr,
                int64_t* out_applied_offset_us = nullptr,
-               uint32_t* out_round_trip_us = nullptr);
+               uint32_t* out_round_trip_us = nullptr,
+               uint32_t* out_slot_offset_us = nullptr,
+               uint32_t* out_slot_period_us = nullptr,
+               uint32_t* out_slot_width_us = nullptr);
 
 size_t pack_ack(uint8_t* out,
                 size_t out_len,
@@ -90,10 +159,35 @@ bool parse_data_ack(const uint8_t* data,
                     const uint8_t expected_client_id[6],
                     uint32_t* out_last_seq_received);
 
-size_t pack_hello_ack(uint8_t* out, size_t out_len, const uint8_t client_id[6]);
+// Backlog stream records are a little-endian u16 length followed by one DATA
+// packet; the server answers each with a DATA_ACK on the same connection.
+size_t pack_stream_record_prefix(uint8_t* out, size_t out_len, size_t packet_len);
+
+// HELLO_ACK echoing the HELLO capabilities the server accepted. The sender
+// only relies on an optional DATA trailer once its bit comes back here;
+// servers that predate the echo send the bare header, which accepts none.
+size_t pack_hello_ack(uint8_t* out,
+                      size_t out_len,
+                      const uint8_t client_id[6],
+                      uint8_t capabilities);
+
+// HELLO_ACK answering a HELLO with kHelloCapResumeReceipts (set in the echo
+// here): every seq from the sender's oldest pending one up to contiguous_seq
+// reached the server, and bit i of receipt_bitmap marks seq
+// contiguous_seq + 2 + i as received too.
+size_t pack_hello_ack(uint8_t* out,
+                      size_t out_len,
+                      const uint8_t client_id[6],
+                      uint8_t capabilities,
+                      uint32_t contiguous_seq,
+                      uint32_t receipt_bitmap);
 
 bool parse_hello_ack(const uint8_t* data,
                      size_t len,
-                     const uint8_t expected_client_id[6]);
+                     const uint8_t expected_client_id[6],
+                     uint8_t* out_capabilities = nullptr,
+                     bool* out_has_receipts = nullptr,
+                     uint32_t* out_contiguous_seq = nullptr,
+                     uint32_t* out_receipt_bitmap = nullptr);
 
 }  // namespace vibesensor
@@ -8,6 +8,7 @@
 #include "runtime_sampling.h"
 #include "runtime_status.h"
 #include "runtime_transport.h"
+#include "runtime_tsf_sync.h"
 #include "runtime_wifi.h"
 
 namespace {
@@ -84,12 +85,12 @@ void setup() {
   }
 
   allocate_frame_queue(g_runtime.queue);
-  if (frame_queue_capacity(g_runtime.queue) == 0) {
+  if (frame_queue_bytes(g_runtime.queue) == 0) {
     Serial.printf("WARN: frame queue alloc failed; running without buffering\n");
   } else {
-    Serial.printf("frame queue: %u slots (%u bytes)\n",
-                  static_cast<unsigned>(frame_queue_capacity(g_runtime.queue)),
-                  static_cast<unsigned>(frame_queue_bytes(g_runtime.queue)));
+    Serial.printf("frame queue: %u bytes (%u raw frames worst case)\n",
+                  static_cast<unsigned>(frame_queue_bytes(g_runtime.queue)),
+                  static_cast<unsigned>(frame_queue_bytes(g_runtime.queue) / kFrameRecordMaxBytes));
   }
 
   begin_leds(g_runtime.led);
@@ -98,7 +99,7 @@ void setup() {
   if (!begin_sampling(g_runtime.sampling)) {
     Serial.printf("WARN: sampling task startup failed\n");
   }
-  if (send_hello(g_runtime.transport, g_runtime.status)) {
+  if (send_hello(g_runtime.transport, g_runtime.queue, g_runtime.status)) {
     g_runtime.transport.last_hello_ms = millis();
   }
   enable_runtime_watchdog();
@@ -109,16 +110,25 @@ void loop() {
 
   service_data_rx(g_runtime.transport, g_runtime.queue, g_runtime.status);
   service_control_rx(g_runtime.transport, g_runtime.queue, g_runtime.led, g_runtime.status);
-  service_sample_handoff(
-      g_runtime.sampling, g_runtime.queue, g_runtime.status, g_runtime.transport.clock_offset_us);
+  service_tsf_sync(g_runtime.transport.tsf_sync, g_runtime.status);
+  service_frame_handoff(g_runtime.sampling,
+                        g_runtime.queue,
+                        g_runtime.status,
+                        frame_clock_offset_us(g_runtime.transport));
+  // Ahead of service_tx so queued frames reach the stream before UDP ages them out.
+  service_backlog_stream(g_runtime.transport, g_runtime.queue, g_runtime.status);
   service_tx(g_runtime.transport, g_runtime.queue, g_runtime.status);
-  service_hello(g_runtime.transport, g_runtime.status);
+  service_hello(g_runtime.transport, g_runtime.queue, g_runtime.status);
   service_wifi(g_runtime.wifi, g_runtime.status);
 
   const uint32_t now_ms = millis();
   service_blink(g_runtime.led, now_ms);
   const SamplingStatusSnapshot sampling_status = snapshot_sampling_status(g_runtime.sampling);
-  report_runtime_status(
-      g_runtime.status, sampling_status, frame_queue_size(g_runtime.queue), frame_queue_capacity(g_runtime.queue), now_ms);
+  report_runtime_status(g_runtime.status,
+                        sampling_status,
+                        frame_queue_size(g_runtime.queue),
+                        frame_queue_used_bytes(g_runtime.queue),
+                        frame_queue_bytes(g_runtime.queue),
+                        now_ms);
   delay(0);
 }
@@ -0,0 +1,251 @@
+#include "runtime_backlog_stream.h"
+
+#include <WiFi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <atomic>
+
+#include "runtime_config.h"
+#include "runtime_transport.h"
+#include "vibesensor_network.h"
+
+namespace vibesensor::runtime {
+namespace {
+
+constexpr char kBacklogConnectTaskName[] = "vs_backlog_tcp";
+constexpr uint32_t kBacklogConnectTaskStackBytes = 4096;
+constexpr uint8_t kTransportErrorBacklogStreamOpen = 16;
+constexpr uint8_t kTransportErrorBacklogStreamBroken = 17;
+
+enum class ConnectPhase : uint8_t { kIdle, kConnecting, kConnected, kFailed };
+
+// Set by the connect task once client.connect() returns; the loop owns the
+// client again only after reading kConnected or kFailed here.
+std::atomic<ConnectPhase> g_connect_phase{ConnectPhase::kIdle};
+
+bool seq_before(uint32_t lhs, uint32_t rhs) {
+  return static_cast<int32_t>(lhs - rhs) < 0;
+}
+
+// Also releases backlog frames at the front that HELLO_ACK receipts settled:
+// the stream skips them, so no in-stream ACK would ever cover the last one.
+bool backlog_pending(const BacklogStreamState& state, FrameQueueState& queue_state) {
+  DataFrame* front = peek_frame(queue_state);
+  while (front != nullptr && front->settled && seq_before(front->seq, state.live_start_seq)) {
+    drop_front_frame(queue_state);
+    front = peek_frame(queue_state);
+  }
+  return front != nullptr && seq_before(front->seq, state.live_start_seq);
+}
+
+void fail_backlog_stream(BacklogStreamState& state,
+                         FrameQueueState& queue_state,
+                         RuntimeStatus& status) {
+  status.backlog_stream_fallbacks++;
+  set_last_error(status, kTransportErrorBacklogStreamBroken);
+  close_backlog_stream(state, queue_state);
+}
+
+void note_open_failure(RuntimeStatus& status) {
+  status.backlog_stream_fallbacks++;
+  set_last_error(status, kTransportErrorBacklogStreamOpen);
+}
+
+// WiFiClient::connect() blocks until the handshake completes or times out, so
+// it runs on a short-lived task and the loop keeps serving UDP meanwhile.
+void backlog_connect_task_main(void* arg) {
+  BacklogStreamState& state = *static_cast<BacklogStreamState*>(arg);
+  const int connected = state.client.connect(
+      vibesensor_network::server_ip, kServerBacklogStreamPort, kBacklogStreamConnectTimeoutMs);
+  g_connect_phase.store(connected == 1 ? ConnectPhase::kConnected : ConnectPhase::kFailed,
+                        std::memory_order_release);
+  vTaskDelete(nullptr);
+}
+
+// The lanes split as soon as the connect starts: frames queued before it wait
+// for the stream, and UDP carries only the newer ones meanwhile.
+void start_backlog_connect(BacklogStreamState& state,
+                           const FrameQueueState& queue_state,
+                           RuntimeStatus& status,
+                           uint32_t now_ms) {
+  if (kBacklogStreamThresholdFrames == 0 ||
+      frame_queue_size(queue_state) < kBacklogStreamThresholdFrames) {
+    return;
+  }
+  if (state.open_attempted &&
+      now_ms - state.last_open_attempt_ms < kBacklogStreamRetryIntervalMs) {
+    return;
+  }
+  state.open_attempted = true;
+  state.last_open_attempt_ms = now_ms;
+  g_connect_phase.store(ConnectPhase::kConnecting, std::memory_order_relaxed);
+  state.connecting = true;
+  state.live_start_seq = queue_state.next_seq;
+  state.next_send_seq = frame_queue_oldest_seq(queue_state);
+  state.next_live_seq = state.live_start_seq;
+  state.ack_fill = 0;
+  const BaseType_t created = xTaskCreatePinnedToCore(backlog_connect_task_main,
+                                                     kBacklogConnectTaskName,
+                                                     kBacklogConnectTaskStackBytes,
+                                                     &state,
+                                                     uxTaskPriorityGet(nullptr),
+                                                     nullptr,
+                                                     static_cast<BaseType_t>(kArduinoLoopTaskCore));
+  if (created != pdPASS) {
+    g_connect_phase.store(ConnectPhase::kIdle, std::memory_order_relaxed);
+    state.connecting = false;
+    note_open_failure(status);
+  }
+}
+
+// Returns true once the connect task has opened the stream; false while it is
+// still connecting or when the attempt failed.
+bool finish_backlog_connect(BacklogStreamState& state,
+                            FrameQueueState& queue_state,
+                            RuntimeStatus& status) {
+  const ConnectPhase phase = g_connect_phase.load(std::memory_order_acquire);
+  if (phase == ConnectPhase::kConnecting) {
+    return false;
+  }
+  g_connect_phase.store(ConnectPhase::kIdle, std::memory_order_relaxed);
+  state.connecting = false;
+  if (phase != ConnectPhase::kConnected) {
+    // As on close, the front-only UDP path drops what the live lane finished.
+    settle_frames(queue_state, state.live_start_seq, state.next_live_seq);
+    note_open_failure(status);
+    return false;
+  }
+  state.client.setNoDelay(true);
+  state.active = true;
+  status.backlog_stream_opens++;
+  return true;
+}
+
+// Returns false when the stream carried something that is not a DATA_ACK for
+// this node; both ends then disagree on framing and the stream is abandoned.
+bool read_stream_acks(TransportState& transport,
+                      FrameQueueState& queue_state,
+                      RuntimeStatus& status) {
+  BacklogStreamState& state = transport.backlog_stream;
+  while (state.client.available() > 0) {
+    const int read = state.client.read(state.ack_bytes + state.ack_fill,
+                                       sizeof(state.ack_bytes) - state.ack_fill);
+    if (read <= 0) {
+      return true;
+    }
+    state.ack_fill += static_cast<size_t>(read);
+    if (state.ack_fill < sizeof(state.ack_bytes)) {
+      continue;
+    }
+    state.ack_fill = 0;
+    uint32_t last_seq_received = 0;
+    if (!vibesensor::parse_data_ack(
+            state.ack_bytes, sizeof(state.ack_bytes), transport.client_id, &last_seq_received)) {
+      status.data_ack_parse_errors++;
+      return false;
+    }
+    // Records go out in seq order, so an in-stream ACK covers everything older.
+    if (seq_before(last_seq_received, state.live_start_seq)) {
+      const size_t size_before = frame_queue_size(queue_state);
+      ack_data_frames(queue_state, last_seq_received);
+      status.backlog_stream_frames +=
+          static_cast<uint32_t>(size_before - frame_queue_size(queue_state));
+    }
+  }
+  return true;
+}
+
+// Returns false when the connection could not take a whole record.
+bool send_stream_records(TransportState& transport,
+                         FrameQueueState& queue_state,
+                         RuntimeStatus& status) {
+  BacklogStreamState& state = transport.backlog_stream;
+  uint8_t record[vibesensor::kStreamRecordPrefixBytes + kMaxDatagramBytes];
+  for (size_t sent = 0; sent < kBacklogStreamRecordsPerLoop; ++sent) {
+    const uint32_t in_flight = state.next_send_seq - frame_queue_oldest_seq(queue_state);
+    if (static_cast<int32_t>(in_flight) >= static_cast<int32_t>(kBacklogStreamWindowFrames)) {
+      return true;
+    }
+    DataFrame* frame = find_frame_from(queue_state, state.next_send_seq);
+    while (frame != nullptr && frame->settled && seq_before(frame->seq, state.live_start_seq)) {
+      frame = find_frame_from(queue_state, frame->seq + 1U);
+    }
+    if (frame == nullptr || !seq_before(frame->seq, state.live_start_seq)) {
+      return true;
+    }
+    const size_t len = pack_queued_frame(transport,
+                                         *frame,
+                                         record + vibesensor::kStreamRecordPrefixBytes,
+                                         kMaxDatagramBytes);
+    state.next_send_seq = frame->seq + 1U;
+    if (len == 0) {
+      status.tx_pack_failures++;
+      continue;
+    }
+    vibesensor::pack_stream_record_prefix(record, sizeof(record), len);
+    const size_t record_len = vibesensor::kStreamRecordPrefixBytes + len;
+    if (state.client.write(record, record_len) != record_len) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+bool backlog_stream_holds_backlog(const BacklogStreamState& state) {
+  return state.active || state.connecting;
+}
+
+bool backlog_stream_owns_seq(const BacklogStreamState& state, uint32_t seq) {
+  return backlog_stream_holds_backlog(state) && seq_before(seq, state.live_start_seq);
+}
+
+void close_backlog_stream(BacklogStreamState& state, FrameQueueState& queue_state) {
+  if (!state.active) {
+    return;
+  }
+  state.client.stop();
+  state.active = false;
+  state.ack_fill = 0;
+  // The live lane already finished with these; the front-only UDP path drops
+  // them once the frames ahead of them are gone.
+  settle_frames(queue_state, state.live_start_seq, state.next_live_seq);
+}
+
+void service_backlog_stream(TransportState& transport,
+                            FrameQueueState& queue_state,
+                            RuntimeStatus& status) {
+  BacklogStreamState& state = transport.backlog_stream;
+  if (state.connecting && !finish_backlog_connect(state, queue_state, status)) {
+    return;
+  }
+  if (WiFi.status() != WL_CONNECTED || !transport.handshake_complete) {
+    if (state.active) {
+      fail_backlog_stream(state, queue_state, status);
+    }
+    return;
+  }
+  if (kTsfTimeSyncEnabled && !tsf_mapping_ready(transport.tsf_sync.mapping)) {
+    return;
+  }
+  if (!state.active) {
+    start_backlog_connect(state, queue_state, status, millis());
+    return;
+  }
+
+  if (!read_stream_acks(transport, queue_state, status)) {
+    fail_backlog_stream(state, queue_state, status);
+    return;
+  }
+  if (!backlog_pending(state, queue_state)) {
+    close_backlog_stream(state, queue_state);
+    return;
+  }
+  if (!state.client.connected() || !send_stream_records(transport, queue_state, status)) {
+    fail_backlog_stream(state, queue_state, status);
+  }
+}
+
+}  // namespace vibesensor::runtime
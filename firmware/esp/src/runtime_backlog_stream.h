@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+#include "runtime_queue.h"
+#include "runtime_status.h"
+#include "vibesensor_proto.h"
+
+namespace vibesensor::runtime {
+
+struct TransportState;
+
+// Optional TCP lane for replaying a large backlog. Frames queued before the
+// stream opened (seq < live_start_seq) go over it in order with a bounded
+// window; newer frames keep going over UDP, where service_tx tracks them by
+// next_live_seq instead of the queue front.
+struct BacklogStreamState {
+  WiFiClient client;
+  bool active = false;
+  // A connect task owns client until service_backlog_stream sees it finish.
+  bool connecting = false;
+  uint32_t live_start_seq = 0;
+  uint32_t next_send_seq = 0;
+  uint32_t next_live_seq = 0;
+  uint32_t last_open_attempt_ms = 0;
+  bool open_attempted = false;
+  uint8_t ack_bytes[vibesensor::kDataAckBytes] = {};
+  size_t ack_fill = 0;
+};
+
+// True while the stream is open or connecting; UDP then leaves frames older
+// than live_start_seq to it.
+bool backlog_stream_holds_backlog(const BacklogStreamState& state);
+bool backlog_stream_owns_seq(const BacklogStreamState& state, uint32_t seq);
+// Opens the stream when the backlog crosses kBacklogStreamThresholdFrames
+// (connecting on a separate task, so the loop never waits on TCP), sends
+// records inside the window, applies in-stream DATA_ACKs and closes the
+// stream once every frame older than live_start_seq is acknowledged. Any
+// stream failure falls back to UDP for whatever is still queued.
+void service_backlog_stream(TransportState& transport,
+                            FrameQueueState& queue_state,
+                            RuntimeStatus& status);
+void close_backlog_stream(BacklogStreamState& state, FrameQueueState& queue_state);
+
+}  // namespace vibesensor::runtime
@@ -31,6 +31,9 @@ constexpr size_t kMaxDatagramBytes = static_cast<size_t>(VIBESENSOR_MAX_UDP_PAYL
 #ifndef VIBESENSOR_SERVER_CONTROL_PORT
 #define VIBESENSOR_SERVER_CONTROL_PORT VS_SERVER_UDP_CONTROL_PORT
 #endif
+#ifndef VIBESENSOR_SERVER_BACKLOG_STREAM_PORT
+#define VIBESENSOR_SERVER_BACKLOG_STREAM_PORT VS_SERVER_BACKLOG_STREAM_PORT
+#endif
 #ifndef VIBESENSOR_CONTROL_PORT_BASE
 #define VIBESENSOR_CONTROL_PORT_BASE VS_FIRMWARE_CONTROL_PORT_BASE
 #endif
@@ -40,8 +43,26 @@ constexpr uint16_t kSampleRateMaxHz = 3200;
 constexpr uint16_t kConfiguredSampleRateHz = static_cast<uint16_t>(VIBESENSOR_SAMPLE_RATE_HZ);
 constexpr uint16_t kSampleRateHz = vibesensor::reliability::clamp_sample_rate(
     kConfiguredSampleRateHz, kSampleRateMinHz, kSampleRateMaxHz);
+// Optional wheel/shaft pulse input (Hall or conditioned reluctor output). A
+// non-negative GPIO enables it: rising edges are timestamped on the sample
+// clock and every DATA frame carries a wheel pulse channel record. Edges closer
+// together than the minimum interval are treated as bounce and not counted.
+#ifndef VIBESENSOR_PULSE_INPUT_PIN
+#define VIBESENSOR_PULSE_INPUT_PIN -1
+#endif
+#ifndef VIBESENSOR_PULSE_MIN_EDGE_INTERVAL_US
+#define VIBESENSOR_PULSE_MIN_EDGE_INTERVAL_US 100
+#endif
+constexpr int kPulseInputPin = VIBESENSOR_PULSE_INPUT_PIN;
+constexpr bool kPulseInputEnabled = kPulseInputPin >= 0;
+constexpr uint32_t kPulseMinEdgeIntervalUs =
+    static_cast<uint32_t>(VIBESENSOR_PULSE_MIN_EDGE_INTERVAL_US);
+
 constexpr uint16_t kFrameSamplesMaxByDatagram =
-    static_cast<uint16_t>((kMaxDatagramBytes - vibesensor::kDataHeaderBytes) / 6);
+    static_cast<uint16_t>((kMaxDatagramBytes - vibesensor::kDataHeaderBytes -
+                           vibesensor::kDataRangeTagBytes -
+                           (kPulseInputEnabled ? vibesensor::kDataPulseChannelBytes : 0U)) /
+                          6);
 constexpr uint16_t kConfiguredFrameSamples = static_cast<uint16_t>(VIBESENSOR_FRAME_SAMPLES);
 constexpr uint16_t kFrameSamples = (kConfiguredFrameSamples == 0)
                                        ? 1
@@ -50,17 +71,21 @@ constexpr uint16_t kFrameSamples = (kConfiguredFrameSamples == 0)
                                               : kConfiguredFrameSamples);
 constexpr uint16_t kServerDataPort = static_cast<uint16_t>(VIBESENSOR_SERVER_DATA_PORT);
 constexpr uint16_t kServerControlPort = static_cast<uint16_t>(VIBESENSOR_SERVER_CONTROL_PORT);
+constexpr uint16_t kServerBacklogStreamPort =
+    static_cast<uint16_t>(VIBESENSOR_SERVER_BACKLOG_STREAM_PORT);
 constexpr uint16_t kControlPortBase = static_cast<uint16_t>(VIBESENSOR_CONTROL_PORT_BASE);
 constexpr size_t kAxesPerSample = 3;
 
-#ifndef VIBESENSOR_FRAME_QUEUE_LEN_TARGET
-#define VIBESENSOR_FRAME_QUEUE_LEN_TARGET 128
+// Frame queue RAM in bytes. Frames are stored delta-packed, so the backlog
+// this buys depends on how compressible the signal is.
+#ifndef VIBESENSOR_FRAME_QUEUE_BYTES_TARGET
+#define VIBESENSOR_FRAME_QUEUE_BYTES_TARGET 65536
 #endif
-#ifndef VIBESENSOR_FRAME_QUEUE_LEN_MIN
-#define VIBESENSOR_FRAME_QUEUE_LEN_MIN 16
+#ifndef VIBESENSOR_FRAME_QUEUE_BYTES_MIN
+#define VIBESENSOR_FRAME_QUEUE_BYTES_MIN 8192
 #endif
-constexpr size_t kFrameQueueLenTarget = static_cast<size_t>(VIBESENSOR_FRAME_QUEUE_LEN_TARGET);
-constexpr size_t kFrameQueueLenMin = static_cast<size_t>(VIBESENSOR_FRAME_QUEUE_LEN_MIN);
+constexpr size_t kFrameQueueBytesTarget = static_cast<size_t>(VIBESENSOR_FRAME_QUEUE_BYTES_TARGET);
+constexpr size_t kFrameQueueBytesMin = static_cast<size_t>(VIBESENSOR_FRAME_QUEUE_BYTES_MIN);
 
 constexpr uint32_t kHelloIntervalMs = 2000;
 
@@ -118,12 +143,29 @@ constexpr size_t kSensorPrefetchSamples = 32;
 constexpr size_t kSensorPrefetchLowWaterSamples = 16;
 constexpr size_t kSensorPrefetchSteadyTargetSamples = 24;
 constexpr size_t kSensorPrefetchLateTargetSamples = 32;
-constexpr size_t kSampleHandoffQueueSamples = static_cast<size_t>(kFrameSamples) * 2U;
+// Committed-frame slots between the sampling task and the main loop; one is
+// being filled by the sampling task at any time.
+constexpr size_t kFrameHandoffFrames = 4;
 constexpr size_t kMaxTxFramesPerLoop = 2;
 constexpr size_t kMaxDataAckPacketsPerLoop = 8;
 constexpr uint32_t kDataRetransmitIntervalMs = 120;
 constexpr uint8_t kDataMaxRetransmits = 4;
 constexpr uint32_t kDataMaxFrameAgeMs = 750;
+
+// TCP backlog stream: once this many frames are queued (a few seconds of
+// outage, far more than UDP replays inside kDataMaxFrameAgeMs), the queued
+// frames are replayed over one TCP connection while new frames stay on UDP.
+// 0 disables the stream.
+#ifndef VIBESENSOR_BACKLOG_STREAM_THRESHOLD_FRAMES
+#define VIBESENSOR_BACKLOG_STREAM_THRESHOLD_FRAMES 24
+#endif
+constexpr size_t kBacklogStreamThresholdFrames =
+    static_cast<size_t>(VIBESENSOR_BACKLOG_STREAM_THRESHOLD_FRAMES);
+// Records in flight before the server's in-stream DATA_ACKs must catch up.
+constexpr uint32_t kBacklogStreamWindowFrames = 8;
+constexpr size_t kBacklogStreamRecordsPerLoop = 4;
+constexpr int32_t kBacklogStreamConnectTimeoutMs = 250;
+constexpr uint32_t kBacklogStreamRetryIntervalMs = 10000;
 constexpr uint32_t kStatusReportIntervalMs = 10000;
 constexpr uint16_t kMaxIdentifyDurationMs = 10000;
 constexpr uint8_t kSensorReinitErrorThreshold = 3;
@@ -135,16 +177,52 @@ constexpr uint32_t kWifiRetryIntervalMaxMs = 60000;
 #endif
 constexpr uint32_t kWifiScanIntervalMs = static_cast<uint32_t>(VIBESENSOR_WIFI_SCAN_INTERVAL_MS);
 
+// Optional Wi-Fi TSF timebase: DATA t0_us is reported on the AP's 802.11 TSF
+// clock instead of the CMD_SYNC_CLOCK-corrected local clock.
+#ifndef VIBESENSOR_TSF_TIME_SYNC
+#define VIBESENSOR_TSF_TIME_SYNC 0
+#endif
+constexpr bool kTsfTimeSyncEnabled = VIBESENSOR_TSF_TIME_SYNC != 0;
+constexpr uint32_t kTsfSyncIntervalMs = 1000;
+constexpr size_t kTsfSyncWindowPoints = 8;
+constexpr size_t kTsfSyncMinPoints = 2;
+constexpr uint32_t kTsfSyncMaxReadSpanUs = 200;
+constexpr uint32_t kTsfSyncMaxResidualUs = 500;
+constexpr uint32_t kTsfSyncMaxSkewPpm = 200;
+
+// Server-assigned TDMA transmit slots (CMD_TX_SLOT). The per-frame airtime
+// budget should cover the worst PHY rate the deployment falls back to.
+#ifndef VIBESENSOR_TDMA_FRAME_AIRTIME_US
+#define VIBESENSOR_TDMA_FRAME_AIRTIME_US 400
+#endif
+constexpr uint32_t kTdmaFrameAirtimeUs = static_cast<uint32_t>(VIBESENSOR_TDMA_FRAME_AIRTIME_US);
+constexpr uint32_t kTdmaMinGuardUs = 100;
+constexpr uint32_t kTdmaDriftPpm = 50;
+// Narrowest slot worth adopting: one frame plus the guard floor at both edges.
+// The server enforces the same floor (TX_SLOT_MIN_WIDTH_US) before assigning.
+constexpr uint32_t kTdmaMinSlotWidthUs = kTdmaFrameAirtimeUs + 2U * kTdmaMinGuardUs;
+
+// ADXL345 auto-ranging. With it off the sensor stays at +/-16 g; frames are
+// range-tagged either way.
+#ifndef VIBESENSOR_AUTO_RANGE
+#define VIBESENSOR_AUTO_RANGE 1
+#endif
+constexpr bool kAutoRangeEnabled = VIBESENSOR_AUTO_RANGE != 0;
+constexpr uint8_t kAutoRangeQuietFrames = 20;
+// DATA range tag of the sensor's power-on configuration (FULL_RES, +/-16 g).
+constexpr uint8_t kDefaultRangeTag = static_cast<uint8_t>(
+    vibesensor::kDataRangeTagFullRes | vibesensor::reliability::kAccelRange16g);
+
 #ifndef VIBESENSOR_ENABLE_SYNTH_FALLBACK
 #define VIBESENSOR_ENABLE_SYNTH_FALLBACK 0
 #endif
 
 static_assert(VIBESENSOR_SAMPLE_RATE_HZ > 0, "VIBESENSOR_SAMPLE_RATE_HZ must be > 0");
 static_assert(VIBESENSOR_FRAME_SAMPLES > 0, "VIBESENSOR_FRAME_SAMPLES must be > 0");
-static_assert(VIBESENSOR_FRAME_QUEUE_LEN_MIN > 0,
-              "VIBESENSOR_FRAME_QUEUE_LEN_MIN must be > 0");
-static_assert(VIBESENSOR_FRAME_QUEUE_LEN_TARGET >= VIBESENSOR_FRAME_QUEUE_LEN_MIN,
-              "VIBESENSOR_FRAME_QUEUE_LEN_TARGET must be >= VIBESENSOR_FRAME_QUEUE_LEN_MIN");
+static_assert(VIBESENSOR_FRAME_QUEUE_BYTES_MIN > 0,
+              "VIBESENSOR_FRAME_QUEUE_BYTES_MIN must be > 0");
+static_assert(VIBESENSOR_FRAME_QUEUE_BYTES_TARGET >= VIBESENSOR_FRAME_QUEUE_BYTES_MIN,
+              "VIBESENSOR_FRAME_QUEUE_BYTES_TARGET must be >= VIBESENSOR_FRAME_QUEUE_BYTES_MIN");
 static_assert(VIBESENSOR_WIFI_INITIAL_CONNECT_ATTEMPTS > 0,
               "VIBESENSOR_WIFI_INITIAL_CONNECT_ATTEMPTS must be > 0");
 static_assert(kFrameSamplesMaxByDatagram > 0, "kMaxDatagramBytes too small for protocol");
@@ -165,8 +243,11 @@ static_assert(kSensorPrefetchLowWaterSamples < kSensorPrefetchSteadyTargetSample
               "steady prefetch target must exceed low-water");
 static_assert(kSensorPrefetchSteadyTargetSamples <= kSensorPrefetchLateTargetSamples,
               "late prefetch target must be at least the steady target");
-static_assert(kSampleHandoffQueueSamples >= static_cast<size_t>(kFrameSamples),
-              "sample handoff queue must hold at least one frame of samples");
+static_assert(kFrameHandoffFrames >= 2 && (kFrameHandoffFrames & (kFrameHandoffFrames - 1U)) == 0,
+              "frame handoff needs a power-of-two slot count of at least two");
+static_assert(kTdmaFrameAirtimeUs > 0, "VIBESENSOR_TDMA_FRAME_AIRTIME_US must be > 0");
+static_assert(kTsfSyncMinPoints >= 1 && kTsfSyncMinPoints <= kTsfSyncWindowPoints,
+              "TSF sync needs at least one and at most the window's worth of points");
 
 constexpr int kI2cSdaPin = 26;
 constexpr int kI2cSclPin = 32;
@@ -0,0 +1,195 @@
+#include "runtime_frame_codec.h"
+
+#include <string.h>
+
+namespace vibesensor::runtime {
+namespace {
+
+uint32_t zigzag(int32_t value) {
+  return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+int32_t unzigzag(uint32_t value) {
+  return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1U);
+}
+
+uint8_t bit_width(uint32_t value) {
+  uint8_t bits = 0;
+  while (value != 0) {
+    bits++;
+    value >>= 1;
+  }
+  return bits;
+}
+
+uint32_t low_mask(uint8_t bits) {
+  return bits >= 32U ? 0xFFFFFFFFU : ((1UL << bits) - 1UL);
+}
+
+int32_t sign_extend(uint32_t value, uint8_t bits) {
+  const uint32_t sign = 1UL << (bits - 1U);
+  return static_cast<int32_t>((value ^ sign) - sign);
+}
+
+bool samples_fit(const int16_t* xyz, uint16_t sample_count, uint8_t sample_bits) {
+  if (sample_bits >= kFrameSampleBitsMax) {
+    return true;
+  }
+  const int32_t max_value = (static_cast<int32_t>(1) << (sample_bits - 1U)) - 1;
+  const int32_t min_value = -max_value - 1;
+  for (size_t i = 0; i < static_cast<size_t>(sample_count) * kAxesPerSample; ++i) {
+    if (xyz[i] > max_value || xyz[i] < min_value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int32_t sample_delta(const int16_t* xyz, size_t index, size_t axis) {
+  return static_cast<int32_t>(xyz[(index * kAxesPerSample) + axis]) -
+         static_cast<int32_t>(xyz[((index - 1U) * kAxesPerSample) + axis]);
+}
+
+// Little-endian bit stream: values are appended LSB first, so 16-bit fields
+// on a byte boundary come out as plain little-endian int16.
+struct BitWriter {
+  uint8_t* cursor;
+  uint64_t acc = 0;
+  uint8_t acc_bits = 0;
+
+  explicit BitWriter(uint8_t* out) : cursor(out) {}
+
+  void put(uint32_t value, uint8_t bits) {
+    acc |= static_cast<uint64_t>(value & low_mask(bits)) << acc_bits;
+    acc_bits = static_cast<uint8_t>(acc_bits + bits);
+    while (acc_bits >= 8U) {
+      *cursor++ = static_cast<uint8_t>(acc & 0xFFU);
+      acc >>= 8;
+      acc_bits = static_cast<uint8_t>(acc_bits - 8U);
+    }
+  }
+
+  void flush() {
+    if (acc_bits > 0) {
+      *cursor = static_cast<uint8_t>(acc & 0xFFU);
+    }
+  }
+};
+
+struct BitReader {
+  const uint8_t* cursor;
+  uint64_t acc = 0;
+  uint8_t acc_bits = 0;
+
+  explicit BitReader(const uint8_t* in) : cursor(in) {}
+
+  uint32_t take(uint8_t bits) {
+    while (acc_bits < bits) {
+      acc |= static_cast<uint64_t>(*cursor++) << acc_bits;
+      acc_bits = static_cast<uint8_t>(acc_bits + 8U);
+    }
+    const uint32_t value = static_cast<uint32_t>(acc) & low_mask(bits);
+    acc >>= bits;
+    acc_bits = static_cast<uint8_t>(acc_bits - bits);
+    return value;
+  }
+};
+
+}  // namespace
+
+FrameEncoding plan_frame_encoding(const int16_t* xyz, uint16_t sample_count, uint8_t sample_bits) {
+  FrameEncoding encoding{};
+  if (sample_bits > 0 && sample_bits < kFrameSampleBitsMax &&
+      samples_fit(xyz, sample_count, sample_bits)) {
+    encoding.sample_bits = sample_bits;
+  }
+  const size_t values = static_cast<size_t>(sample_count) * kAxesPerSample;
+  const size_t raw_bytes = ((values * encoding.sample_bits) + 7U) / 8U;
+  size_t delta_bits_total = 0;
+  for (size_t axis = 0; axis < kAxesPerSample; ++axis) {
+    uint32_t widest = 0;
+    for (size_t i = 1; i < sample_count; ++i) {
+      widest |= zigzag(sample_delta(xyz, i, axis));
+    }
+    encoding.delta_bits[axis] = bit_width(widest);
+    delta_bits_total += encoding.delta_bits[axis];
+  }
+  const size_t deltas = sample_count > 0 ? static_cast<size_t>(sample_count) - 1U : 0U;
+  const size_t packed_bytes =
+      ((kAxesPerSample * encoding.sample_bits) + (deltas * delta_bits_total) + 7U) / 8U;
+  if (sample_count == 0 || packed_bytes >= raw_bytes) {
+    encoding.raw = true;
+    encoding.payload_bytes = static_cast<uint16_t>(raw_bytes);
+    for (size_t axis = 0; axis < kAxesPerSample; ++axis) {
+      encoding.delta_bits[axis] = 0;
+    }
+    return encoding;
+  }
+  encoding.payload_bytes = static_cast<uint16_t>(packed_bytes);
+  return encoding;
+}
+
+void encode_frame(const int16_t* xyz,
+                  uint16_t sample_count,
+                  const FrameEncoding& encoding,
+                  uint8_t* out) {
+  BitWriter writer(out);
+  if (encoding.raw) {
+    for (size_t i = 0; i < static_cast<size_t>(sample_count) * kAxesPerSample; ++i) {
+      writer.put(static_cast<uint32_t>(static_cast<int32_t>(xyz[i])), encoding.sample_bits);
+    }
+    writer.flush();
+    return;
+  }
+
+  for (size_t axis = 0; axis < kAxesPerSample; ++axis) {
+    writer.put(static_cast<uint32_t>(static_cast<int32_t>(xyz[axis])), encoding.sample_bits);
+  }
+  for (size_t axis = 0; axis < kAxesPerSample; ++axis) {
+    const uint8_t bits = encoding.delta_bits[axis];
+    if (bits == 0) {
+      continue;
+    }
+    for (size_t i = 1; i < sample_count; ++i) {
+      writer.put(zigzag(sample_delta(xyz, i, axis)), bits);
+    }
+  }
+  writer.flush();
+}
+
+bool decode_frame(const uint8_t* payload,
+                  uint16_t sample_count,
+                  const FrameEncoding& encoding,
+                  int16_t* out_xyz) {
+  if (sample_count == 0 || sample_count > kFrameSamples || encoding.sample_bits == 0 ||
+      encoding.sample_bits > kFrameSampleBitsMax) {
+    return false;
+  }
+  BitReader reader(payload);
+  if (encoding.raw) {
+    for (size_t i = 0; i < static_cast<size_t>(sample_count) * kAxesPerSample; ++i) {
+      out_xyz[i] = static_cast<int16_t>(
+          sign_extend(reader.take(encoding.sample_bits), encoding.sample_bits));
+    }
+    return true;
+  }
+
+  int32_t first[kAxesPerSample] = {};
+  for (size_t axis = 0; axis < kAxesPerSample; ++axis) {
+    first[axis] = sign_extend(reader.take(encoding.sample_bits), encoding.sample_bits);
+  }
+  for (size_t axis = 0; axis < kAxesPerSample; ++axis) {
+    const uint8_t bits = encoding.delta_bits[axis];
+    int32_t value = first[axis];
+    out_xyz[axis] = static_cast<int16_t>(value);
+    for (size_t i = 1; i < sample_count; ++i) {
+      if (bits != 0) {
+        value += unzigzag(reader.take(bits));
+      }
+      out_xyz[(i * kAxesPerSample) + axis] = static_cast<int16_t>(value);
+    }
+  }
+  return true;
+}
+
+}  // namespace vibesensor::runtime
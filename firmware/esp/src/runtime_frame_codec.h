@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "runtime_config.h"
+
+namespace vibesensor::runtime {
+
+// Lossless in-RAM frame encoding used by the frame queue. Each axis keeps its
+// first sample verbatim followed by zigzagged sample-to-sample deltas, packed
+// at the narrowest bit width that holds every delta of that axis in the frame.
+// Frames whose packed form would not be smaller stay raw. Verbatim samples use
+// sample_bits, the width the sensor range allows (see plan_frame_encoding).
+// The wire format is unaffected: frames are decoded back to int16 XYZ when a
+// DATA packet is built.
+constexpr uint8_t kFrameSampleBitsMax = 16;
+
+struct FrameEncoding {
+  uint16_t payload_bytes = 0;
+  uint8_t sample_bits = kFrameSampleBitsMax;
+  uint8_t delta_bits[kAxesPerSample] = {};
+  bool raw = false;
+};
+
+constexpr size_t kFrameRawPayloadBytes =
+    static_cast<size_t>(kFrameSamples) * kAxesPerSample * sizeof(int16_t);
+
+// sample_bits is the signed width every sample is expected to fit in; frames
+// where that does not hold fall back to 16 bits.
+FrameEncoding plan_frame_encoding(const int16_t* xyz,
+                                  uint16_t sample_count,
+                                  uint8_t sample_bits = kFrameSampleBitsMax);
+void encode_frame(const int16_t* xyz,
+                  uint16_t sample_count,
+                  const FrameEncoding& encoding,
+                  uint8_t* out);
+bool decode_frame(const uint8_t* payload,
+                  uint16_t sample_count,
+                  const FrameEncoding& encoding,
+                  int16_t* out_xyz);
+
+}  // namespace vibesensor::runtime
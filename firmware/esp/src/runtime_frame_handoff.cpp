@@ -0,0 +1,146 @@
+#include "runtime_frame_handoff.h"
+
+namespace vibesensor::runtime {
+namespace {
+
+CommittedFrame& slot_for(FrameHandoffState& state, uint32_t index) {
+  return state.slots[index % state.capacity];
+}
+
+const CommittedFrame& slot_for(const FrameHandoffState& state, uint32_t index) {
+  return state.slots[index % state.capacity];
+}
+
+}  // namespace
+
+void initialize_frame_handoff(FrameHandoffState& state,
+                              CommittedFrame* storage,
+                              size_t capacity) {
+  state.slots = storage;
+  state.capacity = capacity;
+  state.head.store(0, std::memory_order_relaxed);
+  state.tail.store(0, std::memory_order_relaxed);
+  state.staged_count = 0;
+  state.overflow_drops = 0;
+  state.high_watermark = 0;
+}
+
+size_t frame_handoff_size(const FrameHandoffState& state) {
+  return static_cast<size_t>(state.head.load(std::memory_order_acquire) -
+                             state.tail.load(std::memory_order_acquire));
+}
+
+size_t frame_handoff_capacity(const FrameHandoffState& state) {
+  return state.capacity;
+}
+
+size_t frame_handoff_free_samples(const FrameHandoffState& state) {
+  const size_t size = frame_handoff_size(state);
+  if (state.slots == nullptr || size >= state.capacity) {
+    return 0;
+  }
+  return ((state.capacity - size) * kFrameSamples) - state.staged_count;
+}
+
+bool stage_frame_sample(FrameHandoffState& state, const PendingSample& sample) {
+  size_t contiguous_samples = 0;
+  int16_t* xyz = reserve_frame_samples(state, 0, &contiguous_samples);
+  if (xyz == nullptr) {
+    state.overflow_drops++;
+    return false;
+  }
+  xyz[0] = sample.x;
+  xyz[1] = sample.y;
+  xyz[2] = sample.z;
+  return stage_reserved_frame_sample(state, sample.due_us);
+}
+
+int16_t* reserve_frame_samples(FrameHandoffState& state,
+                               size_t ahead,
+                               size_t* contiguous_samples) {
+  *contiguous_samples = 0;
+  if (state.slots == nullptr || state.capacity == 0) {
+    return nullptr;
+  }
+  const size_t position = static_cast<size_t>(state.staged_count) + ahead;
+  const uint32_t index =
+      state.head.load(std::memory_order_relaxed) + static_cast<uint32_t>(position / kFrameSamples);
+  if (index - state.tail.load(std::memory_order_acquire) >= state.capacity) {
+    return nullptr;
+  }
+  const size_t sample_in_frame = position % kFrameSamples;
+  *contiguous_samples = kFrameSamples - sample_in_frame;
+  return slot_for(state, index).xyz + (sample_in_frame * kAxesPerSample);
+}
+
+bool stage_reserved_frame_sample(FrameHandoffState& state, uint64_t due_us) {
+  if (state.slots == nullptr || state.capacity == 0) {
+    state.overflow_drops++;
+    return false;
+  }
+  CommittedFrame& frame = slot_for(state, state.head.load(std::memory_order_relaxed));
+  if (state.staged_count == 0) {
+    frame.t0_us = due_us;
+  }
+  state.staged_count++;
+  return true;
+}
+
+const int16_t* last_staged_frame_sample(const FrameHandoffState& state) {
+  if (state.slots == nullptr || state.staged_count == 0) {
+    return nullptr;
+  }
+  const CommittedFrame& frame = slot_for(state, state.head.load(std::memory_order_relaxed));
+  return frame.xyz + ((static_cast<size_t>(state.staged_count) - 1U) * kAxesPerSample);
+}
+
+bool staged_frame_complete(const FrameHandoffState& state) {
+  return state.staged_count >= kFrameSamples;
+}
+
+uint64_t staged_frame_t0_us(const FrameHandoffState& state) {
+  if (state.slots == nullptr || state.staged_count == 0) {
+    return 0;
+  }
+  return slot_for(state, state.head.load(std::memory_order_relaxed)).t0_us;
+}
+
+void commit_staged_frame(FrameHandoffState& state,
+                         int64_t clock_offset_us,
+                         uint8_t range_tag,
+                         const vibesensor::DataPulseChannel& pulse) {
+  if (state.staged_count == 0) {
+    return;
+  }
+  const uint32_t head = state.head.load(std::memory_order_relaxed);
+  CommittedFrame& frame = slot_for(state, head);
+  frame.t0_us = static_cast<uint64_t>(static_cast<int64_t>(frame.t0_us) + clock_offset_us);
+  frame.sample_count = state.staged_count;
+  frame.range_tag = range_tag;
+  frame.pulse = pulse;
+  state.staged_count = 0;
+  state.head.store(head + 1U, std::memory_order_release);
+
+  const size_t size = frame_handoff_size(state);
+  if (size > state.high_watermark) {
+    state.high_watermark = size;
+  }
+}
+
+const CommittedFrame* peek_committed_frame(FrameHandoffState& state) {
+  const uint32_t tail = state.tail.load(std::memory_order_relaxed);
+  if (state.slots == nullptr || state.head.load(std::memory_order_acquire) == tail) {
+    return nullptr;
+  }
+  return &slot_for(state, tail);
+}
+
+void release_committed_frame(FrameHandoffState& state) {
+  const uint32_t tail = state.tail.load(std::memory_order_relaxed);
+  if (state.head.load(std::memory_order_acquire) == tail) {
+    return;
+  }
+  state.tail.store(tail + 1U, std::memory_order_release);
+}
+
+}  // namespace vibesensor::runtime
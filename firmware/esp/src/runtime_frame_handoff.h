@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <atomic>
+
+#include "runtime_config.h"
+
+namespace vibesensor::runtime {
+
+struct PendingSample {
+  uint64_t due_us = 0;
+  int16_t x = 0;
+  int16_t y = 0;
+  int16_t z = 0;
+};
+
+// One frame assembled by the sampling task. t0_us already includes the clock
+// offset that was current when the frame was committed; the pulse reading is
+// relative to t0_us, so it needs none.
+struct CommittedFrame {
+  uint64_t t0_us = 0;
+  uint16_t sample_count = 0;
+  uint8_t range_tag = kDefaultRangeTag;
+  vibesensor::DataPulseChannel pulse;
+  int16_t xyz[static_cast<size_t>(kFrameSamples) * kAxesPerSample] = {};
+};
+
+// Single-producer/single-consumer ring of whole frames. The sampling task
+// stages samples straight into the slot at head and publishes it once full;
+// the main loop only ever sees committed frames. head and tail are free-running
+// counters, each written by one side only.
+//
+// The producer may also write ahead of the staged position (sensor read-ahead):
+// such samples already sit where they will be staged, so staging them later is
+// index arithmetic only.
+struct FrameHandoffState {
+  CommittedFrame* slots = nullptr;
+  size_t capacity = 0;
+  std::atomic<uint32_t> head{0};
+  std::atomic<uint32_t> tail{0};
+  uint16_t staged_count = 0;
+  uint32_t overflow_drops = 0;
+  size_t high_watermark = 0;
+};
+
+void initialize_frame_handoff(FrameHandoffState& state,
+                              CommittedFrame* storage,
+                              size_t capacity);
+size_t frame_handoff_size(const FrameHandoffState& state);
+size_t frame_handoff_capacity(const FrameHandoffState& state);
+size_t frame_handoff_free_samples(const FrameHandoffState& state);
+
+// Producer side (sampling task).
+bool stage_frame_sample(FrameHandoffState& state, const PendingSample& sample);
+// Returns the XYZ slot for the sample `ahead` positions past the staged one and
+// sets *contiguous_samples to how many samples fit from there to the end of
+// that frame, or returns nullptr while that frame slot still belongs to the
+// consumer.
+int16_t* reserve_frame_samples(FrameHandoffState& state,
+                               size_t ahead,
+                               size_t* contiguous_samples);
+// Stages the sample already written at the staged position.
+bool stage_reserved_frame_sample(FrameHandoffState& state, uint64_t due_us);
+// XYZ of the most recently staged sample of the frame being assembled.
+const int16_t* last_staged_frame_sample(const FrameHandoffState& state);
+bool staged_frame_complete(const FrameHandoffState& state);
+// Local due time of the first sample of the frame being assembled.
+uint64_t staged_frame_t0_us(const FrameHandoffState& state);
+void commit_staged_frame(FrameHandoffState& state,
+                         int64_t clock_offset_us,
+                         uint8_t range_tag = kDefaultRangeTag,
+                         const vibesensor::DataPulseChannel& pulse = vibesensor::DataPulseChannel());
+
+// Consumer side (main loop).
+const CommittedFrame* peek_committed_frame(FrameHandoffState& state);
+void release_committed_frame(FrameHandoffState& state);
+
+}  // namespace vibesensor::runtime
@@ -0,0 +1,70 @@
+#include "runtime_pulse.h"
+
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+
+namespace vibesensor::runtime {
+namespace {
+
+portMUX_TYPE g_pulse_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void IRAM_ATTR on_pulse_edge(void* arg) {
+  record_pulse_edge(*static_cast<PulseInputState*>(arg),
+                    static_cast<uint64_t>(esp_timer_get_time()));
+}
+
+}  // namespace
+
+bool begin_pulse_input(PulseInputState& state) {
+  if (!kPulseInputEnabled) {
+    return false;
+  }
+  portENTER_CRITICAL(&g_pulse_lock);
+  state = PulseInputState();
+  portEXIT_CRITICAL(&g_pulse_lock);
+  // Hall sensors are usually open-collector, so the input idles high.
+  pinMode(kPulseInputPin, INPUT_PULLUP);
+  attachInterruptArg(digitalPinToInterrupt(kPulseInputPin), on_pulse_edge, &state, RISING);
+  return true;
+}
+
+void IRAM_ATTR record_pulse_edge(PulseInputState& state, uint64_t edge_us) {
+  portENTER_CRITICAL_ISR(&g_pulse_lock);
+  if (state.has_edge && edge_us - state.last_edge_us < kPulseMinEdgeIntervalUs) {
+    state.rejected_edges++;
+  } else {
+    state.edge_count++;
+    state.last_edge_us = edge_us;
+    state.has_edge = true;
+  }
+  portEXIT_CRITICAL_ISR(&g_pulse_lock);
+}
+
+PulseReading read_pulse_input(PulseInputState& state) {
+  PulseReading reading;
+  portENTER_CRITICAL(&g_pulse_lock);
+  reading.edge_count = state.edge_count;
+  reading.rejected_edges = state.rejected_edges;
+  reading.last_edge_us = state.last_edge_us;
+  reading.has_edge = state.has_edge;
+  portEXIT_CRITICAL(&g_pulse_lock);
+  return reading;
+}
+
+vibesensor::DataPulseChannel frame_pulse_channel(const PulseReading& reading,
+                                                 uint64_t frame_t0_us) {
+  vibesensor::DataPulseChannel channel;
+  channel.edge_count = static_cast<uint16_t>(reading.edge_count);
+  if (!reading.has_edge) {
+    return channel;
+  }
+  const int64_t offset_us =
+      static_cast<int64_t>(reading.last_edge_us) - static_cast<int64_t>(frame_t0_us);
+  if (offset_us > INT32_MAX || offset_us <= static_cast<int64_t>(vibesensor::kDataPulseNoEdge)) {
+    return channel;
+  }
+  channel.last_edge_offset_us = static_cast<int32_t>(offset_us);
+  return channel;
+}
+
+}  // namespace vibesensor::runtime
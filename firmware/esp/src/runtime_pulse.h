@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "runtime_config.h"
+#include "vibesensor_proto.h"
+
+namespace vibesensor::runtime {
+
+// Wheel/shaft pulse input. The edge interrupt timestamps accepted rising edges
+// with esp_timer_get_time(), the clock sample due times run on, so a frame's
+// pulse reading lines up with its samples. Written by the interrupt and read by
+// the sampling task, both under the pulse lock.
+struct PulseInputState {
+  uint32_t edge_count = 0;
+  uint32_t rejected_edges = 0;
+  uint64_t last_edge_us = 0;
+  bool has_edge = false;
+};
+
+struct PulseReading {
+  uint32_t edge_count = 0;
+  uint32_t rejected_edges = 0;
+  uint64_t last_edge_us = 0;
+  bool has_edge = false;
+};
+
+// Attaches the edge interrupt to kPulseInputPin; false when the input is
+// compiled out.
+bool begin_pulse_input(PulseInputState& state);
+// Counts one rising edge seen at edge_us. An edge within
+// kPulseMinEdgeIntervalUs of the last accepted one is only tallied as rejected.
+void record_pulse_edge(PulseInputState& state, uint64_t edge_us);
+PulseReading read_pulse_input(PulseInputState& state);
+// DATA wheel pulse channel for a frame whose first sample was due at
+// frame_t0_us on the same local clock.
+vibesensor::DataPulseChannel frame_pulse_channel(const PulseReading& reading,
+                                                 uint64_t frame_t0_us);
+
+}  // namespace vibesensor::runtime
@@ -1,6 +1,7 @@
 #include "runtime_queue.h"
 
 #include <esp_heap_caps.h>
+#include <new>
 #include <string.h>
 
 #include "runtime_config.h"
@@ -12,54 +13,65 @@ bool seq_less_or_equal(uint32_t lhs, uint32_t rhs) {
   return static_cast<int32_t>(lhs - rhs) <= 0;
 }
 
-void enqueue_frame(FrameQueueState& state,
-                   RuntimeStatus& status,
-                   int64_t clock_offset_us) {
-  if (state.build_count == 0) {
-    return;
+uint8_t range_tag_sample_bits(uint8_t range_tag) {
+  if ((range_tag & vibesensor::kDataRangeTagFullRes) == 0) {
+    return vibesensor::reliability::accel_range_sample_bits(vibesensor::reliability::kAccelRange2g);
   }
-  if (state.queue == nullptr || state.capacity == 0) {
-    status.queue_overflow_drops++;
-    state.build_count = 0;
-    return;
+  return vibesensor::reliability::accel_range_sample_bits(
+      static_cast<uint8_t>(range_tag & vibesensor::kDataRangeTagRangeMask));
+}
+
+DataFrame* record_at(FrameQueueState& state, size_t offset) {
+  return reinterpret_cast<DataFrame*>(state.ring + offset);
+}
+
+size_t next_record_offset(const FrameQueueState& state, size_t offset, size_t record_bytes) {
+  offset += record_bytes;
+  if (state.wrap_end != 0 && offset >= state.wrap_end) {
+    offset = 0;
   }
+  return offset;
+}
 
-  if (state.size == state.capacity) {
+// Finds room for a record of record_bytes, evicting the oldest records as
+// needed. Returns the write offset, or ring_bytes when the ring is too small.
+size_t reserve_record(FrameQueueState& state, RuntimeStatus& status, size_t record_bytes) {
+  while (true) {
+    if (state.size == 0) {
+      state.head = 0;
+      state.tail = 0;
+      state.wrap_end = 0;
+      return record_bytes <= state.ring_bytes ? 0 : state.ring_bytes;
+    }
+    if (state.wrap_end == 0) {
+      if (state.head + record_bytes <= state.ring_bytes) {
+        return state.head;
+      }
+      if (record_bytes <= state.tail) {
+        state.wrap_end = state.head;
+        state.head = 0;
+        return 0;
+      }
+    } else if (state.head + record_bytes <= state.tail) {
+      return state.head;
+    }
     status.queue_overflow_drops++;
-    state.tail = (state.tail + 1) % state.capacity;
-    state.size--;
-  }
-
-  DataFrame& frame = state.queue[state.head];
-  frame.seq = state.next_seq++;
-  frame.t0_us = static_cast<uint64_t>(static_cast<int64_t>(state.build_t0_us) + clock_offset_us);
-  frame.sample_count = state.build_count;
-  frame.transmitted = false;
-  frame.tx_attempts = 0;
-  frame.queued_ms = millis();
-  frame.first_tx_ms = 0;
-  frame.last_tx_ms = 0;
-  memcpy(frame.xyz,
-         state.build_xyz,
-         static_cast<size_t>(state.build_count) * kAxesPerSample * sizeof(int16_t));
-
-  state.head = (state.head + 1) % state.capacity;
-  state.size++;
-  state.build_count = 0;
+    drop_front_frame(state);
+  }
 }
 
 }  // namespace
 
 bool allocate_frame_queue(FrameQueueState& state) {
-  for (size_t cap = kFrameQueueLenTarget; cap >= kFrameQueueLenMin; --cap) {
-    auto* mem = static_cast<DataFrame*>(
-        heap_caps_malloc(cap * sizeof(DataFrame), MALLOC_CAP_8BIT));
+  for (size_t bytes = kFrameQueueBytesTarget; bytes >= kFrameQueueBytesMin;
+       bytes -= kFrameRecordMaxBytes) {
+    auto* mem = static_cast<uint8_t*>(heap_caps_malloc(bytes, MALLOC_CAP_8BIT));
     if (mem != nullptr) {
-      state.queue = mem;
-      state.capacity = cap;
+      state.ring = mem;
+      state.ring_bytes = bytes;
       return true;
     }
-    if (cap == kFrameQueueLenMin) {
+    if (bytes < kFrameQueueBytesMin + kFrameRecordMaxBytes) {
       break;
     }
   }
@@ -70,54 +82,84 @@ size_t frame_queue_size(const FrameQueueState& state) {
   return state.size;
 }
 
-size_t frame_queue_capacity(const FrameQueueState& state) {
-  return state.capacity;
+size_t frame_queue_used_bytes(const FrameQueueState& state) {
+  return state.used_bytes;
 }
 
 size_t frame_queue_bytes(const FrameQueueState& state) {
-  return state.capacity * sizeof(DataFrame);
+  return state.ring_bytes;
 }
 
-void append_sample(FrameQueueState& state,
+void enqueue_frame(FrameQueueState& state,
                    RuntimeStatus& status,
-                   int16_t x,
-                   int16_t y,
-                   int16_t z,
-                   uint64_t sample_due_us,
-                   int64_t clock_offset_us) {
-  if (state.build_count == 0) {
-    state.build_t0_us = sample_due_us;
+                   uint64_t t0_us,
+                   const int16_t* xyz,
+                   uint16_t sample_count,
+                   uint8_t range_tag,
+                   const vibesensor::DataPulseChannel& pulse) {
+  if (sample_count == 0 || sample_count > kFrameSamples) {
+    return;
   }
-
-  const size_t idx = static_cast<size_t>(state.build_count) * kAxesPerSample;
-  state.build_xyz[idx + 0] = x;
-  state.build_xyz[idx + 1] = y;
-  state.build_xyz[idx + 2] = z;
-  state.build_count++;
-
-  if (state.build_count >= kFrameSamples) {
-    enqueue_frame(state, status, clock_offset_us);
+  const FrameEncoding encoding =
+      plan_frame_encoding(xyz, sample_count, range_tag_sample_bits(range_tag));
+  const size_t record_bytes = frame_record_bytes(encoding.payload_bytes);
+  const size_t offset =
+      state.ring == nullptr ? state.ring_bytes : reserve_record(state, status, record_bytes);
+  if (state.ring == nullptr || offset >= state.ring_bytes) {
+    status.queue_overflow_drops++;
+    return;
   }
+
+  DataFrame* frame = new (state.ring + offset) DataFrame();
+  frame->seq = state.next_seq++;
+  frame->t0_us = t0_us;
+  frame->sample_count = sample_count;
+  frame->record_bytes = static_cast<uint16_t>(record_bytes);
+  frame->range_tag = range_tag;
+  frame->encoding = encoding;
+  frame->pulse = pulse;
+  frame->queued_ms = millis();
+  encode_frame(xyz, sample_count, encoding, state.ring + offset + sizeof(DataFrame));
+
+  state.head = offset + record_bytes;
+  state.used_bytes += record_bytes;
+  state.size++;
 }
 
 DataFrame* peek_frame(FrameQueueState& state) {
   if (state.size == 0) {
     return nullptr;
   }
-  return &state.queue[state.tail];
+  return record_at(state, state.tail);
+}
+
+bool read_frame_samples(const DataFrame& frame, int16_t* out_xyz) {
+  const uint8_t* payload = reinterpret_cast<const uint8_t*>(&frame) + sizeof(DataFrame);
+  return decode_frame(payload, frame.sample_count, frame.encoding, out_xyz);
 }
 
 void drop_front_frame(FrameQueueState& state) {
   if (state.size == 0) {
     return;
   }
-  state.tail = (state.tail + 1) % state.capacity;
+  const size_t record_bytes = record_at(state, state.tail)->record_bytes;
+  state.tail += record_bytes;
+  state.used_bytes -= record_bytes;
   state.size--;
+  if (state.wrap_end != 0 && state.tail >= state.wrap_end) {
+    state.tail = 0;
+    state.wrap_end = 0;
+  }
+  if (state.size == 0) {
+    state.head = 0;
+    state.tail = 0;
+    state.wrap_end = 0;
+  }
 }
 
 void ack_data_frames(FrameQueueState& state, uint32_t last_seq_received) {
   while (state.size > 0) {
-    const DataFrame& front = state.queue[state.tail];
+    const DataFrame& front = *record_at(state, state.tail);
     if (!seq_less_or_equal(front.seq, last_seq_received)) {
       break;
     }
@@ -125,4 +167,74 @@ void ack_data_frames(FrameQueueState& state, uint32_t last_seq_received) {
   }
 }
 
+uint32_t frame_queue_oldest_seq(const FrameQueueState& state) {
+  if (state.size == 0) {
+    return state.next_seq;
+  }
+  return reinterpret_cast<const DataFrame*>(state.ring + state.tail)->seq;
+}
+
+size_t apply_frame_receipts(FrameQueueState& state,
+                            uint32_t contiguous_seq,
+                            uint32_t receipt_bitmap) {
+  const size_t size_before = state.size;
+  ack_data_frames(state, contiguous_seq);
+  size_t received = size_before - state.size;
+
+  // Queued seqs are consecutive from the front, so walk records only as far as
+  // the bitmap reaches.
+  size_t offset = state.tail;
+  for (size_t i = 0; i < state.size; ++i) {
+    DataFrame* frame = record_at(state, offset);
+    const uint32_t distance = frame->seq - contiguous_seq;
+    if (distance >= 2U + vibesensor::kHelloAckReceiptBits) {
+      break;
+    }
+    if (distance >= 2U && (receipt_bitmap & (1UL << (distance - 2U))) != 0 &&
+        !frame->settled) {
+      frame->settled = true;
+      received++;
+    }
+    offset = next_record_offset(state, offset, frame->record_bytes);
+  }
+  return received;
+}
+
+DataFrame* find_frame_from(FrameQueueState& state, uint32_t seq) {
+  if (state.size == 0) {
+    return nullptr;
+  }
+  DataFrame* frame = record_at(state, state.tail);
+  if (seq_less_or_equal(seq, frame->seq)) {
+    return frame;
+  }
+  // Queued seqs are consecutive, so seq sits this many records past the front.
+  const uint32_t index = seq - frame->seq;
+  if (index >= state.size) {
+    return nullptr;
+  }
+  size_t offset = state.tail;
+  for (uint32_t i = 0; i < index; ++i) {
+    offset = next_record_offset(state, offset, record_at(state, offset)->record_bytes);
+  }
+  return record_at(state, offset);
+}
+
+void settle_frames(FrameQueueState& state, uint32_t first_seq, uint32_t end_seq) {
+  DataFrame* frame = find_frame_from(state, first_seq);
+  if (frame == nullptr) {
+    return;
+  }
+  size_t offset = static_cast<size_t>(reinterpret_cast<uint8_t*>(frame) - state.ring);
+  const uint32_t front_seq = record_at(state, state.tail)->seq;
+  for (size_t i = frame->seq - front_seq; i < state.size; ++i) {
+    frame = record_at(state, offset);
+    if (!seq_less_or_equal(frame->seq + 1U, end_seq)) {
+      break;
+    }
+    frame->settled = true;
+    offset = next_record_offset(state, offset, frame->record_bytes);
+  }
+}
+
 }  // namespace vibesensor::runtime
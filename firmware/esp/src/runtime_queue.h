@@ -3,47 +3,88 @@
 #include <Arduino.h>
 
 #include "runtime_config.h"
+#include "runtime_frame_codec.h"
 #include "runtime_status.h"
 
 namespace vibesensor::runtime {
 
+// Header of one queued frame record. The encoded samples follow it in the
+// ring; decode them with read_frame_samples().
 struct DataFrame {
   uint32_t seq = 0;
-  uint64_t t0_us = 0;
-  uint16_t sample_count = 0;
-  int16_t xyz[static_cast<size_t>(kFrameSamples) * kAxesPerSample] = {};
+  uint8_t range_tag = kDefaultRangeTag;
   bool transmitted = false;
+  // Nothing more to send: the server reported it past a gap (HELLO_ACK receipt
+  // bitmap), or the live UDP lane retired it while the backlog stream held the
+  // front. service_tx drops it unsent when it reaches the front.
+  bool settled = false;
   uint8_t tx_attempts = 0;
+  uint64_t t0_us = 0;
+  uint16_t sample_count = 0;
+  uint16_t record_bytes = 0;
+  FrameEncoding encoding;
+  vibesensor::DataPulseChannel pulse;
   uint32_t queued_ms = 0;
   uint32_t first_tx_ms = 0;
   uint32_t last_tx_ms = 0;
 };
 
+constexpr size_t kFrameRecordAlign = alignof(DataFrame);
+constexpr size_t frame_record_bytes(size_t payload_bytes) {
+  return ((sizeof(DataFrame) + payload_bytes + kFrameRecordAlign - 1U) / kFrameRecordAlign) *
+         kFrameRecordAlign;
+}
+// Worst case (raw) record size; a ring must hold at least one.
+constexpr size_t kFrameRecordMaxBytes = frame_record_bytes(kFrameRawPayloadBytes);
+static_assert(kFrameQueueBytesMin >= kFrameRecordMaxBytes,
+              "VIBESENSOR_FRAME_QUEUE_BYTES_MIN must hold at least one raw frame");
+
+// Byte ring of variable-length frame records, oldest at tail. Records never
+// straddle the end of the buffer: when the next one does not fit there, the
+// writer marks wrap_end and continues at offset 0.
 struct FrameQueueState {
-  DataFrame* queue = nullptr;
-  size_t capacity = 0;
+  uint8_t* ring = nullptr;
+  size_t ring_bytes = 0;
   size_t head = 0;
   size_t tail = 0;
+  size_t wrap_end = 0;
+  size_t used_bytes = 0;
   size_t size = 0;
-  int16_t build_xyz[static_cast<size_t>(kFrameSamples) * kAxesPerSample] = {};
-  uint16_t build_count = 0;
-  uint64_t build_t0_us = 0;
   uint32_t next_seq = 0;
 };
 
 bool allocate_frame_queue(FrameQueueState& state);
 size_t frame_queue_size(const FrameQueueState& state);
-size_t frame_queue_capacity(const FrameQueueState& state);
+size_t frame_queue_used_bytes(const FrameQueueState& state);
 size_t frame_queue_bytes(const FrameQueueState& state);
-void append_sample(FrameQueueState& state,
+// Encodes one complete frame into the ring, evicting the oldest records when
+// it does not fit. t0_us is the frame's first-sample time on the wire clock;
+// range_tag is the DATA range tag the frame was sampled under and bounds the
+// width the codec stores samples at; pulse is its wheel pulse reading.
+void enqueue_frame(FrameQueueState& state,
                    RuntimeStatus& status,
-                   int16_t x,
-                   int16_t y,
-                   int16_t z,
-                   uint64_t sample_due_us,
-                   int64_t clock_offset_us);
+                   uint64_t t0_us,
+                   const int16_t* xyz,
+                   uint16_t sample_count,
+                   uint8_t range_tag = kDefaultRangeTag,
+                   const vibesensor::DataPulseChannel& pulse = vibesensor::DataPulseChannel());
 DataFrame* peek_frame(FrameQueueState& state);
+bool read_frame_samples(const DataFrame& frame, int16_t* out_xyz);
 void drop_front_frame(FrameQueueState& state);
 void ack_data_frames(FrameQueueState& state, uint32_t last_seq_received);
+// Seq of the oldest frame still queued, or the next seq to be assigned when the
+// queue is empty. Everything older is settled, so it anchors HELLO receipts.
+uint32_t frame_queue_oldest_seq(const FrameQueueState& state);
+// Applies a HELLO_ACK receipt report: frames up to contiguous_seq are released
+// and frames marked in receipt_bitmap are flagged settled. Returns how many
+// queued frames the server already had.
+size_t apply_frame_receipts(FrameQueueState& state,
+                            uint32_t contiguous_seq,
+                            uint32_t receipt_bitmap);
+// Oldest queued frame whose seq is not before seq, or nullptr when seq has not
+// been queued yet. Walks from the front, so it costs one step per older frame.
+DataFrame* find_frame_from(FrameQueueState& state, uint32_t seq);
+// Flags the queued frames with seqs in [first_seq, end_seq) settled.
+void settle_frames(FrameQueueState& state, uint32_t first_seq, uint32_t end_seq);
 
 }  // namespace vibesensor::runtime
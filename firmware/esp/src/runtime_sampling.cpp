@@ -46,13 +46,14 @@ void record_sampling_error_locked(SamplingState& state, uint8_t error_code, uint
 }
 
 void sync_sampling_snapshot_locked(SamplingState& state) {
-  state.status.sample_handoff_size = static_cast<uint16_t>(sample_handoff_size(state.handoff));
-  state.status.sample_handoff_capacity =
-      static_cast<uint16_t>(sample_handoff_capacity(state.handoff));
+  state.status.frame_handoff_size = static_cast<uint16_t>(frame_handoff_size(state.handoff));
+  state.status.frame_handoff_capacity =
+      static_cast<uint16_t>(frame_handoff_capacity(state.handoff));
   state.status.sensor_prefetch_count = static_cast<uint16_t>(state.sensor_prefetch_count);
   state.status.last_refill_request = static_cast<uint16_t>(state.last_refill_request);
   state.status.last_refill_count = static_cast<uint16_t>(state.last_refill_count);
   state.status.sampling_handoff_overflow_drops = state.handoff.overflow_drops;
+  state.status.sensor_range_g = vibesensor::reliability::accel_range_g(state.sensor_range_code);
 }
 
 void sync_sampling_snapshot(SamplingState& state) {
@@ -62,8 +63,6 @@ void sync_sampling_snapshot(SamplingState& state) {
 }
 
 void clear_sensor_prefetch(SamplingState& state) {
-  state.sensor_prefetch_head = 0;
-  state.sensor_prefetch_tail = 0;
   state.sensor_prefetch_count = 0;
 }
 
@@ -135,17 +134,123 @@ void note_missed_samples(SamplingState& state, uint32_t missed_samples, bool aba
   portEXIT_CRITICAL(&g_sampling_lock);
 }
 
-bool publish_sample(SamplingState& state, const PendingSample& sample) {
-  const uint32_t now_ms = millis();
-  bool ok = false;
+void track_frame_range(SamplingState& state, const int16_t* xyz) {
+  for (size_t axis = 0; axis < kAxesPerSample; ++axis) {
+    const int16_t value = xyz[axis];
+    const int32_t magnitude = value < 0 ? -static_cast<int32_t>(value) : value;
+    if (magnitude > state.frame_peak_counts) {
+      state.frame_peak_counts = magnitude;
+    }
+    if (vibesensor::reliability::accel_sample_clipped(value, state.frame_range_low)) {
+      state.frame_clipped = true;
+    }
+  }
+}
+
+uint8_t staged_frame_range_tag(const SamplingState& state) {
+  const uint8_t clipped =
+      state.frame_clipped ? static_cast<uint8_t>(vibesensor::kDataRangeTagClipped) : 0U;
+  return static_cast<uint8_t>(vibesensor::kDataRangeTagFullRes | state.frame_range_high | clipped);
+}
+
+// Runs the auto-range controller on the frame just committed and reprograms
+// the sensor for the next one. Range switches only happen here, between frames.
+void advance_frame_range(SamplingState& state) {
+  const uint8_t current = state.sensor_range_code;
+  uint8_t next = current;
+  bool switched = false;
+  if (kAutoRangeEnabled && state.sensor_ok) {
+    next = vibesensor::reliability::auto_range_next(
+        state.auto_range, state.frame_peak_counts, state.frame_clipped, kAutoRangeQuietFrames);
+    if (next != current) {
+      ADXL345::FailureKind failure_kind = ADXL345::FailureKind::kNone;
+      switched = state.adxl.set_range(next, &failure_kind);
+      if (!switched) {
+        state.auto_range.range_code = current;
+        next = current;
+        note_sensor_read_error(state, failure_kind);
+      }
+    }
+  }
+
   portENTER_CRITICAL(&g_sampling_lock);
-  ok = enqueue_pending_sample(state.handoff, sample);
-  if (!ok) {
-    record_sampling_error_locked(state, kSamplingErrorHandoffOverflow, now_ms);
+  if (switched) {
+    state.status.sensor_range_switches++;
+  }
+  if (state.frame_clipped) {
+    state.status.sensor_clipped_frames++;
+  }
+  portEXIT_CRITICAL(&g_sampling_lock);
+
+  state.sensor_range_code = next;
+  state.frame_range_low = current < next ? current : next;
+  state.frame_range_high = current < next ? next : current;
+  state.frame_peak_counts = 0;
+  state.frame_clipped = false;
+}
+
+// Reads the pulse input as the frame completes; edges up to now count toward
+// this frame.
+vibesensor::DataPulseChannel staged_frame_pulse(SamplingState& state) {
+  if (!state.pulse_input_ok) {
+    return vibesensor::DataPulseChannel();
   }
+  const PulseReading reading = read_pulse_input(state.pulse);
+  portENTER_CRITICAL(&g_sampling_lock);
+  state.status.pulse_edges = reading.edge_count;
+  state.status.pulse_rejected_edges = reading.rejected_edges;
+  portEXIT_CRITICAL(&g_sampling_lock);
+  return frame_pulse_channel(reading, staged_frame_t0_us(state.handoff));
+}
+
+void note_handoff_overflow(SamplingState& state) {
+  const uint32_t now_ms = millis();
+  portENTER_CRITICAL(&g_sampling_lock);
+  record_sampling_error_locked(state, kSamplingErrorHandoffOverflow, now_ms);
   sync_sampling_snapshot_locked(state);
   portEXIT_CRITICAL(&g_sampling_lock);
-  return ok;
+}
+
+// Range-tracks the sample just staged and publishes the frame to the loop once
+// it is full, stamped with the clock offset current right now.
+bool finish_staged_sample(SamplingState& state) {
+  track_frame_range(state, last_staged_frame_sample(state.handoff));
+  if (!staged_frame_complete(state.handoff)) {
+    return true;
+  }
+
+  int64_t clock_offset_us = 0;
+  portENTER_CRITICAL(&g_sampling_lock);
+  clock_offset_us = state.clock_offset_us;
+  portEXIT_CRITICAL(&g_sampling_lock);
+  commit_staged_frame(state.handoff,
+                      clock_offset_us,
+                      staged_frame_range_tag(state),
+                      staged_frame_pulse(state));
+  advance_frame_range(state);
+  sync_sampling_snapshot(state);
+  return true;
+}
+
+// Stages a sample that did not come from the sensor read-ahead (the synthetic
+// fallback), so the read-ahead must be empty.
+bool publish_sample(SamplingState& state, const PendingSample& sample) {
+  if (!stage_frame_sample(state.handoff, sample)) {
+    note_handoff_overflow(state);
+    return false;
+  }
+  return finish_staged_sample(state);
+}
+
+// Stages the oldest read-ahead sample. It was decoded in place, so only the
+// indices move.
+bool publish_prefetched_sample(SamplingState& state, uint64_t due_us) {
+  if (!stage_reserved_frame_sample(state.handoff, due_us)) {
+    note_handoff_overflow(state);
+    return false;
+  }
+  state.sensor_prefetch_count--;
+  return finish_staged_sample(state);
 }
 
 SensorFailureClass classify_sensor_failure(ADXL345::FailureKind failure_kind,
@@ -171,39 +276,36 @@ SensorFailureClass classify_sensor_failure(ADXL345::FailureKind failure_kind,
   return SensorFailureClass::kNone;
 }
 
-size_t append_sensor_prefetch_samples(SamplingState& state,
-                                      const int16_t* batch_xyz,
-                                      size_t read_count) {
-  size_t appended = 0;
-  for (; appended < read_count && state.sensor_prefetch_count < kSensorPrefetchSamples; ++appended) {
-    const size_t src = appended * kAxesPerSample;
-    const size_t dst = state.sensor_prefetch_head * kAxesPerSample;
-    state.sensor_prefetch_xyz[dst + 0] = batch_xyz[src + 0];
-    state.sensor_prefetch_xyz[dst + 1] = batch_xyz[src + 1];
-    state.sensor_prefetch_xyz[dst + 2] = batch_xyz[src + 2];
-    state.sensor_prefetch_head = (state.sensor_prefetch_head + 1) % kSensorPrefetchSamples;
-    state.sensor_prefetch_count++;
-  }
-  return appended;
-}
-
+// Decodes FIFO entries straight into the handoff frames behind the samples
+// already read ahead. A read that reaches the end of a frame continues in the
+// next one, so the frame boundary does not look like a short FIFO drain.
 SensorRefillAttempt refill_sensor_prefetch_once(SamplingState& state, size_t request_samples) {
   SensorRefillAttempt attempt{};
-  if (request_samples == 0) {
-    return attempt;
+  size_t remaining = request_samples;
+  while (remaining > 0) {
+    size_t contiguous_samples = 0;
+    int16_t* xyz =
+        reserve_frame_samples(state.handoff, state.sensor_prefetch_count, &contiguous_samples);
+    if (xyz == nullptr) {
+      // The loop still owns that frame; the samples wait in the sensor FIFO.
+      break;
+    }
+    const size_t span = remaining < contiguous_samples ? remaining : contiguous_samples;
+    bool span_truncated = false;
+    const size_t read_count =
+        state.adxl.read_samples(xyz, span, &attempt.failure_kind, &span_truncated);
+    state.sensor_prefetch_count += read_count;
+    attempt.recovered_samples += read_count;
+    attempt.fifo_truncated = span_truncated;
+    remaining -= read_count;
+    if (attempt.failure_kind != ADXL345::FailureKind::kNone || read_count < span ||
+        !span_truncated) {
+      break;
+    }
   }
-
-  ADXL345::FailureKind failure_kind = ADXL345::FailureKind::kNone;
-  bool fifo_truncated = false;
-  const size_t read_count = state.adxl.read_samples(
-      state.sensor_batch_xyz, request_samples, &failure_kind, &fifo_truncated);
-  attempt.recovered_samples =
-      append_sensor_prefetch_samples(state, state.sensor_batch_xyz, read_count);
-  attempt.fifo_truncated = fifo_truncated;
-  attempt.failure_kind = failure_kind;
-  attempt.failure_class =
-      classify_sensor_failure(failure_kind, attempt.recovered_samples, fifo_truncated);
-  if (fifo_truncated) {
+  attempt.failure_class = classify_sensor_failure(
+      attempt.failure_kind, attempt.recovered_samples, attempt.fifo_truncated);
+  if (attempt.fifo_truncated) {
     note_fifo_truncated(state);
   }
   return attempt;
@@ -242,6 +344,10 @@ bool maybe_reinit_sensor(SamplingState& state, bool force = false) {
   state.sensor_ok = state.adxl.begin();
   if (state.sensor_ok) {
     state.sensor_consecutive_errors = 0;
+    // begin() puts the sensor back at +/-16 g.
+    state.auto_range = {};
+    state.sensor_range_code = vibesensor::reliability::kAccelRange16g;
+    state.frame_range_high = vibesensor::reliability::kAccelRange16g;
     clear_sensor_prefetch(state);
     state.last_refill_request = 0;
     state.last_refill_count = 0;
@@ -340,53 +446,30 @@ void maybe_refill_sensor_prefetch(SamplingState& state, size_t due_slots) {
   sync_sampling_snapshot(state);
 }
 
-bool next_sensor_sample(SamplingState& state,
-                        size_t due_slots,
-                        int16_t* x,
-                        int16_t* y,
-                        int16_t* z) {
+bool produce_sample(SamplingState& state, size_t due_slots) {
   maybe_refill_sensor_prefetch(state, due_slots);
-  if (state.sensor_prefetch_count == 0) {
+  if (state.sensor_prefetch_count > 0) {
+    return publish_prefetched_sample(state, state.next_sample_due_us);
+  }
+  if (frame_handoff_free_samples(state.handoff) == 0) {
+    // The loop owns every frame, so the refill had nowhere to decode into;
+    // the slot is lost to the handoff, as a staged sample would have been.
+    state.handoff.overflow_drops++;
+    note_handoff_overflow(state);
     return false;
   }
-
-  const size_t offset = state.sensor_prefetch_tail * kAxesPerSample;
-  *x = state.sensor_prefetch_xyz[offset + 0];
-  *y = state.sensor_prefetch_xyz[offset + 1];
-  *z = state.sensor_prefetch_xyz[offset + 2];
-  state.sensor_prefetch_tail =
-      (state.sensor_prefetch_tail + 1) % kSensorPrefetchSamples;
-  state.sensor_prefetch_count--;
-  sync_sampling_snapshot(state);
-  return true;
-}
-
-bool sample_once(SamplingState& state, size_t due_slots, PendingSample* sample) {
-  int16_t x = 0;
-  int16_t y = 0;
-  int16_t z = 0;
-
-  if (!next_sensor_sample(state, due_slots, &x, &y, &z)) {
 #if VIBESENSOR_ENABLE_SYNTH_FALLBACK
-    synth_sample(&x, &y, &z);
+  PendingSample sample{};
+  sample.due_us = state.next_sample_due_us;
+  synth_sample(&sample.x, &sample.y, &sample.z);
+  return publish_sample(state, sample);
 #else
-    return false;
+  return false;
 #endif
-  }
-
-  sample->due_us = state.next_sample_due_us;
-  sample->x = x;
-  sample->y = y;
-  sample->z = z;
-  return true;
 }
 
 size_t current_handoff_headroom(SamplingState& state) {
-  size_t free_slots = 0;
-  portENTER_CRITICAL(&g_sampling_lock);
-  free_slots = sample_handoff_free_slots(state.handoff);
-  portEXIT_CRITICAL(&g_sampling_lock);
-  return free_slots;
+  return frame_handoff_free_samples(state.handoff);
 }
 
 uint64_t advance_due_schedule(SamplingState& state, uint64_t slot_count = 1U) {
@@ -408,9 +491,8 @@ void process_due_samples(SamplingState& state, uint32_t due_slots) {
 
   size_t produced = 0;
   while (produced < recovery.attempt_slots) {
-    PendingSample sample{};
     const size_t remaining_due = static_cast<size_t>(due_slots) - produced;
-    if (!sample_once(state, remaining_due, &sample) || !publish_sample(state, sample)) {
+    if (!produce_sample(state, remaining_due)) {
       const uint32_t missed_samples = static_cast<uint32_t>(remaining_due);
       note_missed_samples(state, missed_samples, remaining_due > 1);
       state.next_sample_due_us += advance_due_schedule(state, missed_samples);
@@ -463,9 +545,11 @@ SamplingState::SamplingState()
     : i2c(Wire), adxl(i2c, kAdxlI2cAddr, kI2cSdaPin, kI2cSclPin) {}
 
 bool begin_sampling(SamplingState& state) {
-  initialize_sample_handoff(state.handoff, state.handoff_storage, kSampleHandoffQueueSamples);
+  initialize_frame_handoff(state.handoff, state.handoff_storage, kFrameHandoffFrames);
   sync_sampling_snapshot(state);
 
+  state.pulse_input_ok = begin_pulse_input(state.pulse);
+
   state.sensor_ok = state.adxl.begin();
   if (!state.sensor_ok) {
     const uint32_t now_ms = millis();
@@ -530,26 +614,33 @@ bool begin_sampling(SamplingState& state) {
   return true;
 }
 
-void service_sample_handoff(SamplingState& state,
-                            FrameQueueState& queue_state,
-                            RuntimeStatus& status,
-                            int64_t clock_offset_us) {
-  PendingSample sample{};
-  while (true) {
-    bool has_sample = false;
+void service_frame_handoff(SamplingState& state,
+                           FrameQueueState& queue_state,
+                           RuntimeStatus& status,
+                           int64_t clock_offset_us) {
+  if (clock_offset_us != state.loop_clock_offset_us) {
     portENTER_CRITICAL(&g_sampling_lock);
-    has_sample = dequeue_pending_sample(state.handoff, &sample);
-    if (has_sample) {
-      sync_sampling_snapshot_locked(state);
-    }
+    state.clock_offset_us = clock_offset_us;
     portEXIT_CRITICAL(&g_sampling_lock);
-    if (!has_sample) {
-      return;
-    }
+    state.loop_clock_offset_us = clock_offset_us;
+  }
 
-    append_sample(
-        queue_state, status, sample.x, sample.y, sample.z, sample.due_us, clock_offset_us);
+  const CommittedFrame* frame = peek_committed_frame(state.handoff);
+  if (frame == nullptr) {
+    return;
   }
+  while (frame != nullptr) {
+    enqueue_frame(queue_state,
+                  status,
+                  frame->t0_us,
+                  frame->xyz,
+                  frame->sample_count,
+                  frame->range_tag,
+                  frame->pulse);
+    release_committed_frame(state.handoff);
+    frame = peek_committed_frame(state.handoff);
+  }
+  sync_sampling_snapshot(state);
 }
 
 SamplingStatusSnapshot snapshot_sampling_status(SamplingState& state) {
@@ -6,8 +6,9 @@
 #include "adxl345.h"
 #include "reliability.h"
 #include "runtime_config.h"
+#include "runtime_frame_handoff.h"
+#include "runtime_pulse.h"
 #include "runtime_queue.h"
-#include "runtime_sample_handoff.h"
 #include "runtime_status.h"
 
 namespace vibesensor::runtime {
@@ -18,10 +19,9 @@ struct SamplingState {
   TwoWire& i2c;
   ADXL345 adxl;
   bool sensor_ok = false;
-  int16_t sensor_batch_xyz[kSensorPrefetchSamples * kAxesPerSample] = {};
-  int16_t sensor_prefetch_xyz[kSensorPrefetchSamples * kAxesPerSample] = {};
-  size_t sensor_prefetch_head = 0;
-  size_t sensor_prefetch_tail = 0;
+  // Samples read from the FIFO ahead of their due slot. They are decoded
+  // straight into the handoff frames just past the staged position, so this
+  // count is the whole prefetch bookkeeping.
   size_t sensor_prefetch_count = 0;
   uint8_t sensor_consecutive_errors = 0;
   uint32_t last_sensor_reinit_ms = 0;
@@ -31,16 +31,33 @@ struct SamplingState {
   size_t last_refill_request = 0;
   size_t last_refill_count = 0;
   bool recent_refill_shortfall = false;
-  PendingSample handoff_storage[kSampleHandoffQueueSamples] = {};
-  SampleHandoffState handoff;
+  CommittedFrame handoff_storage[kFrameHandoffFrames] = {};
+  FrameHandoffState handoff;
+  // Written by the loop under the sampling lock; read by the sampling task
+  // when it commits a frame. loop_clock_offset_us is the loop's own copy.
+  int64_t clock_offset_us = 0;
+  int64_t loop_clock_offset_us = 0;
+  // Auto-range bookkeeping, sampling task only. Samples still in the FIFO and
+  // prefetch when the range switches were taken at the old range, so the frame
+  // after a switch is tagged with the wider range and clip-checked against the
+  // narrower one.
+  vibesensor::reliability::AutoRangeState auto_range = {};
+  uint8_t sensor_range_code = vibesensor::reliability::kAccelRange16g;
+  uint8_t frame_range_low = vibesensor::reliability::kAccelRange16g;
+  uint8_t frame_range_high = vibesensor::reliability::kAccelRange16g;
+  int32_t frame_peak_counts = 0;
+  bool frame_clipped = false;
+  // Wheel/shaft pulse input, read once per committed frame.
+  PulseInputState pulse;
+  bool pulse_input_ok = false;
   SamplingStatusSnapshot status = {};
 };
 
 bool begin_sampling(SamplingState& state);
-void service_sample_handoff(SamplingState& state,
-                            FrameQueueState& queue_state,
-                            RuntimeStatus& status,
-                            int64_t clock_offset_us);
+void service_frame_handoff(SamplingState& state,
+                           FrameQueueState& queue_state,
+                           RuntimeStatus& status,
+                           int64_t clock_offset_us);
 SamplingStatusSnapshot snapshot_sampling_status(SamplingState& state);
 
 }  // namespace vibesensor::runtime
@@ -22,7 +22,8 @@ void set_last_error(RuntimeStatus& status, uint8_t error_code) {
 void report_runtime_status(RuntimeStatus& status,
                            const SamplingStatusSnapshot& sampling,
                            size_t queue_size,
-                           size_t queue_capacity,
+                           size_t queue_used_bytes,
+                           size_t queue_capacity_bytes,
                            uint32_t now_ms) {
   if (now_ms - status.last_status_report_ms < kStatusReportIntervalMs) {
     return;
@@ -36,21 +37,30 @@ void report_runtime_status(RuntimeStatus& status,
       sampling_error_newer ? sampling.last_error_ms : status.last_error_ms;
 
   Serial.printf(
-      "status wifi=%d q=%u/%u drop={queue:%lu stale:%lu retry:%lu} "
-      "tx_fail={pack:%lu begin:%lu end:%lu} "
+      "status wifi=%d q=%u(%u/%uB) drop={queue:%lu stale:%lu retry:%lu} "
+      "tx_fail={pack:%lu begin:%lu end:%lu} resume_skip=%lu "
+      "stream={opens:%lu frames:%lu fallback:%lu} "
       "sensor={err:%lu stat:%lu data:%lu trunc:%lu bus:%lu/%lu reinit:%lu/%lu miss:%lu late:%lu handoff:%lu "
-      "sq:%u/%u prefetch:%u refill:%u/%u} "
+      "fq:%u/%u prefetch:%u refill:%u/%u} "
+      "range={g:%u switches:%lu clipped:%lu} pulse={edges:%lu rejected:%lu} "
       "wifi_retry={attempts:%lu fail:%lu} sync={offset_us:%lld rtt_us:%lu} "
+      "slot={period_us:%lu guard_us:%lu} "
+      "tsf={ready:%u skew_ppb:%ld resets:%lu rejected:%lu} "
       "parse={ctrl:%lu ack:%lu} last_error=%u@%lu\n",
       WiFi.status(),
       static_cast<unsigned>(queue_size),
-      static_cast<unsigned>(queue_capacity),
+      static_cast<unsigned>(queue_used_bytes),
+      static_cast<unsigned>(queue_capacity_bytes),
       static_cast<unsigned long>(status.queue_overflow_drops),
       static_cast<unsigned long>(status.tx_stale_frame_drops),
       static_cast<unsigned long>(status.tx_retransmit_limit_drops),
       static_cast<unsigned long>(status.tx_pack_failures),
       static_cast<unsigned long>(status.tx_begin_failures),
       static_cast<unsigned long>(status.tx_end_failures),
+      static_cast<unsigned long>(status.tx_resume_skipped_frames),
+      static_cast<unsigned long>(status.backlog_stream_opens),
+      static_cast<unsigned long>(status.backlog_stream_frames),
+      static_cast<unsigned long>(status.backlog_stream_fallbacks),
       static_cast<unsigned long>(sampling.sensor_read_errors),
       static_cast<unsigned long>(sampling.sensor_fifo_status_failures),
       static_cast<unsigned long>(sampling.sensor_fifo_data_failures),
@@ -62,15 +72,26 @@ void report_runtime_status(RuntimeStatus& status,
       static_cast<unsigned long>(sampling.sampling_missed_samples),
       static_cast<unsigned long>(sampling.sampling_recovery_abandons),
       static_cast<unsigned long>(sampling.sampling_handoff_overflow_drops),
-      static_cast<unsigned>(sampling.sample_handoff_size),
-      static_cast<unsigned>(sampling.sample_handoff_capacity),
+      static_cast<unsigned>(sampling.frame_handoff_size),
+      static_cast<unsigned>(sampling.frame_handoff_capacity),
       static_cast<unsigned>(sampling.sensor_prefetch_count),
       static_cast<unsigned>(sampling.last_refill_count),
       static_cast<unsigned>(sampling.last_refill_request),
+      static_cast<unsigned>(sampling.sensor_range_g),
+      static_cast<unsigned long>(sampling.sensor_range_switches),
+      static_cast<unsigned long>(sampling.sensor_clipped_frames),
+      static_cast<unsigned long>(sampling.pulse_edges),
+      static_cast<unsigned long>(sampling.pulse_rejected_edges),
       static_cast<unsigned long>(status.wifi_reconnect_attempts),
       static_cast<unsigned long>(status.wifi_connect_failures),
       static_cast<long long>(status.sync_offset_us),
       static_cast<unsigned long>(status.sync_round_trip_us),
+      static_cast<unsigned long>(status.tx_slot_period_us),
+      static_cast<unsigned long>(status.tx_slot_guard_us),
+      static_cast<unsigned>(status.tsf_sync_ready ? 1U : 0U),
+      static_cast<long>(status.tsf_sync_skew_ppb),
+      static_cast<unsigned long>(status.tsf_sync_resets),
+      static_cast<unsigned long>(status.tsf_sync_rejected_reads),
       static_cast<unsigned long>(status.control_parse_errors),
       static_cast<unsigned long>(status.data_ack_parse_errors),
       static_cast<unsigned>(last_error_code),
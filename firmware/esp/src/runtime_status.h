@@ -12,12 +12,22 @@ struct RuntimeStatus {
   uint32_t tx_pack_failures = 0;
   uint32_t tx_begin_failures = 0;
   uint32_t tx_end_failures = 0;
+  uint32_t tx_resume_skipped_frames = 0;
+  uint32_t backlog_stream_opens = 0;
+  uint32_t backlog_stream_frames = 0;
+  uint32_t backlog_stream_fallbacks = 0;
   uint32_t control_parse_errors = 0;
   uint32_t data_ack_parse_errors = 0;
   uint32_t wifi_reconnect_attempts = 0;
   uint32_t wifi_connect_failures = 0;
   uint32_t sync_round_trip_us = 0;
   int64_t sync_offset_us = 0;
+  uint32_t tx_slot_period_us = 0;
+  uint32_t tx_slot_guard_us = 0;
+  uint32_t tsf_sync_resets = 0;
+  uint32_t tsf_sync_rejected_reads = 0;
+  int32_t tsf_sync_skew_ppb = 0;
+  bool tsf_sync_ready = false;
   uint8_t last_error_code = 0;
   uint32_t last_error_ms = 0;
 };
@@ -34,8 +44,13 @@ struct SamplingStatusSnapshot {
   uint32_t sampling_missed_samples = 0;
   uint32_t sampling_recovery_abandons = 0;
   uint32_t sampling_handoff_overflow_drops = 0;
-  uint16_t sample_handoff_size = 0;
-  uint16_t sample_handoff_capacity = 0;
+  uint32_t sensor_range_switches = 0;
+  uint32_t sensor_clipped_frames = 0;
+  uint32_t pulse_edges = 0;
+  uint32_t pulse_rejected_edges = 0;
+  uint8_t sensor_range_g = 16;
+  uint16_t frame_handoff_size = 0;
+  uint16_t frame_handoff_capacity = 0;
   uint16_t sensor_prefetch_count = 0;
   uint16_t last_refill_request = 0;
   uint16_t last_refill_count = 0;
@@ -47,7 +62,8 @@ void set_last_error(RuntimeStatus& status, uint8_t error_code);
 void report_runtime_status(RuntimeStatus& status,
                            const SamplingStatusSnapshot& sampling,
                            size_t queue_size,
-                           size_t queue_capacity,
+                           size_t queue_used_bytes,
+                           size_t queue_capacity_bytes,
                            uint32_t now_ms);
 
 }  // namespace vibesensor::runtime
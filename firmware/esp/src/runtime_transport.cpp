@@ -29,11 +29,92 @@ void derive_fallback_client_id(uint8_t client_id[vibesensor::kClientIdBytes]) {
   }
 }
 
+uint8_t hello_capabilities() {
+  const uint8_t pulse_channel =
+      kPulseInputEnabled ? static_cast<uint8_t>(vibesensor::kHelloCapPulseChannel) : 0U;
+  const uint8_t tsf_timebase =
+      kTsfTimeSyncEnabled ? static_cast<uint8_t>(vibesensor::kHelloCapTsfTimebase) : 0U;
+  return static_cast<uint8_t>(vibesensor::kHelloCapExplicitAck | vibesensor::kHelloCapTxSlots |
+                              vibesensor::kHelloCapRangeTag |
+                              vibesensor::kHelloCapResumeReceipts | pulse_channel | tsf_timebase);
+}
+
+// Slots are placed on the server clock, so they only apply once CMD_SYNC_CLOCK
+// has produced an offset; until then the node stays on contention access.
+bool tx_slots_active(const TransportState& state, const RuntimeStatus& status) {
+  return vibesensor::reliability::tx_slot_schedule_valid(state.tx_slot) &&
+         status.sync_round_trip_us > 0;
+}
+
+// A slot belongs to the session that assigned it; a new or lost handshake
+// returns the node to contention until the server assigns one again.
+void reset_tx_slot(TransportState& state, RuntimeStatus& status) {
+  state.tx_slot = vibesensor::reliability::TxSlotSchedule{};
+  status.tx_slot_period_us = 0;
+}
+
+uint32_t tx_slot_budget_us(const TransportState& state, RuntimeStatus& status) {
+  const uint32_t guard_us = vibesensor::reliability::tx_slot_guard_us(kTdmaMinGuardUs,
+                                                                      status.sync_round_trip_us,
+                                                                      millis() - state.last_sync_ms,
+                                                                      kTdmaDriftPpm,
+                                                                      state.tx_slot.width_us);
+  status.tx_slot_guard_us = guard_us;
+  const int64_t synced_now_us = static_cast<int64_t>(esp_timer_get_time()) + state.clock_offset_us;
+  return vibesensor::reliability::tx_slot_remaining_us(state.tx_slot, synced_now_us, guard_us);
+}
+
+// Optional DATA trailers are only sent once the server has echoed their
+// capability; servers that predate them reject a DATA packet of any other
+// length.
+bool server_accepts(const TransportState& state, uint8_t capability) {
+  return (state.server_capabilities & capability) != 0;
+}
+
+uint64_t frame_wire_t0_us(const TransportState& state, const DataFrame& frame) {
+  return kTsfTimeSyncEnabled ? tsf_from_local_us(state.tsf_sync.mapping, frame.t0_us)
+                             : frame.t0_us;
+}
+
 uint32_t frame_age_ms(const DataFrame& frame, uint32_t now_ms) {
   const uint32_t reference_ms = frame.first_tx_ms != 0 ? frame.first_tx_ms : frame.queued_ms;
   return now_ms - reference_ms;
 }
 
+// With the backlog stream open or connecting, the UDP lane starts at the oldest
+// live frame instead of the queue front, which belongs to the stream.
+DataFrame* next_udp_frame(TransportState& state, FrameQueueState& queue_state) {
+  BacklogStreamState& stream = state.backlog_stream;
+  if (!backlog_stream_holds_backlog(stream)) {
+    return peek_frame(queue_state);
+  }
+  DataFrame* frame = find_frame_from(queue_state, stream.next_live_seq);
+  if (frame != nullptr) {
+    stream.next_live_seq = frame->seq;
+  }
+  return frame;
+}
+
+void retire_udp_frame(TransportState& state, FrameQueueState& queue_state) {
+  if (backlog_stream_holds_backlog(state.backlog_stream)) {
+    state.backlog_stream.next_live_seq++;
+    return;
+  }
+  drop_front_frame(queue_state);
+}
+
+void apply_data_ack(TransportState& state, FrameQueueState& queue_state, uint32_t last_seq) {
+  BacklogStreamState& stream = state.backlog_stream;
+  // A live frame's ACK must not release the backlog queued ahead of it.
+  if (backlog_stream_holds_backlog(stream) && !backlog_stream_owns_seq(stream, last_seq)) {
+    if (static_cast<int32_t>(last_seq + 1U - stream.next_live_seq) > 0) {
+      stream.next_live_seq = last_seq + 1U;
+    }
+    return;
+  }
+  ack_data_frames(queue_state, last_seq);
+}
+
 bool send_control_packet(TransportState& state,
                          RuntimeStatus& status,
                          const uint8_t* packet,
@@ -93,14 +174,62 @@ void initialize_transport(TransportState& state) {
   }
   state.control_port =
       static_cast<uint16_t>(kControlPortBase + (state.client_id[5] % 100));
+  state.boot_id = esp_random();
   state.handshake_complete = false;
   state.data_udp.begin(0);
   state.control_udp.begin(state.control_port);
 }
 
-bool send_hello(TransportState& state, RuntimeStatus& status) {
+int64_t frame_clock_offset_us(const TransportState& state) {
+  // TSF mode keeps queued t0 values on the local clock and maps them onto the
+  // AP TSF at pack time, so the latest fit applies even to backlogged frames.
+  return kTsfTimeSyncEnabled ? 0 : state.clock_offset_us;
+}
+
+size_t pack_queued_frame(const TransportState& state,
+                         const DataFrame& frame,
+                         uint8_t* out,
+                         size_t out_len) {
+  int16_t xyz[static_cast<size_t>(kFrameSamples) * kAxesPerSample];
+  if (!read_frame_samples(frame, xyz)) {
+    return 0;
+  }
+  if (!server_accepts(state, vibesensor::kHelloCapRangeTag)) {
+    return vibesensor::pack_data(out,
+                                 out_len,
+                                 state.client_id,
+                                 frame.seq,
+                                 frame_wire_t0_us(state, frame),
+                                 xyz,
+                                 frame.sample_count);
+  }
+  if (kPulseInputEnabled && server_accepts(state, vibesensor::kHelloCapPulseChannel)) {
+    return vibesensor::pack_data(out,
+                                 out_len,
+                                 state.client_id,
+                                 frame.seq,
+                                 frame_wire_t0_us(state, frame),
+                                 xyz,
+                                 frame.sample_count,
+                                 frame.range_tag,
+                                 frame.pulse);
+  }
+  return vibesensor::pack_data(out,
+                               out_len,
+                               state.client_id,
+                               frame.seq,
+                               frame_wire_t0_us(state, frame),
+                               xyz,
+                               frame.sample_count,
+                               frame.range_tag);
+}
+
+bool send_hello(TransportState& state,
+                const FrameQueueState& queue_state,
+                RuntimeStatus& status) {
   if (WiFi.status() != WL_CONNECTED) {
     state.handshake_complete = false;
+    reset_tx_slot(state, status);
     return false;
   }
   uint8_t packet[128];
@@ -113,17 +242,21 @@ bool send_hello(TransportState& state, RuntimeStatus& status) {
                                       kClientName,
                                       kFirmwareVersion,
                                       status.queue_overflow_drops,
-                                      vibesensor::kHelloCapExplicitAck);
+                                      hello_capabilities(),
+                                      frame_queue_oldest_seq(queue_state),
+                                      state.boot_id);
   if (len == 0) {
     return false;
   }
   return send_control_packet(state, status, packet, len, 4);
 }
 
-void service_hello(TransportState& state, RuntimeStatus& status) {
+void service_hello(TransportState& state,
+                   const FrameQueueState& queue_state,
+                   RuntimeStatus& status) {
   uint32_t now = millis();
   if (now - state.last_hello_ms >= kHelloIntervalMs) {
-    if (send_hello(state, status)) {
+    if (send_hello(state, queue_state, status)) {
       state.last_hello_ms = now;
     }
   }
@@ -134,24 +267,38 @@ void service_tx(TransportState& state,
                 RuntimeStatus& status) {
   if (WiFi.status() != WL_CONNECTED) {
     state.handshake_complete = false;
+    reset_tx_slot(state, status);
     return;
   }
   if (!state.handshake_complete) {
     return;
   }
+  if (kTsfTimeSyncEnabled && !tsf_mapping_ready(state.tsf_sync.mapping)) {
+    return;
+  }
+
+  const bool slotted = tx_slots_active(state, status);
+  const uint32_t slot_budget_us = slotted ? tx_slot_budget_us(state, status) : 0;
 
   uint8_t packet[kMaxDatagramBytes];
   for (size_t sent = 0; sent < kMaxTxFramesPerLoop; ++sent) {
-    DataFrame* frame = peek_frame(queue_state);
+    DataFrame* frame = next_udp_frame(state, queue_state);
     if (frame == nullptr) {
       return;
     }
 
+    // The server already has this frame (HELLO_ACK receipts) or the live lane
+    // finished with it; it only stays queued until the frames ahead of it go.
+    if (frame->settled) {
+      retire_udp_frame(state, queue_state);
+      continue;
+    }
+
     uint32_t now_ms = millis();
     if (frame_age_ms(*frame, now_ms) >= kDataMaxFrameAgeMs) {
       status.tx_stale_frame_drops++;
       set_last_error(status, kTransportErrorStaleFrameDrop);
-      drop_front_frame(queue_state);
+      retire_udp_frame(state, queue_state);
       continue;
     }
     if (frame->transmitted &&
@@ -161,21 +308,19 @@ void service_tx(TransportState& state,
     if (frame->tx_attempts >= static_cast<uint8_t>(kDataMaxRetransmits + 1U)) {
       status.tx_retransmit_limit_drops++;
       set_last_error(status, kTransportErrorRetransmitLimitDrop);
-      drop_front_frame(queue_state);
+      retire_udp_frame(state, queue_state);
       continue;
     }
+    // Only start a datagram that finishes before the trailing guard.
+    if (slotted && slot_budget_us < kTdmaFrameAirtimeUs) {
+      return;
+    }
 
-    size_t len = vibesensor::pack_data(packet,
-                                       sizeof(packet),
-                                       state.client_id,
-                                       frame->seq,
-                                       frame->t0_us,
-                                       frame->xyz,
-                                       frame->sample_count);
+    const size_t len = pack_queued_frame(state, *frame, packet, sizeof(packet));
     if (len == 0) {
       status.tx_pack_failures++;
       set_last_error(status, 5);
-      drop_front_frame(queue_state);
+      retire_udp_frame(state, queue_state);
       continue;
     }
 
@@ -214,12 +359,28 @@ void service_control_rx(TransportState& state,
   }
 
   if (packet[0] == vibesensor::kMsgHelloAck) {
-    if (!vibesensor::parse_hello_ack(packet, read, state.client_id)) {
+    bool has_receipts = false;
+    uint32_t contiguous_seq = 0;
+    uint32_t receipt_bitmap = 0;
+    uint8_t server_capabilities = 0;
+    if (!vibesensor::parse_hello_ack(packet,
+                                     read,
+                                     state.client_id,
+                                     &server_capabilities,
+                                     &has_receipts,
+                                     &contiguous_seq,
+                                     &receipt_bitmap)) {
       status.control_parse_errors++;
       set_last_error(status, 9);
       return;
     }
+    if (has_receipts) {
+      status.tx_resume_skipped_frames +=
+          apply_frame_receipts(queue_state, contiguous_seq, receipt_bitmap);
+    }
+    state.server_capabilities = server_capabilities;
     state.handshake_complete = true;
+    reset_tx_slot(state, status);
     return;
   }
 
@@ -228,7 +389,7 @@ void service_control_rx(TransportState& state,
     bool ok_ack = vibesensor::parse_data_ack(
         packet, read, state.client_id, &last_seq_received);
     if (ok_ack) {
-      ack_data_frames(queue_state, last_seq_received);
+      apply_data_ack(state, queue_state, last_seq_received);
     }
     return;
   }
@@ -239,6 +400,7 @@ void service_control_rx(TransportState& state,
   uint64_t server_time_us = 0;
   int64_t applied_offset_us = 0;
   uint32_t round_trip_us = 0;
+  vibesensor::reliability::TxSlotSchedule slot{};
   bool ok = vibesensor::parse_cmd(packet,
                                   read,
                                   state.client_id,
@@ -247,7 +409,10 @@ void service_control_rx(TransportState& state,
                                   &identify_ms,
                                   &server_time_us,
                                   &applied_offset_us,
-                                  &round_trip_us);
+                                  &round_trip_us,
+                                  &slot.offset_us,
+                                  &slot.period_us,
+                                  &slot.width_us);
   if (!ok) {
     status.control_parse_errors++;
     set_last_error(status, 9);
@@ -262,12 +427,24 @@ void service_control_rx(TransportState& state,
     const uint64_t device_receive_us = static_cast<uint64_t>(esp_timer_get_time());
     if (round_trip_us > 0) {
       state.clock_offset_us = applied_offset_us;
+      state.last_sync_ms = millis();
       status.sync_offset_us = applied_offset_us;
       status.sync_round_trip_us = round_trip_us;
     }
     const uint64_t device_send_us = static_cast<uint64_t>(esp_timer_get_time());
     send_sync_clock_ack(
         state, status, cmd_seq, device_receive_us, device_send_us, 0);
+  } else if (cmd_id == vibesensor::kCmdTxSlot) {
+    // A zero period withdraws the assignment and returns to contention access.
+    // A slot too narrow for one guarded frame is refused rather than adopted.
+    if (slot.period_us != 0 && (!vibesensor::reliability::tx_slot_schedule_valid(slot) ||
+                                slot.width_us < kTdmaMinSlotWidthUs)) {
+      send_ack(state, status, cmd_seq, 1);
+      return;
+    }
+    state.tx_slot = slot;
+    status.tx_slot_period_us = slot.period_us;
+    send_ack(state, status, cmd_seq, 0);
   } else {
     send_ack(state, status, cmd_seq, 2);
   }
@@ -290,7 +467,7 @@ void service_data_rx(TransportState& state,
     bool ok_ack = vibesensor::parse_data_ack(
         packet, read, state.client_id, &last_seq_received);
     if (ok_ack) {
-      ack_data_frames(queue_state, last_seq_received);
+      apply_data_ack(state, queue_state, last_seq_received);
     } else {
       status.data_ack_parse_errors++;
       set_last_error(status, 10);
@@ -3,9 +3,11 @@
 #include <Arduino.h>
 #include <WiFiUdp.h>
 
+#include "runtime_backlog_stream.h"
 #include "runtime_led.h"
 #include "runtime_queue.h"
 #include "runtime_status.h"
+#include "runtime_tsf_sync.h"
 #include "vibesensor_proto.h"
 
 namespace vibesensor::runtime {
@@ -15,14 +17,34 @@ struct TransportState {
   WiFiUDP control_udp;
   uint8_t client_id[vibesensor::kClientIdBytes] = {};
   uint16_t control_port = 0;
+  // Drawn at boot and sent with resume HELLOs. Seqs restart at 0 on every
+  // boot, so the server only reports receipts for the boot it last saw.
+  uint32_t boot_id = 0;
   uint32_t last_hello_ms = 0;
   bool handshake_complete = false;
+  // HELLO capabilities the server echoed in its last HELLO_ACK.
+  uint8_t server_capabilities = 0;
   int64_t clock_offset_us = 0;
+  uint32_t last_sync_ms = 0;
+  vibesensor::reliability::TxSlotSchedule tx_slot;
+  TsfSyncState tsf_sync;
+  BacklogStreamState backlog_stream;
 };
 
 void initialize_transport(TransportState& state);
-bool send_hello(TransportState& state, RuntimeStatus& status);
-void service_hello(TransportState& state, RuntimeStatus& status);
+int64_t frame_clock_offset_us(const TransportState& state);
+// Packs a queued frame as a DATA packet with its wire-clock t0. Returns 0 when
+// the frame cannot be decoded or does not fit out_len.
+size_t pack_queued_frame(const TransportState& state,
+                         const DataFrame& frame,
+                         uint8_t* out,
+                         size_t out_len);
+bool send_hello(TransportState& state,
+                const FrameQueueState& queue_state,
+                RuntimeStatus& status);
+void service_hello(TransportState& state,
+                   const FrameQueueState& queue_state,
+                   RuntimeStatus& status);
 void service_tx(TransportState& state,
                 FrameQueueState& queue_state,
                 RuntimeStatus& status);
@@ -0,0 +1,177 @@
+#include "runtime_tsf_sync.h"
+
+#include <WiFi.h>
+#include <esp_timer.h>
+#include <esp_wifi.h>
+#include <math.h>
+
+#include "runtime_config.h"
+
+namespace vibesensor::runtime {
+namespace {
+
+constexpr double kPartsPerBillion = 1.0e9;
+constexpr uint8_t kTsfErrorMappingReset = 15;
+
+size_t oldest_point_index(const TsfClockMapping& mapping) {
+  return (mapping.next + kTsfSyncWindowPoints - mapping.count) % kTsfSyncWindowPoints;
+}
+
+const TsfClockPoint& newest_point(const TsfClockMapping& mapping) {
+  return mapping.points[(mapping.next + kTsfSyncWindowPoints - 1U) % kTsfSyncWindowPoints];
+}
+
+void refit_tsf_mapping(TsfClockMapping& mapping) {
+  if (mapping.count == 0) {
+    return;
+  }
+  const size_t oldest = oldest_point_index(mapping);
+  mapping.ref_local_us = mapping.points[oldest].local_us;
+  mapping.ref_tsf_us = mapping.points[oldest].tsf_us;
+
+  double sum_x = 0.0;
+  double sum_y = 0.0;
+  for (size_t i = 0; i < mapping.count; ++i) {
+    const TsfClockPoint& point = mapping.points[(oldest + i) % kTsfSyncWindowPoints];
+    sum_x += static_cast<double>(static_cast<int64_t>(point.local_us - mapping.ref_local_us));
+    sum_y += static_cast<double>(static_cast<int64_t>(point.tsf_us - mapping.ref_tsf_us));
+  }
+  mapping.centroid_local_us = sum_x / static_cast<double>(mapping.count);
+  mapping.centroid_tsf_us = sum_y / static_cast<double>(mapping.count);
+  if (mapping.count < 2) {
+    return;
+  }
+
+  double sxx = 0.0;
+  double sxy = 0.0;
+  for (size_t i = 0; i < mapping.count; ++i) {
+    const TsfClockPoint& point = mapping.points[(oldest + i) % kTsfSyncWindowPoints];
+    const double dx =
+        static_cast<double>(static_cast<int64_t>(point.local_us - mapping.ref_local_us)) -
+        mapping.centroid_local_us;
+    const double dy =
+        static_cast<double>(static_cast<int64_t>(point.tsf_us - mapping.ref_tsf_us)) -
+        mapping.centroid_tsf_us;
+    sxx += dx * dx;
+    sxy += dx * dy;
+  }
+  if (sxx > 0.0) {
+    mapping.rate = sxy / sxx;
+    mapping.has_rate_prior = true;
+  }
+}
+
+void restart_from_point(TsfClockMapping& mapping, const TsfClockPoint& point) {
+  mapping.points[0] = point;
+  mapping.count = 1;
+  mapping.next = 1 % kTsfSyncWindowPoints;
+  refit_tsf_mapping(mapping);
+}
+
+bool skew_in_range(const TsfClockMapping& mapping) {
+  const double skew_ppm = (mapping.rate - 1.0) * 1.0e6;
+  return skew_ppm <= static_cast<double>(kTsfSyncMaxSkewPpm) &&
+         skew_ppm >= -static_cast<double>(kTsfSyncMaxSkewPpm);
+}
+
+}  // namespace
+
+void reset_tsf_mapping(TsfClockMapping& mapping) {
+  mapping = TsfClockMapping{};
+}
+
+bool add_tsf_clock_point(TsfClockMapping& mapping, uint64_t local_us, uint64_t tsf_us) {
+  TsfClockPoint point{};
+  point.local_us = local_us;
+  point.tsf_us = tsf_us;
+
+  if (mapping.count > 0 &&
+      static_cast<int64_t>(local_us - newest_point(mapping).local_us) <= 0) {
+    return true;
+  }
+
+  if (tsf_mapping_ready(mapping)) {
+    const int64_t residual_us =
+        static_cast<int64_t>(tsf_us - tsf_from_local_us(mapping, local_us));
+    const int64_t max_residual_us = static_cast<int64_t>(kTsfSyncMaxResidualUs);
+    if (residual_us > max_residual_us || residual_us < -max_residual_us) {
+      // TSF jumped (AP restart or re-association to another BSS); keep the
+      // rate estimate as a prior but drop the stale offset history.
+      restart_from_point(mapping, point);
+      return false;
+    }
+  }
+
+  mapping.points[mapping.next] = point;
+  mapping.next = (mapping.next + 1U) % kTsfSyncWindowPoints;
+  if (mapping.count < kTsfSyncWindowPoints) {
+    mapping.count++;
+  }
+  const double previous_rate = mapping.rate;
+  const bool previous_prior = mapping.has_rate_prior;
+  refit_tsf_mapping(mapping);
+  if (!skew_in_range(mapping)) {
+    mapping.rate = previous_prior ? previous_rate : 1.0;
+    mapping.has_rate_prior = previous_prior;
+    restart_from_point(mapping, point);
+    return false;
+  }
+  return true;
+}
+
+bool tsf_mapping_ready(const TsfClockMapping& mapping) {
+  return mapping.count >= kTsfSyncMinPoints || (mapping.count >= 1 && mapping.has_rate_prior);
+}
+
+uint64_t tsf_from_local_us(const TsfClockMapping& mapping, uint64_t local_us) {
+  if (mapping.count == 0) {
+    return local_us;
+  }
+  const double dx =
+      static_cast<double>(static_cast<int64_t>(local_us - mapping.ref_local_us)) -
+      mapping.centroid_local_us;
+  const double dy = mapping.centroid_tsf_us + (dx * mapping.rate);
+  return mapping.ref_tsf_us + static_cast<uint64_t>(static_cast<int64_t>(llround(dy)));
+}
+
+int32_t tsf_mapping_skew_ppb(const TsfClockMapping& mapping) {
+  return static_cast<int32_t>(lround((mapping.rate - 1.0) * kPartsPerBillion));
+}
+
+void service_tsf_sync(TsfSyncState& state, RuntimeStatus& status) {
+  if (!kTsfTimeSyncEnabled) {
+    return;
+  }
+  const uint32_t now_ms = millis();
+  if (state.sampled && (now_ms - state.last_sample_ms) < kTsfSyncIntervalMs) {
+    return;
+  }
+  if (WiFi.status() != WL_CONNECTED) {
+    return;
+  }
+  state.sampled = true;
+  state.last_sample_ms = now_ms;
+
+  // Bracket the TSF register read with local timestamps; a long bracket means
+  // the read was preempted and its midpoint is not a trustworthy pairing.
+  const uint64_t before_us = static_cast<uint64_t>(esp_timer_get_time());
+  const int64_t tsf_us = esp_wifi_get_tsf_time(WIFI_IF_STA);
+  const uint64_t after_us = static_cast<uint64_t>(esp_timer_get_time());
+  if (tsf_us <= 0) {
+    return;
+  }
+  if ((after_us - before_us) > kTsfSyncMaxReadSpanUs) {
+    status.tsf_sync_rejected_reads++;
+    return;
+  }
+
+  const uint64_t local_us = before_us + ((after_us - before_us) / 2U);
+  if (!add_tsf_clock_point(state.mapping, local_us, static_cast<uint64_t>(tsf_us))) {
+    status.tsf_sync_resets++;
+    set_last_error(status, kTsfErrorMappingReset);
+  }
+  status.tsf_sync_skew_ppb = tsf_mapping_skew_ppb(state.mapping);
+  status.tsf_sync_ready = tsf_mapping_ready(state.mapping);
+}
+
+}  // namespace vibesensor::runtime
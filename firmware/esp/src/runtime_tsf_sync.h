@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "runtime_config.h"
+#include "runtime_status.h"
+
+namespace vibesensor::runtime {
+
+struct TsfClockPoint {
+  uint64_t local_us = 0;
+  uint64_t tsf_us = 0;
+};
+
+// Least-squares TSF<->local mapping over the most recent sample window. The
+// fit is kept relative to the oldest retained point so the double math only
+// carries a few seconds of span.
+struct TsfClockMapping {
+  TsfClockPoint points[kTsfSyncWindowPoints] = {};
+  size_t count = 0;
+  size_t next = 0;
+  uint64_t ref_local_us = 0;
+  uint64_t ref_tsf_us = 0;
+  double centroid_local_us = 0.0;
+  double centroid_tsf_us = 0.0;
+  double rate = 1.0;
+  bool has_rate_prior = false;
+};
+
+struct TsfSyncState {
+  TsfClockMapping mapping;
+  uint32_t last_sample_ms = 0;
+  bool sampled = false;
+};
+
+void reset_tsf_mapping(TsfClockMapping& mapping);
+bool add_tsf_clock_point(TsfClockMapping& mapping, uint64_t local_us, uint64_t tsf_us);
+bool tsf_mapping_ready(const TsfClockMapping& mapping);
+uint64_t tsf_from_local_us(const TsfClockMapping& mapping, uint64_t local_us);
+int32_t tsf_mapping_skew_ppb(const TsfClockMapping& mapping);
+void service_tsf_sync(TsfSyncState& state, RuntimeStatus& status);
+
+}  // namespace vibesensor::runtime
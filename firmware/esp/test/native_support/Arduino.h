@@ -67,6 +67,33 @@ inline uint64_t next_esp_time() {
 
 inline void set_random_value(uint32_t value) { random_value_ref() = value; }
 
+// Interrupt handler attachInterruptArg() registered, one pin at a time.
+struct PinInterrupt {
+  int pin = -1;
+  int mode = 0;
+  int pin_mode = -1;
+  void (*handler)(void*) = nullptr;
+  void* arg = nullptr;
+};
+
+inline PinInterrupt& pin_interrupt_ref() {
+  static PinInterrupt value;
+  return value;
+}
+
+inline void reset_pin_interrupt() { pin_interrupt_ref() = PinInterrupt{}; }
+
+// Runs the attached handler as if the pin had seen its edge; false when no
+// handler is attached.
+inline bool fire_pin_interrupt() {
+  const PinInterrupt& interrupt = pin_interrupt_ref();
+  if (interrupt.handler == nullptr) {
+    return false;
+  }
+  interrupt.handler(interrupt.arg);
+  return true;
+}
+
 }  // namespace arduino_test
 
 inline uint32_t millis() { return arduino_test::millis_ref(); }
@@ -75,6 +102,26 @@ inline void delay(uint32_t ms) { arduino_test::advance_millis(ms); }
 
 inline uint32_t esp_random() { return arduino_test::random_value_ref(); }
 
+#define IRAM_ATTR
+
+constexpr int INPUT_PULLUP = 0x05;
+constexpr int RISING = 0x01;
+
+inline void pinMode(int pin, int mode) {
+  arduino_test::pin_interrupt_ref().pin = pin;
+  arduino_test::pin_interrupt_ref().pin_mode = mode;
+}
+
+inline int digitalPinToInterrupt(int pin) { return pin; }
+
+inline void attachInterruptArg(int pin, void (*handler)(void*), void* arg, int mode) {
+  arduino_test::PinInterrupt& interrupt = arduino_test::pin_interrupt_ref();
+  interrupt.pin = pin;
+  interrupt.mode = mode;
+  interrupt.handler = handler;
+  interrupt.arg = arg;
+}
+
 struct HardwareSerial {
   void begin(unsigned long) {}
 
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <vector>
+
+#include "Arduino.h"
+
+class WiFiClient {
+ public:
+  struct ConnectCall {
+    IPAddress ip;
+    uint16_t port = 0;
+    int32_t timeout_ms = 0;
+  };
+
+  void reset() {
+    connect_calls.clear();
+    written.clear();
+    connect_results_.clear();
+    incoming_.clear();
+    write_limit = -1;
+    no_delay = false;
+    stop_count = 0;
+    connected_ = false;
+  }
+
+  void setConnectResults(std::initializer_list<int> results) {
+    connect_results_ = std::deque<int>(results.begin(), results.end());
+  }
+
+  int connect(const IPAddress& ip, uint16_t port, int32_t timeout_ms) {
+    ConnectCall call;
+    call.ip = ip;
+    call.port = port;
+    call.timeout_ms = timeout_ms;
+    connect_calls.push_back(call);
+    const int result = connect_results_.empty() ? 1 : connect_results_.front();
+    if (!connect_results_.empty()) {
+      connect_results_.pop_front();
+    }
+    connected_ = (result == 1);
+    return result;
+  }
+
+  uint8_t connected() const { return connected_ ? 1 : 0; }
+
+  int setNoDelay(bool value) {
+    no_delay = value;
+    return 1;
+  }
+
+  // Accepts at most write_limit more bytes when it is not negative, standing
+  // in for a connection whose send timed out.
+  size_t write(const uint8_t* data, size_t len) {
+    if (!connected_) {
+      return 0;
+    }
+    size_t accepted = len;
+    if (write_limit >= 0 && static_cast<size_t>(write_limit) < len) {
+      accepted = static_cast<size_t>(write_limit);
+    }
+    if (write_limit >= 0) {
+      write_limit -= static_cast<int32_t>(accepted);
+    }
+    written.insert(written.end(), data, data + accepted);
+    return accepted;
+  }
+
+  void queueIncoming(const uint8_t* data, size_t len) {
+    incoming_.insert(incoming_.end(), data, data + len);
+  }
+
+  int available() const { return static_cast<int>(incoming_.size()); }
+
+  int read(uint8_t* buffer, size_t len) {
+    size_t count = 0;
+    while (count < len && !incoming_.empty()) {
+      buffer[count++] = incoming_.front();
+      incoming_.pop_front();
+    }
+    return static_cast<int>(count);
+  }
+
+  void stop() {
+    stop_count++;
+    connected_ = false;
+    incoming_.clear();
+  }
+
+  // Simulates the server closing or resetting the connection.
+  void drop() { connected_ = false; }
+
+  std::vector<ConnectCall> connect_calls;
+  std::vector<uint8_t> written;
+  int32_t write_limit = -1;
+  bool no_delay = false;
+  int stop_count = 0;
+
+ private:
+  std::deque<int> connect_results_;
+  std::deque<uint8_t> incoming_;
+  bool connected_ = false;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Arduino.h"
+#include "esp_err.h"
+
+using wifi_interface_t = int;
+
+constexpr wifi_interface_t WIFI_IF_STA = 0;
+constexpr wifi_interface_t WIFI_IF_AP = 1;
+
+namespace arduino_test {
+
+// Host-side stand-in for the AP's 802.11 TSF timer: tsf = offset + local * (1 + skew).
+struct TsfSource {
+  bool available = false;
+  int64_t offset_us = 0;
+  int64_t skew_ppb = 0;
+};
+
+inline TsfSource& tsf_source_ref() {
+  static TsfSource value;
+  return value;
+}
+
+inline void reset_tsf_source() { tsf_source_ref() = TsfSource{}; }
+
+inline void set_tsf_source(int64_t offset_us, int64_t skew_ppb) {
+  TsfSource& source = tsf_source_ref();
+  source.available = true;
+  source.offset_us = offset_us;
+  source.skew_ppb = skew_ppb;
+}
+
+inline void set_tsf_available(bool available) { tsf_source_ref().available = available; }
+
+inline int64_t tsf_at_local_us(uint64_t local_us) {
+  const TsfSource& source = tsf_source_ref();
+  const int64_t local = static_cast<int64_t>(local_us);
+  return source.offset_us + local + ((local * source.skew_ppb) / 1000000000LL);
+}
+
+}  // namespace arduino_test
+
+inline int64_t esp_wifi_get_tsf_time(wifi_interface_t) {
+  if (!arduino_test::tsf_source_ref().available) {
+    return 0;
+  }
+  return arduino_test::tsf_at_local_us(arduino_test::esp_time_ref());
+}
@@ -11,6 +11,26 @@ constexpr BaseType_t pdPASS = 1;
 constexpr uint32_t portMAX_DELAY = 0xffffffffU;
 constexpr UBaseType_t configMAX_PRIORITIES = 25;
 
+namespace freertos_test {
+
+inline uint64_t& critical_section_entries() {
+  static uint64_t value = 0;
+  return value;
+}
+
+// Native builds are single-threaded; the atomic swap stands in for the cost of
+// the real spinlock so loop-cost benchmarks see the critical sections they take.
+inline void enter_critical(portMUX_TYPE* lock) {
+  critical_section_entries()++;
+  (void)__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE);
+}
+
+inline void exit_critical(portMUX_TYPE* lock) { __atomic_store_n(lock, 0, __ATOMIC_RELEASE); }
+
+}  // namespace freertos_test
+
 #define portMUX_INITIALIZER_UNLOCKED 0
-#define portENTER_CRITICAL(lock) (void)(lock)
-#define portEXIT_CRITICAL(lock) (void)(lock)
+#define portENTER_CRITICAL(lock) freertos_test::enter_critical(lock)
+#define portEXIT_CRITICAL(lock) freertos_test::exit_critical(lock)
+#define portENTER_CRITICAL_ISR(lock) freertos_test::enter_critical(lock)
+#define portEXIT_CRITICAL_ISR(lock) freertos_test::exit_critical(lock)
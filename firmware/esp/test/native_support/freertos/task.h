@@ -1,16 +1,47 @@
 #pragma once
 
+#include <vector>
+
 #include "freertos/FreeRTOS.h"
 
 using TaskHandle_t = void*;
 
-inline BaseType_t xTaskCreatePinnedToCore(void (*)(void*),
+namespace freertos_test {
+
+struct CreatedTask {
+  void (*entry)(void*) = nullptr;
+  void* arg = nullptr;
+};
+
+inline std::vector<CreatedTask>& created_tasks() {
+  static std::vector<CreatedTask> tasks;
+  return tasks;
+}
+
+// Native builds never schedule created tasks. Tests whose tasks return (rather
+// than loop forever) call this to run them to completion at a chosen point.
+inline size_t run_created_tasks() {
+  std::vector<CreatedTask> tasks;
+  tasks.swap(created_tasks());
+  for (const CreatedTask& task : tasks) {
+    task.entry(task.arg);
+  }
+  return tasks.size();
+}
+
+}  // namespace freertos_test
+
+inline BaseType_t xTaskCreatePinnedToCore(void (*entry)(void*),
                                           const char*,
                                           uint32_t,
-                                          void*,
+                                          void* arg,
                                           UBaseType_t,
                                           TaskHandle_t* out_handle,
                                           BaseType_t) {
+  freertos_test::CreatedTask task;
+  task.entry = entry;
+  task.arg = arg;
+  freertos_test::created_tasks().push_back(task);
   if (out_handle != nullptr) {
     *out_handle = reinterpret_cast<void*>(0x1);
   }
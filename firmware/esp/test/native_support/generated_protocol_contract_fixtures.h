@@ -19,7 +19,11 @@ constexpr char kHelloFirmwareVersion[] = "fw-test";
 constexpr uint32_t kHelloQueueOverflowDrops = 7;
 constexpr uint8_t kHelloCapabilities = 1;
 constexpr std::array<uint8_t, 38> kHelloPacket = {0x01, 0x01, 0xa1, 0xb2, 0xc3, 0xd4, 0xe5, 0xf6, 0xa3, 0x23, 0x20, 0x03, 0x50, 0x00, 0x0a, 0x66, 0x72, 0x6f, 0x6e, 0x74, 0x2d, 0x6c, 0x65, 0x66, 0x74, 0x07, 0x66, 0x77, 0x2d, 0x74, 0x65, 0x73, 0x74, 0x07, 0x00, 0x00, 0x00, 0x01};
-constexpr std::array<uint8_t, 8> kHelloAckPacket = {0x06, 0x01, 0xa1, 0xb2, 0xc3, 0xd4, 0xe5, 0xf6};
+constexpr uint8_t kHelloAckCapabilities = 0x09;
+constexpr std::array<uint8_t, 9> kHelloAckPacket = {0x06, 0x01, 0xa1, 0xb2, 0xc3, 0xd4, 0xe5, 0xf6, 0x09};
+constexpr uint32_t kHelloAckContiguousSeq = 41;
+constexpr uint32_t kHelloAckReceiptBitmap = 0x5;
+constexpr std::array<uint8_t, 17> kHelloAckReceiptsPacket = {0x06, 0x01, 0xa1, 0xb2, 0xc3, 0xd4, 0xe5, 0xf6, 0x19, 0x29, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00};
 
 constexpr std::array<uint8_t, 6> kDataClientId = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
 constexpr uint32_t kDataSeq = 17;
@@ -27,6 +31,12 @@ constexpr uint64_t kDataT0Us = 123456789ULL;
 constexpr uint16_t kDataSampleCount = 3;
 constexpr std::array<int16_t, 9> kDataSamples = {1, 2, 3, 4, 5, 6, -2, -1, 0};
 constexpr std::array<uint8_t, 40> kDataPacket = {0x02, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x11, 0x00, 0x00, 0x00, 0x15, 0xcd, 0x5b, 0x07, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04, 0x00, 0x05, 0x00, 0x06, 0x00, 0xfe, 0xff, 0xff, 0xff, 0x00, 0x00};
+constexpr std::array<uint8_t, 2> kDataStreamRecordPrefix = {0x28, 0x00};
+constexpr uint8_t kDataRangeTag = 0x85;
+constexpr std::array<uint8_t, 41> kDataTaggedPacket = {0x02, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x11, 0x00, 0x00, 0x00, 0x15, 0xcd, 0x5b, 0x07, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04, 0x00, 0x05, 0x00, 0x06, 0x00, 0xfe, 0xff, 0xff, 0xff, 0x00, 0x00, 0x85};
+constexpr uint16_t kDataPulseEdgeCount = 513;
+constexpr int32_t kDataPulseLastEdgeOffsetUs = -1250;
+constexpr std::array<uint8_t, 48> kDataPulsePacket = {0x02, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x11, 0x00, 0x00, 0x00, 0x15, 0xcd, 0x5b, 0x07, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x04, 0x00, 0x05, 0x00, 0x06, 0x00, 0xfe, 0xff, 0xff, 0xff, 0x00, 0x00, 0x85, 0x01, 0x01, 0x02, 0x1e, 0xfb, 0xff, 0xff};
 
 constexpr std::array<uint8_t, 6> kCommandClientId = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
 constexpr uint32_t kIdentifyCmdSeq = 42;
@@ -42,6 +52,12 @@ constexpr uint64_t kSyncClockAckReceiveUs = 876543210ULL;
 constexpr uint64_t kSyncClockAckSendUs = 876543654ULL;
 constexpr std::array<uint8_t, 29> kSyncClockAckPacket = {0x04, 0x01, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x07, 0x00, 0x00, 0x00, 0x00, 0xea, 0xfc, 0x3e, 0x34, 0x00, 0x00, 0x00, 0x00, 0xa6, 0xfe, 0x3e, 0x34, 0x00, 0x00, 0x00, 0x00};
 
+constexpr uint32_t kTxSlotCmdSeq = 11;
+constexpr uint32_t kTxSlotOffsetUs = 2500;
+constexpr uint32_t kTxSlotPeriodUs = 20000;
+constexpr uint32_t kTxSlotWidthUs = 2500;
+constexpr std::array<uint8_t, 25> kTxSlotPacket = {0x03, 0x01, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x03, 0x0b, 0x00, 0x00, 0x00, 0xc4, 0x09, 0x00, 0x00, 0x20, 0x4e, 0x00, 0x00, 0xc4, 0x09, 0x00, 0x00};
+
 constexpr std::array<uint8_t, 6> kAckClientId = {0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
 constexpr uint32_t kAckCmdSeq = 99;
 constexpr uint8_t kAckStatus = 0;
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "Arduino.h"
+
+namespace arduino_test {
+
+// Host-side stand-in for a wheel or shaft pulse sensor. Edge n happens when the
+// pulse phase, rate_hz * t + slope_hz_per_s * t^2 / 2 from the start time,
+// reaches n; each one sets the esp_timer clock to its time and fires the
+// attached pin interrupt. bounce_us adds a second edge that long after every
+// real one, standing in for contact bounce or ringing.
+class PulseSource {
+ public:
+  void start(uint64_t start_us, double rate_hz, double slope_hz_per_s = 0.0) {
+    start_us_ = start_us;
+    rate_hz_ = rate_hz;
+    slope_hz_per_s_ = slope_hz_per_s;
+    next_edge_ = 1;
+    fired_edges = 0;
+  }
+
+  double rate_at(uint64_t t_us) const {
+    const double t_s = static_cast<double>(t_us - start_us_) / 1.0e6;
+    return rate_hz_ + slope_hz_per_s_ * t_s;
+  }
+
+  // Fires every edge due before until_us and leaves the esp_timer clock there.
+  size_t advance_to(uint64_t until_us) {
+    size_t fired = 0;
+    for (;;) {
+      const uint64_t edge_us = edge_time_us(next_edge_);
+      if (edge_us >= until_us) {
+        break;
+      }
+      fire_at(edge_us);
+      fired++;
+      if (bounce_us > 0 && edge_us + bounce_us < until_us) {
+        fire_at(edge_us + bounce_us);
+      }
+      next_edge_++;
+    }
+    set_esp_time(until_us);
+    fired_edges += fired;
+    return fired;
+  }
+
+  uint32_t bounce_us = 0;
+  size_t fired_edges = 0;
+
+ private:
+  uint64_t edge_time_us(uint64_t edge) const {
+    const double n = static_cast<double>(edge);
+    double t_s = 0.0;
+    if (slope_hz_per_s_ == 0.0) {
+      t_s = n / rate_hz_;
+    } else {
+      t_s = (-rate_hz_ + std::sqrt(rate_hz_ * rate_hz_ + 2.0 * slope_hz_per_s_ * n)) /
+            slope_hz_per_s_;
+    }
+    return start_us_ + static_cast<uint64_t>(std::llround(t_s * 1.0e6));
+  }
+
+  void fire_at(uint64_t edge_us) {
+    set_esp_time(edge_us);
+    fire_pin_interrupt();
+  }
+
+  uint64_t start_us_ = 0;
+  double rate_hz_ = 0.0;
+  double slope_hz_per_s_ = 0.0;
+  uint64_t next_edge_ = 1;
+};
+
+}  // namespace arduino_test
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "reliability.h"
+#include "../../src/runtime_frame_codec.h"
+#include "../../src/runtime_queue.h"
+
+namespace vibesensor::test_support {
+
+// Record size of one full ramp frame, sample i carrying (i, i + 1, i + 2);
+// every ramp encodes to the same size whatever its base value.
+inline size_t ramp_record_bytes() {
+  int16_t xyz[static_cast<size_t>(vibesensor::runtime::kFrameSamples) *
+              vibesensor::runtime::kAxesPerSample] = {};
+  for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
+    for (size_t axis = 0; axis < vibesensor::runtime::kAxesPerSample; ++axis) {
+      xyz[(i * vibesensor::runtime::kAxesPerSample) + axis] = static_cast<int16_t>(i + axis);
+    }
+  }
+  return vibesensor::runtime::frame_record_bytes(
+      vibesensor::runtime::plan_frame_encoding(
+          xyz,
+          vibesensor::runtime::kFrameSamples,
+          vibesensor::reliability::accel_range_sample_bits(vibesensor::reliability::kAccelRange16g))
+          .payload_bytes);
+}
+
+}  // namespace vibesensor::test_support
@@ -0,0 +1,422 @@
+// Firmware builds are optimized; time the acquisition paths the same way.
+#pragma GCC optimize("O2")
+
+#include <unity.h>
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define ACQUISITION_HAVE_TSC 1
+#else
+#define ACQUISITION_HAVE_TSC 0
+#endif
+
+#include "../../src/runtime_frame_codec.cpp"
+#include "../../src/runtime_frame_handoff.cpp"
+#include "../../src/runtime_pulse.cpp"
+#include "../../src/runtime_queue.cpp"
+#include "../../src/runtime_sampling.cpp"
+#include "../../src/runtime_status.cpp"
+
+namespace {
+
+constexpr size_t kFifoEntryBytes = 6;
+constexpr size_t kFifoStreamEntries = 4096;
+constexpr size_t kSensorFifoEntries = 32;
+
+// Little-endian X/Y/Z register bytes as the FIFO hands them out, replayed in
+// a loop so both paths decode the same stream.
+struct SyntheticFifo {
+  uint8_t bytes[kFifoStreamEntries * kFifoEntryBytes] = {};
+  size_t cursor = 0;
+  uint64_t decoded_bytes = 0;
+};
+
+// Where the bytes that end up in the handoff frames were written from. When
+// a shadow is attached, the driver mirrors every entry it decodes into frame
+// memory, so after each due slot any other difference between the frames and
+// the shadow was written by staging. Free slots hold a value the FIFO stream
+// never produces, so no write can go unseen by matching what was there.
+struct FrameWriteAudit {
+  int16_t* frames_xyz[vibesensor::runtime::kFrameHandoffFrames] = {};
+  int16_t* shadow_xyz[vibesensor::runtime::kFrameHandoffFrames] = {};
+  uint64_t decoded_into_frames_bytes = 0;
+  uint64_t staged_into_frames_bytes = 0;
+};
+
+SyntheticFifo g_fifo;
+FrameWriteAudit* g_audit = nullptr;
+constexpr size_t kFrameXyzValues =
+    static_cast<size_t>(vibesensor::runtime::kFrameSamples) * 3U;
+constexpr int16_t kFreeSlotValue = INT16_MIN;
+
+void poison_frame(FrameWriteAudit& audit, size_t f) {
+  for (size_t v = 0; v < kFrameXyzValues; ++v) {
+    audit.frames_xyz[f][v] = kFreeSlotValue;
+    audit.shadow_xyz[f][v] = kFreeSlotValue;
+  }
+}
+
+// Returns the shadow location mirroring dst when dst lies in frame memory.
+int16_t* audit_shadow_for(const int16_t* dst) {
+  if (g_audit == nullptr) {
+    return nullptr;
+  }
+  for (size_t f = 0; f < vibesensor::runtime::kFrameHandoffFrames; ++f) {
+    const int16_t* frame = g_audit->frames_xyz[f];
+    if (dst >= frame && dst < frame + kFrameXyzValues) {
+      return g_audit->shadow_xyz[f] + (dst - frame);
+    }
+  }
+  return nullptr;
+}
+
+void fill_fifo_stream() {
+  uint32_t rng = 0x5eedU;
+  for (size_t i = 0; i < kFifoStreamEntries * 3U; ++i) {
+    rng = (rng * 1664525U) + 1013904223U;
+    const int16_t value = static_cast<int16_t>(static_cast<int32_t>((rng >> 8) % 401U) - 200);
+    const uint16_t raw = static_cast<uint16_t>(value);
+    g_fifo.bytes[(i * 2U) + 0U] = static_cast<uint8_t>(raw & 0xFFU);
+    g_fifo.bytes[(i * 2U) + 1U] = static_cast<uint8_t>(raw >> 8);
+  }
+}
+
+void rewind_fifo() {
+  g_fifo.cursor = 0;
+  g_fifo.decoded_bytes = 0;
+}
+
+}  // namespace
+
+ADXL345::ADXL345(TwoWire& wire, uint8_t i2c_addr, int sda_pin, int scl_pin, uint8_t fifo_watermark)
+    : wire_(wire),
+      i2c_addr_(i2c_addr),
+      sda_pin_(sda_pin),
+      scl_pin_(scl_pin),
+      fifo_watermark_(fifo_watermark),
+      available_(false) {}
+
+bool ADXL345::begin(FailureKind* failure_kind) {
+  available_ = true;
+  if (failure_kind != nullptr) {
+    *failure_kind = FailureKind::kNone;
+  }
+  return true;
+}
+
+bool ADXL345::recover_bus(FailureKind* failure_kind) {
+  if (failure_kind != nullptr) {
+    *failure_kind = FailureKind::kNone;
+  }
+  return true;
+}
+
+bool ADXL345::available() const { return available_; }
+
+bool ADXL345::set_range(uint8_t, FailureKind* failure_kind) {
+  if (failure_kind != nullptr) {
+    *failure_kind = FailureKind::kNone;
+  }
+  return available_;
+}
+
+// Decodes one entry at a time into the caller's buffer, like the driver. The
+// FIFO always holds exactly what was asked for, so reads are never truncated.
+size_t ADXL345::read_samples(int16_t* xyz_interleaved,
+                             size_t max_samples,
+                             FailureKind* failure_kind,
+                             bool* fifo_truncated) {
+  if (failure_kind != nullptr) {
+    *failure_kind = FailureKind::kNone;
+  }
+  if (fifo_truncated != nullptr) {
+    *fifo_truncated = false;
+  }
+  const size_t count = max_samples < kSensorFifoEntries ? max_samples : kSensorFifoEntries;
+  for (size_t i = 0; i < count; ++i) {
+    int16_t* dst = xyz_interleaved + (i * 3U);
+    memcpy(dst, g_fifo.bytes + (g_fifo.cursor * kFifoEntryBytes), kFifoEntryBytes);
+    g_fifo.cursor = (g_fifo.cursor + 1U) % kFifoStreamEntries;
+    if (int16_t* shadow = audit_shadow_for(dst)) {
+      memcpy(shadow, dst, kFifoEntryBytes);
+      g_audit->decoded_into_frames_bytes += kFifoEntryBytes;
+    }
+  }
+  g_fifo.decoded_bytes += count * kFifoEntryBytes;
+  return count;
+}
+
+bool ADXL345::read_reg(uint8_t, uint8_t*) { return false; }
+
+bool ADXL345::write_reg(uint8_t, uint8_t) { return false; }
+
+bool ADXL345::read_multi(uint8_t, uint8_t*, size_t) { return false; }
+
+namespace {
+
+using vibesensor::runtime::CommittedFrame;
+using vibesensor::runtime::PendingSample;
+using vibesensor::runtime::SamplingState;
+using vibesensor::runtime::kFrameSamples;
+using vibesensor::runtime::kSampleRateHz;
+using vibesensor::runtime::kSensorPrefetchSamples;
+
+constexpr uint32_t kRunSeconds = 60;
+constexpr uint64_t kTotalSamples = static_cast<uint64_t>(kRunSeconds) * kSampleRateHz;
+constexpr size_t kSampleXyzBytes = 3U * sizeof(int16_t);
+
+// The previous acquisition path, kept here as the baseline: the driver decoded
+// into a batch buffer, the batch was appended to a prefetch ring with a modulo
+// per sample, each due slot popped a PendingSample, and staging copied that
+// into the frame.
+struct LegacyAcquisition {
+  int16_t batch_xyz[kSensorPrefetchSamples * 3U] = {};
+  int16_t prefetch_xyz[kSensorPrefetchSamples * 3U] = {};
+  size_t prefetch_head = 0;
+  size_t prefetch_tail = 0;
+  size_t prefetch_count = 0;
+  bool recent_refill_shortfall = false;
+};
+
+void legacy_refill(LegacyAcquisition& legacy, SamplingState& state) {
+  const vibesensor::reliability::SamplingRefillPlan plan =
+      vibesensor::reliability::sampling_prefetch_refill_plan(
+          legacy.prefetch_count,
+          kSensorPrefetchSamples,
+          vibesensor::runtime::kSensorPrefetchLowWaterSamples,
+          vibesensor::runtime::kSensorPrefetchSteadyTargetSamples,
+          vibesensor::runtime::kSensorPrefetchLateTargetSamples,
+          1U,
+          legacy.recent_refill_shortfall);
+  if (plan.request_samples == 0) {
+    vibesensor::runtime::sync_sampling_snapshot(state);
+    return;
+  }
+  const size_t read_count =
+      state.adxl.read_samples(legacy.batch_xyz, plan.request_samples, nullptr, nullptr);
+  legacy.recent_refill_shortfall = read_count < plan.request_samples;
+  for (size_t i = 0; i < read_count; ++i) {
+    const size_t dst = legacy.prefetch_tail * 3U;
+    legacy.prefetch_xyz[dst + 0U] = legacy.batch_xyz[(i * 3U) + 0U];
+    legacy.prefetch_xyz[dst + 1U] = legacy.batch_xyz[(i * 3U) + 1U];
+    legacy.prefetch_xyz[dst + 2U] = legacy.batch_xyz[(i * 3U) + 2U];
+    legacy.prefetch_tail = (legacy.prefetch_tail + 1U) % kSensorPrefetchSamples;
+    legacy.prefetch_count++;
+  }
+  vibesensor::runtime::sync_sampling_snapshot(state);
+}
+
+bool legacy_produce_sample(LegacyAcquisition& legacy, SamplingState& state) {
+  legacy_refill(legacy, state);
+  if (legacy.prefetch_count == 0) {
+    return false;
+  }
+  PendingSample sample{};
+  sample.due_us = state.next_sample_due_us;
+  const size_t src = legacy.prefetch_head * 3U;
+  sample.x = legacy.prefetch_xyz[src + 0U];
+  sample.y = legacy.prefetch_xyz[src + 1U];
+  sample.z = legacy.prefetch_xyz[src + 2U];
+  legacy.prefetch_head = (legacy.prefetch_head + 1U) % kSensorPrefetchSamples;
+  legacy.prefetch_count--;
+  vibesensor::runtime::sync_sampling_snapshot(state);
+  const bool published = vibesensor::runtime::publish_sample(state, sample);
+  state.next_sample_due_us += vibesensor::runtime::advance_due_schedule(state);
+  return published;
+}
+
+SamplingState* make_sampling() {
+  auto* state = new SamplingState();
+  vibesensor::runtime::initialize_frame_handoff(
+      state->handoff, state->handoff_storage, vibesensor::runtime::kFrameHandoffFrames);
+  state->sensor_ok = state->adxl.begin();
+  state->due_schedule = vibesensor::reliability::make_sampling_interval_schedule(kSampleRateHz);
+  state->next_sample_due_us = 1000000ULL;
+  return state;
+}
+
+struct AcquisitionRun {
+  uint64_t samples = 0;
+  uint64_t decoded_bytes = 0;
+  uint64_t decoded_into_frames_bytes = 0;
+  uint64_t staged_into_frames_bytes = 0;
+  uint64_t elapsed_ns = 0;
+  uint64_t elapsed_cycles = 0;
+  std::vector<CommittedFrame> frames;
+};
+
+uint64_t read_cycles() {
+#if ACQUISITION_HAVE_TSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// Counts the frame sample values that differ from the shadow, i.e. were
+// written since the last audit by something other than the driver, and
+// brings the shadow back in step.
+void audit_staged_writes(FrameWriteAudit& audit) {
+  for (size_t f = 0; f < vibesensor::runtime::kFrameHandoffFrames; ++f) {
+    for (size_t v = 0; v < kFrameXyzValues; ++v) {
+      if (audit.frames_xyz[f][v] != audit.shadow_xyz[f][v]) {
+        audit.staged_into_frames_bytes += sizeof(int16_t);
+        audit.shadow_xyz[f][v] = audit.frames_xyz[f][v];
+      }
+    }
+  }
+}
+
+// Runs one due slot at a time, releasing each committed frame as soon as it
+// appears so the handoff never backs up. keep_frames copies them out for the
+// equivalence check and audits every write into frame memory; timed runs
+// leave both off.
+template <typename ProduceFn>
+AcquisitionRun run_acquisition(ProduceFn produce, bool keep_frames) {
+  AcquisitionRun run;
+  SamplingState* state = make_sampling();
+  rewind_fifo();
+  std::vector<int16_t> shadow;
+  FrameWriteAudit audit;
+  if (keep_frames) {
+    shadow.assign(vibesensor::runtime::kFrameHandoffFrames * kFrameXyzValues, 0);
+    for (size_t f = 0; f < vibesensor::runtime::kFrameHandoffFrames; ++f) {
+      audit.frames_xyz[f] = state->handoff_storage[f].xyz;
+      audit.shadow_xyz[f] = shadow.data() + (f * kFrameXyzValues);
+      poison_frame(audit, f);
+    }
+    g_audit = &audit;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  const uint64_t start_cycles = read_cycles();
+  for (uint64_t i = 0; i < kTotalSamples; ++i) {
+    if (produce(*state)) {
+      run.samples++;
+    }
+    if (keep_frames) {
+      audit_staged_writes(audit);
+    }
+    if (const CommittedFrame* frame = vibesensor::runtime::peek_committed_frame(state->handoff)) {
+      if (keep_frames) {
+        run.frames.push_back(*frame);
+        poison_frame(audit, static_cast<size_t>(frame - state->handoff_storage));
+      }
+      vibesensor::runtime::release_committed_frame(state->handoff);
+    }
+  }
+  run.elapsed_cycles = read_cycles() - start_cycles;
+  run.elapsed_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                             std::chrono::steady_clock::now() - start)
+                                             .count());
+  run.decoded_bytes = g_fifo.decoded_bytes;
+  run.decoded_into_frames_bytes = audit.decoded_into_frames_bytes;
+  run.staged_into_frames_bytes = audit.staged_into_frames_bytes;
+  g_audit = nullptr;
+  delete state;
+  return run;
+}
+
+AcquisitionRun run_legacy(bool keep_frames) {
+  auto* legacy = new LegacyAcquisition();
+  AcquisitionRun run = run_acquisition(
+      [&](SamplingState& state) { return legacy_produce_sample(*legacy, state); }, keep_frames);
+  delete legacy;
+  return run;
+}
+
+AcquisitionRun run_in_place(bool keep_frames) {
+  return run_acquisition(
+      [](SamplingState& state) {
+        const bool produced = vibesensor::runtime::produce_sample(state, 1U);
+        state.next_sample_due_us += vibesensor::runtime::advance_due_schedule(state);
+        return produced;
+      },
+      keep_frames);
+}
+
+// Host timings are noisy at this scale; keep the fastest of a few runs.
+template <typename RunFn>
+AcquisitionRun fastest_of(RunFn run) {
+  AcquisitionRun best = run(false);
+  for (int i = 0; i < 4; ++i) {
+    const AcquisitionRun next = run(false);
+    if (next.elapsed_ns < best.elapsed_ns) {
+      best = next;
+    }
+  }
+  return best;
+}
+
+void print_run(const char* label, const AcquisitionRun& audited, const AcquisitionRun& timed) {
+  const double samples = static_cast<double>(audited.samples);
+  printf("%s samples=%llu decoded_bytes_per_sample=%.1f decoded_into_frames_per_sample=%.1f "
+         "staged_into_frames_per_sample=%.1f ns_per_sample=%.1f",
+         label,
+         static_cast<unsigned long long>(audited.samples),
+         static_cast<double>(audited.decoded_bytes) / samples,
+         static_cast<double>(audited.decoded_into_frames_bytes) / samples,
+         static_cast<double>(audited.staged_into_frames_bytes) / samples,
+         static_cast<double>(timed.elapsed_ns) / static_cast<double>(timed.samples));
+#if ACQUISITION_HAVE_TSC
+  printf(" tsc_cycles_per_sample=%.1f",
+         static_cast<double>(timed.elapsed_cycles) / static_cast<double>(timed.samples));
+#endif
+  printf("\n");
+}
+
+}  // namespace
+
+void setUp() {
+  arduino_test::reset_time();
+  fill_fifo_stream();
+}
+
+void test_in_place_acquisition_commits_identical_frames() {
+  const AcquisitionRun legacy = run_legacy(true);
+  const AcquisitionRun in_place = run_in_place(true);
+
+  TEST_ASSERT_EQUAL_UINT64(kTotalSamples, legacy.samples);
+  TEST_ASSERT_EQUAL_UINT64(kTotalSamples, in_place.samples);
+  TEST_ASSERT_EQUAL_UINT32(kTotalSamples / kFrameSamples, legacy.frames.size());
+  TEST_ASSERT_EQUAL_UINT32(legacy.frames.size(), in_place.frames.size());
+  for (size_t i = 0; i < legacy.frames.size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT64(legacy.frames[i].t0_us, in_place.frames[i].t0_us);
+    TEST_ASSERT_EQUAL_UINT16(legacy.frames[i].sample_count, in_place.frames[i].sample_count);
+    TEST_ASSERT_EQUAL_UINT8(legacy.frames[i].range_tag, in_place.frames[i].range_tag);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(
+        legacy.frames[i].xyz, in_place.frames[i].xyz, static_cast<uint32_t>(kFrameSamples) * 3U);
+  }
+}
+
+void test_in_place_acquisition_moves_each_sample_once() {
+  const AcquisitionRun legacy = run_legacy(true);
+  const AcquisitionRun in_place = run_in_place(true);
+
+  print_run("batch_ring_pending", legacy, fastest_of(run_legacy));
+  print_run("in_place_decode", in_place, fastest_of(run_in_place));
+
+  // Either run may end with a few samples still read ahead.
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT64(kTotalSamples * kFifoEntryBytes, in_place.decoded_bytes);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT64(
+      (kTotalSamples + kSensorPrefetchSamples) * kFifoEntryBytes, in_place.decoded_bytes);
+  // In place, every decoded byte lands in its frame and staging writes none.
+  TEST_ASSERT_EQUAL_UINT64(in_place.decoded_bytes, in_place.decoded_into_frames_bytes);
+  TEST_ASSERT_EQUAL_UINT64(0, in_place.staged_into_frames_bytes);
+  // The old path decoded elsewhere and staging wrote every sample into the
+  // frame afterwards.
+  TEST_ASSERT_EQUAL_UINT64(0, legacy.decoded_into_frames_bytes);
+  TEST_ASSERT_EQUAL_UINT64(kTotalSamples * kSampleXyzBytes, legacy.staged_into_frames_bytes);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_in_place_acquisition_commits_identical_frames);
+  RUN_TEST(test_in_place_acquisition_moves_each_sample_once);
+  return UNITY_END();
+}
@@ -0,0 +1,435 @@
+// Firmware builds are optimized; time the loop paths the same way.
+#pragma GCC optimize("O2")
+
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+#include "../../lib/vibesensor_proto/vibesensor_proto.cpp"
+#include "../../src/runtime_backlog_stream.cpp"
+#include "../../src/runtime_frame_codec.cpp"
+#include "../../src/runtime_frame_handoff.cpp"
+#include "../../src/runtime_led.cpp"
+#include "../../src/runtime_pulse.cpp"
+#include "../../src/runtime_queue.cpp"
+#include "../../src/runtime_sampling.cpp"
+#include "../../src/runtime_status.cpp"
+#include "../../src/runtime_transport.cpp"
+#include "../../src/runtime_tsf_sync.cpp"
+
+ADXL345::ADXL345(TwoWire& wire, uint8_t i2c_addr, int sda_pin, int scl_pin, uint8_t fifo_watermark)
+    : wire_(wire),
+      i2c_addr_(i2c_addr),
+      sda_pin_(sda_pin),
+      scl_pin_(scl_pin),
+      fifo_watermark_(fifo_watermark),
+      available_(false) {}
+
+bool ADXL345::begin(FailureKind* failure_kind) {
+  available_ = true;
+  if (failure_kind != nullptr) {
+    *failure_kind = FailureKind::kNone;
+  }
+  return true;
+}
+
+bool ADXL345::recover_bus(FailureKind* failure_kind) {
+  if (failure_kind != nullptr) {
+    *failure_kind = FailureKind::kNone;
+  }
+  return true;
+}
+
+bool ADXL345::available() const { return available_; }
+
+bool ADXL345::set_range(uint8_t, FailureKind* failure_kind) {
+  if (failure_kind != nullptr) {
+    *failure_kind = FailureKind::kNone;
+  }
+  return available_;
+}
+
+size_t ADXL345::read_samples(
+    int16_t*, size_t, FailureKind* failure_kind, bool* fifo_truncated) {
+  if (failure_kind != nullptr) {
+    *failure_kind = FailureKind::kNone;
+  }
+  if (fifo_truncated != nullptr) {
+    *fifo_truncated = false;
+  }
+  return 0;
+}
+
+bool ADXL345::read_reg(uint8_t, uint8_t*) { return false; }
+
+bool ADXL345::write_reg(uint8_t, uint8_t) { return false; }
+
+bool ADXL345::read_multi(uint8_t, uint8_t*, size_t) { return false; }
+
+namespace {
+
+using vibesensor::runtime::DataFrame;
+using vibesensor::runtime::FrameQueueState;
+using vibesensor::runtime::PendingSample;
+using vibesensor::runtime::RuntimeStatus;
+using vibesensor::runtime::SamplingState;
+using vibesensor::runtime::TransportState;
+using vibesensor::runtime::kAxesPerSample;
+using vibesensor::runtime::kFrameSamples;
+using vibesensor::runtime::kSampleRateHz;
+
+constexpr uint32_t kRunSeconds = 60;
+constexpr uint64_t kLoopPeriodUs = 250;
+constexpr int64_t kClockOffsetUs = 123456;
+constexpr size_t kQueueRecords = 16;
+
+// The previous per-sample boundary, kept here as the baseline: the sampling
+// task published every sample and loop() rebuilt frames one sample at a time,
+// taking the sampling lock for every dequeue and for the final empty check.
+struct LegacySampleLoop {
+  PendingSample samples[static_cast<size_t>(kFrameSamples) * 2U] = {};
+  size_t head = 0;
+  size_t tail = 0;
+  size_t size = 0;
+  int16_t build_xyz[static_cast<size_t>(kFrameSamples) * kAxesPerSample] = {};
+  uint16_t build_count = 0;
+  uint64_t build_t0_us = 0;
+  portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+};
+
+void legacy_publish(LegacySampleLoop& legacy, const PendingSample& sample) {
+  const size_t capacity = sizeof(legacy.samples) / sizeof(legacy.samples[0]);
+  TEST_ASSERT_TRUE(legacy.size < capacity);
+  portENTER_CRITICAL(&legacy.lock);
+  legacy.samples[legacy.head] = sample;
+  legacy.head = (legacy.head + 1U) % capacity;
+  legacy.size++;
+  portEXIT_CRITICAL(&legacy.lock);
+}
+
+void legacy_service(LegacySampleLoop& legacy,
+                    FrameQueueState& queue_state,
+                    RuntimeStatus& status,
+                    int64_t clock_offset_us) {
+  const size_t capacity = sizeof(legacy.samples) / sizeof(legacy.samples[0]);
+  while (true) {
+    portENTER_CRITICAL(&legacy.lock);
+    const bool has_sample = legacy.size > 0;
+    PendingSample sample{};
+    if (has_sample) {
+      sample = legacy.samples[legacy.tail];
+      legacy.tail = (legacy.tail + 1U) % capacity;
+      legacy.size--;
+    }
+    portEXIT_CRITICAL(&legacy.lock);
+    if (!has_sample) {
+      return;
+    }
+
+    if (legacy.build_count == 0) {
+      legacy.build_t0_us = sample.due_us;
+    }
+    const size_t idx = static_cast<size_t>(legacy.build_count) * kAxesPerSample;
+    legacy.build_xyz[idx + 0] = sample.x;
+    legacy.build_xyz[idx + 1] = sample.y;
+    legacy.build_xyz[idx + 2] = sample.z;
+    legacy.build_count++;
+    if (legacy.build_count >= kFrameSamples) {
+      vibesensor::runtime::enqueue_frame(
+          queue_state,
+          status,
+          static_cast<uint64_t>(static_cast<int64_t>(legacy.build_t0_us) + clock_offset_us),
+          legacy.build_xyz,
+          legacy.build_count);
+      legacy.build_count = 0;
+    }
+  }
+}
+
+uint64_t sample_due_us(uint64_t index) {
+  return 1000000ULL + ((index * 1000000ULL) / kSampleRateHz);
+}
+
+PendingSample make_sample(uint64_t index, uint32_t& rng) {
+  PendingSample sample{};
+  sample.due_us = sample_due_us(index);
+  rng = (rng * 1664525U) + 1013904223U;
+  sample.x = static_cast<int16_t>(static_cast<int32_t>((rng >> 8) % 401U) - 200);
+  rng = (rng * 1664525U) + 1013904223U;
+  sample.y = static_cast<int16_t>(static_cast<int32_t>((rng >> 8) % 401U) - 200);
+  rng = (rng * 1664525U) + 1013904223U;
+  sample.z = static_cast<int16_t>(256 + static_cast<int32_t>((rng >> 8) % 61U) - 30);
+  return sample;
+}
+
+struct LoopRun {
+  uint64_t loop_iterations = 0;
+  uint64_t lock_acquisitions = 0;
+  std::vector<std::vector<uint8_t>> packets;
+};
+
+TransportState* make_transport() {
+  auto* transport = new TransportState();
+  for (size_t i = 0; i < vibesensor::kClientIdBytes; ++i) {
+    transport->client_id[i] = static_cast<uint8_t>(0xD0 + i);
+  }
+  transport->handshake_complete = true;
+  return transport;
+}
+
+// Sends whatever loop() queued this iteration, ACKing each frame immediately
+// so the stop-and-wait transport never holds more than one frame in flight.
+void drain_to_wire(TransportState& transport,
+                   FrameQueueState& queue_state,
+                   RuntimeStatus& status,
+                   LoopRun& run) {
+  while (DataFrame* front = vibesensor::runtime::peek_frame(queue_state)) {
+    const uint32_t seq = front->seq;
+    vibesensor::runtime::service_tx(transport, queue_state, status);
+    TEST_ASSERT_EQUAL_UINT32(1, transport.data_udp.sent_packets.size());
+    run.packets.push_back(transport.data_udp.sent_packets[0].payload);
+    transport.data_udp.sent_packets.clear();
+    vibesensor::runtime::ack_data_frames(queue_state, seq);
+  }
+}
+
+template <typename PublishFn, typename ServiceFn>
+void run_loop(PublishFn publish, ServiceFn service, FrameQueueState& queue_state, LoopRun& run) {
+  TransportState* transport = make_transport();
+  RuntimeStatus status{};
+  uint32_t rng = 0x5eedU;
+  const uint64_t total_samples = static_cast<uint64_t>(kRunSeconds) * kSampleRateHz;
+  uint64_t next_sample = 0;
+  for (uint64_t now_us = 1000000ULL; next_sample < total_samples; now_us += kLoopPeriodUs) {
+    arduino_test::set_millis(static_cast<uint32_t>(now_us / 1000ULL));
+    // Sampling task: everything due since the previous loop iteration.
+    while (next_sample < total_samples && sample_due_us(next_sample) <= now_us) {
+      publish(make_sample(next_sample, rng));
+      next_sample++;
+    }
+
+    const uint64_t locks_before = freertos_test::critical_section_entries();
+    service(queue_state, status);
+    run.lock_acquisitions += freertos_test::critical_section_entries() - locks_before;
+    run.loop_iterations++;
+    drain_to_wire(*transport, queue_state, status, run);
+  }
+  delete transport;
+}
+
+struct QueueStorage {
+  alignas(DataFrame) uint8_t ring[kQueueRecords * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+};
+
+LoopRun run_legacy() {
+  LoopRun run;
+  auto* legacy = new LegacySampleLoop();
+  auto* storage = new QueueStorage();
+  FrameQueueState queue_state{};
+  queue_state.ring = storage->ring;
+  queue_state.ring_bytes = sizeof(storage->ring);
+  run_loop([&](const PendingSample& sample) { legacy_publish(*legacy, sample); },
+           [&](FrameQueueState& queue, RuntimeStatus& status) {
+             legacy_service(*legacy, queue, status, kClockOffsetUs);
+           },
+           queue_state,
+           run);
+  delete storage;
+  delete legacy;
+  return run;
+}
+
+LoopRun run_frame_handoff() {
+  LoopRun run;
+  auto* sampling = new SamplingState();
+  auto* storage = new QueueStorage();
+  vibesensor::runtime::initialize_frame_handoff(
+      sampling->handoff, sampling->handoff_storage, vibesensor::runtime::kFrameHandoffFrames);
+  FrameQueueState queue_state{};
+  queue_state.ring = storage->ring;
+  queue_state.ring_bytes = sizeof(storage->ring);
+  run_loop([&](const PendingSample& sample) {
+             TEST_ASSERT_TRUE(vibesensor::runtime::publish_sample(*sampling, sample));
+           },
+           [&](FrameQueueState& queue, RuntimeStatus& status) {
+             vibesensor::runtime::service_frame_handoff(*sampling, queue, status, kClockOffsetUs);
+           },
+           queue_state,
+           run);
+  delete storage;
+  delete sampling;
+  return run;
+}
+
+uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count());
+}
+
+// Loop-side cost of the two kinds of iteration: polling an empty boundary
+// (most iterations) and pulling one frame's worth of data across it. Both are
+// timed in bulk so clock overhead does not swamp the tens of nanoseconds
+// being compared.
+struct LoopCost {
+  double idle_poll_ns = 0.0;
+  double frame_ns = 0.0;
+};
+
+constexpr uint32_t kIdlePolls = 2000000;
+constexpr uint32_t kTimedFrames = 4000;
+
+LoopCost measure_legacy_cost() {
+  LoopCost cost;
+  auto* legacy = new LegacySampleLoop();
+  auto* storage = new QueueStorage();
+  FrameQueueState queue_state{};
+  queue_state.ring = storage->ring;
+  queue_state.ring_bytes = sizeof(storage->ring);
+  RuntimeStatus status{};
+  uint32_t rng = 0x5eedU;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < kIdlePolls; ++i) {
+    legacy_service(*legacy, queue_state, status, kClockOffsetUs);
+  }
+  cost.idle_poll_ns = static_cast<double>(elapsed_ns(start)) / kIdlePolls;
+
+  uint64_t frame_ns = 0;
+  for (uint32_t frame = 0; frame < kTimedFrames; ++frame) {
+    for (uint16_t i = 0; i < kFrameSamples; ++i) {
+      legacy_publish(*legacy, make_sample((frame * kFrameSamples) + i, rng));
+    }
+    start = std::chrono::steady_clock::now();
+    legacy_service(*legacy, queue_state, status, kClockOffsetUs);
+    frame_ns += elapsed_ns(start);
+    vibesensor::runtime::drop_front_frame(queue_state);
+  }
+  cost.frame_ns = static_cast<double>(frame_ns) / kTimedFrames;
+  delete storage;
+  delete legacy;
+  return cost;
+}
+
+LoopCost measure_frame_handoff_cost() {
+  LoopCost cost;
+  auto* sampling = new SamplingState();
+  auto* storage = new QueueStorage();
+  vibesensor::runtime::initialize_frame_handoff(
+      sampling->handoff, sampling->handoff_storage, vibesensor::runtime::kFrameHandoffFrames);
+  FrameQueueState queue_state{};
+  queue_state.ring = storage->ring;
+  queue_state.ring_bytes = sizeof(storage->ring);
+  RuntimeStatus status{};
+  uint32_t rng = 0x5eedU;
+  vibesensor::runtime::service_frame_handoff(*sampling, queue_state, status, kClockOffsetUs);
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < kIdlePolls; ++i) {
+    vibesensor::runtime::service_frame_handoff(*sampling, queue_state, status, kClockOffsetUs);
+  }
+  cost.idle_poll_ns = static_cast<double>(elapsed_ns(start)) / kIdlePolls;
+
+  uint64_t frame_ns = 0;
+  for (uint32_t frame = 0; frame < kTimedFrames; ++frame) {
+    for (uint16_t i = 0; i < kFrameSamples; ++i) {
+      (void)vibesensor::runtime::publish_sample(
+          *sampling, make_sample((frame * kFrameSamples) + i, rng));
+    }
+    start = std::chrono::steady_clock::now();
+    vibesensor::runtime::service_frame_handoff(*sampling, queue_state, status, kClockOffsetUs);
+    frame_ns += elapsed_ns(start);
+    vibesensor::runtime::drop_front_frame(queue_state);
+  }
+  cost.frame_ns = static_cast<double>(frame_ns) / kTimedFrames;
+  delete storage;
+  delete sampling;
+  return cost;
+}
+
+// Host timings are noisy at this scale; keep the fastest of a few runs.
+template <typename MeasureFn>
+LoopCost fastest_of(MeasureFn measure) {
+  LoopCost best = measure();
+  for (int i = 0; i < 4; ++i) {
+    const LoopCost cost = measure();
+    if (cost.idle_poll_ns < best.idle_poll_ns) {
+      best.idle_poll_ns = cost.idle_poll_ns;
+    }
+    if (cost.frame_ns < best.frame_ns) {
+      best.frame_ns = cost.frame_ns;
+    }
+  }
+  return best;
+}
+
+// Loop-side nanoseconds per second of sampling for the simulated loop cadence.
+double loop_ns_per_second(const LoopCost& cost, const LoopRun& run) {
+  const double iterations_per_s = static_cast<double>(run.loop_iterations) / kRunSeconds;
+  const double frames_per_s = static_cast<double>(run.packets.size()) / kRunSeconds;
+  return ((iterations_per_s - frames_per_s) * cost.idle_poll_ns) + (frames_per_s * cost.frame_ns);
+}
+
+void print_cost(const char* label, const LoopCost& cost, const LoopRun& run) {
+  printf("%s loops_per_s=%llu frames_per_s=%u loop_lock_per_s=%llu idle_poll_ns=%.1f "
+         "frame_ns=%.0f loop_ns_per_s=%.0f\n",
+         label,
+         static_cast<unsigned long long>(run.loop_iterations / kRunSeconds),
+         static_cast<unsigned>(run.packets.size() / kRunSeconds),
+         static_cast<unsigned long long>(run.lock_acquisitions / kRunSeconds),
+         cost.idle_poll_ns,
+         cost.frame_ns,
+         loop_ns_per_second(cost, run));
+}
+
+}  // namespace
+
+void setUp() {
+  arduino_test::reset_time();
+  WiFi.reset();
+  WiFi.setStatus(WL_CONNECTED);
+}
+
+void test_frame_handoff_emits_identical_wire_output() {
+  const LoopRun legacy = run_legacy();
+  const LoopRun handoff = run_frame_handoff();
+
+  const size_t expected_frames =
+      (static_cast<size_t>(kRunSeconds) * kSampleRateHz) / kFrameSamples;
+  TEST_ASSERT_EQUAL_UINT32(expected_frames, legacy.packets.size());
+  TEST_ASSERT_EQUAL_UINT32(legacy.packets.size(), handoff.packets.size());
+  for (size_t i = 0; i < legacy.packets.size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT32(legacy.packets[i].size(), handoff.packets[i].size());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(
+        legacy.packets[i].data(), handoff.packets[i].data(), legacy.packets[i].size());
+  }
+}
+
+void test_frame_handoff_cuts_loop_side_work() {
+  const LoopRun legacy_run = run_legacy();
+  const LoopRun handoff_run = run_frame_handoff();
+  const LoopCost legacy = fastest_of(measure_legacy_cost);
+  const LoopCost handoff = fastest_of(measure_frame_handoff_cost);
+
+  print_cost("per_sample_handoff", legacy, legacy_run);
+  print_cost("frame_handoff", handoff, handoff_run);
+
+  // One lock per dequeued sample plus one empty check per loop iteration,
+  // versus one lock per drain that actually found frames.
+  TEST_ASSERT_TRUE(legacy_run.lock_acquisitions >=
+                   static_cast<uint64_t>(kRunSeconds) * kSampleRateHz);
+  TEST_ASSERT_TRUE(handoff_run.lock_acquisitions <= legacy_run.lock_acquisitions / 50U);
+  TEST_ASSERT_TRUE(handoff.idle_poll_ns < legacy.idle_poll_ns);
+  TEST_ASSERT_TRUE(handoff.frame_ns < legacy.frame_ns);
+  TEST_ASSERT_TRUE(loop_ns_per_second(handoff, handoff_run) <
+                   loop_ns_per_second(legacy, legacy_run));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_handoff_emits_identical_wire_output);
+  RUN_TEST(test_frame_handoff_cuts_loop_side_work);
+  return UNITY_END();
+}
@@ -0,0 +1,202 @@
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "../../src/runtime_frame_codec.cpp"
+#include "../../src/runtime_queue.cpp"
+
+namespace {
+
+using vibesensor::runtime::DataFrame;
+using vibesensor::runtime::FrameQueueState;
+using vibesensor::runtime::RuntimeStatus;
+using vibesensor::runtime::kAxesPerSample;
+using vibesensor::runtime::kFrameSamples;
+using vibesensor::runtime::kSampleRateHz;
+
+// Slot layout of the previous fixed-size queue, kept here as the baseline.
+struct FixedSlotFrame {
+  uint32_t seq;
+  uint64_t t0_us;
+  uint16_t sample_count;
+  int16_t xyz[static_cast<size_t>(kFrameSamples) * kAxesPerSample];
+  bool transmitted;
+  uint8_t tx_attempts;
+  uint32_t queued_ms;
+  uint32_t first_tx_ms;
+  uint32_t last_tx_ms;
+};
+
+constexpr size_t kQueueBytes = vibesensor::runtime::kFrameQueueBytesTarget;
+constexpr uint32_t kOutageSeconds = 120;
+constexpr double kTwoPi = 6.283185307179586;
+constexpr double kGravityCounts = 256.0;
+
+struct Tone {
+  double hz;
+  double amp[kAxesPerSample];
+};
+
+// Mirrors the server simulator profiles (apps/server/.../simulator/profiles.py)
+// in ADXL345 full-resolution counts, plus gravity on z and a sensor noise floor.
+struct SignalProfile {
+  const char* name;
+  Tone tones[3];
+  size_t tone_count;
+  double noise_std;
+  double bump_probability;
+  double bump_decay;
+  double bump_strength[kAxesPerSample];
+};
+
+const SignalProfile kProfiles[] = {
+    {"parked", {}, 0, 0.0, 0.0, 0.0, {0.0, 0.0, 0.0}},
+    {"engine_idle",
+     {{13.0, {170.0, 120.0, 250.0}}, {26.0, {55.0, 40.0, 85.0}}, {39.0, {30.0, 24.0, 45.0}}},
+     3,
+     22.0,
+     0.001,
+     0.96,
+     {18.0, 15.0, 28.0}},
+    {"wheel_imbalance",
+     {{13.9, {220.0, 125.0, 170.0}}, {27.8, {80.0, 52.0, 72.0}}, {7.2, {24.0, 18.0, 30.0}}},
+     3,
+     24.0,
+     0.004,
+     0.94,
+     {30.0, 24.0, 45.0}},
+    {"rough_road",
+     {{8.0, {80.0, 90.0, 130.0}}, {15.0, {105.0, 95.0, 140.0}}, {34.0, {55.0, 45.0, 85.0}}},
+     3,
+     28.0,
+     0.012,
+     0.92,
+     {45.0, 55.0, 80.0}},
+};
+
+constexpr double kNoiseFloorStd = 3.5;
+
+struct SignalSource {
+  const SignalProfile* profile;
+  uint64_t rng;
+  double bump[kAxesPerSample];
+  uint64_t index;
+};
+
+double next_uniform(SignalSource& source) {
+  source.rng = (source.rng * 6364136223846793005ULL) + 1442695040888963407ULL;
+  return (static_cast<double>(source.rng >> 11) + 0.5) / 9007199254740992.0;
+}
+
+double next_gaussian(SignalSource& source) {
+  const double u1 = next_uniform(source);
+  const double u2 = next_uniform(source);
+  return sqrt(-2.0 * log(u1)) * cos(kTwoPi * u2);
+}
+
+void next_sample(SignalSource& source, int16_t out[kAxesPerSample]) {
+  const SignalProfile& profile = *source.profile;
+  const double t = static_cast<double>(source.index++) / static_cast<double>(kSampleRateHz);
+  if (next_uniform(source) < profile.bump_probability) {
+    for (size_t axis = 0; axis < kAxesPerSample; ++axis) {
+      source.bump[axis] += profile.bump_strength[axis] * (0.85 + (0.3 * next_uniform(source)));
+    }
+  }
+  for (size_t axis = 0; axis < kAxesPerSample; ++axis) {
+    double value = axis == 2 ? kGravityCounts : 0.0;
+    for (size_t i = 0; i < profile.tone_count; ++i) {
+      value += profile.tones[i].amp[axis] *
+               sin((kTwoPi * profile.tones[i].hz * t) + (0.7 * static_cast<double>(axis)));
+    }
+    value += source.bump[axis];
+    source.bump[axis] *= profile.bump_decay;
+    value += (profile.noise_std * next_gaussian(source)) + (kNoiseFloorStd * next_gaussian(source));
+    out[axis] = static_cast<int16_t>(lround(value));
+  }
+}
+
+struct BacklogResult {
+  size_t frames = 0;
+  double seconds = 0.0;
+  double mean_record_bytes = 0.0;
+  bool newest_lossless = false;
+};
+
+BacklogResult replay_outage(const SignalProfile& profile, std::vector<uint64_t>& storage) {
+  FrameQueueState state{};
+  state.ring = reinterpret_cast<uint8_t*>(storage.data());
+  state.ring_bytes = kQueueBytes;
+  RuntimeStatus status{};
+  SignalSource source{&profile, 0x5eed0000ULL + profile.tone_count, {0.0, 0.0, 0.0}, 0};
+
+  // No ACKs arrive during the outage: the ring keeps the newest frames.
+  const uint64_t samples = static_cast<uint64_t>(kOutageSeconds) * kSampleRateHz;
+  int16_t last_frame[static_cast<size_t>(kFrameSamples) * kAxesPerSample] = {};
+  for (uint64_t i = 0; i < samples; ++i) {
+    const size_t slot = static_cast<size_t>(i % kFrameSamples) * kAxesPerSample;
+    next_sample(source, &last_frame[slot]);
+    if (i % kFrameSamples == kFrameSamples - 1U) {
+      vibesensor::runtime::enqueue_frame(
+          state, status, i + 1U - kFrameSamples, last_frame, kFrameSamples);
+    }
+  }
+
+  BacklogResult result;
+  result.frames = vibesensor::runtime::frame_queue_size(state);
+  result.seconds = (static_cast<double>(result.frames) * kFrameSamples) / kSampleRateHz;
+  result.mean_record_bytes = static_cast<double>(vibesensor::runtime::frame_queue_used_bytes(state)) /
+                             static_cast<double>(result.frames);
+
+  // Lossless: the newest retained frame decodes to exactly what was sampled.
+  while (vibesensor::runtime::frame_queue_size(state) > 1) {
+    vibesensor::runtime::drop_front_frame(state);
+  }
+  int16_t decoded[static_cast<size_t>(kFrameSamples) * kAxesPerSample] = {};
+  result.newest_lossless =
+      vibesensor::runtime::read_frame_samples(*vibesensor::runtime::peek_frame(state), decoded) &&
+      memcmp(last_frame, decoded, sizeof(decoded)) == 0;
+  return result;
+}
+
+}  // namespace
+
+void setUp() { arduino_test::reset_time(); }
+
+void test_byte_ring_backlog_seconds_against_fixed_slots() {
+  std::vector<uint64_t> storage((kQueueBytes + sizeof(uint64_t) - 1U) / sizeof(uint64_t));
+  const size_t fixed_frames = kQueueBytes / sizeof(FixedSlotFrame);
+  const double fixed_seconds =
+      (static_cast<double>(fixed_frames) * kFrameSamples) / kSampleRateHz;
+
+  double parked_seconds = 0.0;
+  for (const SignalProfile& profile : kProfiles) {
+    const BacklogResult ring = replay_outage(profile, storage);
+    if (profile.tone_count == 0) {
+      parked_seconds = ring.seconds;
+    }
+    printf("profile=%s queue_bytes=%u fixed_slots=%u fixed_backlog_s=%.1f ring_frames=%u "
+           "ring_backlog_s=%.1f mean_record_bytes=%.0f gain=%.2fx\n",
+           profile.name,
+           static_cast<unsigned>(kQueueBytes),
+           static_cast<unsigned>(fixed_frames),
+           fixed_seconds,
+           static_cast<unsigned>(ring.frames),
+           ring.seconds,
+           ring.mean_record_bytes,
+           ring.seconds / fixed_seconds);
+    TEST_ASSERT_TRUE(ring.newest_lossless);
+    TEST_ASSERT_TRUE(ring.seconds >= fixed_seconds);
+  }
+
+  // Quiet signals are where the fixed slots waste the most RAM.
+  TEST_ASSERT_TRUE(parked_seconds >= 2.0 * fixed_seconds);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_byte_ring_backlog_seconds_against_fixed_slots);
+  return UNITY_END();
+}
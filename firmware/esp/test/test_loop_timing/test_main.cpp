@@ -6,12 +6,13 @@
 
 #include "reliability.h"
 #include "../../src/runtime_config.h"
-#include "../../src/runtime_sample_handoff.cpp"
+#include "../../src/runtime_frame_handoff.cpp"
 
 namespace {
 
+using vibesensor::runtime::CommittedFrame;
+using vibesensor::runtime::FrameHandoffState;
 using vibesensor::runtime::PendingSample;
-using vibesensor::runtime::SampleHandoffState;
 
 constexpr uint64_t kRunDurationUs = 12000000ULL;
 constexpr uint64_t kStatusSpikeIntervalUs = 10000000ULL;
@@ -21,7 +22,7 @@ constexpr uint32_t kStatusSpikeCostUs = 2200;
 constexpr uint32_t kRefillFixedUs = 70;
 constexpr uint32_t kRefillPerSampleUs = 90;
 constexpr uint32_t kProduceSampleCostUs = 10;
-constexpr size_t kSimulationHandoffCapacity = 96;
+constexpr size_t kSimulationHandoffFrames = vibesensor::runtime::kFrameHandoffFrames;
 
 struct SimulationMetrics {
   uint64_t loop_iterations = 0;
@@ -38,8 +39,8 @@ struct SimulationMetrics {
 };
 
 struct ProducerState {
-  PendingSample handoff_storage[kSimulationHandoffCapacity] = {};
-  SampleHandoffState handoff = {};
+  CommittedFrame handoff_storage[kSimulationHandoffFrames] = {};
+  FrameHandoffState handoff;
   size_t prefetch_count = 0;
   size_t last_refill_request = 0;
   size_t last_refill_count = 0;
@@ -113,7 +114,7 @@ void produce_due_slots(ProducerState& state,
   }
 
   maybe_refill(state, due_slots, metrics);
-  const size_t headroom = publish_to_handoff ? vibesensor::runtime::sample_handoff_free_slots(state.handoff)
+  const size_t headroom = publish_to_handoff ? vibesensor::runtime::frame_handoff_free_samples(state.handoff)
                                              : due_slots;
   const vibesensor::reliability::SamplingRecoveryPlan recovery =
       vibesensor::reliability::sampling_recovery_plan(
@@ -136,10 +137,13 @@ void produce_due_slots(ProducerState& state,
       sample.x = static_cast<int16_t>(metrics.samples_produced);
       sample.y = static_cast<int16_t>(metrics.samples_produced + 1);
       sample.z = static_cast<int16_t>(metrics.samples_produced + 2);
-      if (!vibesensor::runtime::enqueue_pending_sample(state.handoff, sample)) {
+      if (!vibesensor::runtime::stage_frame_sample(state.handoff, sample)) {
         metrics.handoff_overflow_drops = state.handoff.overflow_drops;
         break;
       }
+      if (vibesensor::runtime::staged_frame_complete(state.handoff)) {
+        vibesensor::runtime::commit_staged_frame(state.handoff, 0);
+      }
       if (state.handoff.high_watermark > metrics.handoff_peak) {
         metrics.handoff_peak = state.handoff.high_watermark;
       }
@@ -176,9 +180,11 @@ void advance_dedicated_producer_to(uint64_t wall_time_us,
 }
 
 void drain_handoff(ProducerState& state, SimulationMetrics& metrics) {
-  PendingSample sample{};
-  while (vibesensor::runtime::dequeue_pending_sample(state.handoff, &sample)) {
-    metrics.samples_consumed++;
+  const CommittedFrame* frame = vibesensor::runtime::peek_committed_frame(state.handoff);
+  while (frame != nullptr) {
+    metrics.samples_consumed += frame->sample_count;
+    vibesensor::runtime::release_committed_frame(state.handoff);
+    frame = vibesensor::runtime::peek_committed_frame(state.handoff);
   }
 }
 
@@ -220,8 +226,8 @@ SimulationMetrics run_dedicated_simulation() {
   SimulationMetrics metrics{};
   uint64_t loop_now_us = 0;
   uint64_t next_status_spike_us = kStatusSpikeIntervalUs;
-  vibesensor::runtime::initialize_sample_handoff(
-      state.handoff, state.handoff_storage, kSimulationHandoffCapacity);
+  vibesensor::runtime::initialize_frame_handoff(
+      state.handoff, state.handoff_storage, kSimulationHandoffFrames);
 
   while (loop_now_us < kRunDurationUs) {
     metrics.loop_iterations++;
@@ -238,6 +244,8 @@ SimulationMetrics run_dedicated_simulation() {
   }
 
   drain_handoff(state, metrics);
+  // The partially staged frame has not been published yet.
+  metrics.samples_consumed += state.handoff.staged_count;
   if (metrics.refill_duration_min_us == std::numeric_limits<uint64_t>::max()) {
     metrics.refill_duration_min_us = 0;
   }
@@ -33,16 +33,64 @@ void test_pack_hello_matches_python_fixture() {
 
 void test_pack_hello_ack_matches_python_fixture() {
   std::array<uint8_t, fixture::kHelloAckPacket.size()> packet = {};
-  const size_t len = vibesensor::pack_hello_ack(
-      packet.data(), packet.size(), fixture::kHelloClientId.data());
+  const size_t len = vibesensor::pack_hello_ack(packet.data(),
+                                                packet.size(),
+                                                fixture::kHelloClientId.data(),
+                                                fixture::kHelloAckCapabilities);
   expect_packet_matches_fixture(fixture::kHelloAckPacket, packet, len);
 }
 
 void test_parse_hello_ack_matches_python_fixture() {
+  uint8_t capabilities = 0;
   const bool ok = vibesensor::parse_hello_ack(fixture::kHelloAckPacket.data(),
                                               fixture::kHelloAckPacket.size(),
-                                              fixture::kHelloClientId.data());
+                                              fixture::kHelloClientId.data(),
+                                              &capabilities);
   TEST_ASSERT_TRUE(ok);
+  TEST_ASSERT_EQUAL_UINT8(fixture::kHelloAckCapabilities, capabilities);
+
+  // Servers that predate the echo send the bare header, accepting nothing.
+  TEST_ASSERT_TRUE(vibesensor::parse_hello_ack(fixture::kHelloAckPacket.data(),
+                                               vibesensor::kHelloAckHeaderBytes,
+                                               fixture::kHelloClientId.data(),
+                                               &capabilities));
+  TEST_ASSERT_EQUAL_UINT8(0, capabilities);
+}
+
+void test_hello_ack_receipts_match_python_fixture() {
+  std::array<uint8_t, fixture::kHelloAckReceiptsPacket.size()> packet = {};
+  const size_t len = vibesensor::pack_hello_ack(packet.data(),
+                                                packet.size(),
+                                                fixture::kHelloClientId.data(),
+                                                fixture::kHelloAckCapabilities,
+                                                fixture::kHelloAckContiguousSeq,
+                                                fixture::kHelloAckReceiptBitmap);
+  expect_packet_matches_fixture(fixture::kHelloAckReceiptsPacket, packet, len);
+
+  uint8_t capabilities = 0;
+  bool has_receipts = false;
+  uint32_t contiguous_seq = 0;
+  uint32_t receipt_bitmap = 0;
+  TEST_ASSERT_TRUE(vibesensor::parse_hello_ack(fixture::kHelloAckReceiptsPacket.data(),
+                                               fixture::kHelloAckReceiptsPacket.size(),
+                                               fixture::kHelloClientId.data(),
+                                               &capabilities,
+                                               &has_receipts,
+                                               &contiguous_seq,
+                                               &receipt_bitmap));
+  TEST_ASSERT_TRUE(has_receipts);
+  TEST_ASSERT_TRUE((capabilities & vibesensor::kHelloCapResumeReceipts) != 0);
+  TEST_ASSERT_EQUAL_UINT32(fixture::kHelloAckContiguousSeq, contiguous_seq);
+  TEST_ASSERT_EQUAL_UINT32(fixture::kHelloAckReceiptBitmap, receipt_bitmap);
+
+  TEST_ASSERT_TRUE(vibesensor::parse_hello_ack(fixture::kHelloAckPacket.data(),
+                                               fixture::kHelloAckPacket.size(),
+                                               fixture::kHelloClientId.data(),
+                                               &capabilities,
+                                               &has_receipts,
+                                               &contiguous_seq,
+                                               &receipt_bitmap));
+  TEST_ASSERT_FALSE(has_receipts);
 }
 
 void test_pack_data_matches_python_fixture() {
@@ -57,6 +105,64 @@ void test_pack_data_matches_python_fixture() {
   expect_packet_matches_fixture(fixture::kDataPacket, packet, len);
 }
 
+void test_stream_record_prefix_matches_python_fixture() {
+  std::array<uint8_t, fixture::kDataStreamRecordPrefix.size()> prefix = {};
+  const size_t len = vibesensor::pack_stream_record_prefix(
+      prefix.data(), prefix.size(), fixture::kDataPacket.size());
+  expect_packet_matches_fixture(fixture::kDataStreamRecordPrefix, prefix, len);
+  TEST_ASSERT_EQUAL_UINT32(0, vibesensor::pack_stream_record_prefix(prefix.data(), 1, 4));
+  TEST_ASSERT_EQUAL_UINT32(0, vibesensor::pack_stream_record_prefix(prefix.data(), 2, 0x10000));
+}
+
+void test_pack_data_with_range_tag_matches_python_fixture() {
+  std::array<uint8_t, fixture::kDataTaggedPacket.size()> packet = {};
+  const size_t len = vibesensor::pack_data(packet.data(),
+                                           packet.size(),
+                                           fixture::kDataClientId.data(),
+                                           fixture::kDataSeq,
+                                           fixture::kDataT0Us,
+                                           fixture::kDataSamples.data(),
+                                           fixture::kDataSampleCount,
+                                           fixture::kDataRangeTag);
+  expect_packet_matches_fixture(fixture::kDataTaggedPacket, packet, len);
+  TEST_ASSERT_EQUAL_UINT32(0,
+                           vibesensor::pack_data(packet.data(),
+                                                 packet.size() - 1U,
+                                                 fixture::kDataClientId.data(),
+                                                 fixture::kDataSeq,
+                                                 fixture::kDataT0Us,
+                                                 fixture::kDataSamples.data(),
+                                                 fixture::kDataSampleCount,
+                                                 fixture::kDataRangeTag));
+}
+
+void test_pack_data_with_pulse_channel_matches_python_fixture() {
+  vibesensor::DataPulseChannel pulse;
+  pulse.edge_count = fixture::kDataPulseEdgeCount;
+  pulse.last_edge_offset_us = fixture::kDataPulseLastEdgeOffsetUs;
+  std::array<uint8_t, fixture::kDataPulsePacket.size()> packet = {};
+  const size_t len = vibesensor::pack_data(packet.data(),
+                                           packet.size(),
+                                           fixture::kDataClientId.data(),
+                                           fixture::kDataSeq,
+                                           fixture::kDataT0Us,
+                                           fixture::kDataSamples.data(),
+                                           fixture::kDataSampleCount,
+                                           fixture::kDataRangeTag,
+                                           pulse);
+  expect_packet_matches_fixture(fixture::kDataPulsePacket, packet, len);
+  TEST_ASSERT_EQUAL_UINT32(0,
+                           vibesensor::pack_data(packet.data(),
+                                                 packet.size() - 1U,
+                                                 fixture::kDataClientId.data(),
+                                                 fixture::kDataSeq,
+                                                 fixture::kDataT0Us,
+                                                 fixture::kDataSamples.data(),
+                                                 fixture::kDataSampleCount,
+                                                 fixture::kDataRangeTag,
+                                                 pulse));
+}
+
 void test_parse_identify_matches_python_fixture() {
   uint8_t cmd_id = 0;
   uint32_t cmd_seq = 0;
@@ -98,6 +204,32 @@ void test_parse_sync_clock_matches_python_fixture() {
   TEST_ASSERT_EQUAL_UINT32(fixture::kSyncClockRoundTripUs, round_trip_us);
 }
 
+void test_parse_tx_slot_matches_python_fixture() {
+  uint8_t cmd_id = 0;
+  uint32_t cmd_seq = 0;
+  uint32_t slot_offset_us = 0;
+  uint32_t slot_period_us = 0;
+  uint32_t slot_width_us = 0;
+  const bool ok = vibesensor::parse_cmd(fixture::kTxSlotPacket.data(),
+                                        fixture::kTxSlotPacket.size(),
+                                        fixture::kCommandClientId.data(),
+                                        &cmd_id,
+                                        &cmd_seq,
+                                        nullptr,
+                                        nullptr,
+                                        nullptr,
+                                        nullptr,
+                                        &slot_offset_us,
+                                        &slot_period_us,
+                                        &slot_width_us);
+  TEST_ASSERT_TRUE(ok);
+  TEST_ASSERT_EQUAL_UINT8(vibesensor::kCmdTxSlot, cmd_id);
+  TEST_ASSERT_EQUAL_UINT32(fixture::kTxSlotCmdSeq, cmd_seq);
+  TEST_ASSERT_EQUAL_UINT32(fixture::kTxSlotOffsetUs, slot_offset_us);
+  TEST_ASSERT_EQUAL_UINT32(fixture::kTxSlotPeriodUs, slot_period_us);
+  TEST_ASSERT_EQUAL_UINT32(fixture::kTxSlotWidthUs, slot_width_us);
+}
+
 void test_pack_sync_clock_ack_matches_python_fixture() {
   std::array<uint8_t, fixture::kSyncClockAckPacket.size()> packet = {};
   const size_t len = vibesensor::pack_ack_sync_clock(packet.data(),
@@ -144,9 +276,14 @@ int main(int argc, char** argv) {
   RUN_TEST(test_pack_hello_matches_python_fixture);
   RUN_TEST(test_pack_hello_ack_matches_python_fixture);
   RUN_TEST(test_parse_hello_ack_matches_python_fixture);
+  RUN_TEST(test_hello_ack_receipts_match_python_fixture);
   RUN_TEST(test_pack_data_matches_python_fixture);
+  RUN_TEST(test_stream_record_prefix_matches_python_fixture);
+  RUN_TEST(test_pack_data_with_range_tag_matches_python_fixture);
+  RUN_TEST(test_pack_data_with_pulse_channel_matches_python_fixture);
   RUN_TEST(test_parse_identify_matches_python_fixture);
   RUN_TEST(test_parse_sync_clock_matches_python_fixture);
+  RUN_TEST(test_parse_tx_slot_matches_python_fixture);
   RUN_TEST(test_pack_sync_clock_ack_matches_python_fixture);
   RUN_TEST(test_pack_ack_matches_python_fixture);
   RUN_TEST(test_parse_data_ack_matches_python_fixture);
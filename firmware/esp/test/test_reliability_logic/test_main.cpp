@@ -420,6 +420,106 @@ void test_flaky_wifi_repeated_connect_disconnect_cycles() {
   }
 }
 
+void test_tx_slot_schedule_rejects_degenerate_assignments() {
+  vibesensor::reliability::TxSlotSchedule schedule{};
+  TEST_ASSERT_FALSE(vibesensor::reliability::tx_slot_schedule_valid(schedule));
+  schedule.period_us = 20000;
+  schedule.width_us = 5000;
+  schedule.offset_us = 15000;
+  TEST_ASSERT_TRUE(vibesensor::reliability::tx_slot_schedule_valid(schedule));
+  schedule.width_us = 20001;
+  TEST_ASSERT_FALSE(vibesensor::reliability::tx_slot_schedule_valid(schedule));
+  schedule.width_us = 5000;
+  schedule.offset_us = 20000;
+  TEST_ASSERT_FALSE(vibesensor::reliability::tx_slot_schedule_valid(schedule));
+}
+
+void test_tx_slot_guard_grows_with_sync_error_and_drift_then_caps() {
+  // 100 us floor + half of a 600 us round trip.
+  TEST_ASSERT_EQUAL_UINT32(
+      400, vibesensor::reliability::tx_slot_guard_us(100, 600, 0, 50, 10000));
+  // 4 s since the last sync at 50 ppm adds 200 us of possible drift.
+  TEST_ASSERT_EQUAL_UINT32(
+      600, vibesensor::reliability::tx_slot_guard_us(100, 600, 4000, 50, 10000));
+  // A stale sync never eats more than 3/8 of the slot from each edge.
+  TEST_ASSERT_EQUAL_UINT32(
+      3750, vibesensor::reliability::tx_slot_guard_us(100, 600, 600000, 50, 10000));
+}
+
+void test_tx_slot_remaining_tracks_phase_within_guarded_window() {
+  vibesensor::reliability::TxSlotSchedule schedule{};
+  schedule.offset_us = 5000;
+  schedule.period_us = 20000;
+  schedule.width_us = 4000;
+  // Before the leading guard, inside the slot, at the trailing guard, and in
+  // a later period.
+  TEST_ASSERT_EQUAL_UINT32(0, vibesensor::reliability::tx_slot_remaining_us(schedule, 5100, 200));
+  TEST_ASSERT_EQUAL_UINT32(
+      3300, vibesensor::reliability::tx_slot_remaining_us(schedule, 5500, 200));
+  TEST_ASSERT_EQUAL_UINT32(0, vibesensor::reliability::tx_slot_remaining_us(schedule, 8800, 200));
+  TEST_ASSERT_EQUAL_UINT32(
+      3300, vibesensor::reliability::tx_slot_remaining_us(schedule, 2005500, 200));
+  // Synced clocks can be negative right after boot; phase still wraps.
+  TEST_ASSERT_EQUAL_UINT32(
+      3300, vibesensor::reliability::tx_slot_remaining_us(schedule, -14500, 200));
+  // A guard of half the slot leaves nothing usable.
+  TEST_ASSERT_EQUAL_UINT32(
+      0, vibesensor::reliability::tx_slot_remaining_us(schedule, 7000, 2000));
+}
+
+void test_accel_range_rails_and_clip_detection() {
+  using vibesensor::reliability::accel_sample_clipped;
+  TEST_ASSERT_EQUAL_UINT8(2, vibesensor::reliability::accel_range_g(0));
+  TEST_ASSERT_EQUAL_UINT8(16, vibesensor::reliability::accel_range_g(3));
+  TEST_ASSERT_EQUAL_UINT8(10, vibesensor::reliability::accel_range_sample_bits(0));
+  TEST_ASSERT_EQUAL_UINT8(13, vibesensor::reliability::accel_range_sample_bits(3));
+  TEST_ASSERT_EQUAL_INT32(511, vibesensor::reliability::accel_range_rail_counts(0));
+  TEST_ASSERT_EQUAL_INT32(4095, vibesensor::reliability::accel_range_rail_counts(3));
+
+  // FULL_RES saturates at [-2^(n-1), 2^(n-1) - 1] for an n-bit range.
+  TEST_ASSERT_FALSE(accel_sample_clipped(510, 0));
+  TEST_ASSERT_TRUE(accel_sample_clipped(511, 0));
+  TEST_ASSERT_FALSE(accel_sample_clipped(-511, 0));
+  TEST_ASSERT_TRUE(accel_sample_clipped(-512, 0));
+  TEST_ASSERT_FALSE(accel_sample_clipped(511, 1));
+  TEST_ASSERT_TRUE(accel_sample_clipped(-4096, 3));
+}
+
+void test_auto_range_steps_up_on_loud_frames_and_jumps_on_clip() {
+  vibesensor::reliability::AutoRangeState state{};
+  state.range_code = 0;
+  // 3/4 of the +/-2 g rail is 383 counts.
+  TEST_ASSERT_EQUAL_UINT8(0, vibesensor::reliability::auto_range_next(state, 383, false, 20));
+  TEST_ASSERT_EQUAL_UINT8(1, vibesensor::reliability::auto_range_next(state, 384, false, 20));
+  TEST_ASSERT_EQUAL_UINT8(1, vibesensor::reliability::auto_range_next(state, 700, false, 20));
+  // A clipped frame says nothing about how far past the rail the signal went.
+  TEST_ASSERT_EQUAL_UINT8(3, vibesensor::reliability::auto_range_next(state, 1023, true, 20));
+  TEST_ASSERT_EQUAL_UINT8(3, vibesensor::reliability::auto_range_next(state, 4095, false, 20));
+}
+
+void test_auto_range_steps_down_only_after_sustained_quiet() {
+  vibesensor::reliability::AutoRangeState state{};
+  // 3/8 of the +/-8 g rail is 767 counts.
+  for (uint8_t i = 0; i < 19; ++i) {
+    TEST_ASSERT_EQUAL_UINT8(3, vibesensor::reliability::auto_range_next(state, 766, false, 20));
+  }
+  // One frame above the step-down threshold restarts the count.
+  TEST_ASSERT_EQUAL_UINT8(3, vibesensor::reliability::auto_range_next(state, 767, false, 20));
+  for (uint8_t i = 0; i < 19; ++i) {
+    TEST_ASSERT_EQUAL_UINT8(3, vibesensor::reliability::auto_range_next(state, 300, false, 20));
+  }
+  TEST_ASSERT_EQUAL_UINT8(2, vibesensor::reliability::auto_range_next(state, 300, false, 20));
+  TEST_ASSERT_EQUAL_UINT8(0, state.quiet_frames);
+
+  // The same signal never walks back up: it sits well under 3/4 of the new
+  // rail, so there is no oscillation at the boundary.
+  for (uint8_t i = 0; i < 100; ++i) {
+    TEST_ASSERT_TRUE(vibesensor::reliability::auto_range_next(state, 300, false, 20) <= 2U);
+  }
+  // 300 counts needs +/-4 g at most: 3/8 of the +/-2 g rail is 191.
+  TEST_ASSERT_EQUAL_UINT8(1, state.range_code);
+}
+
 int main() {
   UNITY_BEGIN();
   RUN_TEST(test_frame_samples_are_clamped_to_datagram_limit);
@@ -456,5 +556,11 @@ int main() {
   RUN_TEST(test_flaky_wifi_backoff_bounded_across_many_failures);
   RUN_TEST(test_flaky_wifi_reconnect_success_resets_backoff);
   RUN_TEST(test_flaky_wifi_repeated_connect_disconnect_cycles);
+  RUN_TEST(test_tx_slot_schedule_rejects_degenerate_assignments);
+  RUN_TEST(test_tx_slot_guard_grows_with_sync_error_and_drift_then_caps);
+  RUN_TEST(test_tx_slot_remaining_tracks_phase_within_guarded_window);
+  RUN_TEST(test_accel_range_rails_and_clip_detection);
+  RUN_TEST(test_auto_range_steps_up_on_loud_frames_and_jumps_on_clip);
+  RUN_TEST(test_auto_range_steps_down_only_after_sustained_quiet);
   return UNITY_END();
 }
@@ -0,0 +1,374 @@
+#include <unity.h>
+
+#include <algorithm>
+#include <deque>
+#include <set>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "../native_support/generated_protocol_contract_fixtures.h"
+
+#include "../../lib/vibesensor_proto/vibesensor_proto.cpp"
+#include "../../src/runtime_backlog_stream.cpp"
+#include "../../src/runtime_frame_codec.cpp"
+#include "../../src/runtime_led.cpp"
+#include "../../src/runtime_queue.cpp"
+#include "../../src/runtime_status.cpp"
+#include "../../src/runtime_transport.cpp"
+#include "../../src/runtime_tsf_sync.cpp"
+
+namespace {
+
+namespace fixture = vibesensor::test_support;
+
+using vibesensor::runtime::DataFrame;
+using vibesensor::runtime::FrameQueueState;
+using vibesensor::runtime::RuntimeStatus;
+using vibesensor::runtime::TransportState;
+
+constexpr size_t kDataSeqOffset = 2 + vibesensor::kClientIdBytes;
+constexpr uint32_t kFramePeriodMs =
+    1000U * vibesensor::runtime::kFrameSamples / vibesensor::runtime::kSampleRateHz;
+
+FrameQueueState make_queue_state(uint8_t* ring, size_t ring_bytes) {
+  FrameQueueState state{};
+  state.ring = ring;
+  state.ring_bytes = ring_bytes;
+  return state;
+}
+
+void append_full_frame(FrameQueueState& state, RuntimeStatus& status, int16_t sample_base) {
+  int16_t xyz[static_cast<size_t>(vibesensor::runtime::kFrameSamples) *
+              vibesensor::runtime::kAxesPerSample] = {};
+  for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
+    const int16_t value = static_cast<int16_t>(sample_base + static_cast<int16_t>(i));
+    const size_t idx = static_cast<size_t>(i) * vibesensor::runtime::kAxesPerSample;
+    xyz[idx + 0] = value;
+    xyz[idx + 1] = static_cast<int16_t>(value + 1);
+    xyz[idx + 2] = static_cast<int16_t>(value + 2);
+  }
+  vibesensor::runtime::enqueue_frame(
+      state, status, 1000, xyz, vibesensor::runtime::kFrameSamples);
+}
+
+void init_transport(TransportState& transport) {
+  for (size_t i = 0; i < vibesensor::kClientIdBytes; ++i) {
+    transport.client_id[i] = fixture::kCommandClientId[i];
+  }
+  transport.backlog_stream.client.reset();
+  transport.handshake_complete = true;
+}
+
+uint32_t read_u32_le_at(const uint8_t* data) {
+  return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+         (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// Splits the bytes written to the stream since *offset into records and
+// returns their DATA seqs.
+std::vector<uint32_t> take_stream_records(const std::vector<uint8_t>& written, size_t* offset) {
+  std::vector<uint32_t> seqs;
+  while (written.size() - *offset >= vibesensor::kStreamRecordPrefixBytes) {
+    const size_t len = static_cast<size_t>(written[*offset]) |
+                       (static_cast<size_t>(written[*offset + 1]) << 8);
+    if (written.size() - *offset < vibesensor::kStreamRecordPrefixBytes + len) {
+      break;
+    }
+    const uint8_t* packet = written.data() + *offset + vibesensor::kStreamRecordPrefixBytes;
+    seqs.push_back(read_u32_le_at(packet + kDataSeqOffset));
+    *offset += vibesensor::kStreamRecordPrefixBytes + len;
+  }
+  return seqs;
+}
+
+void queue_data_ack(TransportState& transport, uint32_t seq, bool in_stream) {
+  uint8_t ack[vibesensor::kDataAckBytes] = {};
+  const size_t len = vibesensor::pack_data_ack(ack, sizeof(ack), transport.client_id, seq);
+  if (in_stream) {
+    transport.backlog_stream.client.queueIncoming(ack, len);
+  } else {
+    transport.data_udp.queueIncoming(ack, len);
+  }
+}
+
+struct OutageReplayResult {
+  uint32_t backlog_frames = 0;
+  uint32_t backlog_delivered = 0;
+  uint32_t replay_ms = 0;
+  uint32_t live_frames = 0;
+  uint32_t live_latency_p50_ms = 0;
+  uint32_t live_latency_max_ms = 0;
+};
+
+// A Wi-Fi outage queues a backlog; after reconnect the loop runs on a 1 ms tick
+// against a simulated server with a fixed round trip. Each DATA reaches the
+// server half a round trip after it is sent and its DATA_ACK returns a full
+// round trip later. Sampling keeps queuing live frames throughout.
+OutageReplayResult run_outage_replay(bool stream_listener) {
+  constexpr size_t kOutageFrames = 96;
+  constexpr uint32_t kRoundTripMs = 20;
+  constexpr uint32_t kRunMs = 3000;
+  alignas(DataFrame) static uint8_t ring[(kOutageFrames + 16) *
+                                         vibesensor::runtime::kFrameRecordMaxBytes];
+  memset(ring, 0, sizeof(ring));
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
+  RuntimeStatus status{};
+  static TransportState transport;
+  transport = TransportState();
+  init_transport(transport);
+  if (!stream_listener) {
+    transport.backlog_stream.client.setConnectResults({0, 0, 0, 0});
+  }
+
+  WiFi.setStatus(WL_DISCONNECTED);
+  arduino_test::set_millis(1);
+  for (size_t i = 0; i < kOutageFrames; ++i) {
+    append_full_frame(queue_state, status, static_cast<int16_t>(i));
+    arduino_test::advance_millis(kFramePeriodMs);
+  }
+  WiFi.setStatus(WL_CONNECTED);
+  const uint32_t reconnect_ms = millis();
+
+  struct InFlightAck {
+    uint32_t due_ms;
+    uint32_t seq;
+    bool in_stream;
+  };
+  std::deque<InFlightAck> acks;
+  std::vector<uint32_t> live_queued_ms;
+  std::set<uint32_t> server_seqs;
+  std::vector<uint32_t> live_latency_ms;
+  OutageReplayResult result;
+  result.backlog_frames = kOutageFrames;
+  size_t udp_seen = 0;
+  size_t stream_offset = 0;
+  uint32_t next_frame_ms = reconnect_ms;
+
+  auto server_receive = [&](uint32_t seq, uint32_t now_ms) {
+    const uint32_t arrival_ms = now_ms + kRoundTripMs / 2U;
+    if (!server_seqs.insert(seq).second) {
+      return;
+    }
+    if (seq < kOutageFrames) {
+      result.backlog_delivered++;
+      result.replay_ms = arrival_ms - reconnect_ms;
+    } else if (seq - kOutageFrames < live_queued_ms.size()) {
+      live_latency_ms.push_back(arrival_ms - live_queued_ms[seq - kOutageFrames]);
+    }
+  };
+
+  while (millis() - reconnect_ms < kRunMs) {
+    const uint32_t now_ms = millis();
+    while (!acks.empty() && acks.front().due_ms <= now_ms) {
+      if (!acks.front().in_stream || transport.backlog_stream.client.connected()) {
+        queue_data_ack(transport, acks.front().seq, acks.front().in_stream);
+      }
+      acks.pop_front();
+    }
+
+    vibesensor::runtime::service_data_rx(transport, queue_state, status);
+    vibesensor::runtime::service_backlog_stream(transport, queue_state, status);
+    vibesensor::runtime::service_tx(transport, queue_state, status);
+    // The connect task finishes within the tick; the next loop picks it up.
+    freertos_test::run_created_tasks();
+    if (now_ms >= next_frame_ms) {
+      live_queued_ms.push_back(now_ms);
+      append_full_frame(queue_state, status, static_cast<int16_t>(live_queued_ms.size()));
+      next_frame_ms += kFramePeriodMs;
+    }
+
+    for (; udp_seen < transport.data_udp.sent_packets.size(); ++udp_seen) {
+      const uint32_t seq =
+          read_u32_le_at(transport.data_udp.sent_packets[udp_seen].payload.data() + kDataSeqOffset);
+      server_receive(seq, now_ms);
+      acks.push_back({now_ms + kRoundTripMs, seq, false});
+    }
+    for (uint32_t seq : take_stream_records(transport.backlog_stream.client.written,
+                                            &stream_offset)) {
+      server_receive(seq, now_ms);
+      acks.push_back({now_ms + kRoundTripMs, seq, true});
+    }
+    arduino_test::advance_millis(1);
+  }
+
+  std::sort(live_latency_ms.begin(), live_latency_ms.end());
+  result.live_frames = static_cast<uint32_t>(live_latency_ms.size());
+  if (!live_latency_ms.empty()) {
+    result.live_latency_p50_ms = live_latency_ms[live_latency_ms.size() / 2U];
+    result.live_latency_max_ms = live_latency_ms.back();
+  }
+  return result;
+}
+
+}  // namespace
+
+void setUp() {
+  arduino_test::reset_time();
+  freertos_test::created_tasks().clear();
+  WiFi.reset();
+  WiFi.setStatus(WL_CONNECTED);
+}
+
+void tearDown() {}
+
+void test_stream_replays_backlog_while_live_frames_stay_on_udp() {
+  constexpr size_t kBacklog = vibesensor::runtime::kBacklogStreamThresholdFrames;
+  alignas(DataFrame) static uint8_t ring[(kBacklog + 4) *
+                                         vibesensor::runtime::kFrameRecordMaxBytes];
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
+  RuntimeStatus status{};
+  static TransportState transport;
+  transport = TransportState();
+  init_transport(transport);
+  arduino_test::set_millis(1000);
+  for (size_t i = 0; i < kBacklog; ++i) {
+    append_full_frame(queue_state, status, static_cast<int16_t>(i));
+  }
+
+  // The connect runs on its own task; the loop returns without waiting for it.
+  vibesensor::runtime::service_backlog_stream(transport, queue_state, status);
+  TEST_ASSERT_FALSE(transport.backlog_stream.active);
+  TEST_ASSERT_TRUE(transport.backlog_stream.connecting);
+  TEST_ASSERT_EQUAL_UINT32(0, transport.backlog_stream.client.connect_calls.size());
+  vibesensor::runtime::service_backlog_stream(transport, queue_state, status);
+  TEST_ASSERT_FALSE(transport.backlog_stream.active);
+  TEST_ASSERT_EQUAL_UINT32(1, freertos_test::run_created_tasks());
+
+  vibesensor::runtime::service_backlog_stream(transport, queue_state, status);
+  TEST_ASSERT_TRUE(transport.backlog_stream.active);
+  TEST_ASSERT_FALSE(transport.backlog_stream.connecting);
+  TEST_ASSERT_EQUAL_UINT32(1, transport.backlog_stream.client.connect_calls.size());
+  TEST_ASSERT_EQUAL_UINT16(9002, transport.backlog_stream.client.connect_calls[0].port);
+  TEST_ASSERT_TRUE(transport.backlog_stream.client.no_delay);
+  TEST_ASSERT_EQUAL_UINT32(kBacklog, transport.backlog_stream.live_start_seq);
+
+  size_t stream_offset = 0;
+  std::vector<uint32_t> records =
+      take_stream_records(transport.backlog_stream.client.written, &stream_offset);
+  TEST_ASSERT_EQUAL_UINT32(vibesensor::runtime::kBacklogStreamRecordsPerLoop, records.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT32(i, records[i]);
+  }
+
+  // The window caps records in flight until the server acknowledges.
+  for (int loop = 0; loop < 4; ++loop) {
+    vibesensor::runtime::service_backlog_stream(transport, queue_state, status);
+  }
+  records = take_stream_records(transport.backlog_stream.client.written, &stream_offset);
+  TEST_ASSERT_EQUAL_UINT32(
+      vibesensor::runtime::kBacklogStreamWindowFrames -
+          vibesensor::runtime::kBacklogStreamRecordsPerLoop,
+      records.size());
+
+  // A live frame goes over UDP even though the backlog is still queued ahead
+  // of it, and its DATA_ACK releases nothing from the backlog.
+  append_full_frame(queue_state, status, 500);
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(1, transport.data_udp.sent_packets.size());
+  TEST_ASSERT_EQUAL_UINT32(
+      kBacklog, read_u32_le_at(transport.data_udp.sent_packets[0].payload.data() + kDataSeqOffset));
+  queue_data_ack(transport, kBacklog, false);
+  vibesensor::runtime::service_data_rx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(kBacklog + 1U, vibesensor::runtime::frame_queue_size(queue_state));
+
+  // The server acknowledges every record in-stream; once the backlog is gone
+  // the stream closes and the already-acknowledged live frame is not resent.
+  uint32_t last_sent = vibesensor::runtime::kBacklogStreamWindowFrames - 1U;
+  for (int loop = 0; loop < 64 && transport.backlog_stream.active; ++loop) {
+    queue_data_ack(transport, last_sent, true);
+    vibesensor::runtime::service_backlog_stream(transport, queue_state, status);
+    records = take_stream_records(transport.backlog_stream.client.written, &stream_offset);
+    if (!records.empty()) {
+      last_sent = records.back();
+    }
+  }
+  TEST_ASSERT_FALSE(transport.backlog_stream.active);
+  TEST_ASSERT_EQUAL_INT(1, transport.backlog_stream.client.stop_count);
+  TEST_ASSERT_EQUAL_UINT32(kBacklog, status.backlog_stream_frames);
+  TEST_ASSERT_EQUAL_UINT32(0, status.backlog_stream_fallbacks);
+
+  arduino_test::advance_millis(vibesensor::runtime::kDataRetransmitIntervalMs);
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(1, transport.data_udp.sent_packets.size());
+  TEST_ASSERT_EQUAL_UINT32(0, vibesensor::runtime::frame_queue_size(queue_state));
+}
+
+void test_stream_failures_fall_back_to_udp_and_retry_later() {
+  constexpr size_t kBacklog = vibesensor::runtime::kBacklogStreamThresholdFrames;
+  alignas(DataFrame) static uint8_t ring[(kBacklog + 4) *
+                                         vibesensor::runtime::kFrameRecordMaxBytes];
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
+  RuntimeStatus status{};
+  static TransportState transport;
+  transport = TransportState();
+  init_transport(transport);
+  arduino_test::set_millis(1000);
+  for (size_t i = 0; i < kBacklog; ++i) {
+    append_full_frame(queue_state, status, static_cast<int16_t>(i));
+  }
+
+  // No listener: UDP keeps the front, and the node waits before retrying.
+  transport.backlog_stream.client.setConnectResults({0});
+  vibesensor::runtime::service_backlog_stream(transport, queue_state, status);
+  freertos_test::run_created_tasks();
+  vibesensor::runtime::service_backlog_stream(transport, queue_state, status);
+  TEST_ASSERT_FALSE(transport.backlog_stream.active);
+  TEST_ASSERT_FALSE(transport.backlog_stream.connecting);
+  TEST_ASSERT_EQUAL_UINT32(1, status.backlog_stream_fallbacks);
+  TEST_ASSERT_EQUAL_UINT8(16, status.last_error_code);
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(
+      0, read_u32_le_at(transport.data_udp.sent_packets[0].payload.data() + kDataSeqOffset));
+  arduino_test::advance_millis(vibesensor::runtime::kBacklogStreamRetryIntervalMs - 1U);
+  vibesensor::runtime::service_backlog_stream(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(0, freertos_test::run_created_tasks());
+  TEST_ASSERT_EQUAL_UINT32(1, transport.backlog_stream.client.connect_calls.size());
+
+  // The retry connects, but the connection stalls mid-record.
+  arduino_test::advance_millis(1);
+  transport.backlog_stream.client.write_limit = 10;
+  vibesensor::runtime::service_backlog_stream(transport, queue_state, status);
+  freertos_test::run_created_tasks();
+  vibesensor::runtime::service_backlog_stream(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(2, transport.backlog_stream.client.connect_calls.size());
+  TEST_ASSERT_FALSE(transport.backlog_stream.active);
+  TEST_ASSERT_EQUAL_UINT32(1, status.backlog_stream_opens);
+  TEST_ASSERT_EQUAL_UINT32(2, status.backlog_stream_fallbacks);
+  TEST_ASSERT_EQUAL_UINT8(17, status.last_error_code);
+  TEST_ASSERT_EQUAL_UINT32(kBacklog, vibesensor::runtime::frame_queue_size(queue_state));
+}
+
+void test_stream_replay_throughput_and_live_latency_after_outage() {
+  const OutageReplayResult udp = run_outage_replay(false);
+  const OutageReplayResult stream = run_outage_replay(true);
+
+  printf("outage backlog=%u frames rtt=20ms udp={replayed:%u in %ums live:%u p50:%ums max:%ums} "
+         "stream={replayed:%u in %ums live:%u p50:%ums max:%ums}\n",
+         static_cast<unsigned>(udp.backlog_frames),
+         static_cast<unsigned>(udp.backlog_delivered),
+         static_cast<unsigned>(udp.replay_ms),
+         static_cast<unsigned>(udp.live_frames),
+         static_cast<unsigned>(udp.live_latency_p50_ms),
+         static_cast<unsigned>(udp.live_latency_max_ms),
+         static_cast<unsigned>(stream.backlog_delivered),
+         static_cast<unsigned>(stream.replay_ms),
+         static_cast<unsigned>(stream.live_frames),
+         static_cast<unsigned>(stream.live_latency_p50_ms),
+         static_cast<unsigned>(stream.live_latency_max_ms));
+
+  // UDP only replays what is younger than the stale-frame limit; the stream
+  // replays the whole backlog without holding back live frames.
+  TEST_ASSERT_TRUE(udp.backlog_delivered * 4U < udp.backlog_frames);
+  TEST_ASSERT_EQUAL_UINT32(stream.backlog_frames, stream.backlog_delivered);
+  TEST_ASSERT_EQUAL_UINT32(udp.live_frames, stream.live_frames);
+  TEST_ASSERT_TRUE(stream.live_latency_max_ms <= udp.live_latency_max_ms + 20U);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_stream_replays_backlog_while_live_frames_stay_on_udp);
+  RUN_TEST(test_stream_failures_fall_back_to_udp_and_retry_later);
+  RUN_TEST(test_stream_replay_throughput_and_live_latency_after_outage);
+  return UNITY_END();
+}
@@ -0,0 +1,138 @@
+#include <unity.h>
+
+#include "../../src/runtime_frame_handoff.cpp"
+
+namespace {
+
+using vibesensor::runtime::CommittedFrame;
+using vibesensor::runtime::FrameHandoffState;
+using vibesensor::runtime::PendingSample;
+using vibesensor::runtime::kFrameSamples;
+
+PendingSample make_sample(uint64_t due_us, int16_t base) {
+  PendingSample sample{};
+  sample.due_us = due_us;
+  sample.x = base;
+  sample.y = static_cast<int16_t>(base + 1);
+  sample.z = static_cast<int16_t>(base + 2);
+  return sample;
+}
+
+// Stages one full frame starting at first_due_us and commits it.
+void publish_frame(FrameHandoffState& state, uint64_t first_due_us, int64_t clock_offset_us) {
+  for (uint16_t i = 0; i < kFrameSamples; ++i) {
+    TEST_ASSERT_TRUE(vibesensor::runtime::stage_frame_sample(
+        state, make_sample(first_due_us + i, static_cast<int16_t>(i))));
+  }
+  TEST_ASSERT_TRUE(vibesensor::runtime::staged_frame_complete(state));
+  vibesensor::runtime::commit_staged_frame(state, clock_offset_us);
+}
+
+void test_frame_handoff_only_exposes_committed_frames() {
+  CommittedFrame storage[2] = {};
+  FrameHandoffState state{};
+  vibesensor::runtime::initialize_frame_handoff(state, storage, 2);
+
+  for (uint16_t i = 0; i + 1U < kFrameSamples; ++i) {
+    TEST_ASSERT_TRUE(vibesensor::runtime::stage_frame_sample(state, make_sample(100 + i, 7)));
+  }
+  TEST_ASSERT_FALSE(vibesensor::runtime::staged_frame_complete(state));
+  TEST_ASSERT_NULL(vibesensor::runtime::peek_committed_frame(state));
+  TEST_ASSERT_EQUAL_UINT32(0, vibesensor::runtime::frame_handoff_size(state));
+
+  TEST_ASSERT_TRUE(vibesensor::runtime::stage_frame_sample(state, make_sample(999, 40)));
+  vibesensor::runtime::commit_staged_frame(state, -50);
+
+  const CommittedFrame* frame = vibesensor::runtime::peek_committed_frame(state);
+  TEST_ASSERT_NOT_NULL(frame);
+  TEST_ASSERT_EQUAL_UINT64(50, frame->t0_us);
+  TEST_ASSERT_EQUAL_UINT16(kFrameSamples, frame->sample_count);
+  const size_t last = static_cast<size_t>(kFrameSamples - 1U) * 3U;
+  TEST_ASSERT_EQUAL_INT16(40, frame->xyz[last + 0]);
+  TEST_ASSERT_EQUAL_INT16(42, frame->xyz[last + 2]);
+}
+
+void test_frame_handoff_preserves_fifo_order_across_wrap() {
+  CommittedFrame storage[2] = {};
+  FrameHandoffState state{};
+  vibesensor::runtime::initialize_frame_handoff(state, storage, 2);
+
+  for (uint64_t frame = 0; frame < 7; ++frame) {
+    publish_frame(state, 1000 * frame, 5);
+    const CommittedFrame* front = vibesensor::runtime::peek_committed_frame(state);
+    TEST_ASSERT_NOT_NULL(front);
+    TEST_ASSERT_EQUAL_UINT64((1000 * frame) + 5, front->t0_us);
+    vibesensor::runtime::release_committed_frame(state);
+  }
+  TEST_ASSERT_NULL(vibesensor::runtime::peek_committed_frame(state));
+  TEST_ASSERT_EQUAL_UINT64(1, state.high_watermark);
+}
+
+void test_frame_handoff_rejects_new_samples_when_full() {
+  CommittedFrame storage[2] = {};
+  FrameHandoffState state{};
+  vibesensor::runtime::initialize_frame_handoff(state, storage, 2);
+
+  publish_frame(state, 0, 0);
+  TEST_ASSERT_EQUAL_UINT32(kFrameSamples, vibesensor::runtime::frame_handoff_free_samples(state));
+  publish_frame(state, 1000, 0);
+  TEST_ASSERT_EQUAL_UINT32(0, vibesensor::runtime::frame_handoff_free_samples(state));
+  TEST_ASSERT_FALSE(vibesensor::runtime::stage_frame_sample(state, make_sample(2000, 1)));
+  TEST_ASSERT_EQUAL_UINT32(1, state.overflow_drops);
+  TEST_ASSERT_EQUAL_UINT32(2, vibesensor::runtime::frame_handoff_size(state));
+  TEST_ASSERT_EQUAL_UINT64(2, state.high_watermark);
+
+  // Releasing the oldest frame makes room; the next frame starts cleanly.
+  vibesensor::runtime::release_committed_frame(state);
+  publish_frame(state, 3000, 0);
+  vibesensor::runtime::release_committed_frame(state);
+  TEST_ASSERT_EQUAL_UINT64(3000, vibesensor::runtime::peek_committed_frame(state)->t0_us);
+}
+
+void test_frame_handoff_read_ahead_spans_frames_and_stages_in_place() {
+  CommittedFrame storage[2] = {};
+  FrameHandoffState state{};
+  vibesensor::runtime::initialize_frame_handoff(state, storage, 2);
+
+  // Read ahead to the last sample of the first frame: the span stops at the
+  // frame end and the next reservation lands at the start of the second slot.
+  size_t contiguous = 0;
+  int16_t* tail_of_first =
+      vibesensor::runtime::reserve_frame_samples(state, kFrameSamples - 1U, &contiguous);
+  TEST_ASSERT_EQUAL_PTR(storage[0].xyz + ((kFrameSamples - 1U) * 3U), tail_of_first);
+  TEST_ASSERT_EQUAL_UINT32(1, contiguous);
+  tail_of_first[0] = 11;
+  int16_t* head_of_second =
+      vibesensor::runtime::reserve_frame_samples(state, kFrameSamples, &contiguous);
+  TEST_ASSERT_EQUAL_PTR(storage[1].xyz, head_of_second);
+  TEST_ASSERT_EQUAL_UINT32(kFrameSamples, contiguous);
+  head_of_second[0] = 22;
+
+  for (uint16_t i = 0; i < kFrameSamples; ++i) {
+    TEST_ASSERT_TRUE(vibesensor::runtime::stage_reserved_frame_sample(state, 500 + i));
+  }
+  TEST_ASSERT_EQUAL_INT16(11, vibesensor::runtime::last_staged_frame_sample(state)[0]);
+  vibesensor::runtime::commit_staged_frame(state, 0);
+  TEST_ASSERT_TRUE(vibesensor::runtime::stage_reserved_frame_sample(state, 900));
+  TEST_ASSERT_EQUAL_INT16(22, vibesensor::runtime::last_staged_frame_sample(state)[0]);
+  TEST_ASSERT_EQUAL_UINT64(500, vibesensor::runtime::peek_committed_frame(state)->t0_us);
+
+  // The slot after the staged one is the committed frame the loop still owns.
+  TEST_ASSERT_NULL(vibesensor::runtime::reserve_frame_samples(state, kFrameSamples, &contiguous));
+  TEST_ASSERT_EQUAL_UINT32(0, contiguous);
+  vibesensor::runtime::release_committed_frame(state);
+  TEST_ASSERT_EQUAL_PTR(storage[0].xyz,
+                        vibesensor::runtime::reserve_frame_samples(
+                            state, kFrameSamples - 1U, &contiguous));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_handoff_only_exposes_committed_frames);
+  RUN_TEST(test_frame_handoff_preserves_fifo_order_across_wrap);
+  RUN_TEST(test_frame_handoff_rejects_new_samples_when_full);
+  RUN_TEST(test_frame_handoff_read_ahead_spans_frames_and_stages_in_place);
+  return UNITY_END();
+}
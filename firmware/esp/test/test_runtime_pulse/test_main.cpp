@@ -0,0 +1,170 @@
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#define VIBESENSOR_PULSE_INPUT_PIN 33
+#define VIBESENSOR_PULSE_MIN_EDGE_INTERVAL_US 100
+
+#include "../native_support/pulse_source.h"
+
+#include "../../src/runtime_pulse.cpp"
+
+namespace {
+
+using vibesensor::runtime::PulseInputState;
+using vibesensor::runtime::PulseReading;
+
+// 200-sample frames at 800 Hz.
+constexpr uint64_t kFrameUs = 250000ULL;
+
+PulseReading reading_with_edge(uint32_t edge_count, uint64_t last_edge_us) {
+  PulseReading reading;
+  reading.edge_count = edge_count;
+  reading.last_edge_us = last_edge_us;
+  reading.has_edge = true;
+  return reading;
+}
+
+// Rate the server derives from two consecutive frames: new edges over the time
+// between their last edges, with both last edges rebuilt from the frame t0.
+double rate_between(const vibesensor::DataPulseChannel& previous,
+                    uint64_t previous_t0_us,
+                    const vibesensor::DataPulseChannel& current,
+                    uint64_t current_t0_us) {
+  const uint16_t new_edges = static_cast<uint16_t>(current.edge_count - previous.edge_count);
+  const int64_t previous_edge_us =
+      static_cast<int64_t>(previous_t0_us) + previous.last_edge_offset_us;
+  const int64_t current_edge_us = static_cast<int64_t>(current_t0_us) + current.last_edge_offset_us;
+  if (new_edges == 0 || current_edge_us <= previous_edge_us) {
+    return 0.0;
+  }
+  return static_cast<double>(new_edges) * 1.0e6 /
+         static_cast<double>(current_edge_us - previous_edge_us);
+}
+
+}  // namespace
+
+void setUp() {
+  arduino_test::reset_time();
+  arduino_test::reset_pin_interrupt();
+}
+
+void test_begin_pulse_input_attaches_rising_edge_interrupt_with_pullup() {
+  PulseInputState state;
+  state.edge_count = 7;
+
+  TEST_ASSERT_TRUE(vibesensor::runtime::begin_pulse_input(state));
+
+  const arduino_test::PinInterrupt& interrupt = arduino_test::pin_interrupt_ref();
+  TEST_ASSERT_EQUAL_INT(33, interrupt.pin);
+  TEST_ASSERT_EQUAL_INT(INPUT_PULLUP, interrupt.pin_mode);
+  TEST_ASSERT_EQUAL_INT(RISING, interrupt.mode);
+  TEST_ASSERT_EQUAL_UINT32(0, state.edge_count);
+
+  arduino_test::set_esp_time(1234);
+  TEST_ASSERT_TRUE(arduino_test::fire_pin_interrupt());
+  const PulseReading reading = vibesensor::runtime::read_pulse_input(state);
+  TEST_ASSERT_EQUAL_UINT32(1, reading.edge_count);
+  TEST_ASSERT_EQUAL_UINT64(1234, reading.last_edge_us);
+  TEST_ASSERT_TRUE(reading.has_edge);
+}
+
+void test_bounce_within_min_interval_is_rejected_not_counted() {
+  PulseInputState state;
+  TEST_ASSERT_TRUE(vibesensor::runtime::begin_pulse_input(state));
+  arduino_test::PulseSource source;
+  source.bounce_us = 40;
+  source.start(10000, 250.0);
+
+  source.advance_to(10000 + 1002000);
+
+  const PulseReading reading = vibesensor::runtime::read_pulse_input(state);
+  TEST_ASSERT_EQUAL_UINT32(250, source.fired_edges);
+  TEST_ASSERT_EQUAL_UINT32(250, reading.edge_count);
+  TEST_ASSERT_EQUAL_UINT32(250, reading.rejected_edges);
+  TEST_ASSERT_EQUAL_UINT64(10000 + 1000000, reading.last_edge_us);
+}
+
+void test_frame_pulse_channel_reports_last_edge_relative_to_t0() {
+  vibesensor::DataPulseChannel channel =
+      vibesensor::runtime::frame_pulse_channel(reading_with_edge(70000, 5000250), 5000000);
+  TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(70000), channel.edge_count);
+  TEST_ASSERT_EQUAL_INT32(250, channel.last_edge_offset_us);
+
+  // A slow wheel's last edge can predate the frame by several frames.
+  channel = vibesensor::runtime::frame_pulse_channel(reading_with_edge(3, 1000000), 5000000);
+  TEST_ASSERT_EQUAL_INT32(-4000000, channel.last_edge_offset_us);
+}
+
+void test_frame_pulse_channel_without_usable_edge_reports_no_edge() {
+  vibesensor::DataPulseChannel channel =
+      vibesensor::runtime::frame_pulse_channel(PulseReading(), 5000000);
+  TEST_ASSERT_EQUAL_UINT16(0, channel.edge_count);
+  TEST_ASSERT_EQUAL_INT32(vibesensor::kDataPulseNoEdge, channel.last_edge_offset_us);
+
+  // Out of int32 range after ~35 minutes without an edge.
+  channel = vibesensor::runtime::frame_pulse_channel(reading_with_edge(9, 1000),
+                                                     3000000000ULL);
+  TEST_ASSERT_EQUAL_UINT16(9, channel.edge_count);
+  TEST_ASSERT_EQUAL_INT32(vibesensor::kDataPulseNoEdge, channel.last_edge_offset_us);
+}
+
+void test_edge_timed_rate_tracks_an_acceleration_ramp() {
+  PulseInputState state;
+  TEST_ASSERT_TRUE(vibesensor::runtime::begin_pulse_input(state));
+  arduino_test::PulseSource source;
+  // A 48-tooth ring on a ~2 m tyre, from under 1 km/h to ~60 km/h in 8 s.
+  const uint64_t start_us = 2000000;
+  source.start(start_us, 6.0, 50.0);
+
+  vibesensor::DataPulseChannel previous;
+  uint64_t previous_t0_us = 0;
+  bool have_previous = false;
+  double worst_edge_error = 0.0;
+  double worst_count_error = 0.0;
+  size_t frames = 0;
+  for (uint64_t t0_us = start_us; t0_us + kFrameUs <= start_us + 8000000ULL; t0_us += kFrameUs) {
+    const uint32_t count_before = vibesensor::runtime::read_pulse_input(state).edge_count;
+    source.advance_to(t0_us + kFrameUs);
+    const PulseReading reading = vibesensor::runtime::read_pulse_input(state);
+    const vibesensor::DataPulseChannel channel =
+        vibesensor::runtime::frame_pulse_channel(reading, t0_us);
+
+    if (have_previous && channel.edge_count != previous.edge_count) {
+      const uint64_t previous_edge_us = static_cast<uint64_t>(
+          static_cast<int64_t>(previous_t0_us) + previous.last_edge_offset_us);
+      // Over a linear ramp the mean rate between two edges is the rate at
+      // their midpoint.
+      const double truth = source.rate_at((previous_edge_us + reading.last_edge_us) / 2U);
+      const double edge_rate = rate_between(previous, previous_t0_us, channel, t0_us);
+      const double count_rate =
+          static_cast<double>(reading.edge_count - count_before) * 1.0e6 / kFrameUs;
+      const double frame_truth = source.rate_at(t0_us + kFrameUs / 2U);
+      worst_edge_error = fmax(worst_edge_error, fabs(edge_rate - truth) / truth);
+      worst_count_error = fmax(worst_count_error, fabs(count_rate - frame_truth) / frame_truth);
+      frames++;
+    }
+    previous = channel;
+    previous_t0_us = t0_us;
+    have_previous = true;
+  }
+
+  printf("pulse_ramp frames=%u edge_timed_max_error=%.4f%% per_frame_count_max_error=%.2f%%\n",
+         static_cast<unsigned>(frames),
+         worst_edge_error * 100.0,
+         worst_count_error * 100.0);
+  TEST_ASSERT_TRUE(frames > 25);
+  TEST_ASSERT_TRUE(worst_edge_error < 0.001);
+  TEST_ASSERT_TRUE(worst_count_error > worst_edge_error * 10.0);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_begin_pulse_input_attaches_rising_edge_interrupt_with_pullup);
+  RUN_TEST(test_bounce_within_min_interval_is_rejected_not_counted);
+  RUN_TEST(test_frame_pulse_channel_reports_last_edge_relative_to_t0);
+  RUN_TEST(test_frame_pulse_channel_without_usable_edge_reports_no_edge);
+  RUN_TEST(test_edge_timed_rate_tracks_an_acceleration_ramp);
+  return UNITY_END();
+}
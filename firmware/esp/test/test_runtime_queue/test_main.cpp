@@ -1,17 +1,21 @@
 #include <unity.h>
 
+#include "../../src/runtime_frame_codec.cpp"
 #include "../../src/runtime_queue.cpp"
 
+#include "../native_support/ramp_frames.h"
+
 namespace {
 
 using vibesensor::runtime::DataFrame;
 using vibesensor::runtime::FrameQueueState;
 using vibesensor::runtime::RuntimeStatus;
+using vibesensor::test_support::ramp_record_bytes;
 
-FrameQueueState make_queue_state(DataFrame* frames, size_t capacity) {
+FrameQueueState make_queue_state(uint8_t* ring, size_t ring_bytes) {
   FrameQueueState state{};
-  state.queue = frames;
-  state.capacity = capacity;
+  state.ring = ring;
+  state.ring_bytes = ring_bytes;
   return state;
 }
 
@@ -20,10 +24,13 @@ void expect_xyz_sample(const DataFrame& frame,
                        int16_t expected_x,
                        int16_t expected_y,
                        int16_t expected_z) {
+  int16_t xyz[static_cast<size_t>(vibesensor::runtime::kFrameSamples) *
+              vibesensor::runtime::kAxesPerSample] = {};
+  TEST_ASSERT_TRUE(vibesensor::runtime::read_frame_samples(frame, xyz));
   const size_t offset = static_cast<size_t>(sample_index) * vibesensor::runtime::kAxesPerSample;
-  TEST_ASSERT_EQUAL_INT16(expected_x, frame.xyz[offset + 0]);
-  TEST_ASSERT_EQUAL_INT16(expected_y, frame.xyz[offset + 1]);
-  TEST_ASSERT_EQUAL_INT16(expected_z, frame.xyz[offset + 2]);
+  TEST_ASSERT_EQUAL_INT16(expected_x, xyz[offset + 0]);
+  TEST_ASSERT_EQUAL_INT16(expected_y, xyz[offset + 1]);
+  TEST_ASSERT_EQUAL_INT16(expected_z, xyz[offset + 2]);
 }
 
 void append_full_frame(FrameQueueState& state,
@@ -31,24 +38,39 @@ void append_full_frame(FrameQueueState& state,
                        int16_t sample_base,
                        uint64_t first_due_us,
                        int64_t clock_offset_us) {
+  int16_t xyz[static_cast<size_t>(vibesensor::runtime::kFrameSamples) *
+              vibesensor::runtime::kAxesPerSample] = {};
   for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
     const int16_t value = static_cast<int16_t>(sample_base + static_cast<int16_t>(i));
-    vibesensor::runtime::append_sample(state,
-                                       status,
-                                       value,
-                                       static_cast<int16_t>(value + 1),
-                                       static_cast<int16_t>(value + 2),
-                                       first_due_us + i,
-                                       clock_offset_us);
+    const size_t idx = static_cast<size_t>(i) * vibesensor::runtime::kAxesPerSample;
+    xyz[idx + 0] = value;
+    xyz[idx + 1] = static_cast<int16_t>(value + 1);
+    xyz[idx + 2] = static_cast<int16_t>(value + 2);
+  }
+  vibesensor::runtime::enqueue_frame(
+      state,
+      status,
+      static_cast<uint64_t>(static_cast<int64_t>(first_due_us) + clock_offset_us),
+      xyz,
+      vibesensor::runtime::kFrameSamples);
+}
+
+void fill_noise_frame(int16_t* xyz, uint16_t samples, uint32_t seed, int32_t amplitude) {
+  uint32_t state = seed;
+  for (size_t i = 0; i < static_cast<size_t>(samples) * vibesensor::runtime::kAxesPerSample;
+       ++i) {
+    state = (state * 1664525U) + 1013904223U;
+    const int32_t span = (amplitude * 2) + 1;
+    xyz[i] = static_cast<int16_t>(static_cast<int32_t>((state >> 8) % span) - amplitude);
   }
 }
 
 }  // namespace
 
-void test_append_sample_builds_frame_and_applies_clock_offset() {
-  DataFrame frames[2] = {};
+void test_enqueue_frame_encodes_samples_and_assigns_seq() {
+  alignas(DataFrame) uint8_t ring[2 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
   RuntimeStatus status{};
-  FrameQueueState state = make_queue_state(frames, 2);
+  FrameQueueState state = make_queue_state(ring, sizeof(ring));
 
   append_full_frame(state, status, 10, 1000, 50);
 
@@ -68,9 +90,9 @@ void test_append_sample_builds_frame_and_applies_clock_offset() {
 }
 
 void test_queue_overflow_drops_oldest_frame() {
-  DataFrame frames[1] = {};
+  alignas(DataFrame) uint8_t ring[vibesensor::runtime::kFrameRecordMaxBytes] = {};
   RuntimeStatus status{};
-  FrameQueueState state = make_queue_state(frames, 1);
+  FrameQueueState state = make_queue_state(ring, ramp_record_bytes());
 
   append_full_frame(state, status, 10, 1000, 0);
   append_full_frame(state, status, 500, 2000, 0);
@@ -84,9 +106,9 @@ void test_queue_overflow_drops_oldest_frame() {
 }
 
 void test_ack_data_frames_handles_wraparound_after_partial_drain() {
-  DataFrame frames[2] = {};
+  alignas(DataFrame) uint8_t ring[2 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
   RuntimeStatus status{};
-  FrameQueueState state = make_queue_state(frames, 2);
+  FrameQueueState state = make_queue_state(ring, 2 * ramp_record_bytes());
 
   append_full_frame(state, status, 0, 1000, 0);
   append_full_frame(state, status, 1000, 2000, 0);
@@ -102,10 +124,221 @@ void test_ack_data_frames_handles_wraparound_after_partial_drain() {
   TEST_ASSERT_NULL(vibesensor::runtime::peek_frame(state));
 }
 
+void test_apply_frame_receipts_releases_and_flags_frames_across_the_wrap() {
+  alignas(DataFrame) uint8_t ring[3 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  RuntimeStatus status{};
+  FrameQueueState state = make_queue_state(ring, 3 * ramp_record_bytes());
+
+  TEST_ASSERT_EQUAL_UINT32(0, vibesensor::runtime::frame_queue_oldest_seq(state));
+  append_full_frame(state, status, 0, 1000, 0);
+  append_full_frame(state, status, 1000, 2000, 0);
+  append_full_frame(state, status, 2000, 3000, 0);
+  vibesensor::runtime::ack_data_frames(state, 0);
+  append_full_frame(state, status, 3000, 4000, 0);
+  TEST_ASSERT_EQUAL_UINT32(1, vibesensor::runtime::frame_queue_oldest_seq(state));
+
+  // Seq 1 is contiguous; bit 0 marks seq 3, which sits past the wrap. Bits
+  // beyond the queued frames are ignored.
+  TEST_ASSERT_EQUAL_UINT32(
+      2, vibesensor::runtime::apply_frame_receipts(state, 1, 0x80000001UL));
+  TEST_ASSERT_EQUAL_UINT32(2, state.size);
+  TEST_ASSERT_EQUAL_UINT32(2, vibesensor::runtime::frame_queue_oldest_seq(state));
+  TEST_ASSERT_FALSE(vibesensor::runtime::peek_frame(state)->settled);
+
+  // A repeated report does not count seq 3 twice.
+  TEST_ASSERT_EQUAL_UINT32(0, vibesensor::runtime::apply_frame_receipts(state, 1, 0x1));
+  vibesensor::runtime::ack_data_frames(state, 2);
+  const DataFrame* frame = vibesensor::runtime::peek_frame(state);
+  TEST_ASSERT_NOT_NULL(frame);
+  TEST_ASSERT_EQUAL_UINT32(3, frame->seq);
+  TEST_ASSERT_TRUE(frame->settled);
+
+  vibesensor::runtime::ack_data_frames(state, 3);
+  TEST_ASSERT_EQUAL_UINT32(4, vibesensor::runtime::frame_queue_oldest_seq(state));
+}
+
+void test_find_frame_from_and_settle_frames_walk_across_the_wrap() {
+  alignas(DataFrame) uint8_t ring[3 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  RuntimeStatus status{};
+  FrameQueueState state = make_queue_state(ring, 3 * ramp_record_bytes());
+
+  TEST_ASSERT_NULL(vibesensor::runtime::find_frame_from(state, 0));
+  append_full_frame(state, status, 0, 1000, 0);
+  append_full_frame(state, status, 1000, 2000, 0);
+  append_full_frame(state, status, 2000, 3000, 0);
+  vibesensor::runtime::ack_data_frames(state, 0);
+  append_full_frame(state, status, 3000, 4000, 0);
+
+  // Seq 0 is gone, so asking for it yields the front; seq 3 sits past the wrap.
+  TEST_ASSERT_EQUAL_UINT32(1, vibesensor::runtime::find_frame_from(state, 0)->seq);
+  TEST_ASSERT_EQUAL_UINT32(3, vibesensor::runtime::find_frame_from(state, 3)->seq);
+  TEST_ASSERT_NULL(vibesensor::runtime::find_frame_from(state, 4));
+
+  vibesensor::runtime::settle_frames(state, 2, 4);
+  TEST_ASSERT_FALSE(vibesensor::runtime::find_frame_from(state, 1)->settled);
+  TEST_ASSERT_TRUE(vibesensor::runtime::find_frame_from(state, 2)->settled);
+  TEST_ASSERT_TRUE(vibesensor::runtime::find_frame_from(state, 3)->settled);
+}
+
+void test_frame_codec_round_trips_packed_and_raw_frames() {
+  int16_t xyz[static_cast<size_t>(vibesensor::runtime::kFrameSamples) *
+              vibesensor::runtime::kAxesPerSample] = {};
+  int16_t decoded[sizeof(xyz) / sizeof(xyz[0])] = {};
+  uint8_t payload[vibesensor::runtime::kFrameRawPayloadBytes] = {};
+
+  // Low-amplitude noise packs well below raw size.
+  fill_noise_frame(xyz, vibesensor::runtime::kFrameSamples, 7, 20);
+  vibesensor::runtime::FrameEncoding encoding =
+      vibesensor::runtime::plan_frame_encoding(xyz, vibesensor::runtime::kFrameSamples);
+  TEST_ASSERT_FALSE(encoding.raw);
+  TEST_ASSERT_TRUE(encoding.payload_bytes < vibesensor::runtime::kFrameRawPayloadBytes / 2U);
+  vibesensor::runtime::encode_frame(xyz, vibesensor::runtime::kFrameSamples, encoding, payload);
+  TEST_ASSERT_TRUE(vibesensor::runtime::decode_frame(
+      payload, vibesensor::runtime::kFrameSamples, encoding, decoded));
+  TEST_ASSERT_EQUAL_INT16_ARRAY(xyz, decoded, sizeof(xyz) / sizeof(xyz[0]));
+
+  // Full-scale swings need 17-bit deltas, so the frame stays raw.
+  for (size_t i = 0; i < sizeof(xyz) / sizeof(xyz[0]); ++i) {
+    xyz[i] = (i / vibesensor::runtime::kAxesPerSample) % 2U == 0U ? INT16_MIN : INT16_MAX;
+  }
+  encoding = vibesensor::runtime::plan_frame_encoding(xyz, vibesensor::runtime::kFrameSamples);
+  TEST_ASSERT_TRUE(encoding.raw);
+  TEST_ASSERT_EQUAL_UINT16(vibesensor::runtime::kFrameRawPayloadBytes, encoding.payload_bytes);
+  vibesensor::runtime::encode_frame(xyz, vibesensor::runtime::kFrameSamples, encoding, payload);
+  TEST_ASSERT_TRUE(vibesensor::runtime::decode_frame(
+      payload, vibesensor::runtime::kFrameSamples, encoding, decoded));
+  TEST_ASSERT_EQUAL_INT16_ARRAY(xyz, decoded, sizeof(xyz) / sizeof(xyz[0]));
+
+  // A constant axis costs no delta bits at all.
+  for (size_t i = 0; i < sizeof(xyz) / sizeof(xyz[0]); ++i) {
+    xyz[i] = i % vibesensor::runtime::kAxesPerSample == 2U ? 256 : static_cast<int16_t>(i % 5U);
+  }
+  encoding = vibesensor::runtime::plan_frame_encoding(xyz, vibesensor::runtime::kFrameSamples);
+  TEST_ASSERT_EQUAL_UINT8(0, encoding.delta_bits[2]);
+  vibesensor::runtime::encode_frame(xyz, vibesensor::runtime::kFrameSamples, encoding, payload);
+  TEST_ASSERT_TRUE(vibesensor::runtime::decode_frame(
+      payload, vibesensor::runtime::kFrameSamples, encoding, decoded));
+  TEST_ASSERT_EQUAL_INT16_ARRAY(xyz, decoded, sizeof(xyz) / sizeof(xyz[0]));
+}
+
+void test_frame_codec_stores_samples_at_the_range_bit_width() {
+  int16_t xyz[static_cast<size_t>(vibesensor::runtime::kFrameSamples) *
+              vibesensor::runtime::kAxesPerSample] = {};
+  int16_t decoded[sizeof(xyz) / sizeof(xyz[0])] = {};
+  uint8_t payload[vibesensor::runtime::kFrameRawPayloadBytes] = {};
+  const size_t values = sizeof(xyz) / sizeof(xyz[0]);
+
+  // Rail-to-rail +/-2 g noise: 11-bit deltas barely beat 16-bit raw, but 10-bit
+  // raw beats both.
+  fill_noise_frame(xyz, vibesensor::runtime::kFrameSamples, 11, 511);
+  const vibesensor::runtime::FrameEncoding wide =
+      vibesensor::runtime::plan_frame_encoding(xyz, vibesensor::runtime::kFrameSamples);
+  vibesensor::runtime::FrameEncoding encoding =
+      vibesensor::runtime::plan_frame_encoding(xyz, vibesensor::runtime::kFrameSamples, 10);
+  TEST_ASSERT_FALSE(wide.raw);
+  TEST_ASSERT_TRUE(encoding.raw);
+  TEST_ASSERT_EQUAL_UINT8(10, encoding.sample_bits);
+  TEST_ASSERT_EQUAL_UINT16((values * 10U) / 8U, encoding.payload_bytes);
+  TEST_ASSERT_TRUE(encoding.payload_bytes < wide.payload_bytes);
+  vibesensor::runtime::encode_frame(xyz, vibesensor::runtime::kFrameSamples, encoding, payload);
+  TEST_ASSERT_TRUE(vibesensor::runtime::decode_frame(
+      payload, vibesensor::runtime::kFrameSamples, encoding, decoded));
+  TEST_ASSERT_EQUAL_INT16_ARRAY(xyz, decoded, values);
+
+  // Packed frames store their first samples at the narrow width too.
+  fill_noise_frame(xyz, vibesensor::runtime::kFrameSamples, 12, 20);
+  xyz[0] = -512;
+  xyz[1] = 511;
+  for (size_t i = 3; i < values; i += 3) {
+    xyz[i] = static_cast<int16_t>(-500 + (xyz[i] / 4));
+  }
+  encoding = vibesensor::runtime::plan_frame_encoding(xyz, vibesensor::runtime::kFrameSamples, 10);
+  TEST_ASSERT_FALSE(encoding.raw);
+  TEST_ASSERT_EQUAL_UINT8(10, encoding.sample_bits);
+  vibesensor::runtime::encode_frame(xyz, vibesensor::runtime::kFrameSamples, encoding, payload);
+  TEST_ASSERT_TRUE(vibesensor::runtime::decode_frame(
+      payload, vibesensor::runtime::kFrameSamples, encoding, decoded));
+  TEST_ASSERT_EQUAL_INT16_ARRAY(xyz, decoded, values);
+
+  // A sample outside the hinted width falls back to 16 bits instead of
+  // truncating.
+  xyz[values - 1U] = 512;
+  encoding = vibesensor::runtime::plan_frame_encoding(xyz, vibesensor::runtime::kFrameSamples, 10);
+  TEST_ASSERT_EQUAL_UINT8(vibesensor::runtime::kFrameSampleBitsMax, encoding.sample_bits);
+  vibesensor::runtime::encode_frame(xyz, vibesensor::runtime::kFrameSamples, encoding, payload);
+  TEST_ASSERT_TRUE(vibesensor::runtime::decode_frame(
+      payload, vibesensor::runtime::kFrameSamples, encoding, decoded));
+  TEST_ASSERT_EQUAL_INT16_ARRAY(xyz, decoded, values);
+}
+
+void test_byte_ring_holds_more_compressible_frames_than_raw_slots() {
+  alignas(DataFrame) uint8_t ring[4 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  RuntimeStatus status{};
+  FrameQueueState state = make_queue_state(ring, sizeof(ring));
+
+  for (int16_t frame = 0; frame < 12; ++frame) {
+    append_full_frame(state, status, static_cast<int16_t>(frame * 100), 1000U * frame, 0);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(12, vibesensor::runtime::frame_queue_size(state));
+  TEST_ASSERT_EQUAL_UINT32(0, status.queue_overflow_drops);
+  TEST_ASSERT_EQUAL_UINT32(12 * ramp_record_bytes(), vibesensor::runtime::frame_queue_used_bytes(state));
+}
+
+void test_byte_ring_keeps_fifo_order_across_mixed_sizes_and_wraps() {
+  alignas(DataFrame) uint8_t ring[3 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  RuntimeStatus status{};
+  FrameQueueState state = make_queue_state(ring, sizeof(ring));
+  int16_t xyz[static_cast<size_t>(vibesensor::runtime::kFrameSamples) *
+              vibesensor::runtime::kAxesPerSample] = {};
+  int16_t decoded[sizeof(xyz) / sizeof(xyz[0])] = {};
+
+  uint32_t expected_front = 0;
+  for (uint32_t frame = 0; frame < 200; ++frame) {
+    // Mix quiet, busy and full-scale (raw) frames so record sizes vary.
+    const int32_t amplitude = frame % 3U == 0U ? 8 : (frame % 3U == 1U ? 900 : 32767);
+    fill_noise_frame(xyz, vibesensor::runtime::kFrameSamples, frame + 1U, amplitude);
+    vibesensor::runtime::enqueue_frame(
+        state, status, 1000ULL * frame, xyz, vibesensor::runtime::kFrameSamples);
+    TEST_ASSERT_TRUE(vibesensor::runtime::frame_queue_used_bytes(state) <= sizeof(ring));
+
+    // The newest frame always survives and decodes intact.
+    const DataFrame* front = vibesensor::runtime::peek_frame(state);
+    TEST_ASSERT_NOT_NULL(front);
+    TEST_ASSERT_TRUE(front->seq >= expected_front);
+    expected_front = front->seq;
+    if (frame % 4U == 3U) {
+      vibesensor::runtime::ack_data_frames(state, front->seq);
+    }
+  }
+  TEST_ASSERT_TRUE(status.queue_overflow_drops > 0);
+
+  // Drain: seqs are strictly increasing and the payloads still decode.
+  uint32_t previous_seq = 0;
+  bool first = true;
+  while (DataFrame* frame = vibesensor::runtime::peek_frame(state)) {
+    TEST_ASSERT_TRUE(first || frame->seq == previous_seq + 1U);
+    TEST_ASSERT_TRUE(vibesensor::runtime::read_frame_samples(*frame, decoded));
+    previous_seq = frame->seq;
+    first = false;
+    vibesensor::runtime::drop_front_frame(state);
+  }
+  TEST_ASSERT_EQUAL_UINT32(199, previous_seq);
+  fill_noise_frame(xyz, vibesensor::runtime::kFrameSamples, 200, 900);
+  TEST_ASSERT_EQUAL_INT16_ARRAY(xyz, decoded, sizeof(xyz) / sizeof(xyz[0]));
+  TEST_ASSERT_EQUAL_UINT32(0, vibesensor::runtime::frame_queue_used_bytes(state));
+}
+
 int main(int argc, char** argv) {
   UNITY_BEGIN();
-  RUN_TEST(test_append_sample_builds_frame_and_applies_clock_offset);
+  RUN_TEST(test_enqueue_frame_encodes_samples_and_assigns_seq);
   RUN_TEST(test_queue_overflow_drops_oldest_frame);
   RUN_TEST(test_ack_data_frames_handles_wraparound_after_partial_drain);
+  RUN_TEST(test_apply_frame_receipts_releases_and_flags_frames_across_the_wrap);
+  RUN_TEST(test_find_frame_from_and_settle_frames_walk_across_the_wrap);
+  RUN_TEST(test_frame_codec_round_trips_packed_and_raw_frames);
+  RUN_TEST(test_frame_codec_stores_samples_at_the_range_bit_width);
+  RUN_TEST(test_byte_ring_holds_more_compressible_frames_than_raw_slots);
+  RUN_TEST(test_byte_ring_keeps_fifo_order_across_mixed_sizes_and_wraps);
   return UNITY_END();
 }
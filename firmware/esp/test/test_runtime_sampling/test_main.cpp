@@ -1,9 +1,13 @@
 #include <unity.h>
 
+#include "../../src/runtime_frame_codec.cpp"
+#include "../../src/runtime_frame_handoff.cpp"
+#include "../../src/runtime_pulse.cpp"
 #include "../../src/runtime_queue.cpp"
-#include "../../src/runtime_sample_handoff.cpp"
 #include "../../src/runtime_sampling.cpp"
 
+#include "../native_support/ramp_frames.h"
+
 ADXL345::ADXL345(TwoWire& wire, uint8_t i2c_addr, int sda_pin, int scl_pin, uint8_t fifo_watermark)
     : wire_(wire),
       i2c_addr_(i2c_addr),
@@ -29,6 +33,20 @@ bool ADXL345::recover_bus(FailureKind* failure_kind) {
 
 bool ADXL345::available() const { return available_; }
 
+namespace {
+int g_set_range_calls = 0;
+uint8_t g_last_range_code = 0xFF;
+}  // namespace
+
+bool ADXL345::set_range(uint8_t range_code, FailureKind* failure_kind) {
+  if (failure_kind != nullptr) {
+    *failure_kind = FailureKind::kNone;
+  }
+  g_set_range_calls++;
+  g_last_range_code = range_code;
+  return available_;
+}
+
 size_t ADXL345::read_samples(
     int16_t*, size_t, FailureKind* failure_kind, bool* fifo_truncated) {
   if (failure_kind != nullptr) {
@@ -53,11 +71,12 @@ using vibesensor::runtime::FrameQueueState;
 using vibesensor::runtime::PendingSample;
 using vibesensor::runtime::RuntimeStatus;
 using vibesensor::runtime::SamplingState;
+using vibesensor::test_support::ramp_record_bytes;
 
-FrameQueueState make_queue_state(DataFrame* frames, size_t capacity) {
+FrameQueueState make_queue_state(uint8_t* ring, size_t ring_bytes) {
   FrameQueueState state{};
-  state.queue = frames;
-  state.capacity = capacity;
+  state.ring = ring;
+  state.ring_bytes = ring_bytes;
   return state;
 }
 
@@ -66,38 +85,63 @@ void expect_xyz_sample(const DataFrame& frame,
                        int16_t expected_x,
                        int16_t expected_y,
                        int16_t expected_z) {
+  int16_t xyz[static_cast<size_t>(vibesensor::runtime::kFrameSamples) *
+              vibesensor::runtime::kAxesPerSample] = {};
+  TEST_ASSERT_TRUE(vibesensor::runtime::read_frame_samples(frame, xyz));
   const size_t offset = static_cast<size_t>(sample_index) * vibesensor::runtime::kAxesPerSample;
-  TEST_ASSERT_EQUAL_INT16(expected_x, frame.xyz[offset + 0]);
-  TEST_ASSERT_EQUAL_INT16(expected_y, frame.xyz[offset + 1]);
-  TEST_ASSERT_EQUAL_INT16(expected_z, frame.xyz[offset + 2]);
+  TEST_ASSERT_EQUAL_INT16(expected_x, xyz[offset + 0]);
+  TEST_ASSERT_EQUAL_INT16(expected_y, xyz[offset + 1]);
+  TEST_ASSERT_EQUAL_INT16(expected_z, xyz[offset + 2]);
 }
 
-void enqueue_sample(SamplingState& state, uint64_t due_us, int16_t base) {
+// Feeds one sample through the sampling task's publish path.
+void publish_sample(SamplingState& state, uint64_t due_us, int16_t base) {
   PendingSample sample{};
   sample.due_us = due_us;
   sample.x = base;
   sample.y = static_cast<int16_t>(base + 1);
   sample.z = static_cast<int16_t>(base + 2);
-  TEST_ASSERT_TRUE(vibesensor::runtime::enqueue_pending_sample(state.handoff, sample));
+  TEST_ASSERT_TRUE(vibesensor::runtime::publish_sample(state, sample));
+}
+
+void initialize_handoff(SamplingState& state) {
+  vibesensor::runtime::initialize_frame_handoff(
+      state.handoff, state.handoff_storage, vibesensor::runtime::kFrameHandoffFrames);
+}
+
+// Publishes one full frame whose first sample is peak (the rest are quiet)
+// and returns the range tag it was committed with.
+uint8_t publish_frame(SamplingState& state, int16_t peak) {
+  for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
+    publish_sample(state, 1000 + i, i == 0 ? peak : 0);
+  }
+  const vibesensor::runtime::CommittedFrame* frame =
+      vibesensor::runtime::peek_committed_frame(state.handoff);
+  const uint8_t tag = frame != nullptr ? frame->range_tag : 0;
+  vibesensor::runtime::release_committed_frame(state.handoff);
+  return tag;
 }
 
 }  // namespace
 
 void setUp() { arduino_test::reset_time(); }
 
-void test_service_sample_handoff_builds_frame_and_updates_snapshot() {
+void test_service_frame_handoff_builds_frame_and_updates_snapshot() {
   SamplingState sampling_state;
-  vibesensor::runtime::initialize_sample_handoff(
-      sampling_state.handoff, sampling_state.handoff_storage, vibesensor::runtime::kSampleHandoffQueueSamples);
-  DataFrame frames[2] = {};
-  FrameQueueState queue_state = make_queue_state(frames, 2);
+  initialize_handoff(sampling_state);
+  alignas(DataFrame) uint8_t ring[2 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
   RuntimeStatus status{};
 
+  // The loop hands the current clock offset over; the next frame carries it.
+  vibesensor::runtime::service_frame_handoff(sampling_state, queue_state, status, 25);
+  TEST_ASSERT_NULL(vibesensor::runtime::peek_frame(queue_state));
   for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
-    enqueue_sample(sampling_state, 1000 + i, static_cast<int16_t>(10 + i));
+    publish_sample(sampling_state, 1000 + i, static_cast<int16_t>(10 + i));
   }
+  TEST_ASSERT_EQUAL_UINT32(1, vibesensor::runtime::frame_handoff_size(sampling_state.handoff));
 
-  vibesensor::runtime::service_sample_handoff(sampling_state, queue_state, status, 25);
+  vibesensor::runtime::service_frame_handoff(sampling_state, queue_state, status, 25);
 
   const DataFrame* frame = vibesensor::runtime::peek_frame(queue_state);
   TEST_ASSERT_NOT_NULL(frame);
@@ -114,27 +158,26 @@ void test_service_sample_handoff_builds_frame_and_updates_snapshot() {
 
   const vibesensor::runtime::SamplingStatusSnapshot snapshot =
       vibesensor::runtime::snapshot_sampling_status(sampling_state);
-  TEST_ASSERT_EQUAL_UINT16(0, snapshot.sample_handoff_size);
-  TEST_ASSERT_EQUAL_UINT16(
-      vibesensor::runtime::kSampleHandoffQueueSamples, snapshot.sample_handoff_capacity);
+  TEST_ASSERT_EQUAL_UINT16(0, snapshot.frame_handoff_size);
+  TEST_ASSERT_EQUAL_UINT16(vibesensor::runtime::kFrameHandoffFrames,
+                           snapshot.frame_handoff_capacity);
 }
 
-void test_service_sample_handoff_drops_oldest_frame_when_queue_saturates() {
+void test_service_frame_handoff_drops_oldest_frame_when_queue_saturates() {
   SamplingState sampling_state;
-  vibesensor::runtime::initialize_sample_handoff(
-      sampling_state.handoff, sampling_state.handoff_storage, vibesensor::runtime::kSampleHandoffQueueSamples);
-  DataFrame frames[1] = {};
-  FrameQueueState queue_state = make_queue_state(frames, 1);
+  initialize_handoff(sampling_state);
+  alignas(DataFrame) uint8_t ring[vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, ramp_record_bytes());
   RuntimeStatus status{};
 
   for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
-    enqueue_sample(sampling_state, 1000 + i, static_cast<int16_t>(100 + i));
+    publish_sample(sampling_state, 1000 + i, static_cast<int16_t>(100 + i));
   }
   for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
-    enqueue_sample(sampling_state, 2000 + i, static_cast<int16_t>(500 + i));
+    publish_sample(sampling_state, 2000 + i, static_cast<int16_t>(500 + i));
   }
 
-  vibesensor::runtime::service_sample_handoff(sampling_state, queue_state, status, 0);
+  vibesensor::runtime::service_frame_handoff(sampling_state, queue_state, status, 0);
 
   const DataFrame* frame = vibesensor::runtime::peek_frame(queue_state);
   TEST_ASSERT_NOT_NULL(frame);
@@ -145,12 +188,142 @@ void test_service_sample_handoff_drops_oldest_frame_when_queue_saturates() {
 
   const vibesensor::runtime::SamplingStatusSnapshot snapshot =
       vibesensor::runtime::snapshot_sampling_status(sampling_state);
-  TEST_ASSERT_EQUAL_UINT16(0, snapshot.sample_handoff_size);
+  TEST_ASSERT_EQUAL_UINT16(0, snapshot.frame_handoff_size);
+}
+
+void test_clock_offset_is_applied_when_the_frame_is_published() {
+  SamplingState sampling_state;
+  initialize_handoff(sampling_state);
+  alignas(DataFrame) uint8_t ring[2 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
+  RuntimeStatus status{};
+
+  vibesensor::runtime::service_frame_handoff(sampling_state, queue_state, status, 100);
+  for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
+    publish_sample(sampling_state, 1000 + i, 0);
+  }
+  // The first frame was committed at offset 100; a later sync step must not
+  // retime it, only frames committed after the loop hands the new offset over.
+  vibesensor::runtime::service_frame_handoff(sampling_state, queue_state, status, 700);
+  for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
+    publish_sample(sampling_state, 2000 + i, 0);
+  }
+  vibesensor::runtime::service_frame_handoff(sampling_state, queue_state, status, 700);
+
+  TEST_ASSERT_EQUAL_UINT32(2, vibesensor::runtime::frame_queue_size(queue_state));
+  TEST_ASSERT_EQUAL_UINT64(1100, vibesensor::runtime::peek_frame(queue_state)->t0_us);
+  vibesensor::runtime::drop_front_frame(queue_state);
+  TEST_ASSERT_EQUAL_UINT64(2700, vibesensor::runtime::peek_frame(queue_state)->t0_us);
+}
+
+void test_publish_sample_reports_overflow_when_the_loop_stops_draining() {
+  SamplingState sampling_state;
+  initialize_handoff(sampling_state);
+
+  const size_t capacity_samples =
+      vibesensor::runtime::kFrameHandoffFrames * vibesensor::runtime::kFrameSamples;
+  TEST_ASSERT_EQUAL_UINT32(capacity_samples,
+                           vibesensor::runtime::frame_handoff_free_samples(sampling_state.handoff));
+  for (size_t i = 0; i < capacity_samples; ++i) {
+    publish_sample(sampling_state, 1000 + i, 0);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, vibesensor::runtime::frame_handoff_free_samples(sampling_state.handoff));
+
+  PendingSample sample{};
+  sample.due_us = 9000;
+  TEST_ASSERT_FALSE(vibesensor::runtime::publish_sample(sampling_state, sample));
+  const vibesensor::runtime::SamplingStatusSnapshot snapshot =
+      vibesensor::runtime::snapshot_sampling_status(sampling_state);
+  TEST_ASSERT_EQUAL_UINT32(1, snapshot.sampling_handoff_overflow_drops);
+  TEST_ASSERT_EQUAL_UINT8(vibesensor::runtime::kSamplingErrorHandoffOverflow,
+                          snapshot.last_error_code);
+  TEST_ASSERT_EQUAL_UINT16(vibesensor::runtime::kFrameHandoffFrames, snapshot.frame_handoff_size);
+}
+
+void test_auto_range_switches_at_frame_boundaries_and_tags_frames() {
+  using vibesensor::reliability::kAccelRange16g;
+  constexpr uint8_t kFullRes = vibesensor::kDataRangeTagFullRes;
+  constexpr uint8_t kClipped = vibesensor::kDataRangeTagClipped;
+  SamplingState sampling_state;
+  initialize_handoff(sampling_state);
+  TEST_ASSERT_TRUE(sampling_state.adxl.begin());
+  sampling_state.sensor_ok = true;
+  g_set_range_calls = 0;
+
+  // Quiet frames step down one range only after the hysteresis count.
+  for (uint8_t i = 0; i + 1U < vibesensor::runtime::kAutoRangeQuietFrames; ++i) {
+    TEST_ASSERT_EQUAL_UINT8(kFullRes | kAccelRange16g, publish_frame(sampling_state, 10));
+  }
+  TEST_ASSERT_EQUAL_INT(0, g_set_range_calls);
+  TEST_ASSERT_EQUAL_UINT8(kFullRes | kAccelRange16g, publish_frame(sampling_state, 10));
+  TEST_ASSERT_EQUAL_INT(1, g_set_range_calls);
+  TEST_ASSERT_EQUAL_UINT8(2, g_last_range_code);
+
+  // The frame straddling the switch keeps the wider range; the next one
+  // carries the new range.
+  TEST_ASSERT_EQUAL_UINT8(kFullRes | kAccelRange16g, publish_frame(sampling_state, 10));
+  TEST_ASSERT_EQUAL_UINT8(kFullRes | 2U, publish_frame(sampling_state, 10));
+  vibesensor::runtime::SamplingStatusSnapshot snapshot =
+      vibesensor::runtime::snapshot_sampling_status(sampling_state);
+  TEST_ASSERT_EQUAL_UINT8(8, snapshot.sensor_range_g);
+  TEST_ASSERT_EQUAL_UINT32(1, snapshot.sensor_range_switches);
+
+  // A sample on the +/-8 g rail flags the frame and jumps back to +/-16 g.
+  TEST_ASSERT_EQUAL_UINT8(kFullRes | kClipped | 2U, publish_frame(sampling_state, 2047));
+  TEST_ASSERT_EQUAL_UINT8(kAccelRange16g, g_last_range_code);
+  snapshot = vibesensor::runtime::snapshot_sampling_status(sampling_state);
+  TEST_ASSERT_EQUAL_UINT8(16, snapshot.sensor_range_g);
+  TEST_ASSERT_EQUAL_UINT32(2, snapshot.sensor_range_switches);
+  TEST_ASSERT_EQUAL_UINT32(1, snapshot.sensor_clipped_frames);
+}
+
+void test_committed_frames_carry_the_pulse_reading() {
+  SamplingState sampling_state;
+  initialize_handoff(sampling_state);
+  sampling_state.pulse_input_ok = true;
+  alignas(DataFrame) uint8_t ring[2 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
+  RuntimeStatus status{};
+
+  vibesensor::runtime::service_frame_handoff(sampling_state, queue_state, status, 100);
+  vibesensor::runtime::record_pulse_edge(sampling_state.pulse, 1040);
+  vibesensor::runtime::record_pulse_edge(sampling_state.pulse, 1150);
+  vibesensor::runtime::record_pulse_edge(sampling_state.pulse, 1160);
+  for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
+    publish_sample(sampling_state, 1000 + i, 0);
+  }
+  // No edge during the second frame: the count holds and the last edge
+  // falls before its t0.
+  for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
+    publish_sample(sampling_state, 2000 + i, 0);
+  }
+  vibesensor::runtime::service_frame_handoff(sampling_state, queue_state, status, 100);
+
+  // Offsets stay relative to the local t0, so the clock offset the frame is
+  // shifted by applies to the edges as well.
+  TEST_ASSERT_EQUAL_UINT32(2, vibesensor::runtime::frame_queue_size(queue_state));
+  const DataFrame* frame = vibesensor::runtime::peek_frame(queue_state);
+  TEST_ASSERT_EQUAL_UINT64(1100, frame->t0_us);
+  TEST_ASSERT_EQUAL_UINT16(2, frame->pulse.edge_count);
+  TEST_ASSERT_EQUAL_INT32(150, frame->pulse.last_edge_offset_us);
+  vibesensor::runtime::drop_front_frame(queue_state);
+  frame = vibesensor::runtime::peek_frame(queue_state);
+  TEST_ASSERT_EQUAL_UINT16(2, frame->pulse.edge_count);
+  TEST_ASSERT_EQUAL_INT32(-850, frame->pulse.last_edge_offset_us);
+
+  const vibesensor::runtime::SamplingStatusSnapshot snapshot =
+      vibesensor::runtime::snapshot_sampling_status(sampling_state);
+  TEST_ASSERT_EQUAL_UINT32(2, snapshot.pulse_edges);
+  TEST_ASSERT_EQUAL_UINT32(1, snapshot.pulse_rejected_edges);
 }
 
 int main(int argc, char** argv) {
   UNITY_BEGIN();
-  RUN_TEST(test_service_sample_handoff_builds_frame_and_updates_snapshot);
-  RUN_TEST(test_service_sample_handoff_drops_oldest_frame_when_queue_saturates);
+  RUN_TEST(test_service_frame_handoff_builds_frame_and_updates_snapshot);
+  RUN_TEST(test_service_frame_handoff_drops_oldest_frame_when_queue_saturates);
+  RUN_TEST(test_clock_offset_is_applied_when_the_frame_is_published);
+  RUN_TEST(test_publish_sample_reports_overflow_when_the_loop_stops_draining);
+  RUN_TEST(test_auto_range_switches_at_frame_boundaries_and_tags_frames);
+  RUN_TEST(test_committed_frames_carry_the_pulse_reading);
   return UNITY_END();
 }
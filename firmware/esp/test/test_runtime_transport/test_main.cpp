@@ -1,14 +1,21 @@
 #include <unity.h>
 
 #include <array>
+#include <set>
+#include <stdio.h>
+
+#define VIBESENSOR_PULSE_INPUT_PIN 33
 
 #include "../native_support/generated_protocol_contract_fixtures.h"
 
 #include "../../lib/vibesensor_proto/vibesensor_proto.cpp"
+#include "../../src/runtime_backlog_stream.cpp"
 #include "../../src/runtime_led.cpp"
+#include "../../src/runtime_frame_codec.cpp"
 #include "../../src/runtime_queue.cpp"
 #include "../../src/runtime_status.cpp"
 #include "../../src/runtime_transport.cpp"
+#include "../../src/runtime_tsf_sync.cpp"
 
 namespace {
 
@@ -20,10 +27,10 @@ using vibesensor::runtime::LedState;
 using vibesensor::runtime::RuntimeStatus;
 using vibesensor::runtime::TransportState;
 
-FrameQueueState make_queue_state(DataFrame* frames, size_t capacity) {
+FrameQueueState make_queue_state(uint8_t* ring, size_t ring_bytes) {
   FrameQueueState state{};
-  state.queue = frames;
-  state.capacity = capacity;
+  state.ring = ring;
+  state.ring_bytes = ring_bytes;
   return state;
 }
 
@@ -32,16 +39,21 @@ void append_full_frame(FrameQueueState& state,
                        int16_t sample_base,
                        uint64_t first_due_us,
                        int64_t clock_offset_us) {
+  int16_t xyz[static_cast<size_t>(vibesensor::runtime::kFrameSamples) *
+              vibesensor::runtime::kAxesPerSample] = {};
   for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
     const int16_t value = static_cast<int16_t>(sample_base + static_cast<int16_t>(i));
-    vibesensor::runtime::append_sample(state,
-                                       status,
-                                       value,
-                                       static_cast<int16_t>(value + 1),
-                                       static_cast<int16_t>(value + 2),
-                                       first_due_us + i,
-                                       clock_offset_us);
+    const size_t idx = static_cast<size_t>(i) * vibesensor::runtime::kAxesPerSample;
+    xyz[idx + 0] = value;
+    xyz[idx + 1] = static_cast<int16_t>(value + 1);
+    xyz[idx + 2] = static_cast<int16_t>(value + 2);
   }
+  vibesensor::runtime::enqueue_frame(
+      state,
+      status,
+      static_cast<uint64_t>(static_cast<int64_t>(first_due_us) + clock_offset_us),
+      xyz,
+      vibesensor::runtime::kFrameSamples);
 }
 
 void copy_client_id(uint8_t out[vibesensor::kClientIdBytes],
@@ -51,6 +63,99 @@ void copy_client_id(uint8_t out[vibesensor::kClientIdBytes],
   }
 }
 
+uint32_t read_u32_le_at(const std::vector<uint8_t>& payload, size_t offset) {
+  return static_cast<uint32_t>(payload[offset]) |
+         (static_cast<uint32_t>(payload[offset + 1]) << 8) |
+         (static_cast<uint32_t>(payload[offset + 2]) << 16) |
+         (static_cast<uint32_t>(payload[offset + 3]) << 24);
+}
+
+uint32_t data_packet_seq(const std::vector<uint8_t>& payload) {
+  return read_u32_le_at(payload, 2 + vibesensor::kClientIdBytes);
+}
+
+struct ReconnectResult {
+  size_t data_bytes = 0;
+  size_t redundant_bytes = 0;
+  uint32_t skipped_frames = 0;
+};
+
+// Each cycle sends the front frame, loses its DATA_ACK to a Wi-Fi drop, then
+// reconnects. The simulated server keeps every seq it saw and answers HELLO
+// with or without receipt state; DATA it already had counts as redundant.
+ReconnectResult run_reconnect_cycles(size_t cycles, bool server_reports_receipts) {
+  alignas(DataFrame) uint8_t ring[4 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
+  RuntimeStatus status{};
+  TransportState transport{};
+  LedState led_state;
+  vibesensor::runtime::begin_leds(led_state);
+  copy_client_id(transport.client_id, fixture::kCommandClientId);
+  transport.handshake_complete = true;
+  WiFi.setStatus(WL_CONNECTED);
+  arduino_test::set_millis(1000);
+
+  std::set<uint32_t> server_seqs;
+  ReconnectResult result;
+  size_t sent_seen = 0;
+  auto server_receive = [&](bool ack) {
+    for (; sent_seen < transport.data_udp.sent_packets.size(); ++sent_seen) {
+      const std::vector<uint8_t>& payload = transport.data_udp.sent_packets[sent_seen].payload;
+      const uint32_t seq = data_packet_seq(payload);
+      result.data_bytes += payload.size();
+      if (!server_seqs.insert(seq).second) {
+        result.redundant_bytes += payload.size();
+      }
+      if (ack) {
+        vibesensor::runtime::ack_data_frames(queue_state, seq);
+      }
+    }
+  };
+
+  for (size_t cycle = 0; cycle < cycles; ++cycle) {
+    while (queue_state.size < 2) {
+      append_full_frame(queue_state, status, static_cast<int16_t>(cycle), 1000, 0);
+    }
+    vibesensor::runtime::service_tx(transport, queue_state, status);
+    server_receive(false);
+
+    WiFi.setStatus(WL_DISCONNECTED);
+    vibesensor::runtime::service_tx(transport, queue_state, status);
+    WiFi.setStatus(WL_CONNECTED);
+    arduino_test::advance_millis(vibesensor::runtime::kDataRetransmitIntervalMs);
+
+    transport.control_udp.sent_packets.clear();
+    vibesensor::runtime::send_hello(transport, queue_state, status);
+    const std::vector<uint8_t>& hello = transport.control_udp.sent_packets.back().payload;
+    const uint32_t oldest_pending =
+        read_u32_le_at(hello, hello.size() - vibesensor::kHelloResumeBytes);
+    uint8_t hello_ack[vibesensor::kHelloAckReceiptsBytes] = {};
+    size_t hello_ack_len = 0;
+    if (server_reports_receipts) {
+      uint32_t contiguous = oldest_pending - 1U;
+      while (server_seqs.count(contiguous + 1U) != 0) {
+        contiguous++;
+      }
+      hello_ack_len = vibesensor::pack_hello_ack(hello_ack,
+                                                 sizeof(hello_ack),
+                                                 transport.client_id,
+                                                 vibesensor::kHelloCapExplicitAck,
+                                                 contiguous,
+                                                 0);
+    } else {
+      hello_ack_len = vibesensor::pack_hello_ack(
+          hello_ack, sizeof(hello_ack), transport.client_id, vibesensor::kHelloCapExplicitAck);
+    }
+    transport.control_udp.queueIncoming(hello_ack, hello_ack_len);
+    vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+
+    vibesensor::runtime::service_tx(transport, queue_state, status);
+    server_receive(true);
+  }
+  result.skipped_frames = status.tx_resume_skipped_frames;
+  return result;
+}
+
 }  // namespace
 
 void setUp() {
@@ -60,8 +165,8 @@ void setUp() {
 }
 
 void test_service_tx_tracks_send_failures_and_retries_after_backoff() {
-  DataFrame frames[1] = {};
-  FrameQueueState queue_state = make_queue_state(frames, 1);
+  alignas(DataFrame) uint8_t ring[vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
   RuntimeStatus status{};
   TransportState transport{};
   copy_client_id(transport.client_id, fixture::kCommandClientId);
@@ -93,8 +198,8 @@ void test_service_tx_tracks_send_failures_and_retries_after_backoff() {
 }
 
 void test_service_control_rx_handles_handshake_identify_and_sync_clock() {
-  DataFrame frames[1] = {};
-  FrameQueueState queue_state = make_queue_state(frames, 1);
+  alignas(DataFrame) uint8_t ring[vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
   RuntimeStatus status{};
   TransportState transport{};
   LedState led_state;
@@ -102,11 +207,12 @@ void test_service_control_rx_handles_handshake_identify_and_sync_clock() {
   copy_client_id(transport.client_id, fixture::kCommandClientId);
 
   uint8_t hello_ack[vibesensor::kHelloAckBytes] = {};
-  const size_t hello_ack_len =
-      vibesensor::pack_hello_ack(hello_ack, sizeof(hello_ack), transport.client_id);
+  const size_t hello_ack_len = vibesensor::pack_hello_ack(
+      hello_ack, sizeof(hello_ack), transport.client_id, vibesensor::kHelloCapExplicitAck);
   transport.control_udp.queueIncoming(hello_ack, hello_ack_len);
   vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
   TEST_ASSERT_TRUE(transport.handshake_complete);
+  TEST_ASSERT_EQUAL_UINT8(vibesensor::kHelloCapExplicitAck, transport.server_capabilities);
 
   arduino_test::set_millis(5000);
   transport.control_udp.queueIncoming(
@@ -137,8 +243,8 @@ void test_service_control_rx_handles_handshake_identify_and_sync_clock() {
 }
 
 void test_service_tx_drops_stale_and_retry_exhausted_frames() {
-  DataFrame frames[1] = {};
-  FrameQueueState queue_state = make_queue_state(frames, 1);
+  alignas(DataFrame) uint8_t ring[vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
   RuntimeStatus status{};
   TransportState transport{};
   copy_client_id(transport.client_id, fixture::kCommandClientId);
@@ -172,6 +278,145 @@ void test_service_tx_drops_stale_and_retry_exhausted_frames() {
   TEST_ASSERT_NULL(vibesensor::runtime::peek_frame(queue_state));
 }
 
+void test_tx_slot_assignment_gates_data_to_the_guarded_slot() {
+  alignas(DataFrame) uint8_t ring[3 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
+  RuntimeStatus status{};
+  TransportState transport{};
+  LedState led_state;
+  vibesensor::runtime::begin_leds(led_state);
+  copy_client_id(transport.client_id, fixture::kCommandClientId);
+  transport.handshake_complete = true;
+  WiFi.setStatus(WL_CONNECTED);
+  arduino_test::set_millis(1000);
+
+  // Out-of-range slot (width > period) is refused and leaves contention on.
+  std::array<uint8_t, fixture::kTxSlotPacket.size()> bad_slot = fixture::kTxSlotPacket;
+  bad_slot[21] = 0xff;
+  bad_slot[22] = 0xff;
+  transport.control_udp.queueIncoming(bad_slot.data(), bad_slot.size());
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+  uint8_t expected_ack[vibesensor::kAckBytes] = {};
+  size_t expected_ack_len = vibesensor::pack_ack(
+      expected_ack, sizeof(expected_ack), transport.client_id, fixture::kTxSlotCmdSeq, 1);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(
+      expected_ack, transport.control_udp.sent_packets[0].payload.data(), expected_ack_len);
+  TEST_ASSERT_FALSE(vibesensor::reliability::tx_slot_schedule_valid(transport.tx_slot));
+
+  transport.control_udp.queueIncoming(
+      fixture::kTxSlotPacket.data(), fixture::kTxSlotPacket.size());
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+  expected_ack_len = vibesensor::pack_ack(
+      expected_ack, sizeof(expected_ack), transport.client_id, fixture::kTxSlotCmdSeq, 0);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(
+      expected_ack, transport.control_udp.sent_packets[1].payload.data(), expected_ack_len);
+  TEST_ASSERT_EQUAL_UINT32(fixture::kTxSlotPeriodUs, transport.tx_slot.period_us);
+  TEST_ASSERT_EQUAL_UINT32(fixture::kTxSlotPeriodUs, status.tx_slot_period_us);
+
+  append_full_frame(queue_state, status, 10, 1000, 0);
+  append_full_frame(queue_state, status, 20, 2000, 0);
+  append_full_frame(queue_state, status, 30, 3000, 0);
+
+  // Without a clock sync the slot cannot be placed, so the node still sends
+  // on contention.
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(1, transport.data_udp.sent_packets.size());
+  vibesensor::runtime::ack_data_frames(queue_state, 0);
+  transport.data_udp.sent_packets.clear();
+
+  transport.control_udp.queueIncoming(
+      fixture::kSyncClockPacket.data(), fixture::kSyncClockPacket.size());
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+  TEST_ASSERT_EQUAL_UINT32(fixture::kSyncClockRoundTripUs, status.sync_round_trip_us);
+
+  // Synced time 2 010 000 us sits 7.5 ms past the slot start: outside it.
+  arduino_test::set_esp_time(static_cast<uint64_t>(2010000LL - fixture::kSyncClockAppliedOffsetUs));
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(0, transport.data_udp.sent_packets.size());
+
+  // The 6.8 ms sync round trip caps the guard at 3/8 of the 2.5 ms slot.
+  // 1.3 ms in, a 400 us frame would overrun the trailing guard; 1 ms in, it
+  // still fits.
+  arduino_test::set_esp_time(static_cast<uint64_t>(2003800LL - fixture::kSyncClockAppliedOffsetUs));
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(937, status.tx_slot_guard_us);
+  TEST_ASSERT_EQUAL_UINT32(0, transport.data_udp.sent_packets.size());
+
+  arduino_test::set_esp_time(static_cast<uint64_t>(2003500LL - fixture::kSyncClockAppliedOffsetUs));
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(1, transport.data_udp.sent_packets.size());
+  TEST_ASSERT_EQUAL_UINT32(1, vibesensor::runtime::peek_frame(queue_state)->seq);
+}
+
+void test_tx_slot_is_refused_when_narrow_and_cleared_by_withdrawal_or_new_handshake() {
+  alignas(DataFrame) uint8_t ring[vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
+  RuntimeStatus status{};
+  TransportState transport{};
+  LedState led_state;
+  vibesensor::runtime::begin_leds(led_state);
+  copy_client_id(transport.client_id, fixture::kCommandClientId);
+  transport.handshake_complete = true;
+  WiFi.setStatus(WL_CONNECTED);
+  uint8_t expected_ack[vibesensor::kAckBytes] = {};
+
+  // A 500 us slot cannot fit a 400 us frame plus both edge guards.
+  std::array<uint8_t, fixture::kTxSlotPacket.size()> narrow_slot = fixture::kTxSlotPacket;
+  narrow_slot[21] = 0xf4;
+  narrow_slot[22] = 0x01;
+  transport.control_udp.queueIncoming(narrow_slot.data(), narrow_slot.size());
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+  size_t expected_ack_len = vibesensor::pack_ack(
+      expected_ack, sizeof(expected_ack), transport.client_id, fixture::kTxSlotCmdSeq, 1);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(
+      expected_ack, transport.control_udp.sent_packets.back().payload.data(), expected_ack_len);
+  TEST_ASSERT_EQUAL_UINT32(0, transport.tx_slot.period_us);
+
+  // A zero period is the server withdrawing the slot (TDMA disabled).
+  transport.control_udp.queueIncoming(
+      fixture::kTxSlotPacket.data(), fixture::kTxSlotPacket.size());
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+  TEST_ASSERT_EQUAL_UINT32(fixture::kTxSlotPeriodUs, transport.tx_slot.period_us);
+  std::array<uint8_t, fixture::kTxSlotPacket.size()> withdraw = fixture::kTxSlotPacket;
+  for (size_t i = 17; i < 21; ++i) {
+    withdraw[i] = 0;
+  }
+  transport.control_udp.queueIncoming(withdraw.data(), withdraw.size());
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+  expected_ack_len = vibesensor::pack_ack(
+      expected_ack, sizeof(expected_ack), transport.client_id, fixture::kTxSlotCmdSeq, 0);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(
+      expected_ack, transport.control_udp.sent_packets.back().payload.data(), expected_ack_len);
+  TEST_ASSERT_EQUAL_UINT32(0, transport.tx_slot.period_us);
+  TEST_ASSERT_EQUAL_UINT32(0, status.tx_slot_period_us);
+
+  // A fresh HELLO_ACK starts a new session: the old slot no longer applies.
+  transport.control_udp.queueIncoming(
+      fixture::kTxSlotPacket.data(), fixture::kTxSlotPacket.size());
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+  TEST_ASSERT_EQUAL_UINT32(fixture::kTxSlotPeriodUs, status.tx_slot_period_us);
+  uint8_t hello_ack[vibesensor::kHelloAckBytes] = {};
+  const size_t hello_ack_len = vibesensor::pack_hello_ack(
+      hello_ack, sizeof(hello_ack), transport.client_id, vibesensor::kHelloCapExplicitAck);
+  transport.control_udp.queueIncoming(hello_ack, hello_ack_len);
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+  TEST_ASSERT_TRUE(transport.handshake_complete);
+  TEST_ASSERT_EQUAL_UINT32(0, transport.tx_slot.period_us);
+  TEST_ASSERT_EQUAL_UINT32(0, status.tx_slot_period_us);
+
+  // Losing the link drops the handshake and the slot with it.
+  transport.control_udp.queueIncoming(
+      fixture::kTxSlotPacket.data(), fixture::kTxSlotPacket.size());
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+  TEST_ASSERT_EQUAL_UINT32(fixture::kTxSlotPeriodUs, transport.tx_slot.period_us);
+  WiFi.setStatus(WL_DISCONNECTED);
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_FALSE(transport.handshake_complete);
+  TEST_ASSERT_EQUAL_UINT32(0, transport.tx_slot.period_us);
+  TEST_ASSERT_EQUAL_UINT32(0, status.tx_slot_period_us);
+  WiFi.setStatus(WL_CONNECTED);
+}
+
 void test_initialize_transport_uses_efuse_fallback_client_id_when_wifi_mac_is_invalid() {
   TransportState transport{};
   WiFi.setMacAddress("not-a-mac");
@@ -187,11 +432,153 @@ void test_initialize_transport_uses_efuse_fallback_client_id_when_wifi_mac_is_in
       transport.control_port);
 }
 
+void test_hello_carries_oldest_pending_seq_and_receipts_release_queued_frames() {
+  alignas(DataFrame) uint8_t ring[4 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
+  RuntimeStatus status{};
+  TransportState transport{};
+  LedState led_state;
+  vibesensor::runtime::begin_leds(led_state);
+  copy_client_id(transport.client_id, fixture::kCommandClientId);
+  transport.boot_id = 0xB0075EEDU;
+  WiFi.setStatus(WL_CONNECTED);
+  arduino_test::set_millis(1000);
+  for (int16_t i = 0; i < 4; ++i) {
+    append_full_frame(queue_state, status, i, 1000, 0);
+  }
+  vibesensor::runtime::ack_data_frames(queue_state, 0);
+
+  TEST_ASSERT_TRUE(vibesensor::runtime::send_hello(transport, queue_state, status));
+  const std::vector<uint8_t>& hello = transport.control_udp.sent_packets[0].payload;
+  const size_t caps_offset = hello.size() - 1 - vibesensor::kHelloResumeBytes;
+  TEST_ASSERT_TRUE((hello[caps_offset] & vibesensor::kHelloCapResumeReceipts) != 0);
+  TEST_ASSERT_EQUAL_UINT32(1, read_u32_le_at(hello, caps_offset + 1));
+  TEST_ASSERT_EQUAL_UINT32(0xB0075EEDU, read_u32_le_at(hello, caps_offset + 5));
+
+  // Seq 1 and 3 reached the server; 2 did not.
+  uint8_t hello_ack[vibesensor::kHelloAckReceiptsBytes] = {};
+  const size_t hello_ack_len = vibesensor::pack_hello_ack(hello_ack,
+                                                          sizeof(hello_ack),
+                                                          transport.client_id,
+                                                          vibesensor::kHelloCapExplicitAck,
+                                                          1U,
+                                                          0x1U);
+  TEST_ASSERT_EQUAL_UINT32(vibesensor::kHelloAckReceiptsBytes, hello_ack_len);
+  transport.control_udp.queueIncoming(hello_ack, hello_ack_len);
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+  TEST_ASSERT_TRUE(transport.handshake_complete);
+  TEST_ASSERT_EQUAL_UINT32(2, status.tx_resume_skipped_frames);
+  TEST_ASSERT_EQUAL_UINT32(2, vibesensor::runtime::frame_queue_oldest_seq(queue_state));
+
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(1, transport.data_udp.sent_packets.size());
+  TEST_ASSERT_EQUAL_UINT32(2, data_packet_seq(transport.data_udp.sent_packets[0].payload));
+  vibesensor::runtime::ack_data_frames(queue_state, 2);
+
+  // Seq 3 is already on the server, so the queue drains without sending it.
+  arduino_test::advance_millis(vibesensor::runtime::kDataRetransmitIntervalMs);
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(1, transport.data_udp.sent_packets.size());
+  TEST_ASSERT_NULL(vibesensor::runtime::peek_frame(queue_state));
+}
+
+void test_reconnect_receipts_avoid_resending_frames_the_server_already_has() {
+  const size_t cycles = 16;
+  const ReconnectResult legacy = run_reconnect_cycles(cycles, false);
+  const ReconnectResult resumed = run_reconnect_cycles(cycles, true);
+
+  printf("reconnect cycles=%u legacy={data:%uB redundant:%uB} "
+         "receipts={data:%uB redundant:%uB skipped:%u}\n",
+         static_cast<unsigned>(cycles),
+         static_cast<unsigned>(legacy.data_bytes),
+         static_cast<unsigned>(legacy.redundant_bytes),
+         static_cast<unsigned>(resumed.data_bytes),
+         static_cast<unsigned>(resumed.redundant_bytes),
+         static_cast<unsigned>(resumed.skipped_frames));
+
+  // Without receipts every lost ACK costs one full resend of the in-flight frame.
+  TEST_ASSERT_EQUAL_UINT32(legacy.data_bytes, 2 * legacy.redundant_bytes);
+  TEST_ASSERT_EQUAL_UINT32(0, resumed.redundant_bytes);
+  TEST_ASSERT_EQUAL_UINT32(cycles, resumed.skipped_frames);
+}
+
+void test_data_trailers_wait_for_the_server_to_echo_them() {
+  alignas(DataFrame) uint8_t ring[3 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
+  RuntimeStatus status{};
+  TransportState transport{};
+  LedState led_state;
+  vibesensor::runtime::begin_leds(led_state);
+  copy_client_id(transport.client_id, fixture::kCommandClientId);
+  WiFi.setStatus(WL_CONNECTED);
+  arduino_test::set_millis(1000);
+  const size_t untagged_bytes = vibesensor::kDataHeaderBytes +
+                                (static_cast<size_t>(vibesensor::runtime::kFrameSamples) *
+                                 vibesensor::runtime::kAxesPerSample * sizeof(int16_t));
+
+  // A server that predates the echo answers with the bare header: handshake
+  // done, but DATA keeps the exact length it expects.
+  uint8_t hello_ack[vibesensor::kHelloAckBytes] = {};
+  vibesensor::pack_hello_ack(
+      hello_ack, sizeof(hello_ack), transport.client_id, vibesensor::kHelloCapExplicitAck);
+  transport.control_udp.queueIncoming(hello_ack, vibesensor::kHelloAckHeaderBytes);
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+  TEST_ASSERT_TRUE(transport.handshake_complete);
+  TEST_ASSERT_EQUAL_UINT8(0, transport.server_capabilities);
+
+  append_full_frame(queue_state, status, 10, 1000, 0);
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(1, transport.data_udp.sent_packets.size());
+  TEST_ASSERT_EQUAL_UINT32(untagged_bytes, transport.data_udp.sent_packets[0].payload.size());
+  vibesensor::runtime::ack_data_frames(queue_state, 0);
+
+  vibesensor::pack_hello_ack(hello_ack,
+                             sizeof(hello_ack),
+                             transport.client_id,
+                             static_cast<uint8_t>(vibesensor::kHelloCapExplicitAck |
+                                                  vibesensor::kHelloCapRangeTag));
+  transport.control_udp.queueIncoming(hello_ack, sizeof(hello_ack));
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+
+  append_full_frame(queue_state, status, 20, 2000, 0);
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(2, transport.data_udp.sent_packets.size());
+  const std::vector<uint8_t>& tagged = transport.data_udp.sent_packets[1].payload;
+  TEST_ASSERT_EQUAL_UINT32(untagged_bytes + vibesensor::kDataRangeTagBytes, tagged.size());
+  TEST_ASSERT_EQUAL_UINT8(vibesensor::runtime::kDefaultRangeTag, tagged.back());
+  vibesensor::runtime::ack_data_frames(queue_state, 1);
+
+  // The pulse record follows the range tag once its own bit comes back too.
+  vibesensor::pack_hello_ack(hello_ack,
+                             sizeof(hello_ack),
+                             transport.client_id,
+                             static_cast<uint8_t>(vibesensor::kHelloCapExplicitAck |
+                                                  vibesensor::kHelloCapRangeTag |
+                                                  vibesensor::kHelloCapPulseChannel));
+  transport.control_udp.queueIncoming(hello_ack, sizeof(hello_ack));
+  vibesensor::runtime::service_control_rx(transport, queue_state, led_state, status);
+
+  append_full_frame(queue_state, status, 30, 3000, 0);
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(3, transport.data_udp.sent_packets.size());
+  const std::vector<uint8_t>& with_pulse = transport.data_udp.sent_packets[2].payload;
+  TEST_ASSERT_EQUAL_UINT32(
+      untagged_bytes + vibesensor::kDataRangeTagBytes + vibesensor::kDataPulseChannelBytes,
+      with_pulse.size());
+  TEST_ASSERT_EQUAL_UINT8(vibesensor::kDataChannelWheelPulse,
+                          with_pulse[untagged_bytes + vibesensor::kDataRangeTagBytes]);
+}
+
 int main(int argc, char** argv) {
   UNITY_BEGIN();
   RUN_TEST(test_service_tx_tracks_send_failures_and_retries_after_backoff);
   RUN_TEST(test_service_control_rx_handles_handshake_identify_and_sync_clock);
   RUN_TEST(test_service_tx_drops_stale_and_retry_exhausted_frames);
+  RUN_TEST(test_tx_slot_assignment_gates_data_to_the_guarded_slot);
+  RUN_TEST(test_tx_slot_is_refused_when_narrow_and_cleared_by_withdrawal_or_new_handshake);
+  RUN_TEST(test_data_trailers_wait_for_the_server_to_echo_them);
   RUN_TEST(test_initialize_transport_uses_efuse_fallback_client_id_when_wifi_mac_is_invalid);
+  RUN_TEST(test_hello_carries_oldest_pending_seq_and_receipts_release_queued_frames);
+  RUN_TEST(test_reconnect_receipts_avoid_resending_frames_the_server_already_has);
   return UNITY_END();
 }
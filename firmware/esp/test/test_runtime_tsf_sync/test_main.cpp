@@ -0,0 +1,294 @@
+#include <unity.h>
+
+#include <array>
+#include <stdio.h>
+
+#define VIBESENSOR_TSF_TIME_SYNC 1
+
+#include "../native_support/generated_protocol_contract_fixtures.h"
+
+#include "../../lib/vibesensor_proto/vibesensor_proto.cpp"
+#include "../../src/runtime_backlog_stream.cpp"
+#include "../../src/runtime_led.cpp"
+#include "../../src/runtime_frame_codec.cpp"
+#include "../../src/runtime_queue.cpp"
+#include "../../src/runtime_status.cpp"
+#include "../../src/runtime_transport.cpp"
+#include "../../src/runtime_tsf_sync.cpp"
+
+namespace {
+
+namespace fixture = vibesensor::test_support;
+
+using vibesensor::runtime::DataFrame;
+using vibesensor::runtime::FrameQueueState;
+using vibesensor::runtime::RuntimeStatus;
+using vibesensor::runtime::TransportState;
+using vibesensor::runtime::TsfClockMapping;
+using vibesensor::runtime::TsfSyncState;
+
+constexpr uint64_t kSyncStepUs = 1000000ULL;
+
+// Linear clock model used for both node-local clocks and the AP TSF:
+// clock(true_us) = offset_us + true_us * (1 + skew_ppb / 1e9).
+struct ClockModel {
+  int64_t offset_us;
+  int64_t skew_ppb;
+};
+
+uint64_t clock_at(const ClockModel& model, uint64_t true_us) {
+  const int64_t t = static_cast<int64_t>(true_us);
+  return static_cast<uint64_t>(model.offset_us + t + ((t * model.skew_ppb) / 1000000000LL));
+}
+
+int64_t abs_i64(int64_t value) { return value < 0 ? -value : value; }
+
+// Deterministic +/- jitter in microseconds for read bracketing noise.
+int64_t read_jitter_us(uint32_t index, int64_t span_us) {
+  const uint32_t mixed = (index * 2654435761U) >> 16;
+  return static_cast<int64_t>(mixed % static_cast<uint32_t>((span_us * 2) + 1)) - span_us;
+}
+
+uint64_t read_u64_le(const uint8_t* src) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < 8; ++i) {
+    value |= static_cast<uint64_t>(src[i]) << (8U * i);
+  }
+  return value;
+}
+
+void copy_client_id(uint8_t out[vibesensor::kClientIdBytes],
+                    const std::array<uint8_t, vibesensor::kClientIdBytes>& value) {
+  for (size_t i = 0; i < value.size(); ++i) {
+    out[i] = value[i];
+  }
+}
+
+FrameQueueState make_queue_state(uint8_t* ring, size_t ring_bytes) {
+  FrameQueueState state{};
+  state.ring = ring;
+  state.ring_bytes = ring_bytes;
+  return state;
+}
+
+}  // namespace
+
+void setUp() {
+  arduino_test::reset_time();
+  arduino_test::reset_tsf_source();
+  WiFi.reset();
+}
+
+void test_tsf_mapping_recovers_offset_and_skew() {
+  TsfClockMapping mapping{};
+  const ClockModel tsf_vs_local{5000000000LL, 40000};
+
+  for (uint64_t local_us = 1000000ULL; local_us <= 8000000ULL; local_us += kSyncStepUs) {
+    TEST_ASSERT_TRUE(vibesensor::runtime::add_tsf_clock_point(
+        mapping, local_us, clock_at(tsf_vs_local, local_us)));
+  }
+
+  TEST_ASSERT_TRUE(vibesensor::runtime::tsf_mapping_ready(mapping));
+  TEST_ASSERT_INT64_WITHIN(5, 40000, vibesensor::runtime::tsf_mapping_skew_ppb(mapping));
+  const uint64_t extrapolated_local_us = 18000000ULL;
+  TEST_ASSERT_INT64_WITHIN(
+      1,
+      static_cast<int64_t>(clock_at(tsf_vs_local, extrapolated_local_us)),
+      static_cast<int64_t>(vibesensor::runtime::tsf_from_local_us(mapping, extrapolated_local_us)));
+}
+
+void test_tsf_mapping_restarts_on_tsf_jump_but_keeps_rate_prior() {
+  TsfClockMapping mapping{};
+  ClockModel tsf_vs_local{1000LL, -25000};
+  for (uint64_t local_us = 1000000ULL; local_us <= 5000000ULL; local_us += kSyncStepUs) {
+    vibesensor::runtime::add_tsf_clock_point(mapping, local_us, clock_at(tsf_vs_local, local_us));
+  }
+
+  tsf_vs_local.offset_us += 750000000LL;
+  TEST_ASSERT_FALSE(vibesensor::runtime::add_tsf_clock_point(
+      mapping, 6000000ULL, clock_at(tsf_vs_local, 6000000ULL)));
+  TEST_ASSERT_EQUAL_UINT32(1, mapping.count);
+  TEST_ASSERT_TRUE(vibesensor::runtime::tsf_mapping_ready(mapping));
+  TEST_ASSERT_INT64_WITHIN(
+      2,
+      static_cast<int64_t>(clock_at(tsf_vs_local, 6500000ULL)),
+      static_cast<int64_t>(vibesensor::runtime::tsf_from_local_us(mapping, 6500000ULL)));
+}
+
+void test_tsf_mapping_rejects_implausible_skew() {
+  TsfClockMapping mapping{};
+  TEST_ASSERT_TRUE(vibesensor::runtime::add_tsf_clock_point(mapping, 1000000ULL, 2000000ULL));
+  TEST_ASSERT_FALSE(vibesensor::runtime::tsf_mapping_ready(mapping));
+
+  // 1000 ppm apart is far outside crystal tolerance; treat as a bad pairing.
+  TEST_ASSERT_FALSE(vibesensor::runtime::add_tsf_clock_point(mapping, 1100000ULL, 2100100ULL));
+  TEST_ASSERT_EQUAL_UINT32(1, mapping.count);
+  TEST_ASSERT_FALSE(vibesensor::runtime::tsf_mapping_ready(mapping));
+}
+
+void test_service_tsf_sync_samples_on_interval_only_when_associated() {
+  TsfSyncState state{};
+  RuntimeStatus status{};
+  arduino_test::set_esp_time(1000000ULL);
+  arduino_test::set_millis(1000);
+
+  vibesensor::runtime::service_tsf_sync(state, status);
+  TEST_ASSERT_EQUAL_UINT32(0, state.mapping.count);
+
+  WiFi.setStatus(WL_CONNECTED);
+  vibesensor::runtime::service_tsf_sync(state, status);
+  TEST_ASSERT_EQUAL_UINT32(0, state.mapping.count);
+
+  arduino_test::set_tsf_source(7000000LL, 10000);
+  arduino_test::advance_millis(vibesensor::runtime::kTsfSyncIntervalMs);
+  vibesensor::runtime::service_tsf_sync(state, status);
+  TEST_ASSERT_EQUAL_UINT32(1, state.mapping.count);
+  vibesensor::runtime::service_tsf_sync(state, status);
+  TEST_ASSERT_EQUAL_UINT32(1, state.mapping.count);
+
+  arduino_test::set_esp_time(2000000ULL);
+  arduino_test::set_esp_time_step(vibesensor::runtime::kTsfSyncMaxReadSpanUs + 1U);
+  arduino_test::advance_millis(vibesensor::runtime::kTsfSyncIntervalMs);
+  vibesensor::runtime::service_tsf_sync(state, status);
+  TEST_ASSERT_EQUAL_UINT32(1, state.mapping.count);
+  TEST_ASSERT_EQUAL_UINT32(1, status.tsf_sync_rejected_reads);
+
+  arduino_test::set_esp_time_step(0);
+  arduino_test::advance_millis(vibesensor::runtime::kTsfSyncIntervalMs);
+  vibesensor::runtime::service_tsf_sync(state, status);
+  TEST_ASSERT_EQUAL_UINT32(2, state.mapping.count);
+  TEST_ASSERT_TRUE(status.tsf_sync_ready);
+  TEST_ASSERT_INT64_WITHIN(5, 10000, status.tsf_sync_skew_ppb);
+}
+
+void test_service_tx_waits_for_tsf_mapping_and_sends_tsf_t0() {
+  alignas(DataFrame) uint8_t ring[2 * vibesensor::runtime::kFrameRecordMaxBytes] = {};
+  FrameQueueState queue_state = make_queue_state(ring, sizeof(ring));
+  RuntimeStatus status{};
+  TransportState transport{};
+  copy_client_id(transport.client_id, fixture::kCommandClientId);
+  transport.handshake_complete = true;
+  transport.clock_offset_us = 123456;
+  WiFi.setStatus(WL_CONNECTED);
+  arduino_test::set_millis(1000);
+  arduino_test::set_tsf_source(90000000LL, -20000);
+
+  TEST_ASSERT_TRUE(vibesensor::runtime::send_hello(transport, queue_state, status));
+  const std::vector<uint8_t>& hello = transport.control_udp.sent_packets[0].payload;
+  const uint8_t capabilities = hello[hello.size() - 1 - vibesensor::kHelloResumeBytes];
+  TEST_ASSERT_TRUE((capabilities & vibesensor::kHelloCapTsfTimebase) != 0);
+
+  arduino_test::set_esp_time(1000000ULL);
+  vibesensor::runtime::service_tsf_sync(transport.tsf_sync, status);
+  TEST_ASSERT_FALSE(status.tsf_sync_ready);
+
+  const uint64_t frame_local_t0_us = 1500000ULL;
+  arduino_test::set_millis(1600);
+  int16_t xyz[static_cast<size_t>(vibesensor::runtime::kFrameSamples) *
+              vibesensor::runtime::kAxesPerSample] = {};
+  for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
+    xyz[static_cast<size_t>(i) * vibesensor::runtime::kAxesPerSample] = static_cast<int16_t>(i);
+  }
+  vibesensor::runtime::enqueue_frame(
+      queue_state,
+      status,
+      static_cast<uint64_t>(static_cast<int64_t>(frame_local_t0_us) +
+                            vibesensor::runtime::frame_clock_offset_us(transport)),
+      xyz,
+      vibesensor::runtime::kFrameSamples);
+  TEST_ASSERT_EQUAL_UINT64(frame_local_t0_us, vibesensor::runtime::peek_frame(queue_state)->t0_us);
+
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(0, transport.data_udp.sent_packets.size());
+
+  arduino_test::set_esp_time(2000000ULL);
+  arduino_test::set_millis(1000 + vibesensor::runtime::kTsfSyncIntervalMs);
+  vibesensor::runtime::service_tsf_sync(transport.tsf_sync, status);
+  TEST_ASSERT_TRUE(status.tsf_sync_ready);
+
+  vibesensor::runtime::service_tx(transport, queue_state, status);
+  TEST_ASSERT_EQUAL_UINT32(1, transport.data_udp.sent_packets.size());
+  const uint64_t wire_t0_us =
+      read_u64_le(transport.data_udp.sent_packets[0].payload.data() + 12);
+  TEST_ASSERT_INT64_WITHIN(1,
+                           arduino_test::tsf_at_local_us(frame_local_t0_us),
+                           static_cast<int64_t>(wire_t0_us));
+}
+
+void test_tsf_timebase_aligns_nodes_tighter_than_round_trip_sync() {
+  // One AP TSF shared by two nodes whose local oscillators differ in offset
+  // and rate. Each node samples TSF once per second with a few microseconds of
+  // read jitter; the round-trip path instead applies one offset every 5 s that
+  // carries half the uplink/downlink asymmetry and then free-runs on skew.
+  const ClockModel ap_tsf{3000000000LL, 5000};
+  const ClockModel node_a{1234567LL, -30000};
+  const ClockModel node_b{98765LL, 45000};
+  constexpr int64_t kReadJitterUs = 3;
+  constexpr int64_t kSyncAsymmetryUs = 1200;
+  constexpr uint64_t kSyncIntervalUs = 5000000ULL;
+
+  TsfClockMapping mapping_a{};
+  TsfClockMapping mapping_b{};
+  int64_t offset_a_us = 0;
+  int64_t offset_b_us = 0;
+  int64_t max_tsf_error_us = 0;
+  int64_t max_round_trip_error_us = 0;
+  uint32_t jitter_index = 0;
+
+  for (uint64_t true_us = 1000000ULL; true_us <= 60000000ULL; true_us += 100000ULL) {
+    if ((true_us % kSyncStepUs) == 0) {
+      const int64_t jitter_a = read_jitter_us(jitter_index++, kReadJitterUs);
+      const int64_t jitter_b = read_jitter_us(jitter_index++, kReadJitterUs);
+      vibesensor::runtime::add_tsf_clock_point(
+          mapping_a,
+          static_cast<uint64_t>(static_cast<int64_t>(clock_at(node_a, true_us)) + jitter_a),
+          clock_at(ap_tsf, true_us));
+      vibesensor::runtime::add_tsf_clock_point(
+          mapping_b,
+          static_cast<uint64_t>(static_cast<int64_t>(clock_at(node_b, true_us)) + jitter_b),
+          clock_at(ap_tsf, true_us));
+    }
+    if ((true_us % kSyncIntervalUs) == 0) {
+      offset_a_us = static_cast<int64_t>(clock_at(ap_tsf, true_us)) -
+                    static_cast<int64_t>(clock_at(node_a, true_us)) + (kSyncAsymmetryUs / 2);
+      offset_b_us = static_cast<int64_t>(clock_at(ap_tsf, true_us)) -
+                    static_cast<int64_t>(clock_at(node_b, true_us)) - (kSyncAsymmetryUs / 4);
+    }
+    if (!vibesensor::runtime::tsf_mapping_ready(mapping_a) ||
+        !vibesensor::runtime::tsf_mapping_ready(mapping_b) || offset_a_us == 0) {
+      continue;
+    }
+
+    // Both nodes timestamp the same physical instant shortly after `true_us`.
+    const uint64_t event_us = true_us + 37000ULL;
+    const int64_t tsf_a = static_cast<int64_t>(
+        vibesensor::runtime::tsf_from_local_us(mapping_a, clock_at(node_a, event_us)));
+    const int64_t tsf_b = static_cast<int64_t>(
+        vibesensor::runtime::tsf_from_local_us(mapping_b, clock_at(node_b, event_us)));
+    const int64_t rt_a = static_cast<int64_t>(clock_at(node_a, event_us)) + offset_a_us;
+    const int64_t rt_b = static_cast<int64_t>(clock_at(node_b, event_us)) + offset_b_us;
+    if (abs_i64(tsf_a - tsf_b) > max_tsf_error_us) {
+      max_tsf_error_us = abs_i64(tsf_a - tsf_b);
+    }
+    if (abs_i64(rt_a - rt_b) > max_round_trip_error_us) {
+      max_round_trip_error_us = abs_i64(rt_a - rt_b);
+    }
+  }
+
+  printf("tsf_timebase max_cross_node_error_us=%lld round_trip_sync max_cross_node_error_us=%lld\n",
+         static_cast<long long>(max_tsf_error_us),
+         static_cast<long long>(max_round_trip_error_us));
+  TEST_ASSERT_TRUE(max_tsf_error_us <= 10);
+  TEST_ASSERT_TRUE(max_tsf_error_us < max_round_trip_error_us);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_tsf_mapping_recovers_offset_and_skew);
+  RUN_TEST(test_tsf_mapping_restarts_on_tsf_jump_but_keeps_rate_prior);
+  RUN_TEST(test_tsf_mapping_rejects_implausible_skew);
+  RUN_TEST(test_service_tsf_sync_samples_on_interval_only_when_associated);
+  RUN_TEST(test_service_tx_waits_for_tsf_mapping_and_sends_tsf_t0);
+  RUN_TEST(test_tsf_timebase_aligns_nodes_tighter_than_round_trip_sync);
+  return UNITY_END();
+}
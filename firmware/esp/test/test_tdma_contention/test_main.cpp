@@ -0,0 +1,328 @@
+#include <unity.h>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <stdio.h>
+#include <vector>
+
+// Budget one frame at a low fallback PHY rate: ~1.6 ms on air plus DIFS and
+// a worst-case first backoff.
+#define VIBESENSOR_TDMA_FRAME_AIRTIME_US 2000
+
+#include "../native_support/generated_protocol_contract_fixtures.h"
+
+#include "../../lib/vibesensor_proto/vibesensor_proto.cpp"
+#include "../../src/runtime_backlog_stream.cpp"
+#include "../../src/runtime_led.cpp"
+#include "../../src/runtime_frame_codec.cpp"
+#include "../../src/runtime_queue.cpp"
+#include "../../src/runtime_status.cpp"
+#include "../../src/runtime_transport.cpp"
+#include "../../src/runtime_tsf_sync.cpp"
+
+namespace {
+
+using vibesensor::runtime::DataFrame;
+using vibesensor::runtime::FrameQueueState;
+using vibesensor::runtime::RuntimeStatus;
+using vibesensor::runtime::TransportState;
+
+// Shared-medium model: a DCF-style MAC (DIFS + slotted random backoff with
+// binary exponential CW and a short retry limit) in front of one AP. The car
+// body splits the nodes into two groups that cannot carrier-sense each other,
+// so cross-group transmissions overlap at the AP and both are lost.
+constexpr size_t kNodes = 8;
+constexpr uint64_t kStepUs = 10;
+constexpr uint64_t kSimUs = 12000000ULL;
+constexpr uint64_t kWarmupUs = 2000000ULL;
+// loop() spins with delay(0); a 250 us pass models it with sampling and
+// control work interleaved.
+constexpr uint64_t kLoopPeriodUs = 250;
+constexpr uint64_t kFramePeriodUs = 40000;
+constexpr uint64_t kOnAirUs = 1600;
+constexpr uint64_t kDifsUs = 30;
+constexpr uint64_t kBackoffSlotUs = 10;
+constexpr uint32_t kCwMin = 16;
+constexpr uint32_t kCwMax = 256;
+constexpr uint8_t kMacRetryLimit = 3;
+constexpr uint64_t kAckDelayUs = 1500;
+constexpr uint64_t kSyncIntervalUs = 5000000ULL;
+constexpr uint32_t kSyncRoundTripUs = 400;
+constexpr uint32_t kSlotPeriodUs = 32000;
+constexpr size_t kQueueFrames = 32;
+
+struct MacFrame {
+  uint32_t seq = 0;
+  uint8_t retries = 0;
+};
+
+struct Node {
+  TransportState transport;
+  RuntimeStatus status;
+  FrameQueueState queue;
+  alignas(DataFrame) uint8_t ring[kQueueFrames * vibesensor::runtime::kFrameRecordMaxBytes];
+  std::deque<MacFrame> mac_queue;
+  uint32_t cw = kCwMin;
+  int64_t backoff_us = -1;
+  bool on_air = false;
+  bool collided = false;
+  uint64_t air_end_us = 0;
+  MacFrame air_frame;
+  std::vector<uint64_t> produced_us;
+  std::vector<uint64_t> delivered_us;
+};
+
+struct PendingAck {
+  size_t node;
+  uint32_t seq;
+  uint64_t due_us;
+};
+
+struct SimResult {
+  uint64_t produced = 0;
+  uint64_t delivered = 0;
+  uint64_t collisions = 0;
+  uint64_t air_us = 0;
+  uint64_t p50_latency_us = 0;
+  uint64_t p99_latency_us = 0;
+  double goodput_bytes_per_s = 0.0;
+};
+
+uint32_t g_rng = 0x9e3779b9U;
+
+uint32_t next_random() {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 17;
+  g_rng ^= g_rng << 5;
+  return g_rng;
+}
+
+bool can_hear(size_t a, size_t b) { return (a < kNodes / 2) == (b < kNodes / 2); }
+
+bool medium_busy_for(const std::array<bool, kNodes>& on_air, size_t self) {
+  for (size_t i = 0; i < kNodes; ++i) {
+    if (i != self && on_air[i] && can_hear(i, self)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void append_full_frame(Node& node, uint64_t now_us) {
+  int16_t xyz[static_cast<size_t>(vibesensor::runtime::kFrameSamples) *
+              vibesensor::runtime::kAxesPerSample] = {};
+  for (uint16_t i = 0; i < vibesensor::runtime::kFrameSamples; ++i) {
+    const size_t idx = static_cast<size_t>(i) * vibesensor::runtime::kAxesPerSample;
+    xyz[idx + 0] = 1;
+    xyz[idx + 1] = 2;
+    xyz[idx + 2] = 3;
+  }
+  vibesensor::runtime::enqueue_frame(
+      node.queue,
+      node.status,
+      static_cast<uint64_t>(static_cast<int64_t>(now_us) + node.transport.clock_offset_us),
+      xyz,
+      vibesensor::runtime::kFrameSamples);
+}
+
+void set_clock(uint64_t now_us) {
+  arduino_test::set_esp_time(now_us);
+  arduino_test::set_millis(static_cast<uint32_t>(now_us / 1000ULL));
+}
+
+SimResult run_medium(bool tdma) {
+  g_rng = 0x9e3779b9U;
+  std::vector<Node> storage(kNodes);
+  std::vector<Node*> nodes;
+  for (size_t i = 0; i < kNodes; ++i) {
+    Node& node = storage[i];
+    node.queue.ring = node.ring;
+    node.queue.ring_bytes = sizeof(node.ring);
+    node.transport.client_id[5] = static_cast<uint8_t>(i + 1);
+    node.transport.handshake_complete = true;
+    if (tdma) {
+      // Residual sync error after CMD_SYNC_CLOCK, well inside the RTT/2 bound.
+      node.transport.clock_offset_us =
+          static_cast<int64_t>(next_random() % 301U) - 150;
+      node.status.sync_round_trip_us = kSyncRoundTripUs;
+      node.transport.tx_slot.offset_us = static_cast<uint32_t>(i * (kSlotPeriodUs / kNodes));
+      node.transport.tx_slot.period_us = kSlotPeriodUs;
+      node.transport.tx_slot.width_us = kSlotPeriodUs / kNodes;
+    }
+    nodes.push_back(&node);
+  }
+
+  std::deque<PendingAck> acks;
+  SimResult result;
+  for (uint64_t now_us = 0; now_us < kSimUs; now_us += kStepUs) {
+    set_clock(now_us);
+    while (!acks.empty() && acks.front().due_us <= now_us) {
+      vibesensor::runtime::ack_data_frames(nodes[acks.front().node]->queue, acks.front().seq);
+      acks.pop_front();
+    }
+
+    for (size_t i = 0; i < kNodes; ++i) {
+      Node& node = *nodes[i];
+      // Sample clocks differ by a few hundred ppm, so frame boundaries slide
+      // past each other instead of staying politely interleaved.
+      const uint64_t frame_period_us = kFramePeriodUs + (i * 10ULL);
+      const uint64_t phase_us = (i * 3700ULL) % frame_period_us;
+      if (now_us % frame_period_us == phase_us) {
+        node.produced_us.push_back(now_us);
+        node.delivered_us.push_back(0);
+        append_full_frame(node, now_us);
+      }
+      if (tdma && now_us % kSyncIntervalUs == 0) {
+        node.transport.last_sync_ms = millis();
+      }
+      if (now_us % kLoopPeriodUs == (i * 30ULL) % kLoopPeriodUs) {
+        const size_t sent_before = node.transport.data_udp.sent_packets.size();
+        vibesensor::runtime::service_tx(node.transport, node.queue, node.status);
+        if (node.transport.data_udp.sent_packets.size() != sent_before) {
+          MacFrame frame;
+          frame.seq = vibesensor::runtime::peek_frame(node.queue)->seq;
+          node.mac_queue.push_back(frame);
+        }
+      }
+    }
+
+    for (size_t i = 0; i < kNodes; ++i) {
+      Node& node = *nodes[i];
+      if (!node.on_air || node.air_end_us > now_us) {
+        continue;
+      }
+      node.on_air = false;
+      if (!node.collided) {
+        const uint32_t seq = node.air_frame.seq;
+        if (seq < node.delivered_us.size() && node.delivered_us[seq] == 0) {
+          node.delivered_us[seq] = now_us;
+        }
+        acks.push_back(PendingAck{i, seq, now_us + kAckDelayUs});
+        node.cw = kCwMin;
+        continue;
+      }
+      if (now_us >= kWarmupUs) {
+        result.collisions++;
+      }
+      if (node.air_frame.retries < kMacRetryLimit) {
+        node.air_frame.retries++;
+        node.mac_queue.push_front(node.air_frame);
+        node.cw = std::min(node.cw * 2U, kCwMax);
+      } else {
+        node.cw = kCwMin;
+      }
+    }
+
+    // Carrier sense sees the medium as it was at the start of the step, so two
+    // audible nodes finishing backoff in the same slot still collide.
+    std::array<bool, kNodes> on_air = {};
+    for (size_t i = 0; i < kNodes; ++i) {
+      on_air[i] = nodes[i]->on_air;
+    }
+    for (size_t i = 0; i < kNodes; ++i) {
+      Node& node = *nodes[i];
+      if (node.on_air || node.mac_queue.empty()) {
+        continue;
+      }
+      if (medium_busy_for(on_air, i)) {
+        continue;
+      }
+      if (node.backoff_us < 0) {
+        node.backoff_us =
+            static_cast<int64_t>(kDifsUs + (next_random() % node.cw) * kBackoffSlotUs);
+      }
+      node.backoff_us -= static_cast<int64_t>(kStepUs);
+      if (node.backoff_us > 0) {
+        continue;
+      }
+      node.backoff_us = -1;
+      node.air_frame = node.mac_queue.front();
+      node.mac_queue.pop_front();
+      node.on_air = true;
+      node.collided = false;
+      node.air_end_us = now_us + kOnAirUs;
+      if (now_us >= kWarmupUs) {
+        result.air_us += kOnAirUs;
+      }
+      // Anything else on air at the AP overlaps this frame.
+      for (size_t j = 0; j < kNodes; ++j) {
+        if (j != i && nodes[j]->on_air) {
+          nodes[j]->collided = true;
+          node.collided = true;
+        }
+      }
+    }
+  }
+
+  std::vector<uint64_t> latencies;
+  for (size_t i = 0; i < kNodes; ++i) {
+    const Node& node = *nodes[i];
+    for (size_t seq = 0; seq < node.produced_us.size(); ++seq) {
+      const uint64_t produced_us = node.produced_us[seq];
+      if (produced_us < kWarmupUs || produced_us + 1000000ULL > kSimUs) {
+        continue;
+      }
+      result.produced++;
+      if (node.delivered_us[seq] == 0) {
+        continue;
+      }
+      result.delivered++;
+      latencies.push_back(node.delivered_us[seq] - produced_us);
+    }
+  }
+  std::sort(latencies.begin(), latencies.end());
+  if (!latencies.empty()) {
+    result.p50_latency_us = latencies[latencies.size() / 2];
+    result.p99_latency_us = latencies[(latencies.size() * 99U) / 100U];
+  }
+  const double frame_bytes = static_cast<double>(vibesensor::runtime::kFrameSamples) *
+                             static_cast<double>(vibesensor::runtime::kAxesPerSample) * 2.0;
+  const double window_s = static_cast<double>(kSimUs - kWarmupUs - 1000000ULL) / 1.0e6;
+  result.goodput_bytes_per_s = (static_cast<double>(result.delivered) * frame_bytes) / window_s;
+  return result;
+}
+
+void print_result(const char* label, const SimResult& result) {
+  printf("%s nodes=%u produced=%llu delivered=%llu goodput_Bps=%.0f collisions=%llu "
+         "air_ms=%llu p50_us=%llu p99_us=%llu\n",
+         label,
+         static_cast<unsigned>(kNodes),
+         static_cast<unsigned long long>(result.produced),
+         static_cast<unsigned long long>(result.delivered),
+         result.goodput_bytes_per_s,
+         static_cast<unsigned long long>(result.collisions),
+         static_cast<unsigned long long>(result.air_us / 1000ULL),
+         static_cast<unsigned long long>(result.p50_latency_us),
+         static_cast<unsigned long long>(result.p99_latency_us));
+}
+
+}  // namespace
+
+void setUp() {
+  arduino_test::reset_time();
+  WiFi.reset();
+  WiFi.setStatus(WL_CONNECTED);
+}
+
+void test_tdma_slots_beat_contention_on_shared_medium() {
+  const SimResult contention = run_medium(false);
+  const SimResult tdma = run_medium(true);
+  print_result("contention", contention);
+  print_result("tdma", tdma);
+
+  TEST_ASSERT_TRUE(contention.collisions > 0);
+  TEST_ASSERT_EQUAL_UINT64(0, tdma.collisions);
+  TEST_ASSERT_EQUAL_UINT64(tdma.produced, tdma.delivered);
+  TEST_ASSERT_TRUE(tdma.goodput_bytes_per_s >= contention.goodput_bytes_per_s);
+  TEST_ASSERT_TRUE(tdma.air_us < contention.air_us);
+  TEST_ASSERT_TRUE(tdma.p99_latency_us < contention.p99_latency_us);
+  // A frame waits at most one slot period plus its own airtime and the loop.
+  TEST_ASSERT_TRUE(tdma.p99_latency_us <= kSlotPeriodUs + kOnAirUs + (2U * kLoopPeriodUs));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_tdma_slots_beat_contention_on_shared_medium);
+  return UNITY_END();
+}
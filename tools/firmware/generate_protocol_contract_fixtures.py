@@ -22,15 +22,21 @@ OUTPUT = (
 )
 
 from vibesensor.adapters.udp.protocol import (  # noqa: E402
+    DATA_RANGE_TAG_CLIPPED,
+    DATA_RANGE_TAG_FULL_RES,
     HELLO_CAP_EXPLICIT_ACK,
+    HELLO_CAP_RANGE_TAG,
+    STREAM_RECORD_PREFIX_BYTES,
     pack_ack,
     pack_ack_sync_clock,
     pack_cmd_identify,
     pack_cmd_sync_clock,
+    pack_cmd_tx_slot,
     pack_data,
     pack_data_ack,
     pack_hello,
     pack_hello_ack,
+    pack_stream_record,
 )
 
 
@@ -61,7 +67,15 @@ def render_header() -> str:
         queue_overflow_drops=hello_queue_overflow_drops,
         capabilities=hello_capabilities,
     )
-    hello_ack_packet = pack_hello_ack(hello_client_id)
+    hello_ack_capabilities = HELLO_CAP_EXPLICIT_ACK | HELLO_CAP_RANGE_TAG
+    hello_ack_packet = pack_hello_ack(hello_client_id, hello_ack_capabilities)
+    hello_ack_contiguous_seq = 41
+    hello_ack_receipt_bitmap = 0x5
+    hello_ack_receipts_packet = pack_hello_ack(
+        hello_client_id,
+        hello_ack_capabilities,
+        (hello_ack_contiguous_seq, hello_ack_receipt_bitmap),
+    )
 
     data_client_id = bytes.fromhex("010203040506")
     data_seq = 17
@@ -73,6 +87,25 @@ def render_header() -> str:
         t0_us=data_t0_us,
         samples=data_samples,
     )
+    data_stream_record_prefix = pack_stream_record(data_packet)[:STREAM_RECORD_PREFIX_BYTES]
+    data_range_tag = DATA_RANGE_TAG_FULL_RES | DATA_RANGE_TAG_CLIPPED | 1
+    data_tagged_packet = pack_data(
+        client_id=data_client_id,
+        seq=data_seq,
+        t0_us=data_t0_us,
+        samples=data_samples,
+        range_tag=data_range_tag,
+    )
+    data_pulse_edge_count = 513
+    data_pulse_last_edge_offset_us = -1_250
+    data_pulse_packet = pack_data(
+        client_id=data_client_id,
+        seq=data_seq,
+        t0_us=data_t0_us,
+        samples=data_samples,
+        range_tag=data_range_tag,
+        pulse=(data_pulse_edge_count, data_pulse_last_edge_offset_us),
+    )
 
     cmd_client_id = bytes.fromhex("112233445566")
     identify_cmd_seq = 42
@@ -103,6 +136,18 @@ def render_header() -> str:
         device_send_us=sync_clock_ack_send_us,
     )
 
+    tx_slot_cmd_seq = 11
+    tx_slot_offset_us = 2_500
+    tx_slot_period_us = 20_000
+    tx_slot_width_us = 2_500
+    tx_slot_packet = pack_cmd_tx_slot(
+        cmd_client_id,
+        cmd_seq=tx_slot_cmd_seq,
+        slot_offset_us=tx_slot_offset_us,
+        slot_period_us=tx_slot_period_us,
+        slot_width_us=tx_slot_width_us,
+    )
+
     ack_client_id = bytes.fromhex("aabbccddeeff")
     ack_cmd_seq = 99
     ack_status = 0
@@ -139,7 +184,11 @@ constexpr char kHelloFirmwareVersion[] = "{hello_firmware_version}";
 constexpr uint32_t kHelloQueueOverflowDrops = {hello_queue_overflow_drops};
 constexpr uint8_t kHelloCapabilities = {hello_capabilities};
 constexpr std::array<uint8_t, {len(hello_packet)}> kHelloPacket = {{{_format_u8_array(hello_packet)}}};
+constexpr uint8_t kHelloAckCapabilities = 0x{hello_ack_capabilities:02x};
 constexpr std::array<uint8_t, {len(hello_ack_packet)}> kHelloAckPacket = {{{_format_u8_array(hello_ack_packet)}}};
+constexpr uint32_t kHelloAckContiguousSeq = {hello_ack_contiguous_seq};
+constexpr uint32_t kHelloAckReceiptBitmap = 0x{hello_ack_receipt_bitmap:x};
+constexpr std::array<uint8_t, {len(hello_ack_receipts_packet)}> kHelloAckReceiptsPacket = {{{_format_u8_array(hello_ack_receipts_packet)}}};
 
 constexpr std::array<uint8_t, 6> kDataClientId = {{{_format_u8_array(data_client_id)}}};
 constexpr uint32_t kDataSeq = {data_seq};
@@ -147,6 +196,12 @@ constexpr uint64_t kDataT0Us = {data_t0_us}ULL;
 constexpr uint16_t kDataSampleCount = {data_samples.shape[0]};
 constexpr std::array<int16_t, {data_samples.size}> kDataSamples = {{{_format_i16_array(data_samples)}}};
 constexpr std::array<uint8_t, {len(data_packet)}> kDataPacket = {{{_format_u8_array(data_packet)}}};
+constexpr std::array<uint8_t, {len(data_stream_record_prefix)}> kDataStreamRecordPrefix = {{{_format_u8_array(data_stream_record_prefix)}}};
+constexpr uint8_t kDataRangeTag = 0x{data_range_tag:02x};
+constexpr std::array<uint8_t, {len(data_tagged_packet)}> kDataTaggedPacket = {{{_format_u8_array(data_tagged_packet)}}};
+constexpr uint16_t kDataPulseEdgeCount = {data_pulse_edge_count};
+constexpr int32_t kDataPulseLastEdgeOffsetUs = {data_pulse_last_edge_offset_us};
+constexpr std::array<uint8_t, {len(data_pulse_packet)}> kDataPulsePacket = {{{_format_u8_array(data_pulse_packet)}}};
 
 constexpr std::array<uint8_t, 6> kCommandClientId = {{{_format_u8_array(cmd_client_id)}}};
 constexpr uint32_t kIdentifyCmdSeq = {identify_cmd_seq};
@@ -162,6 +217,12 @@ constexpr uint64_t kSyncClockAckReceiveUs = {sync_clock_ack_receive_us}ULL;
 constexpr uint64_t kSyncClockAckSendUs = {sync_clock_ack_send_us}ULL;
 constexpr std::array<uint8_t, {len(sync_clock_ack_packet)}> kSyncClockAckPacket = {{{_format_u8_array(sync_clock_ack_packet)}}};
 
+constexpr uint32_t kTxSlotCmdSeq = {tx_slot_cmd_seq};
+constexpr uint32_t kTxSlotOffsetUs = {tx_slot_offset_us};
+constexpr uint32_t kTxSlotPeriodUs = {tx_slot_period_us};
+constexpr uint32_t kTxSlotWidthUs = {tx_slot_width_us};
+constexpr std::array<uint8_t, {len(tx_slot_packet)}> kTxSlotPacket = {{{_format_u8_array(tx_slot_packet)}}};
+
 constexpr std::array<uint8_t, 6> kAckClientId = {{{_format_u8_array(ack_client_id)}}};
 constexpr uint32_t kAckCmdSeq = {ack_cmd_seq};
 constexpr uint8_t kAckStatus = {ack_status};